@@ -171,7 +171,7 @@ export class LightProbeGroup extends Component {
         const changed = lightProbeInfo.addNode(this.node);
         if (changed) {
             lightProbeInfo.syncData(this.node, this.probes);
-            lightProbeInfo.update(true);
+            lightProbeInfo.update(true, true);
         }
     }
 
@@ -225,7 +225,8 @@ export class LightProbeGroup extends Component {
     public onProbeChanged (updateTet = true, emitEvent = true): void {
         const lightProbeInfo = this.node.scene.globals.lightProbeInfo;
         lightProbeInfo.syncData(this.node, this.probes);
-        lightProbeInfo.update(updateTet);
+        // probes are edited a few at a time, only retriangulate around the changed ones
+        lightProbeInfo.update(updateTet, true);
 
         if (emitEvent) {
             this.node.emit(NodeEventType.LIGHT_PROBE_CHANGED);
@@ -706,6 +706,21 @@ export interface BasicPipeline extends PipelineRuntime, Setter {
      * @zh 光照计算时，裁切受光源影响的物件。默认开启。
      */
     enableCpuLightCulling: boolean;
+    /**
+     * @en Record render passes on job system workers when the device supports it. Disabled by default.
+     * @zh 设备支持时，在任务系统的工作线程上录制渲染通道。默认关闭。
+     */
+    enableParallelRecording: boolean;
+    /**
+     * @en Reorder independent passes to shorten attachment lifetimes and barriers. Disabled by default.
+     * @zh 重排互不依赖的渲染通道，以缩短附件生命周期并减少屏障。默认关闭。
+     */
+    enablePassReorder: boolean;
+    /**
+     * @en Let transient resources whose lifetimes do not overlap share memory slots. Disabled by default.
+     * @zh 让生命周期互不重叠的临时资源共享内存槽。默认关闭。
+     */
+    enableMemoryAliasing: boolean;
     /**
      * @en Check whether the resource has been registered in the pipeline.
      * @zh 检查资源是否在管线中已注册
@@ -851,6 +851,30 @@ export class WebPipeline implements BasicPipeline {
         }
         this._executor._context.culling.enableLightCulling = enable;
     }
+    // only stored, passes are always recorded on the main thread on the web
+    get enableParallelRecording (): boolean {
+        return this._enableParallelRecording;
+    }
+    set enableParallelRecording (enable: boolean) {
+        this._enableParallelRecording = enable;
+    }
+    private _enableParallelRecording = false;
+    // only stored, passes always run in submission order on the web
+    get enablePassReorder (): boolean {
+        return this._enablePassReorder;
+    }
+    set enablePassReorder (enable: boolean) {
+        this._enablePassReorder = enable;
+    }
+    private _enablePassReorder = false;
+    // only stored, the web backend allocates every transient resource separately
+    get enableMemoryAliasing (): boolean {
+        return this._enableMemoryAliasing;
+    }
+    set enableMemoryAliasing (enable: boolean) {
+        this._enableMemoryAliasing = enable;
+    }
+    private _enableMemoryAliasing = false;
     addCustomBuffer (name: string, info: BufferInfo, type: string): number {
         throw new Error('Method not implemented.');
     }
@@ -1519,7 +1519,12 @@ export class LightProbeInfo {
         }
     }
 
-    public update (updateTet = true): void {
+    /**
+     * @param updateTet whether to update the tetrahedrons of the probes
+     * @param incremental keep the tetrahedralization between updates and only retriangulate around changed probes,
+     * only used on native platforms, the web implementation always rebuilds it
+     */
+    public update (updateTet = true, incremental = false): void {
         if (!cclegacy.internal.LightProbesData) {
             return;
         }
@@ -22,6 +22,8 @@
  THE SOFTWARE.
 ****************************************************************************/
 #include "3d/models/BakedSkinningModel.h"
+#include <algorithm>
+#include <cfloat>
 #include "3d/assets/Mesh.h"
 //#include "3d/skeletal-animation/DataPoolManager.h"
 #include "core/Root.h"
@@ -57,6 +59,7 @@ BakedSkinningModel::BakedSkinningModel()
 
 void BakedSkinningModel::destroy() {
     // CC_SAFE_DELETE(uploadedAnim);
+    setCrowdInstanceCount(0);
     _jointMedium.boundsInfo.clear();
 
     if (_jointMedium.buffer != nullptr) {
@@ -90,6 +93,31 @@ void BakedSkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Me
 
 void BakedSkinningModel::updateTransform(uint32_t stamp) {
     Super::updateTransform(stamp);
+    updateAnimationBounds();
+    packCrowdInstances();
+    mergeCrowdBounds();
+}
+
+void BakedSkinningModel::updateUBOs(uint32_t stamp) {
+    Super::updateUBOs(stamp);
+    updateInstancedFrame();
+    commitFrameData();
+}
+
+void BakedSkinningModel::updateLocalData(uint32_t stamp) {
+    Super::updateLocalData(stamp);
+    updateAnimationBounds();
+    packCrowdInstances();
+    mergeCrowdBounds();
+    updateInstancedFrame();
+}
+
+void BakedSkinningModel::uploadLocalData(uint32_t stamp) {
+    Super::uploadLocalData(stamp);
+    commitFrameData();
+}
+
+void BakedSkinningModel::updateAnimationBounds() {
     if (!_isUploadedAnim) {
         return;
     }
@@ -109,29 +137,169 @@ void BakedSkinningModel::updateTransform(uint32_t stamp) {
     }
 }
 
-void BakedSkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
-
-    IAnimInfo &info = _jointMedium.animInfo;
+void BakedSkinningModel::updateInstancedFrame() {
     const int idx = _instAnimInfoIdx;
-    const float *curFrame = info.curFrame;
-    bool hasNonInstancingPass = false;
+    if (idx < 0) {
+        return;
+    }
+    const float *curFrame = _jointMedium.animInfo.curFrame;
     for (const auto &subModel : _subModels) {
-        if (idx >= 0) {
-            auto &views = subModel->getInstancedAttributeBlock().views[idx];
-            setTypedArrayValue(views, 0, *curFrame);
-        } else {
-            hasNonInstancingPass = true;
-        }
+        auto &views = subModel->getInstancedAttributeBlock().views[idx];
+        setTypedArrayValue(views, 0, *curFrame);
     }
+}
 
+void BakedSkinningModel::commitFrameData() {
+    IAnimInfo &info = _jointMedium.animInfo;
+    // without instancing the frame is uploaded to the uniform buffer
+    const bool hasNonInstancingPass = _instAnimInfoIdx < 0 && !_subModels.empty();
     const uint32_t frameDataBytes = info.frameDataBytes;
     if (hasNonInstancingPass && *info.dirtyForJSB != 0) {
-        info.buffer->update(curFrame, frameDataBytes);
+        info.buffer->update(info.curFrame, frameDataBytes);
         *info.dirtyForJSB = 0;
     }
 }
 
+void BakedSkinningModel::setCrowdInstanceCount(uint32_t count) {
+    if (count == _crowdInstanceCount) {
+        return;
+    }
+    if (count > 0 && _instAnimInfoIdx < 0 && !_subModels.empty()) {
+        CC_LOG_WARNING("Crowd instances of baked skinning model are only drawn by instanced passes.");
+    }
+    _crowdInstanceCount = count;
+    _crowdData.resize(static_cast<size_t>(count) * CROWD_INSTANCE_FLOATS);
+    _crowdDirty = true;
+    if (count == 0) {
+        _crowdAttributes.clear();
+        for (const auto &subModel : _subModels) {
+            subModel->setBatchedInstances(nullptr, 0);
+        }
+    }
+}
+
+void BakedSkinningModel::setCrowdInstance(uint32_t index, const Mat4 &world, float frame, float clipPixelOffset) {
+    if (index >= _crowdInstanceCount) {
+        return;
+    }
+    float *dst = _crowdData.data() + static_cast<size_t>(index) * CROWD_INSTANCE_FLOATS;
+    const float *m = world.m;
+    dst[0] = m[0];
+    dst[1] = m[1];
+    dst[2] = m[2];
+    dst[3] = m[12];
+    dst[4] = m[4];
+    dst[5] = m[5];
+    dst[6] = m[6];
+    dst[7] = m[13];
+    dst[8] = m[8];
+    dst[9] = m[9];
+    dst[10] = m[10];
+    dst[11] = m[14];
+    dst[12] = frame;
+    dst[13] = clipPixelOffset;
+    _crowdDirty = true;
+}
+
+void BakedSkinningModel::updateCrowdInstances(const Float32Array &data) {
+    const auto count = std::min(data.length() / CROWD_INSTANCE_FLOATS, _crowdInstanceCount);
+    if (count == 0) {
+        return;
+    }
+    memcpy(_crowdData.data(), &data[0], sizeof(float) * count * CROWD_INSTANCE_FLOATS);
+    _crowdDirty = true;
+}
+
+void BakedSkinningModel::packCrowdInstances() {
+    if (!_crowdDirty) {
+        return;
+    }
+    _crowdDirty = false;
+    _crowdBoundsChanged = true;
+    const uint32_t count = _crowdInstanceCount;
+    if (count == 0) {
+        return;
+    }
+
+    const index_t animIdx = _instAnimInfoIdx;
+    const float jointCount = _jointMedium.jointTextureInfo[1];
+    _crowdAttributes.resize(_subModels.size());
+    for (size_t i = 0; i < _subModels.size(); ++i) {
+        auto *subModel = _subModels[i].get();
+        auto &block = subModel->getInstancedAttributeBlock();
+        const uint32_t stride = block.buffer.length();
+        const int32_t worldIdx = subModel->getInstancedWorldMatrixIndex();
+        if (!stride || worldIdx < 0 || animIdx < 0) {
+            subModel->setBatchedInstances(nullptr, 0);
+            continue;
+        }
+        const uint32_t rowOffsets[3] = {
+            ccstd::get<Float32Array>(block.views[worldIdx]).byteOffset(),
+            ccstd::get<Float32Array>(block.views[worldIdx + 1]).byteOffset(),
+            ccstd::get<Float32Array>(block.views[worldIdx + 2]).byteOffset(),
+        };
+        const uint32_t animOffset = ccstd::get<Float32Array>(block.views[animIdx]).byteOffset();
+        const uint8_t *prototype = block.buffer.buffer()->getData();
+
+        // every instance starts from the attributes of this model, e.g. lightmap uv or user attributes
+        auto &packed = _crowdAttributes[i];
+        packed.resize(static_cast<size_t>(stride) * count);
+        const float *src = _crowdData.data();
+        uint8_t *dst = packed.data();
+        for (uint32_t n = 0; n < count; ++n, src += CROWD_INSTANCE_FLOATS, dst += stride) {
+            memcpy(dst, prototype, stride);
+            memcpy(dst + rowOffsets[0], src, sizeof(float) * 4);
+            memcpy(dst + rowOffsets[1], src + 4, sizeof(float) * 4);
+            memcpy(dst + rowOffsets[2], src + 8, sizeof(float) * 4);
+            // the pixel offset is an integer, guard against floor() underflow like applyJointTexture
+            const float animInfo[3] = {src[12], jointCount, src[13] + 0.1F};
+            memcpy(dst + animOffset, animInfo, sizeof(animInfo));
+        }
+        subModel->setBatchedInstances(packed.data(), count);
+    }
+
+    if (!_modelBounds || !_modelBounds->isValid()) {
+        return;
+    }
+    Vec3 crowdMin{FLT_MAX, FLT_MAX, FLT_MAX};
+    Vec3 crowdMax{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    Vec3 instanceMin;
+    Vec3 instanceMax;
+    Mat4 world;
+    geometry::AABB instanceBounds;
+    const float *src = _crowdData.data();
+    for (uint32_t n = 0; n < count; ++n, src += CROWD_INSTANCE_FLOATS) {
+        world.set(src[0], src[1], src[2], 0.F,
+                  src[4], src[5], src[6], 0.F,
+                  src[8], src[9], src[10], 0.F,
+                  src[3], src[7], src[11], 1.F);
+        _modelBounds->transform(world, &instanceBounds);
+        instanceBounds.getBoundary(&instanceMin, &instanceMax);
+        Vec3::min(crowdMin, instanceMin, &crowdMin);
+        Vec3::max(crowdMax, instanceMax, &crowdMax);
+    }
+    geometry::AABB::fromPoints(crowdMin, crowdMax, &_crowdBounds);
+}
+
+void BakedSkinningModel::mergeCrowdBounds() {
+    if (!_worldBounds || !_modelBounds || !_modelBounds->isValid()) {
+        return;
+    }
+    if (_crowdBoundsChanged) {
+        // the world bounds still hold the crowd merged before if neither the node nor the animation changed
+        _crowdBoundsChanged = false;
+        if (!_isUploadedAnim) {
+            _modelBounds->transform(getTransform()->getWorldMatrix(), _worldBounds);
+        }
+        _worldBoundsDirty = true;
+    }
+    if (_crowdInstanceCount == 0) {
+        return;
+    }
+    _worldBounds->merge(_crowdBounds);
+    _worldBoundsDirty = true;
+}
+
 void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture) {
     auto oldTex = _jointMedium.texture;
     if (oldTex.has_value() && texture.has_value() && (&oldTex.value() != &texture.value())) {
@@ -185,6 +353,8 @@ void BakedSkinningModel::updateInstancedAttributes(const ccstd::vector<gfx::Attr
     Super::updateInstancedAttributes(attributes, subModel);
     _instAnimInfoIdx = subModel->getInstancedAttributeIndex(INST_JOINT_ANIM_INFO);
     updateInstancedJointTextureInfo();
+    // the attribute layout changed, repack the crowd with it
+    _crowdDirty = _crowdInstanceCount > 0;
 }
 
 void BakedSkinningModel::updateInstancedJointTextureInfo() {
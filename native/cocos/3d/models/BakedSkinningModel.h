@@ -50,6 +50,15 @@ struct BakedJointInfo {
 class BakedSkinningModel final : public MorphModel {
 public:
     using Super = MorphModel;
+    /**
+     * @en Floats per crowd instance: the world matrix as three rows of [m0 m1 m2 m12], [m4 m5 m6 m13], [m8 m9 m10 m14],
+     * followed by the current frame and the pixel offset of the clip in the joint texture, i.e. the integer
+     * IJointTextureHandle::pixelOffset of the clip.
+     * @zh 每个群体实例的浮点数个数：按 [m0 m1 m2 m12]、[m4 m5 m6 m13]、[m8 m9 m10 m14] 排列的世界矩阵，接着是当前帧与动画片段在骨骼贴图中的像素偏移，
+     * 即该动画片段的 IJointTextureHandle::pixelOffset 整数值。
+     */
+    static constexpr uint32_t CROWD_INSTANCE_FLOATS = 14;
+
     BakedSkinningModel();
     ~BakedSkinningModel() override = default;
     void destroy() override;
@@ -57,6 +66,8 @@ public:
     void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet) override;
     void updateTransform(uint32_t stamp) override;
     void updateUBOs(uint32_t stamp) override;
+    void updateLocalData(uint32_t stamp) override;
+    void uploadLocalData(uint32_t stamp) override;
     void updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, scene::SubModel *subModel) override;
     void updateInstancedJointTextureInfo();
     // void                             uploadAnimation(AnimationClip *anim); // TODO(xwx): AnimationClip not define
@@ -83,10 +94,38 @@ public:
 
     void setUploadedAnimForJS(bool value) { _isUploadedAnim = value; }
 
+    /**
+     * @en Sets the number of crowd instances drawn together with this model. All crowd instances share the joint
+     * texture of this model, so every clip they play must be baked into that texture. Crowd instances are only
+     * rendered by instanced passes and are culled as a whole with the bounds of this model.
+     * @zh 设置与该模型一同绘制的群体实例数量。所有群体实例共享该模型的骨骼贴图，因此其播放的动画片段必须烘焙在同一张贴图中。
+     * 群体实例只在实例化渲染的 Pass 中绘制，并以该模型的包围盒整体剔除。
+     */
+    void setCrowdInstanceCount(uint32_t count);
+    inline uint32_t getCrowdInstanceCount() const { return _crowdInstanceCount; }
+
+    /**
+     * @en Sets the transform and animation state of one crowd instance.
+     * @zh 设置单个群体实例的变换与动画状态。
+     */
+    void setCrowdInstance(uint32_t index, const Mat4 &world, float frame, float clipPixelOffset);
+
+    /**
+     * @en Updates all crowd instances at once, see CROWD_INSTANCE_FLOATS for the layout.
+     * @zh 一次性更新所有群体实例，数据布局参见 CROWD_INSTANCE_FLOATS。
+     */
+    void updateCrowdInstances(const Float32Array &data);
+
 protected:
     void applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture);
 
 private:
+    void updateAnimationBounds();
+    void updateInstancedFrame();
+    void commitFrameData();
+    void packCrowdInstances();
+    void mergeCrowdBounds();
+
     BakedJointInfo _jointMedium;
     index_t _instAnimInfoIdx{CC_INVALID_INDEX};
     //    IntrusivePtr<DataPoolManager> _dataPoolManager;
@@ -95,6 +134,14 @@ private:
     // AnimationClip* uploadedAnim;
     bool _isUploadedAnim{false};
 
+    ccstd::vector<float> _crowdData;
+    // packed instanced attributes of the crowd, one block per sub model
+    ccstd::vector<ccstd::vector<uint8_t>> _crowdAttributes;
+    geometry::AABB _crowdBounds;
+    uint32_t _crowdInstanceCount{0};
+    bool _crowdDirty{false};
+    bool _crowdBoundsChanged{false};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(BakedSkinningModel);
 };
 
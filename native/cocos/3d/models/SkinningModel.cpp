@@ -78,6 +78,10 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     }
     _bufferIndices.clear();
     _joints.clear();
+    if (_jointPalette) {
+        releaseJointPalette(_jointPalette);
+        _jointPalette = nullptr;
+    }
 
     if (!skeleton || !skinningRoot || !mesh) return;
     auto jointCount = static_cast<uint32_t>(skeleton->getJoints().size());
@@ -88,12 +92,13 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     ensureEnoughBuffers((jointMaps.has_value() && !jointMaps->empty()) ? static_cast<uint32_t>(jointMaps->size()) : 1);
     _bufferIndices = mesh->getJointBufferIndices();
     initRealTimeJointTexture();
+    _jointPalette = acquireJointPalette(skeleton, skinningRoot);
     for (index_t index = 0; index < skeleton->getJoints().size(); ++index) {
         geometry::AABB *bound = boneSpaceBounds[index];
-        auto *target = skinningRoot->getChildByPath(skeleton->getJoints()[index]);
-        if (!bound || !target) continue;
+        auto *transform = _jointPalette->transforms[index].get();
+        if (!bound || !transform) continue;
 
-        auto *transform = cc::getTransform(target, skinningRoot);
+        auto *target = transform->node;
         const Mat4 &bindPose = skeleton->getBindposes()[index];
         ccstd::vector<index_t> indices;
         ccstd::vector<index_t> buffers;
@@ -111,6 +116,7 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
         jointInfo.transform = transform;
         jointInfo.buffers = std::move(buffers);
         jointInfo.indices = std::move(indices);
+        jointInfo.jointIndex = index;
         _joints.emplace_back(std::move(jointInfo));
     }
 }
@@ -121,14 +127,68 @@ void SkinningModel::updateTransform(uint32_t stamp) {
         root->updateWorldTransform();
         _localDataUpdated = true;
     }
+    updateJointTransforms(stamp);
+    updateJointData(stamp);
+}
+
+void SkinningModel::updateUBOs(uint32_t stamp) {
+    Super::updateUBOs(stamp);
+    commitJointData();
+}
+
+void SkinningModel::prepareParallelUpdate(uint32_t stamp) {
+    Super::prepareParallelUpdate(stamp);
+    // joint transforms are shared by the models skinned with the same skeleton
+    updateJointTransforms(stamp);
+}
+
+void SkinningModel::updateLocalData(uint32_t stamp) {
+    const auto *root = getTransform();
+    if (root->getChangedFlags() || root->isTransformDirty()) {
+        _localDataUpdated = true;
+    }
+    updateJointData(stamp);
+    updateLocalUBOData();
+}
+
+void SkinningModel::uploadLocalData(uint32_t stamp) {
+    Super::uploadLocalData(stamp);
+    commitJointData();
+}
+
+void SkinningModel::updateJointTransforms(uint32_t stamp) {
+    if (_jointPalette) {
+        updateJointPaletteTransforms(_jointPalette, static_cast<int32_t>(stamp));
+    }
+}
+
+// write the joint palette to the skinning data and merge the joint bounds in one pass
+void SkinningModel::updateJointData(uint32_t stamp) {
+    // reuse the palette computed by other models bound to the same skeleton and root,
+    // otherwise compute the palette directly into the skinning data
+    const float *palette = nullptr;
+    if (_jointPalette && _jointPalette->getRefCount() > 1) {
+        palette = updateJointPalette(_jointPalette, static_cast<int32_t>(stamp));
+    }
+
     Vec3 v3Min{INFINITY, INFINITY, INFINITY};
     Vec3 v3Max{-INFINITY, -INFINITY, -INFINITY};
     geometry::AABB ab1;
     Vec3 v31;
     Vec3 v32;
-    for (JointInfo &jointInfo : _joints) {
-        auto &transform = jointInfo.transform;
-        Mat4 worldMatrix = cc::getWorldMatrix(transform, static_cast<int32_t>(stamp));
+    for (const JointInfo &jointInfo : _joints) {
+        const Mat4 &worldMatrix = jointInfo.transform->world;
+        const float *src = palette ? palette + jointInfo.jointIndex * JOINT_PALETTE_STRIDE : nullptr;
+        for (size_t i = 0; i < jointInfo.buffers.size(); ++i) {
+            float *dst = _dataArray[jointInfo.buffers[i]] + jointInfo.indices[i] * JOINT_PALETTE_STRIDE;
+            if (src) {
+                memcpy(dst, src, sizeof(float) * JOINT_PALETTE_STRIDE);
+            } else {
+                computeJointPalette(worldMatrix, jointInfo.bindpose, dst);
+                src = dst;
+            }
+        }
+
         jointInfo.bound->transform(worldMatrix, &ab1);
         ab1.getBoundary(&v31, &v32);
         Vec3::min(v3Min, v31, &v3Min);
@@ -136,27 +196,16 @@ void SkinningModel::updateTransform(uint32_t stamp) {
     }
     if (_modelBounds && _modelBounds->isValid() && _worldBounds) {
         geometry::AABB::fromPoints(v3Min, v3Max, _modelBounds);
-        _modelBounds->transform(root->getWorldMatrix(), _worldBounds);
+        _modelBounds->transform(getTransform()->getWorldMatrix(), _worldBounds);
         _worldBoundsDirty = true;
     }
 }
 
-void SkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
-    uint32_t bIdx = 0;
-    Mat4 mat4;
-    for (const JointInfo &jointInfo : _joints) {
-        Mat4::multiply(jointInfo.transform->world, jointInfo.bindpose, &mat4);
-        for (uint32_t buffer : jointInfo.buffers) {
-            uploadJointData(jointInfo.indices[bIdx] * 12, mat4, _dataArray[buffer]);
-            bIdx++;
-        }
-        bIdx = 0;
-    }
+void SkinningModel::commitJointData() {
     if (_realTimeTextureMode) {
         updateRealTimeJointTextureBuffer();
     } else {
-        bIdx = 0;
+        uint32_t bIdx = 0;
         for (gfx::Buffer *buffer : _buffers) {
             buffer->update(_dataArray[bIdx], buffer->getSize());
             bIdx++;
@@ -187,13 +236,6 @@ ccstd::vector<scene::IMacroPatch> SkinningModel::getMacroPatches(index_t subMode
     return myPatches;
 }
 
-void SkinningModel::uploadJointData(uint32_t base, const Mat4 &mat, float *dst) {
-    memcpy(reinterpret_cast<void *>(dst + base), mat.m, sizeof(float) * 12);
-    dst[base + 3] = mat.m[12];
-    dst[base + 7] = mat.m[13];
-    dst[base + 11] = mat.m[14];
-}
-
 void SkinningModel::updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) {
     Super::updateLocalDescriptors(submodelIdx, descriptorset);
     uint32_t idx = _bufferIndices[submodelIdx];
@@ -348,6 +390,10 @@ void SkinningModel::releaseData() {
         _dataArray.clear();
     }
     CC_SAFE_DELETE(_realTimeJointTexture);
+    if (_jointPalette) {
+        releaseJointPalette(_jointPalette);
+        _jointPalette = nullptr;
+    }
     if (!_buffers.empty()) {
         for (gfx::Buffer *buffer : _buffers) {
             CC_SAFE_DESTROY(buffer);
@@ -45,6 +45,7 @@ struct JointInfo {
     IntrusivePtr<IJointTransform> transform;
     ccstd::vector<index_t> buffers;
     ccstd::vector<index_t> indices;
+    index_t jointIndex{0};
 };
 
 class SkinningModel final : public MorphModel {
@@ -56,6 +57,9 @@ public:
     void updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) override;
     void updateTransform(uint32_t stamp) override;
     void updateUBOs(uint32_t stamp) override;
+    void prepareParallelUpdate(uint32_t stamp) override;
+    void updateLocalData(uint32_t stamp) override;
+    void uploadLocalData(uint32_t stamp) override;
     void destroy() override;
 
     void initSubModel(index_t idx, RenderingSubMesh *subMeshData, Material *mat) override;
@@ -65,7 +69,9 @@ public:
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
 private:
-    static void uploadJointData(uint32_t base, const Mat4 &mat, float *dst);
+    void updateJointTransforms(uint32_t stamp);
+    void updateJointData(uint32_t stamp);
+    void commitJointData();
     void ensureEnoughBuffers(uint32_t count);
     void updateRealTimeJointTextureBuffer();
     void initRealTimeJointTexture();
@@ -76,6 +82,7 @@ private:
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
     ccstd::vector<JointInfo> _joints;
     ccstd::vector<float *> _dataArray;
+    JointPalette *_jointPalette{nullptr};
     bool _realTimeTextureMode = false;
     RealTimeJointTexture *_realTimeJointTexture = nullptr;
 
@@ -135,6 +135,8 @@ AudioEngineImpl::~AudioEngineImpl() {
         sche->unschedule("AudioEngine", this);
     }
 
+    _streamService.reset();
+
     if (sALContext) {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
 
@@ -162,6 +164,7 @@ bool AudioEngineImpl::init() {
             alGetError();
             sALContext = alcCreateContext(sALDevice, nullptr);
             alcMakeContextCurrent(sALContext);
+            _streamService = std::make_unique<AudioStreamService>();
 
             alGenSources(MAX_AUDIOINSTANCES, _alSources);
             auto alError = alGetError();
@@ -237,6 +240,7 @@ int AudioEngineImpl::play2d(const ccstd::string &filePath, bool loop, float volu
     player->_alSource = alSource;
     player->_loop = loop;
     player->_volume = volume;
+    player->_streamService = _streamService.get();
 
     auto audioCache = preload(filePath, nullptr);
     if (audioCache == nullptr) {
@@ -482,26 +486,35 @@ void AudioEngineImpl::setFinishCallback(int audioID, const std::function<void(in
 
 void AudioEngineImpl::update(float /*dt*/) {
     ALint sourceState;
-    int audioID;
     AudioPlayer *player;
-    ALuint alSource;
 
     //    ALOGV("AudioPlayer count: %d", (int)_audioPlayers.size());
 
-    for (auto it = _audioPlayers.begin(); it != _audioPlayers.end();) {
-        audioID = it->first;
-        player = it->second;
-        alSource = player->_alSource;
-        alGetSourcei(alSource, AL_SOURCE_STATE, &sourceState);
+    // Players are only added and erased in Cocos thread, so they are collected without locking,
+    // and play2dImpl is only blocked once to erase all of them.
+    ccstd::vector<std::pair<int, AudioPlayer *>> finishedPlayers;
+    for (auto &&it : _audioPlayers) {
+        player = it.second;
+        alGetSourcei(player->_alSource, AL_SOURCE_STATE, &sourceState);
+        if (player->_removeByAudioEngine || (player->_ready && sourceState == AL_STOPPED)) {
+            finishedPlayers.emplace_back(it.first, player);
+        }
+    }
+
+    if (!finishedPlayers.empty()) {
+        _threadMutex.lock();
+        for (auto &&it : finishedPlayers) {
+            _audioPlayers.erase(it.first);
+        }
+        _threadMutex.unlock();
+    }
 
+    for (auto &&it : finishedPlayers) {
+        int audioID = it.first;
+        player = it.second;
         if (player->_removeByAudioEngine) {
             AudioEngine::remove(audioID);
-            _threadMutex.lock();
-            it = _audioPlayers.erase(it);
-            _threadMutex.unlock();
-            delete player;
-            _alSourceUsed[alSource] = false;
-        } else if (player->_ready && sourceState == AL_STOPPED) {
+        } else {
             ccstd::string filePath;
             if (player->_finishCallbak) {
                 auto &audioInfo = AudioEngine::sAudioIDInfoMap[audioID];
@@ -510,18 +523,12 @@ void AudioEngineImpl::update(float /*dt*/) {
 
             AudioEngine::remove(audioID);
 
-            _threadMutex.lock();
-            it = _audioPlayers.erase(it);
-            _threadMutex.unlock();
-
             if (player->_finishCallbak) {
                 player->_finishCallbak(audioID, filePath); //IDEA: callback will delay 50ms
             }
-            delete player;
-            _alSourceUsed[alSource] = false;
-        } else {
-            ++it;
         }
+        _alSourceUsed[player->_alSource] = false;
+        delete player;
     }
 
     if (_audioPlayers.empty()) {
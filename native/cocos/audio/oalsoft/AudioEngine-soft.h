@@ -26,9 +26,11 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 #include "audio/include/AudioDef.h"
 #include "audio/oalsoft/AudioCache.h"
 #include "audio/oalsoft/AudioPlayer.h"
+#include "audio/oalsoft/AudioStreamService.h"
 #include "base/std/container/unordered_map.h"
 #include "cocos/base/RefCounted.h"
 #include "cocos/base/std/any.h"
@@ -81,6 +83,9 @@ private:
     ccstd::unordered_map<int, AudioPlayer *> _audioPlayers;
     std::mutex _threadMutex;
 
+    // Refills the buffers of all streaming players.
+    std::unique_ptr<AudioStreamService> _streamService;
+
     bool _lazyInitLoop;
 
     int _currentAudioID;
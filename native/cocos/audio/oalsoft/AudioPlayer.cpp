@@ -28,9 +28,11 @@
 #include "audio/oalsoft/AudioPlayer.h"
 #include <cstdlib>
 #include <cstring>
+#include <thread>
 #include "audio/common/decoder/AudioDecoder.h"
 #include "audio/common/decoder/AudioDecoderManager.h"
 #include "audio/oalsoft/AudioCache.h"
+#include "audio/oalsoft/AudioStreamService.h"
 #include "base/Log.h"
 #include "base/memory/Memory.h"
 
@@ -48,9 +50,10 @@ AudioPlayer::AudioPlayer()
   _ready(false),
   _currTime(0.0F),
   _streamingSource(false),
-  _rotateBufferThread(nullptr),
+  _streamService(nullptr),
+  _decoder(nullptr),
+  _offsetFrame(0),
   _timeDirty(false),
-  _isRotateThreadExited(false),
   _id(++gIdIndex) {
     memset(_bufferIds, 0, sizeof(_bufferIds));
 }
@@ -89,21 +92,14 @@ void AudioPlayer::destroy() {
         _play2dMutex.lock();
         _play2dMutex.unlock();
 
-        if (_streamingSource) {
-            if (_rotateBufferThread != nullptr) {
-                while (!_isRotateThreadExited) {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable()) {
-                    _rotateBufferThread->join();
-                }
+        if (_streamingSource && _streamService != nullptr) {
+            _streamService->removeStream(_id);
+        }
 
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                CC_LOG_DEBUG("rotateBufferThread exited!");
-            }
+        if (_decoder != nullptr) {
+            _decoder->close();
+            AudioDecoderManager::destroyDecoder(_decoder);
+            _decoder = nullptr;
         }
     } while (false);
 
@@ -172,25 +168,22 @@ bool AudioPlayer::play2d() {
             _streamingSource = true;
         }
 
-        {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed) {
-                break;
-            }
-
-            if (_streamingSource) {
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = ccnew std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                        _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            } else {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
+        if (_isDestroyed) {
+            break;
+        }
 
-            alSourcePlay(_alSource);
+        if (_streamingSource) {
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+            _offsetFrame = _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1;
+            _streamService->addStream(_id, this);
+        } else {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
         }
 
+        alSourcePlay(_alSource);
+
         auto alError = alGetError();
         if (alError != AL_NO_ERROR) {
             ALOGE("%s:alSourcePlay error code:%x", __FUNCTION__, alError);
@@ -217,85 +210,78 @@ bool AudioPlayer::play2d() {
     return ret;
 }
 
-void AudioPlayer::rotateBufferThread(int offsetFrame) {
-    char *tmpBuffer = nullptr;
-    AudioDecoder *decoder = AudioDecoderManager::createDecoder(_audioCache->_fileFullPath.c_str());
-    do {
-        BREAK_IF(decoder == nullptr || !decoder->open(_audioCache->_fileFullPath.c_str()));
+float AudioPlayer::rotateBuffers(ccstd::vector<char> &buffer) {
+    if (_isDestroyed) {
+        return -1.0F;
+    }
 
-        uint32_t framesRead = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize = framesToRead * decoder->getBytesPerFrame();
-        tmpBuffer = static_cast<char *>(malloc(bufferSize));
-        memset(tmpBuffer, 0, bufferSize);
+    if (_decoder == nullptr) {
+        _decoder = AudioDecoderManager::createDecoder(_audioCache->_fileFullPath.c_str());
+        if (_decoder == nullptr || !_decoder->open(_audioCache->_fileFullPath.c_str())) {
+            CC_LOG_ERROR("AudioPlayer::rotateBuffers, open %s failed!", _audioCache->_fileFullPath.c_str());
+            return -1.0F;
+        }
 
-        if (offsetFrame != 0) {
-            decoder->seek(offsetFrame);
+        if (_offsetFrame != 0) {
+            _decoder->seek(_offsetFrame);
         }
+    }
+
+    const uint32_t framesToRead = _audioCache->_queBufferFrames;
+    const uint32_t bytesPerFrame = _decoder->getBytesPerFrame();
+    const uint32_t sampleRate = _decoder->getSampleRate();
+    if (buffer.size() < framesToRead * bytesPerFrame) {
+        buffer.resize(framesToRead * bytesPerFrame);
+    }
+
+    ALint sourceState;
+    alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState != AL_PLAYING) {
+        // Not started yet or paused, the queued buffers are kept.
+        return QUEUEBUFFER_TIME_STEP;
+    }
 
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
-
-        while (!_isDestroyed) {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING) {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0) {
-                    bufferProcessed--;
-                    if (_timeDirty) {
-                        _timeDirty = false;
-                        offsetFrame = static_cast<int>(_currTime * decoder->getSampleRate());
-                        decoder->seek(offsetFrame);
-                    } else {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration) {
-                            if (_loop) {
-                                _currTime = 0.0F;
-                            } else {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0) {
-                        if (_loop) {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        } else {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, framesRead * decoder->getBytesPerFrame(),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
+    ALint bufferProcessed = 0;
+    alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+    while (bufferProcessed > 0) {
+        bufferProcessed--;
+        if (_timeDirty) {
+            _timeDirty = false;
+            _offsetFrame = static_cast<uint32_t>(_currTime * static_cast<float>(sampleRate));
+            _decoder->seek(_offsetFrame);
+        } else {
+            _currTime += QUEUEBUFFER_TIME_STEP;
+            if (_currTime > _audioCache->_duration) {
+                if (_loop) {
+                    _currTime = 0.0F;
+                } else {
+                    _currTime = _audioCache->_duration;
                 }
             }
+        }
 
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread) {
-                break;
+        uint32_t framesRead = _decoder->readFixedFrames(framesToRead, buffer.data());
+        if (framesRead == 0) {
+            if (_loop) {
+                _decoder->seek(0);
+                framesRead = _decoder->readFixedFrames(framesToRead, buffer.data());
+            } else {
+                return -1.0F;
             }
-
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(75));
         }
 
-    } while (false);
-
-    CC_LOG_INFO("Exit rotate buffer thread ...");
-    if (decoder != nullptr) {
-        decoder->close();
+        ALuint bid;
+        alSourceUnqueueBuffers(_alSource, 1, &bid);
+        alBufferData(bid, _audioCache->_format, buffer.data(), static_cast<ALsizei>(framesRead * bytesPerFrame),
+                     static_cast<ALsizei>(sampleRate));
+        alSourceQueueBuffers(_alSource, 1, &bid);
     }
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
-    CC_LOG_INFO("%s exited.\n", __FUNCTION__);
+
+    // The next refill is due when the playing buffer has been processed.
+    ALint sampleOffset = 0;
+    alGetSourcei(_alSource, AL_SAMPLE_OFFSET, &sampleOffset);
+    const uint32_t remainingFrames = framesToRead - static_cast<uint32_t>(sampleOffset) % framesToRead;
+    return static_cast<float>(remainingFrames) / static_cast<float>(sampleRate);
 }
 
 bool AudioPlayer::setLoop(bool loop) {
@@ -311,6 +297,9 @@ bool AudioPlayer::setTime(float time) {
     if (!_isDestroyed && time >= 0.0F && time < _audioCache->_duration) {
         _currTime = time;
         _timeDirty = true;
+        if (_streamService != nullptr) {
+            _streamService->wakeStream(_id);
+        }
 
         return true;
     }
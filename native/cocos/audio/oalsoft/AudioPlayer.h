@@ -25,11 +25,10 @@
 
 #pragma once
 
-#include <condition_variable>
 #include <functional>
 #include <mutex>
-#include <thread>
 #include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 #ifdef OPENAL_PLAIN_INCLUDES
     #include <al.h>
 #elif CC_PLATFORM == CC_PLATFORM_WINDOWS
@@ -39,17 +38,19 @@
 #elif CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX
     #include <AL/al.h>
 #endif
+#include "audio/oalsoft/AudioStreamService.h"
 #include "base/Macros.h"
 
 namespace cc {
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
 
-class CC_DLL AudioPlayer {
+class CC_DLL AudioPlayer : public AudioStream {
 public:
     AudioPlayer();
-    ~AudioPlayer();
+    ~AudioPlayer() override;
 
     void destroy();
 
@@ -60,7 +61,8 @@ public:
 
 protected:
     void setCache(AudioCache *cache);
-    void rotateBufferThread(int offsetFrame);
+    // Refills the processed buffers of a streaming source, called by AudioStreamService.
+    float rotateBuffers(ccstd::vector<char> &buffer) override;
     bool play2d();
 
     AudioCache *_audioCache;
@@ -78,11 +80,10 @@ protected:
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[3];
-    std::thread *_rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    AudioStreamService *_streamService;
+    AudioDecoder *_decoder;
+    uint32_t _offsetFrame;
     bool _timeDirty;
-    bool _isRotateThreadExited;
 
     std::mutex _play2dMutex;
 
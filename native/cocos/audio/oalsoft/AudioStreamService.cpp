@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#define LOG_TAG "AudioStreamService"
+
+#include "audio/oalsoft/AudioStreamService.h"
+
+namespace cc {
+
+namespace {
+// OpenAL reports processed buffers with the granularity of its mixer, leave it some time.
+constexpr auto REFILL_LATENCY = std::chrono::milliseconds(10);
+} // namespace
+
+AudioStreamService::AudioStreamService(uint32_t workerCount) {
+    for (uint32_t index = 0; index < workerCount; ++index) {
+        _workers.emplace_back([this]() {
+            threadFunc();
+        });
+    }
+}
+
+AudioStreamService::~AudioStreamService() {
+    {
+        std::unique_lock<std::mutex> lk(_mutex);
+        _stop = true;
+        _condition.notify_all();
+    }
+
+    for (auto &&worker : _workers) {
+        worker.join();
+    }
+}
+
+void AudioStreamService::addStream(unsigned int id, AudioStream *source) {
+    std::unique_lock<std::mutex> lk(_mutex);
+    auto &stream = _streams[id];
+    stream.source = source;
+    schedule(id, stream, Clock::now());
+}
+
+void AudioStreamService::removeStream(unsigned int id) {
+    std::unique_lock<std::mutex> lk(_mutex);
+    auto it = _streams.find(id);
+    if (it == _streams.end()) {
+        return;
+    }
+
+    _idleCondition.wait(lk, [&]() { return !it->second.busy; });
+    _streams.erase(it);
+}
+
+void AudioStreamService::wakeStream(unsigned int id) {
+    std::unique_lock<std::mutex> lk(_mutex);
+    auto it = _streams.find(id);
+    if (it == _streams.end() || it->second.finished) {
+        return;
+    }
+
+    if (it->second.busy) {
+        it->second.wakeRequested = true;
+    } else {
+        schedule(it->first, it->second, Clock::now());
+    }
+}
+
+void AudioStreamService::schedule(unsigned int id, Stream &stream, Clock::time_point deadline) {
+    stream.deadline = deadline;
+    _queue.push({deadline, id});
+    _condition.notify_one();
+}
+
+void AudioStreamService::threadFunc() {
+    ccstd::vector<char> buffer;
+
+    std::unique_lock<std::mutex> lk(_mutex);
+    while (!_stop) {
+        if (_queue.empty()) {
+            _condition.wait(lk);
+            continue;
+        }
+
+        const auto entry = _queue.top();
+        if (entry.deadline > Clock::now()) {
+            _condition.wait_until(lk, entry.deadline);
+            continue;
+        }
+        _queue.pop();
+
+        auto it = _streams.find(entry.id);
+        if (it == _streams.end() || it->second.busy || it->second.deadline != entry.deadline) {
+            continue;
+        }
+
+        auto &stream = it->second;
+        stream.busy = true;
+        lk.unlock();
+        const float delay = stream.source->rotateBuffers(buffer);
+        lk.lock();
+        stream.busy = false;
+
+        if (delay < 0.0F) {
+            stream.finished = true;
+        } else if (stream.wakeRequested) {
+            schedule(entry.id, stream, Clock::now());
+        } else {
+            const auto duration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(delay));
+            schedule(entry.id, stream, Clock::now() + duration + REFILL_LATENCY);
+        }
+        stream.wakeRequested = false;
+        _idleCondition.notify_all();
+    }
+}
+
+} // namespace cc
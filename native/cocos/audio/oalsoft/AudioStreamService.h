@@ -0,0 +1,109 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "base/Macros.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * A streaming source refilled by AudioStreamService, implemented by AudioPlayer.
+ */
+class CC_DLL AudioStream {
+public:
+    virtual ~AudioStream() = default;
+
+    // Refills the processed buffers, buffer is the decode buffer of the calling worker.
+    // Returns the seconds until the playing buffer is processed, or a negative value once the stream has ended.
+    virtual float rotateBuffers(ccstd::vector<char> &buffer) = 0;
+};
+
+/**
+ * Refills the OpenAL buffer queues of all streaming players from a small, fixed pool of worker threads.
+ * A stream is not polled, it is woken up when its playing buffer is about to be processed, or when
+ * it's explicitly woken up, e.g. after seeking. Each worker owns a decode buffer that is reused for
+ * every stream it refills.
+ */
+class CC_DLL AudioStreamService {
+public:
+    static constexpr uint32_t DEFAULT_WORKER_COUNT = 2;
+
+    explicit AudioStreamService(uint32_t workerCount = DEFAULT_WORKER_COUNT);
+    ~AudioStreamService();
+
+    // The first refill opens the decoder of the player and is scheduled immediately.
+    void addStream(unsigned int id, AudioStream *source);
+    // Blocks until no worker is refilling the stream anymore.
+    void removeStream(unsigned int id);
+    // Refills the stream as soon as possible.
+    void wakeStream(unsigned int id);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stream {
+        AudioStream *source{nullptr};
+        Clock::time_point deadline;
+        bool busy{false};
+        bool wakeRequested{false};
+        bool finished{false};
+    };
+
+    struct Entry {
+        Clock::time_point deadline;
+        unsigned int id{0};
+
+        bool operator>(const Entry &rhs) const { return deadline > rhs.deadline; }
+    };
+
+    void schedule(unsigned int id, Stream &stream, Clock::time_point deadline);
+    void threadFunc();
+
+    std::mutex _mutex;
+    // Wakes up workers when a stream is due earlier than they expect.
+    std::condition_variable _condition;
+    // Signals removeStream that a refill has finished.
+    std::condition_variable _idleCondition;
+
+    // player id, stream
+    ccstd::unordered_map<unsigned int, Stream> _streams;
+    // Entries whose deadline differs from the stream's one are stale and skipped.
+    std::priority_queue<Entry, ccstd::vector<Entry>, std::greater<Entry>> _queue;
+    ccstd::vector<std::thread> _workers;
+    bool _stop{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(AudioStreamService)
+};
+
+} // namespace cc
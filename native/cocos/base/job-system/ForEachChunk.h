@@ -0,0 +1,67 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "base/job-system/JobSystem.h"
+
+namespace cc {
+
+/**
+ * Calls fn(begin, end) on contiguous chunks covering [0, count), at most one chunk per job system thread.
+ * The first chunk is processed on the calling thread, which returns once every chunk is done. The whole
+ * range is processed on the calling thread below threshold items or without worker threads.
+ * Chunks hold at least minChunkSize items, and all but the last one hold a multiple of alignment items.
+ */
+template <typename Fn>
+void forEachChunk(uint32_t count, uint32_t threshold, const Fn &fn, uint32_t minChunkSize = 1U, uint32_t alignment = 1U) {
+    auto *jobSystem = JobSystem::getInstance();
+    const uint32_t threadCount = jobSystem->threadCount();
+    if (count < threshold || threadCount < 2) {
+        fn(0U, count);
+        return;
+    }
+
+    uint32_t chunkSize = std::max((count + threadCount - 1) / threadCount, minChunkSize);
+    chunkSize = (chunkSize + alignment - 1) / alignment * alignment;
+    const uint32_t jobCount = (count + chunkSize - 1) / chunkSize;
+    if (jobCount < 2) {
+        fn(0U, count);
+        return;
+    }
+
+    JobGraph g(jobSystem);
+    g.createForEachIndexJob(1U, jobCount, 1U, [&fn, count, chunkSize](uint32_t job) {
+        const uint32_t begin = job * chunkSize;
+        fn(begin, std::min(begin + chunkSize, count));
+    });
+    g.run();
+    fn(0U, chunkSize);
+    g.waitForAll();
+}
+
+} // namespace cc
@@ -26,6 +26,7 @@
 
 #include "TFJobSystem.h"
 #include "base/std/container/deque.h"
+#include "profiler/TraceRecorder.h"
 #include "taskflow/taskflow.hpp"
 
 namespace cc {
@@ -65,13 +66,27 @@ private:
 
 template <typename Function>
 uint32_t TFJobGraph::createJob(Function &&func) noexcept {
+#if CC_USE_PROFILER
+    _tasks.emplace_back(_flow.emplace([func]() {
+        CC_TRACE_SCOPE("Job");
+        func();
+    }));
+#else
     _tasks.emplace_back(_flow.emplace(func));
+#endif
     return static_cast<uint32_t>(_tasks.size() - 1u);
 }
 
 template <typename Function>
 uint32_t TFJobGraph::createForEachIndexJob(uint32_t begin, uint32_t end, uint32_t step, Function &&func) noexcept {
+#if CC_USE_PROFILER
+    _tasks.emplace_back(_flow.for_each_index(begin, end, step, [func](uint32_t index) {
+        CC_TRACE_SCOPE("Job");
+        func(index);
+    }));
+#else
     _tasks.emplace_back(_flow.for_each_index(begin, end, step, func));
+#endif
     return static_cast<uint32_t>(_tasks.size() - 1u);
 }
 
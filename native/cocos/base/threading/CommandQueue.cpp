@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "CommandQueue.h"
+#include <algorithm>
+#include <thread>
+#include "base/Utils.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+    #define CC_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+    #define CC_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+    #define CC_CPU_RELAX()
+#endif
+
+namespace cc {
+
+namespace {
+uint32_t constexpr MIN_SPIN_COUNT = 16;
+uint32_t constexpr MAX_SPIN_COUNT = 4096;
+uint32_t constexpr YIELD_COUNT = 8;
+} // namespace
+
+CommandQueue::CommandQueue(uint32_t const capacity) noexcept
+: _capacity(utils::nextPOT(std::max(capacity, 4096U))) {
+    _mask = _capacity - 1;
+    _buffer = static_cast<uint8_t *>(CC_MALLOC_ALIGN(_capacity, 64));
+    CC_ASSERT(_buffer);
+
+    _written.spinCount = MAX_SPIN_COUNT;
+    _read.spinCount = MAX_SPIN_COUNT;
+}
+
+CommandQueue::~CommandQueue() {
+    CC_FREE_ALIGN(_buffer);
+}
+
+void CommandQueue::kick() noexcept {
+    if (_producer.writePos == _producer.publishedWritePos) return;
+
+    _producer.publishedWritePos = _producer.writePos;
+    notify(_written, _producer.writePos);
+}
+
+uint8_t *CommandQueue::reserve(uint32_t const size) noexcept {
+    CC_ASSERT(size <= _capacity / 2);
+
+    auto offset = static_cast<uint32_t>(_producer.writePos & _mask);
+    uint32_t const tail = _capacity - offset;
+    // commands never straddle the end of the ring, the tail is skipped by a wrap record instead
+    uint32_t const required = size <= tail ? size : tail + size;
+
+    if (_producer.writePos + required - _producer.readPosSnap > _capacity) {
+        _producer.readPosSnap = _read.value.load(std::memory_order_acquire);
+        if (_producer.writePos + required - _producer.readPosSnap > _capacity) {
+            waitForSpace(required);
+        }
+    }
+
+    if (size > tail) {
+        auto *const wrap = reinterpret_cast<CommandHeader *>(_buffer + offset);
+        wrap->type = WRAP_COMMAND;
+        wrap->size = tail;
+        _producer.writePos += tail;
+        offset = 0;
+    }
+
+    _producer.writePos += size;
+    return _buffer + offset;
+}
+
+void CommandQueue::waitForSpace(uint32_t const size) noexcept {
+    // the consumer may be waiting for exactly what is pending here
+    kick();
+
+    uint64_t const end = _producer.writePos + size;
+    uint32_t const capacity = _capacity;
+    _producer.readPosSnap = waitFor(_read, [end, capacity](uint64_t readPos) {
+        return end - readPos <= capacity;
+    });
+}
+
+void CommandQueue::waitForCommands() noexcept {
+    if (_consumer.readPos != _consumer.writePosSnap) return;
+
+    uint64_t const readPos = _consumer.readPos;
+    _consumer.writePosSnap = waitFor(_written, [readPos](uint64_t writePos) {
+        return writePos != readPos;
+    });
+}
+
+void CommandQueue::publishReadPos() noexcept {
+    if (_consumer.readPos == _consumer.publishedReadPos) return;
+
+    _consumer.publishedReadPos = _consumer.readPos;
+    notify(_read, _consumer.readPos);
+}
+
+template <typename Pred>
+uint64_t CommandQueue::waitFor(Counter &counter, Pred &&ready) noexcept {
+    while (true) {
+        for (uint32_t i = 0; i < counter.spinCount; ++i) {
+            uint64_t const value = counter.value.load(std::memory_order_acquire);
+            if (ready(value)) {
+                counter.spinCount = std::min(counter.spinCount * 2, MAX_SPIN_COUNT);
+                return value;
+            }
+            CC_CPU_RELAX();
+        }
+        for (uint32_t i = 0; i < YIELD_COUNT; ++i) {
+            std::this_thread::yield();
+            uint64_t const value = counter.value.load(std::memory_order_acquire);
+            if (ready(value)) return value;
+        }
+
+        // spinning didn't pay off this time, block sooner next time
+        counter.spinCount = std::max(counter.spinCount / 2, MIN_SPIN_COUNT);
+
+        counter.sleeping.store(true, std::memory_order_seq_cst);
+        uint64_t const value = counter.value.load(std::memory_order_seq_cst);
+        if (ready(value)) {
+            if (!counter.sleeping.exchange(false, std::memory_order_seq_cst)) {
+                counter.wakeup.wait(); // the other side has claimed the flag and signaled
+            }
+            return value;
+        }
+        counter.wakeup.wait();
+    }
+}
+
+void CommandQueue::notify(Counter &counter, uint64_t const value) noexcept {
+    counter.value.store(value, std::memory_order_seq_cst);
+    if (counter.sleeping.load(std::memory_order_seq_cst) && counter.sleeping.exchange(false, std::memory_order_seq_cst)) {
+        counter.wakeup.signal();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,168 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include "../memory/Memory.h"
+#include "Semaphore.h"
+
+namespace cc {
+
+// structs may be padded
+#if (CC_COMPILER == CC_COMPILER_MSVC)
+    #pragma warning(disable : 4324)
+#endif
+
+// A single-producer single-consumer ring buffer of POD commands, an alternative transport to MessageQueue.
+// Each command is a record tagged with a type, executed by a dispatcher supplied by the consumer
+// (typically a switch over the tags) instead of a virtual call, and is never destructed.
+// Waiting sides spin adaptively before blocking, and are only signaled when they actually went to sleep.
+class ALIGNAS(64) CommandQueue final {
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 1U << 20;
+    static constexpr uint32_t COMMAND_ALIGNMENT = 16;
+
+    explicit CommandQueue(uint32_t capacity = DEFAULT_CAPACITY) noexcept;
+    ~CommandQueue();
+    CommandQueue(CommandQueue const &) = delete;
+    CommandQueue(CommandQueue &&) = delete;
+    CommandQueue &operator=(CommandQueue const &) = delete;
+    CommandQueue &operator=(CommandQueue &&) = delete;
+
+    // reserve a command of the specified type, with extraSize bytes of trailing data after T,
+    // invisible to the consumer until the next kick
+    template <typename T>
+    T *allocate(uint32_t type, uint32_t extraSize = 0) noexcept;
+
+    // publish the commands allocated so far, waking up the consumer if it is sleeping
+    void kick() noexcept;
+
+    // block until commands are available, then dispatch all of them as (type, payload), returns the command count;
+    // a dispatcher returning bool can stop after the current command by returning false, the rest is kept for the next call
+    template <typename Fn>
+    uint32_t execute(Fn &&dispatch) noexcept;
+
+    // bytes allocated since the last kick
+    inline uint32_t getUnpublishedSize() const noexcept { return static_cast<uint32_t>(_producer.writePos - _producer.publishedWritePos); }
+
+    inline uint32_t getCapacity() const noexcept { return _capacity; }
+
+private:
+    struct ALIGNAS(16) CommandHeader final {
+        uint32_t type{0};
+        uint32_t size{0};
+    };
+    static constexpr uint32_t WRAP_COMMAND = ~0U;
+
+    struct ALIGNAS(64) ProducerContext final {
+        uint64_t writePos{0};
+        uint64_t publishedWritePos{0};
+        uint64_t readPosSnap{0};
+    };
+
+    struct ALIGNAS(64) ConsumerContext final {
+        uint64_t readPos{0};
+        uint64_t publishedReadPos{0};
+        uint64_t writePosSnap{0};
+    };
+
+    // a position published by one side and waited on by the other
+    struct ALIGNAS(64) Counter final {
+        std::atomic<uint64_t> value{0};
+        std::atomic<bool> sleeping{false};
+        uint32_t spinCount{0}; // only touched by the waiting side
+        Semaphore wakeup{0};
+    };
+
+    uint8_t *reserve(uint32_t size) noexcept;
+    void waitForSpace(uint32_t size) noexcept;
+    void waitForCommands() noexcept;
+    void publishReadPos() noexcept;
+
+    template <typename Pred>
+    static uint64_t waitFor(Counter &counter, Pred &&ready) noexcept;
+    static void notify(Counter &counter, uint64_t value) noexcept;
+
+    uint8_t *_buffer{nullptr};
+    uint32_t _capacity{0};
+    uint32_t _mask{0};
+
+    ProducerContext _producer;
+    ConsumerContext _consumer;
+    Counter _written; // published by the producer
+    Counter _read;    // published by the consumer
+};
+
+// structs may be padded
+#if (CC_COMPILER == CC_COMPILER_MSVC)
+    #pragma warning(default : 4324)
+#endif
+
+template <typename T>
+T *CommandQueue::allocate(uint32_t const type, uint32_t const extraSize) noexcept {
+    static_assert(std::is_trivially_destructible<T>::value, "commands are never destructed");
+    CC_ASSERT(type != WRAP_COMMAND);
+
+    uint32_t const size = (sizeof(CommandHeader) + sizeof(T) + extraSize + COMMAND_ALIGNMENT - 1) & ~(COMMAND_ALIGNMENT - 1);
+    auto *const header = reinterpret_cast<CommandHeader *>(reserve(size));
+    header->type = type;
+    header->size = size;
+    return reinterpret_cast<T *>(header + 1);
+}
+
+template <typename Fn>
+uint32_t CommandQueue::execute(Fn &&dispatch) noexcept {
+    waitForCommands();
+
+    uint32_t count = 0;
+    while (_consumer.readPos != _consumer.writePosSnap) {
+        auto const *const header = reinterpret_cast<CommandHeader const *>(_buffer + (_consumer.readPos & _mask));
+        bool proceed = true;
+        if (header->type != WRAP_COMMAND) {
+            auto const *const payload = static_cast<void const *>(header + 1);
+            if constexpr (std::is_same<decltype(dispatch(header->type, payload)), bool>::value) {
+                proceed = dispatch(header->type, payload);
+            } else {
+                dispatch(header->type, payload);
+            }
+            ++count;
+        }
+        _consumer.readPos += header->size;
+        if (!proceed) break;
+
+        // hand space back early so a producer waiting on a full ring can continue
+        if (_consumer.readPos - _consumer.publishedReadPos >= _capacity / 4) {
+            publishReadPos();
+        }
+    }
+    publishReadPos();
+
+    return count;
+}
+
+} // namespace cc
@@ -26,6 +26,7 @@
 #include "AutoReleasePool.h"
 #include "base/Utils.h"
 #include "base/Log.h"
+#include "profiler/TraceRecorder.h"
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
     #include <unistd.h>
@@ -252,6 +253,7 @@ void MessageQueue::executeMessages() noexcept {
         return;
     }
 
+    CC_TRACE_SCOPE(msg->getName());
     msg->execute();
     msg->~Message();
 }
@@ -261,6 +263,7 @@ Message *MessageQueue::readMessage() noexcept {
         std::unique_lock<std::mutex> lock(_mutex);
         pullMessages();          // try pulling data from consumer
         if (!hasNewMessage()) {  // still empty
+            CC_TRACE_SCOPE("MessageQueueWait");
             _condVar.wait(lock); // wait for the producer to wake me up
             pullMessages();      // pulling again
         }
@@ -283,6 +286,7 @@ void MessageQueue::consumerThreadLoop() noexcept {
     int32_t tid = gettid();
     ADPFManager::getInstance().addThreadIdToHintSession(tid);
 #endif
+    CC_TRACE_THREAD_NAME("MessageQueueConsumer");
     while (!_reader.terminateConsumerThread) {
         AutoReleasePool autoReleasePool;
         flushMessages();
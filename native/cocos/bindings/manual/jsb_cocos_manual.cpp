@@ -314,6 +314,49 @@ static bool JSB_localStorage_getLength(se::State &s) { // NOLINT(readability-ide
 }
 SE_BIND_PROP_GET(JSB_localStorage_getLength); // NOLINT(readability-identifier-naming)
 
+static bool JSB_localStorageSetWriteBehindEnabled(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        bool ok = true;
+        bool enabled = false;
+        ok = sevalue_to_native(args[0], &enabled);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+        localStorageSetWriteBehindEnabled(enabled);
+        return true;
+    }
+
+    SE_REPORT_ERROR("Invalid number of arguments");
+    return false;
+}
+SE_BIND_FUNC(JSB_localStorageSetWriteBehindEnabled) // NOLINT(readability-identifier-naming)
+
+static bool JSB_localStorageIsWriteBehindEnabled(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 0) {
+        s.rval().setBoolean(localStorageIsWriteBehindEnabled());
+        return true;
+    }
+
+    SE_REPORT_ERROR("Invalid number of arguments");
+    return false;
+}
+SE_BIND_FUNC(JSB_localStorageIsWriteBehindEnabled) // NOLINT(readability-identifier-naming)
+
+static bool JSB_localStorageFlush(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 0) {
+        localStorageFlush();
+        return true;
+    }
+
+    SE_REPORT_ERROR("Invalid number of arguments");
+    return false;
+}
+SE_BIND_FUNC(JSB_localStorageFlush) // NOLINT(readability-identifier-naming)
+
 static bool register_sys_localStorage(se::Object *obj) { // NOLINT(readability-identifier-naming)
     se::Value sys;
     if (!obj->getProperty("sys", &sys)) {
@@ -331,6 +374,10 @@ static bool register_sys_localStorage(se::Object *obj) { // NOLINT(readability-i
     localStorageObj->defineFunction("clear", _SE(JSB_localStorageClear));
     localStorageObj->defineFunction("key", _SE(JSB_localStorageKey));
     localStorageObj->defineProperty("length", _SE(JSB_localStorage_getLength), nullptr);
+    // native only, not part of the Web Storage API
+    localStorageObj->defineFunction("setWriteBehindEnabled", _SE(JSB_localStorageSetWriteBehindEnabled));
+    localStorageObj->defineFunction("isWriteBehindEnabled", _SE(JSB_localStorageIsWriteBehindEnabled));
+    localStorageObj->defineFunction("flush", _SE(JSB_localStorageFlush));
 
     ccstd::string strFilePath = cc::FileUtils::getInstance()->getWritablePath();
 #if defined(__QNX__)
@@ -352,6 +352,17 @@ bool seval_to_DownloaderHints(const se::Value &v, cc::network::DownloaderHints *
     SE_PRECONDITION3(ok && tmp.isString(), false, *ret = ZERO);
     ret->tempFileNameSuffix = tmp.toString();
 
+    // optional, the defaults apply when they are missing
+    if (obj->getProperty("countOfMaxConnectionsPerHost", &tmp) && tmp.isNumber()) {
+        ret->countOfMaxConnectionsPerHost = tmp.toUint32();
+    }
+    if (obj->getProperty("rangeChunkSize", &tmp) && tmp.isNumber()) {
+        ret->rangeChunkSize = tmp.toUint32();
+    }
+    if (obj->getProperty("useHttp2", &tmp) && tmp.isBoolean()) {
+        ret->useHttp2 = tmp.toBoolean();
+    }
+
     return ok;
 }
 
@@ -1753,6 +1764,55 @@ bool sevalue_to_native(const se::Value &from, cc::physics::HeightFieldDesc *to,
     return ok;
 }
 
+bool sevalue_to_native(const se::Value &from, cc::physics::BatchQueryDesc *to, se::Object *ctx) {
+    CC_ASSERT(from.isObject());
+    se::Object *json = from.toObject();
+    auto *data = static_cast<cc::physics::BatchQueryDesc *>(json->getPrivateData());
+    if (data) {
+        *to = *data;
+        return true;
+    }
+
+    se::Value field;
+    bool ok = true;
+
+    json->getProperty("queryCount", &field);
+    if (!field.isNullOrUndefined()) ok &= sevalue_to_native(field, &to->queryCount, ctx);
+
+    json->getProperty("mask", &field);
+    if (!field.isNullOrUndefined()) ok &= sevalue_to_native(field, &to->mask, ctx);
+
+    json->getProperty("queryTrigger", &field);
+    if (!field.isNullOrUndefined()) ok &= sevalue_to_native(field, &to->queryTrigger, ctx);
+
+    // both buffers are referenced in place, results are written straight into the caller's typed array
+    size_t dataLength = 0;
+    json->getProperty("queries", &field);
+    if (!field.isNullOrUndefined()) {
+        se::Object *obj = field.toObject();
+        if (obj->isTypedArray()) {
+            ok &= obj->getTypedArrayData(reinterpret_cast<uint8_t **>(&to->queries), &dataLength);
+            SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
+            to->queryLength = static_cast<uint32_t>(dataLength / sizeof(float));
+        } else {
+            ok &= false;
+        }
+    }
+
+    json->getProperty("results", &field);
+    if (!field.isNullOrUndefined()) {
+        se::Object *obj = field.toObject();
+        if (obj->isTypedArray()) {
+            ok &= obj->getTypedArrayData(reinterpret_cast<uint8_t **>(&to->results), &dataLength);
+            SE_PRECONDITION2(ok, false, "getTypedArrayData failed!");
+            to->resultLength = static_cast<uint32_t>(dataLength / sizeof(float));
+        } else {
+            ok &= false;
+        }
+    }
+    return ok;
+}
+
 bool sevalue_to_native(const se::Value &from, cc::physics::RaycastOptions *to, se::Object *ctx) {
     CC_ASSERT(from.isObject());
     se::Object *json = from.toObject();
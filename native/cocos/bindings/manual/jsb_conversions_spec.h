@@ -637,6 +637,7 @@ bool nativevalue_to_se(const ccstd::vector<std::shared_ptr<cc::physics::CCTTrigg
 bool sevalue_to_native(const se::Value &from, cc::physics::ConvexDesc *to, se::Object *ctx);
 bool sevalue_to_native(const se::Value &from, cc::physics::TrimeshDesc *to, se::Object *ctx);
 bool sevalue_to_native(const se::Value &from, cc::physics::HeightFieldDesc *to, se::Object *ctx);
+bool sevalue_to_native(const se::Value &from, cc::physics::BatchQueryDesc *to, se::Object *ctx);
 bool sevalue_to_native(const se::Value &from, cc::physics::RaycastOptions *to, se::Object *ctx);
 
 #endif // USE_PHYSICS_PHYSX
@@ -39,8 +39,10 @@
 #include "network/Downloader.h"
 #include "network/HttpClient.h"
 #include "platform/Image.h"
+#include "platform/ImageDecodeQueue.h"
 #include "platform/interfaces/modules/ISystem.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
+#include "profiler/TraceRecorder.h"
 #include "ui/edit-box/EditBox.h"
 #include "xxtea/xxtea.h"
 
@@ -62,6 +64,10 @@ using namespace cc; // NOLINT
 
 LegacyThreadPool *gIOThreadPool = nullptr;
 
+// images requested by jsb.loadImage are decoded in parallel and delivered on the cocos thread within a memory budget
+static IntrusivePtr<ImageDecodeQueue> gImageDecodeQueue;
+static const ccstd::string IMAGE_DELIVERY_KEY{"jsbImageDelivery"};
+
 static std::shared_ptr<cc::network::Downloader> gLocalDownloader = nullptr;
 static ccstd::unordered_map<ccstd::string, std::function<void(const ccstd::string &, unsigned char *, uint)>> gLocalDownloaderHandlers;
 static uint64_t gLocalDownloaderTaskId = 1000000;
@@ -576,6 +582,25 @@ struct ImageInfo *createImageInfo(Image *img) {
 
     return imgInfo;
 }
+
+// delivers the decoded images every frame until the queue is drained
+void scheduleImageDelivery() {
+    auto *queue = gImageDecodeQueue.get();
+    auto app = CC_CURRENT_APPLICATION();
+    CC_ASSERT_NOT_NULL(app);
+    auto scheduler = app->getEngine()->getScheduler();
+    if (scheduler->isScheduled(IMAGE_DELIVERY_KEY, queue)) {
+        return;
+    }
+    scheduler->schedule(
+        [queue, scheduler = scheduler.get()](float /*dt*/) {
+            queue->deliver();
+            if (queue->getPendingCount() == 0) {
+                scheduler->unschedule(IMAGE_DELIVERY_KEY, queue);
+            }
+        },
+        queue, 0.0F, false, IMAGE_DELIVERY_KEY);
+}
 } // namespace
 
 bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal) { // NOLINT(readability-identifier-naming)
@@ -587,62 +612,45 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
 
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
 
-    auto initImageFunc = [path, callbackPtr](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
-        auto *img = ccnew Image();
-
-        gIOThreadPool->pushTask([=](int /*tid*/) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
-            // Be careful of invoking any Cocos2d-x interface in a sub-thread.
-            bool loadSucceed = false;
-            if (fullPath.empty()) {
-                loadSucceed = img->initWithImageData(imageData, imageBytes);
-                free(imageData);
-            } else {
-                loadSucceed = img->initWithImageFile(fullPath);
-            }
+    // called by ImageDecodeQueue::deliver on the cocos thread, img is nullptr if decoding failed
+    auto onImageDecoded = [path, callbackPtr](uint32_t /*index*/, Image *img) {
+        se::AutoHandleScope hs;
+        se::ValueArray seArgs;
 
-            ImageInfo *imgInfo = nullptr;
-            if (loadSucceed) {
-                imgInfo = createImageInfo(img);
-            }
-            auto app = CC_CURRENT_APPLICATION();
-            if (!app) {
-                delete imgInfo;
-                delete img;
-                return;
-            }
-            auto engine = app->getEngine();
-            CC_ASSERT_NOT_NULL(engine);
-            engine->getScheduler()->performFunctionInCocosThread([=]() {
-                se::AutoHandleScope hs;
-                se::ValueArray seArgs;
+        if (img) {
+            ImageInfo *imgInfo = createImageInfo(img);
+            se::HandleObject retObj(se::Object::createPlainObject());
+            auto *obj = se::Object::createObjectWithClass(__jsb_cc_JSBNativeDataHolder_class);
+            auto *nativeObj = JSB_MAKE_PRIVATE_OBJECT(cc::JSBNativeDataHolder, imgInfo->data);
+            obj->setPrivateObject(nativeObj);
+            retObj->setProperty("data", se::Value(obj));
+            retObj->setProperty("width", se::Value(imgInfo->width));
+            retObj->setProperty("height", se::Value(imgInfo->height));
 
-                if (loadSucceed) {
-                    se::HandleObject retObj(se::Object::createPlainObject());
-                    auto *obj = se::Object::createObjectWithClass(__jsb_cc_JSBNativeDataHolder_class);
-                    auto *nativeObj = JSB_MAKE_PRIVATE_OBJECT(cc::JSBNativeDataHolder, imgInfo->data);
-                    obj->setPrivateObject(nativeObj);
-                    retObj->setProperty("data", se::Value(obj));
-                    retObj->setProperty("width", se::Value(imgInfo->width));
-                    retObj->setProperty("height", se::Value(imgInfo->height));
+            se::Value mipmapLevelDataSizeArr;
+            nativevalue_to_se(imgInfo->mipmapLevelDataSize, mipmapLevelDataSizeArr, nullptr);
+            retObj->setProperty("mipmapLevelDataSize", mipmapLevelDataSizeArr);
 
-                    se::Value mipmapLevelDataSizeArr;
-                    nativevalue_to_se(imgInfo->mipmapLevelDataSize, mipmapLevelDataSizeArr, nullptr);
-                    retObj->setProperty("mipmapLevelDataSize", mipmapLevelDataSizeArr);
+            seArgs.push_back(se::Value(retObj));
 
-                    seArgs.push_back(se::Value(retObj));
+            delete imgInfo;
+        } else {
+            SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
+        }
+        callbackPtr->toObject()->call(seArgs, nullptr);
+    };
 
-                    delete imgInfo;
-                } else {
-                    SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
-                }
-                callbackPtr->toObject()->call(seArgs, nullptr);
-                delete img;
-            });
-        });
+    auto initImageFunc = [onImageDecoded](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
+        // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
+        // the full path of the file is resolved before the decode workers map it.
+        if (fullPath.empty()) {
+            ccstd::vector<Data> buffers(1);
+            buffers[0].fastSet(imageData, static_cast<uint32_t>(imageBytes));
+            gImageDecodeQueue->decode(std::move(buffers), onImageDecoded);
+        } else {
+            gImageDecodeQueue->decodeFiles({fullPath}, onImageDecoded);
+        }
+        scheduleImageDelivery();
     };
     size_t pos = ccstd::string::npos;
     if (path.find("http://") == 0 || path.find("https://") == 0) {
@@ -827,6 +835,54 @@ static bool JSB_setPreferredFramesPerSecond(se::State &s) { // NOLINT
 }
 SE_BIND_FUNC(JSB_setPreferredFramesPerSecond)
 
+#if CC_USE_PROFILER
+static bool JSB_profiler_startTrace(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    uint32_t eventsPerThread = cc::TraceRecorder::DEFAULT_EVENTS_PER_THREAD;
+    if (!args.empty()) {
+        CC_UNUSED bool ok = sevalue_to_native(args[0], &eventsPerThread);
+        SE_PRECONDITION2(ok, false, "eventsPerThread is invalid!");
+    }
+    cc::TraceRecorder::start(eventsPerThread);
+    return true;
+}
+SE_BIND_FUNC(JSB_profiler_startTrace)
+
+static bool JSB_profiler_stopTrace(se::State &s) { // NOLINT
+    cc::TraceRecorder::stop();
+    return true;
+}
+SE_BIND_FUNC(JSB_profiler_stopTrace)
+
+static bool JSB_profiler_isTracing(se::State &s) { // NOLINT
+    s.rval().setBoolean(cc::TraceRecorder::isRecording());
+    return true;
+}
+SE_BIND_FUNC(JSB_profiler_isTracing)
+
+static bool JSB_profiler_exportTrace(se::State &s) { // NOLINT
+    s.rval().setString(cc::TraceRecorder::exportChromeTrace());
+    return true;
+}
+SE_BIND_FUNC(JSB_profiler_exportTrace)
+
+static bool JSB_profiler_saveTrace(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc > 0) {
+        ccstd::string path;
+        CC_UNUSED bool ok = sevalue_to_native(args[0], &path);
+        SE_PRECONDITION2(ok, false, "path is invalid!");
+        s.rval().setBoolean(cc::TraceRecorder::saveChromeTrace(path));
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_profiler_saveTrace)
+#endif
+
 #if CC_USE_EDITBOX
 static bool JSB_showInputBox(se::State &s) { // NOLINT
     const auto &args = s.args();
@@ -1556,6 +1612,7 @@ SE_BIND_FUNC(JSB_openharmony_postSyncMessage)
 
 bool jsb_register_global_variables(se::Object *global) { // NOLINT
     gIOThreadPool = LegacyThreadPool::newFixedThreadPool(5);
+    gImageDecodeQueue = ccnew ImageDecodeQueue();
 
 #if CC_EDITOR
     global->defineFunction("__require", _SE(require));
@@ -1584,6 +1641,17 @@ bool jsb_register_global_variables(se::Object *global) { // NOLINT
     __jsbObj->defineFunction("saveByteCode", _SE(JSB_saveByteCode));
     __jsbObj->defineFunction("createExternalArrayBuffer", _SE(jsb_createExternalArrayBuffer));
 
+#if CC_USE_PROFILER
+    // Create profiler object, the trace is exported in the Chrome trace event format
+    se::HandleObject profilerObj{se::Object::createPlainObject()};
+    profilerObj->defineFunction("startTrace", _SE(JSB_profiler_startTrace));
+    profilerObj->defineFunction("stopTrace", _SE(JSB_profiler_stopTrace));
+    profilerObj->defineFunction("isTracing", _SE(JSB_profiler_isTracing));
+    profilerObj->defineFunction("exportTrace", _SE(JSB_profiler_exportTrace));
+    profilerObj->defineFunction("saveTrace", _SE(JSB_profiler_saveTrace));
+    __jsbObj->setProperty("profiler", se::Value(profilerObj));
+#endif
+
     // Create process object
     se::HandleObject processObj{se::Object::createPlainObject()};
     processObj->defineProperty("argv", _SE(JSB_process_get_argv), nullptr);
@@ -1640,6 +1708,13 @@ bool jsb_register_global_variables(se::Object *global) { // NOLINT
         delete gIOThreadPool;
         gIOThreadPool = nullptr;
 
+        auto app = CC_CURRENT_APPLICATION();
+        if (app) {
+            app->getEngine()->getScheduler()->unschedule(IMAGE_DELIVERY_KEY, gImageDecodeQueue.get());
+        }
+        // the pending completions hold script values, drop them before the vm is cleaned up
+        gImageDecodeQueue = nullptr;
+
         DeferredReleasePool::clear();
     });
 
@@ -112,13 +112,13 @@ static bool js_register_spine_initSkeletonData(se::State &s) {
     if (binPos != ccstd::string::npos) {
         auto fileUtils = cc::FileUtils::getInstance();
         if (fileUtils->isFileExist(skeletonDataFile)) {
-            cc::Data cocos2dData;
             const auto fullpath = fileUtils->fullPathForFilename(skeletonDataFile);
-            fileUtils->getContents(fullpath, &cocos2dData);
+            // the binary parser copies what it keeps, so it can read the mapped file directly
+            const cc::IntrusivePtr<cc::MappedFile> file = fileUtils->mapFile(fullpath);
 
             spine::SkeletonBinary binary(attachmentLoader);
             binary.setScale(scale);
-            skeletonData = binary.readSkeletonData(cocos2dData.getBytes(), (int)cocos2dData.getSize());
+            skeletonData = file ? binary.readSkeletonData(file->getBytes(), (int)file->getSize()) : nullptr;
             const auto &errorMsg = binary.getError();
             CC_ASSERTF(skeletonData, "Spine parse error: %s", errorMsg.buffer());
         }
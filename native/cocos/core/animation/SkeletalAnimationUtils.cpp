@@ -22,7 +22,18 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+// Detect SIMD support before including math headers, Mat4.h undefines __SSE__.
+#if defined(__SSE__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define USE_SSE
+    #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define USE_NEON
+    #include <arm_neon.h>
+#endif
+
 #include "core/animation/SkeletalAnimationUtils.h"
+#include <cstring>
+#include "3d/assets/Skeleton.h"
 #include "core/scene-graph/Node.h"
 
 namespace cc {
@@ -30,6 +41,7 @@ namespace cc {
 namespace {
 ccstd::vector<IJointTransform *> stack;
 ccstd::unordered_map<ccstd::string, IJointTransform *> pool;
+ccstd::unordered_map<ccstd::string, JointPalette *> palettePool;
 } // namespace
 
 Mat4 getWorldMatrix(IJointTransform *transform, int32_t stamp) {
@@ -107,4 +119,102 @@ void deleteTransform(Node *node) {
     }
 }
 
+void computeJointPalette(const Mat4 &world, const Mat4 &bindpose, float *dst) {
+    const float *b = bindpose.m;
+#if defined(USE_SSE)
+    const __m128 w0 = _mm_loadu_ps(world.m);
+    const __m128 w1 = _mm_loadu_ps(world.m + 4);
+    const __m128 w2 = _mm_loadu_ps(world.m + 8);
+    const __m128 w3 = _mm_loadu_ps(world.m + 12);
+    __m128 c[4];
+    for (uint32_t j = 0; j < 4; ++j) {
+        const float *col = b + 4 * j;
+        c[j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(col[0])), _mm_mul_ps(w1, _mm_set1_ps(col[1]))),
+                          _mm_add_ps(_mm_mul_ps(w2, _mm_set1_ps(col[2])), _mm_mul_ps(w3, _mm_set1_ps(col[3]))));
+    }
+    // move the translation into the w component of the first three columns
+    const __m128 t0 = _mm_shuffle_ps(c[0], c[3], _MM_SHUFFLE(0, 0, 2, 2));
+    const __m128 t1 = _mm_shuffle_ps(c[1], c[3], _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 t2 = _mm_shuffle_ps(c[2], c[3], _MM_SHUFFLE(2, 2, 2, 2));
+    _mm_storeu_ps(dst, _mm_shuffle_ps(c[0], t0, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(c[1], t1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(c[2], t2, _MM_SHUFFLE(2, 0, 1, 0)));
+#elif defined(USE_NEON)
+    const float32x4_t w0 = vld1q_f32(world.m);
+    const float32x4_t w1 = vld1q_f32(world.m + 4);
+    const float32x4_t w2 = vld1q_f32(world.m + 8);
+    const float32x4_t w3 = vld1q_f32(world.m + 12);
+    float32x4_t c[4];
+    for (uint32_t j = 0; j < 4; ++j) {
+        const float *col = b + 4 * j;
+        c[j] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(w0, col[0]), w1, col[1]), w2, col[2]), w3, col[3]);
+    }
+    // move the translation into the w component of the first three columns
+    vst1q_f32(dst, vsetq_lane_f32(vgetq_lane_f32(c[3], 0), c[0], 3));
+    vst1q_f32(dst + 4, vsetq_lane_f32(vgetq_lane_f32(c[3], 1), c[1], 3));
+    vst1q_f32(dst + 8, vsetq_lane_f32(vgetq_lane_f32(c[3], 2), c[2], 3));
+#else
+    Mat4 mat;
+    Mat4::multiply(world, bindpose, &mat);
+    memcpy(dst, mat.m, sizeof(float) * 12);
+    dst[3] = mat.m[12];
+    dst[7] = mat.m[13];
+    dst[11] = mat.m[14];
+#endif
+}
+
+JointPalette *acquireJointPalette(Skeleton *skeleton, Node *root) {
+    ccstd::string key = root->getUuid() + "#" + std::to_string(skeleton->getHash());
+    auto iter = palettePool.find(key);
+    if (iter != palettePool.end()) {
+        iter->second->addRef();
+        return iter->second;
+    }
+
+    auto *palette = ccnew JointPalette;
+    const auto &joints = skeleton->getJoints();
+    palette->transforms.resize(joints.size());
+    for (size_t i = 0; i < joints.size(); ++i) {
+        auto *target = root->getChildByPath(joints[i]);
+        if (target) {
+            palette->transforms[i] = getTransform(target, root);
+        }
+    }
+    palette->bindposes = skeleton->getBindposes();
+    palette->data.resize(joints.size() * JOINT_PALETTE_STRIDE);
+    palette->key = key;
+    palette->addRef();
+    palettePool.emplace(std::move(key), palette);
+    return palette;
+}
+
+void releaseJointPalette(JointPalette *palette) {
+    if (palette->getRefCount() == 1) {
+        palettePool.erase(palette->key);
+    }
+    palette->release();
+}
+
+void updateJointPaletteTransforms(JointPalette *palette, int32_t stamp) {
+    for (auto &transform : palette->transforms) {
+        if (transform) {
+            getWorldMatrix(transform, stamp);
+        }
+    }
+}
+
+const float *updateJointPalette(JointPalette *palette, int32_t stamp) {
+    std::lock_guard<std::mutex> lock(palette->mutex);
+    if (palette->stamp != stamp) {
+        float *dst = palette->data.data();
+        for (size_t i = 0; i < palette->transforms.size(); ++i) {
+            if (palette->transforms[i]) {
+                computeJointPalette(palette->transforms[i]->world, palette->bindposes[i], dst + i * JOINT_PALETTE_STRIDE);
+            }
+        }
+        palette->stamp = stamp;
+    }
+    return palette->data.data();
+}
+
 } // namespace cc
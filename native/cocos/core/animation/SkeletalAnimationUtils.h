@@ -24,14 +24,18 @@
 
 #pragma once
 
+#include <mutex>
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 #include "math/Mat4.h"
 #include "renderer/gfx-base/GFXTexture.h"
 
 namespace cc {
 
 class Node;
+class Skeleton;
 
 struct IJointTransform : RefCounted {
     Node *node{nullptr};
@@ -52,8 +56,40 @@ struct RealTimeJointTexture {
     float *buffer = nullptr;
 };
 
+/**
+ * @en Skinning matrices of a skeleton bound to a skinning root, shared by all the skinning models
+ * using the same skeleton and root so that the palette is computed only once per frame.
+ * @zh 绑定到蒙皮根节点的骨骼的蒙皮矩阵，被使用相同骨骼与根节点的所有蒙皮模型共享，每帧只计算一次。
+ */
+struct JointPalette : RefCounted {
+    ccstd::string key;
+    ccstd::vector<IntrusivePtr<IJointTransform>> transforms; // nullptr if the joint node is missing
+    ccstd::vector<Mat4> bindposes;
+    ccstd::vector<float> data; // JOINT_PALETTE_STRIDE floats per joint
+    int stamp{-1};
+    std::mutex mutex;
+};
+
+constexpr uint32_t JOINT_PALETTE_STRIDE = 12;
+
 Mat4 getWorldMatrix(IJointTransform *transform, int32_t stamp);
 
+/**
+ * @en Write world * bindpose as three columns with the translation in the w components, the layout of the skinning UBO.
+ * @zh 以 w 分量存放平移的三列形式写入 world * bindpose，与蒙皮 UBO 的布局一致。
+ */
+void computeJointPalette(const Mat4 &world, const Mat4 &bindpose, float *dst);
+
+JointPalette *acquireJointPalette(Skeleton *skeleton, Node *root);
+
+void releaseJointPalette(JointPalette *palette);
+
+// resolve the world matrices of all the joints, not thread safe
+void updateJointPaletteTransforms(JointPalette *palette, int32_t stamp);
+
+// compute the palette once per stamp, thread safe after the transforms are resolved
+const float *updateJointPalette(JointPalette *palette, int32_t stamp);
+
 IJointTransform *getTransform(Node *node, Node *root);
 
 void deleteTransform(Node *node);
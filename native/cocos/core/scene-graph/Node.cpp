@@ -40,6 +40,7 @@ uint32_t Node::clearFrame{0};
 uint32_t Node::clearRound{1000};
 const uint32_t Node::TRANSFORM_ON{1 << 0};
 uint32_t Node::globalFlagChangeVersion{0};
+uint32_t Node::globalHierarchyVersion{0};
 
 namespace {
 const ccstd::string EMPTY_NODE_NAME;
@@ -170,6 +171,7 @@ void Node::setParent(Node *parent, bool isKeepWorld /* = false */) {
 #endif
     _parent = newParent;
     _siblingIndex = 0;
+    ++globalHierarchyVersion;
     onSetParent(oldParent, isKeepWorld);
     emit<ParentChanged>(oldParent);
     if (oldParent) {
@@ -257,6 +259,7 @@ bool Node::onPreDestroyBase() {
             index_t childIdx = getIdxOfChild(_parent->_children, this);
             if (childIdx != -1) {
                 _parent->_children.erase(_parent->_children.begin() + childIdx);
+                ++globalHierarchyVersion;
             }
             _siblingIndex = 0;
             _parent->updateSiblingIndex();
@@ -571,9 +574,60 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { // NOLINT(misc-n
         }
     }
     
+    ++_worldTransformVersion;
     _transformFlags = (static_cast<uint32_t>(TransformBit::NONE));
 }
 
+void Node::updateWorldTransformFromParent(const Mat4 *parentWorldMatrix) {
+    const uint32_t dirtyBits = _transformFlags;
+    if (!dirtyBits) {
+        return;
+    }
+
+    if (parentWorldMatrix) {
+        if (!(dirtyBits & static_cast<uint32_t>(TransformBit::RSS))) {
+            _worldPosition.transformMat4(_localPosition, *parentWorldMatrix);
+            _worldMatrix.m[12] = _worldPosition.x;
+            _worldMatrix.m[13] = _worldPosition.y;
+            _worldMatrix.m[14] = _worldPosition.z;
+        } else {
+            // Don't use static temporaries here, this function may run on several threads at the same time.
+            Mat4 localMatrix;
+            Mat4::fromRTS(_localRotation, _localPosition, _localScale, &localMatrix);
+            Mat4::multiply(*parentWorldMatrix, localMatrix, &_worldMatrix);
+            const bool rotChanged = dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION);
+            Quaternion *rotTmp = rotChanged ? &_worldRotation : nullptr;
+            Mat4::toRTS(_worldMatrix, rotTmp, &_worldPosition, &_worldScale);
+        }
+    } else {
+        if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
+            _worldPosition.set(_localPosition);
+            _worldMatrix.m[12] = _worldPosition.x;
+            _worldMatrix.m[13] = _worldPosition.y;
+            _worldMatrix.m[14] = _worldPosition.z;
+        }
+        if (dirtyBits & static_cast<uint32_t>(TransformBit::RSS)) {
+            if (dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
+                _worldRotation.set(_localRotation);
+            }
+            if (dirtyBits & static_cast<uint32_t>(TransformBit::SCALE)) {
+                _worldScale.set(_localScale);
+            }
+            Mat4::fromRTS(_worldRotation, _worldPosition, _worldScale, &_worldMatrix);
+            if (_skewType != static_cast<uint8_t>(SkewType::NONE)) {
+                updateLocalMatrixBySkew(&_worldMatrix);
+            }
+        }
+    }
+
+    ++_worldTransformVersion;
+    _transformFlags = (static_cast<uint32_t>(TransformBit::NONE));
+}
+
+bool Node::hasSkewComponents() {
+    return skewCompCount > 0;
+}
+
 const Mat4 &Node::getWorldMatrix() const { // NOLINT(misc-no-recursion)
     const_cast<Node *>(this)->updateWorldTransform();
     return _worldMatrix;
@@ -1054,11 +1108,13 @@ void Node::onHierarchyChanged(Node *oldParent) {
 //
 void Node::_setChildren(ccstd::vector<IntrusivePtr<Node>> &&children) {
     _children = std::move(children);
+    ++globalHierarchyVersion;
 }
 
 void Node::destruct() {
     CCObject::destruct();
     _children.clear();
+    ++globalHierarchyVersion;
     _scene = nullptr;
     _userData = nullptr;
 }
@@ -146,7 +146,10 @@ public:
     virtual void onPostActivated(bool active) {}
 
     void setParent(Node *parent, bool isKeepWorld = false);
-    inline void modifyParent(Node *parent) { _parent = parent; }
+    inline void modifyParent(Node *parent) {
+        _parent = parent;
+        ++globalHierarchyVersion;
+    }
 
     inline Scene *getScene() const { return _scene; };
 
@@ -629,6 +632,13 @@ private:
 
     void inverseTransformPointRecursive(Vec3 &out) const;
     void updateWorldTransformRecursive(uint32_t &superDirtyBits);
+    /**
+     * Update the world transform of this node only, the parent's world matrix should be up to date.
+     * Skew is not taken into account, it doesn't touch any shared state so it could run on worker threads.
+     * @param parentWorldMatrix The parent's world matrix, nullptr if the node has no parent.
+     */
+    void updateWorldTransformFromParent(const Mat4 *parentWorldMatrix);
+    static bool hasSkewComponents();
     void updateLocalMatrixBySkew(Mat4 *outLocalMatrix) const;
 
     inline void notifyLocalPositionUpdated() {
@@ -658,6 +668,8 @@ private:
 
     // increase on every frame, used to identify the frame
     static uint32_t globalFlagChangeVersion;
+    // increase whenever the parent-child relationship of any node changes
+    static uint32_t globalHierarchyVersion;
 
     static uint32_t clearFrame;
     static uint32_t clearRound;
@@ -698,10 +710,14 @@ private:
     uint32_t _hasChangedFlagsVersion{0};
     uint32_t _hasChangedFlags{0};
 
+    // increase whenever the world transform is recomputed
+    uint32_t _worldTransformVersion{0};
+
     bool _eulerDirty{false};
 
     friend class NodeActivator;
     friend class Scene;
+    friend class TransformHierarchy;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Node);
 };
@@ -24,10 +24,12 @@
 
 #include "core/scene-graph/Scene.h"
 #include "core/scene-graph/SceneGlobals.h"
+#include "core/scene-graph/TransformHierarchy.h"
 // #include "core/Director.h"
 #include "core/Root.h"
 //#include "core/scene-graph/NodeActivator.h"
 #include "engine/EngineEvents.h"
+#include "scene/RenderScene.h"
 
 namespace cc {
 
@@ -47,6 +49,17 @@ Scene::~Scene() = default;
 
 void Scene::setSceneGlobals(SceneGlobals *globals) { _globals = globals; }
 
+void Scene::setBatchedTransformEnabled(bool enabled) {
+    if (enabled == isBatchedTransformEnabled()) {
+        return;
+    }
+
+    _transformHierarchy = enabled ? ccnew TransformHierarchy(this) : nullptr;
+    if (_renderScene) {
+        _renderScene->setTransformHierarchy(_transformHierarchy);
+    }
+}
+
 void Scene::load() {
     events::SceneLoad::broadcast();
     if (!_inited) {
@@ -105,8 +118,10 @@ bool Scene::destroy() {
     }
 
     if (_renderScene != nullptr) {
+        _renderScene->setTransformHierarchy(nullptr);
         Root::getInstance()->destroyScene(_renderScene);
     }
+    _transformHierarchy = nullptr;
 
     _active = false;
     setActiveInHierarchy(false);
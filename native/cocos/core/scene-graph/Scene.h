@@ -28,6 +28,7 @@
 
 namespace cc {
 class SceneGlobals;
+class TransformHierarchy;
 namespace scene {
 class RenderScene;
 }
@@ -45,6 +46,13 @@ public:
     inline bool isAutoReleaseAssets() const { return _autoReleaseAssets; }
     inline void setAutoReleaseAssets(bool val) { _autoReleaseAssets = val; }
 
+    /**
+     * @en Whether to update the world transforms of the whole scene in one batched pass per frame, see [[TransformHierarchy]].
+     * @zh 是否在每帧以批处理的方式统一更新整个场景的世界变换，参见 [[TransformHierarchy]]。
+     */
+    void setBatchedTransformEnabled(bool enabled);
+    inline bool isBatchedTransformEnabled() const { return _transformHierarchy != nullptr; }
+
     void load();
     void activate(bool active = true);
 
@@ -61,6 +69,7 @@ protected:
      */
     //    @serializable
     IntrusivePtr<SceneGlobals> _globals;
+    IntrusivePtr<TransformHierarchy> _transformHierarchy;
     bool _inited{false};
 
     /**
@@ -0,0 +1,133 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "core/scene-graph/TransformHierarchy.h"
+#include <algorithm>
+#include "base/job-system/ForEachChunk.h"
+#include "core/scene-graph/Node.h"
+
+namespace cc {
+
+namespace {
+// Levels smaller than this are updated on the calling thread, dispatching jobs costs more than the update itself.
+constexpr uint32_t PARALLEL_LEVEL_THRESHOLD = 1024;
+constexpr uint32_t MIN_NODES_PER_JOB = 256;
+} // namespace
+
+TransformHierarchy::TransformHierarchy(Node *root)
+: _root(root) {
+}
+
+void TransformHierarchy::rebuild() {
+    _nodes.clear();
+    _parents.clear();
+    _levelOffsets.clear();
+
+    if (_root) {
+        _nodes.emplace_back(_root);
+        _parents.emplace_back(-1);
+        _levelOffsets.emplace_back(0);
+
+        uint32_t levelBegin = 0;
+        while (levelBegin < _nodes.size()) {
+            const auto levelEnd = static_cast<uint32_t>(_nodes.size());
+            _levelOffsets.emplace_back(levelEnd);
+            for (uint32_t i = levelBegin; i < levelEnd; ++i) {
+                for (const auto &child : _nodes[i]->getChildren()) {
+                    if (child) {
+                        _nodes.emplace_back(child.get());
+                        _parents.emplace_back(static_cast<int32_t>(i));
+                    }
+                }
+            }
+            levelBegin = levelEnd;
+        }
+    }
+
+    const auto nodeCount = _nodes.size();
+    _worldMatrices.resize(nodeCount);
+    _worldVersions.resize(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i) {
+        // Mismatch on purpose, so that the cached world matrix is synchronized on the next pass.
+        _worldVersions[i] = _nodes[i]->_worldTransformVersion - 1U;
+    }
+
+    _hierarchyVersion = Node::globalHierarchyVersion;
+    _built = true;
+}
+
+void TransformHierarchy::update() {
+    if (!_built || _hierarchyVersion != Node::globalHierarchyVersion) {
+        rebuild();
+    }
+
+    // The skew path of Node relies on static temporaries and walks up the ancestors, keep it on the calling thread.
+    const bool hasSkew = Node::hasSkewComponents();
+
+    const uint32_t levelCount = getLevelCount();
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const uint32_t begin = _levelOffsets[level];
+        const uint32_t end = _levelOffsets[level + 1];
+        if (hasSkew) {
+            updateRange(begin, end, true);
+            continue;
+        }
+
+        // Nodes of the same level never depend on each other.
+        forEachChunk(
+            end - begin, PARALLEL_LEVEL_THRESHOLD, [this, begin](uint32_t first, uint32_t last) {
+                updateRange(begin + first, begin + last, false);
+            },
+            MIN_NODES_PER_JOB);
+    }
+}
+
+void TransformHierarchy::updateRange(uint32_t begin, uint32_t end, bool hasSkew) {
+    for (uint32_t i = begin; i < end; ++i) {
+        Node *node = _nodes[i];
+        // Children of an inactive node are inactive too, so they never read a stale parent entry.
+        if (!node->isActiveInHierarchy()) {
+            continue;
+        }
+
+        if (node->_transformFlags) {
+            if (hasSkew) {
+                // The parent has been updated by the previous level, so this doesn't recurse.
+                node->updateWorldTransform();
+            } else {
+                const int32_t parent = _parents[i];
+                node->updateWorldTransformFromParent(parent < 0 ? nullptr : &_worldMatrices[parent]);
+            }
+        } else if (node->_worldTransformVersion == _worldVersions[i]) {
+            continue;
+        }
+
+        // Either updated above or on demand through the Node API since the last pass.
+        _worldMatrices[i] = node->_worldMatrix;
+        _worldVersions[i] = node->_worldTransformVersion;
+    }
+}
+
+} // namespace cc
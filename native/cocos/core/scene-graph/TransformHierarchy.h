@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Data oriented storage of a node tree's transforms.
+ * Nodes are flattened breadth first so that every hierarchy level is a contiguous range and
+ * parents always precede their children. Dirty nodes are then updated level by level in one
+ * linear pass, big levels are split across the job system workers.
+ * The world transforms are written back to the nodes, so the existing Node API keeps working.
+ * @zh 以数据为导向存储节点树的变换信息。
+ * 节点按广度优先展开，每一层级在数组中连续存放且父节点总在子节点之前，脏节点按层级线性更新，较大的层级会分发到 job system 中并行计算。
+ * 计算得到的世界变换会回写到节点上，因此原有的 Node 接口保持不变。
+ */
+class TransformHierarchy final : public RefCounted {
+public:
+    explicit TransformHierarchy(Node *root);
+    ~TransformHierarchy() override = default;
+
+    /**
+     * @en Updates the world transform of all dirty nodes that are active in hierarchy.
+     * @zh 更新所有在层级中激活的脏节点的世界变换。
+     */
+    void update();
+
+    inline Node *getRoot() const { return _root; }
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+    inline uint32_t getLevelCount() const { return _levelOffsets.empty() ? 0U : static_cast<uint32_t>(_levelOffsets.size() - 1); }
+
+private:
+    void rebuild();
+    void updateRange(uint32_t begin, uint32_t end, bool hasSkew);
+
+    Node *_root{nullptr};
+    uint32_t _hierarchyVersion{0};
+    bool _built{false};
+
+    // SoA storage, indexed in breadth first order
+    ccstd::vector<Node *> _nodes;
+    ccstd::vector<int32_t> _parents;
+    ccstd::vector<uint32_t> _worldVersions;
+    ccstd::vector<Mat4> _worldMatrices;
+    // level i occupies [_levelOffsets[i], _levelOffsets[i + 1])
+    ccstd::vector<uint32_t> _levelOffsets;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TransformHierarchy);
+};
+
+} // namespace cc
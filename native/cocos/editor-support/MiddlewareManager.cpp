@@ -26,10 +26,16 @@
 #include <algorithm>
 #include "2d/renderer/Batcher2d.h"
 #include "SeApi.h"
+#include "base/job-system/ForEachChunk.h"
 #include "core/Root.h"
 
 MIDDLEWARE_BEGIN
 
+namespace {
+// below this count the job dispatch costs more than the updates themselves
+constexpr size_t PARALLEL_UPDATE_THRESHOLD = 16;
+} // namespace
+
 MiddlewareManager *MiddlewareManager::instance = nullptr;
 
 MiddlewareManager::MiddlewareManager() : _renderInfo(se::Object::TypedArrayType::UINT32),
@@ -76,9 +82,13 @@ void MiddlewareManager::update(float dt) {
         attachBuffer->writeUint32(0);
     }
 
-    for (size_t i = 0, len = _updateList.size(); i < len; ++i) {
-        auto *editor = _updateList[i];
-        editor->update(dt);
+    if (_parallelUpdate && _updateList.size() >= PARALLEL_UPDATE_THRESHOLD) {
+        updateInParallel(dt);
+    } else {
+        for (size_t i = 0, len = _updateList.size(); i < len; ++i) {
+            auto *editor = _updateList[i];
+            editor->update(dt);
+        }
     }
 
     for (auto &iter: _operateCacheMap) {
@@ -89,6 +99,31 @@ void MiddlewareManager::update(float dt) {
     }
 }
 
+void MiddlewareManager::updateInParallel(float dt) {
+    _parallelUpdateList.clear();
+    _serialUpdateList.clear();
+    for (auto *editor : _updateList) {
+        if (editor->isParallelUpdateSafe()) {
+            _parallelUpdateList.push_back(editor);
+        } else {
+            _serialUpdateList.push_back(editor);
+        }
+    }
+
+    // phase 1: pose evaluation of independent skeletons
+    auto **editors = _parallelUpdateList.data();
+    forEachChunk(static_cast<uint32_t>(_parallelUpdateList.size()), PARALLEL_UPDATE_THRESHOLD, [editors, dt](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            editors[i]->update(dt);
+        }
+    });
+
+    // phase 2: middleware which may call back into scripts, once every pose is stable
+    for (auto *editor : _serialUpdateList) {
+        editor->update(dt);
+    }
+}
+
 void MiddlewareManager::render(float dt) {
     for (auto it : _mbMap) {
         auto *buffer = it.second;
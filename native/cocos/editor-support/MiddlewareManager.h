@@ -42,6 +42,11 @@ public:
     virtual ~IMiddleware() = default;
     virtual void update(float dt) = 0;
     virtual void render(float dt) = 0;
+    /**
+     * Whether update may run on a job system worker, concurrently with the update of other middleware.
+     * Such an update must only touch its own pose data: no shared mesh buffers, no script callbacks.
+     */
+    virtual bool isParallelUpdateSafe() const { return false; }
 };
 
 /**
@@ -82,6 +87,13 @@ public:
      */
     void render(float dt);
 
+    /**
+     * @brief Update middleware which is parallel update safe on the job system,
+     * before the remaining middleware is updated serially. Disabled by default.
+     */
+    void setParallelUpdate(bool enabled) { _parallelUpdate = enabled; }
+    bool isParallelUpdateEnabled() const { return _parallelUpdate; }
+
     /**
      * @brief Mark the add flag to _operateCacheMap, and perform the update in the next frame
      * @param[in] editor Module must implement IMiddleware interface.
@@ -110,14 +122,19 @@ public:
 
 private:
     void updateOperateCache();
+    void updateInParallel(float dt);
 
     ccstd::vector<IMiddleware *> _updateList;
+    ccstd::vector<IMiddleware *> _parallelUpdateList;
+    ccstd::vector<IMiddleware *> _serialUpdateList;
     ccstd::unordered_map<IMiddleware *, bool> _operateCacheMap;
     ccstd::unordered_map<int, MeshBuffer *> _mbMap;
 
     SharedBufferManager _renderInfo;
     SharedBufferManager _attachInfo;
 
+    bool _parallelUpdate{false};
+
     static MiddlewareManager *instance;
 };
 MIDDLEWARE_END
@@ -95,17 +95,26 @@ DragonBonesData *CCFactory::loadDragonBonesData(const std::string &filePath, con
 
             return parseDragonBonesData(data.c_str(), name, scale);
         } else {
-            cc::Data cocos2dData;
-            cc::FileUtils::getInstance()->getContents(fullpath, &cocos2dData);
-            uint8_t *binary = cocos2dData.takeBuffer();
-            // NOTE: binary is freed in DragonBonesData::_onClear
-            return parseDragonBonesData(reinterpret_cast<char *>(binary), name, scale);
+            return parseDragonBonesDataFromMappedFile(fullpath, name, scale);
         }
     }
 
     return nullptr;
 }
 
+DragonBonesData *CCFactory::parseDragonBonesDataFromMappedFile(const std::string &fullpath, const std::string &name, float scale) {
+    const cc::IntrusivePtr<cc::MappedFile> file = cc::FileUtils::getInstance()->mapFile(fullpath);
+    if (!file || file->getSize() == 0) {
+        return nullptr;
+    }
+    auto *data = parseDragonBonesData(reinterpret_cast<const char *>(file->getBytes()), name, scale);
+    if (data) {
+        // the parsed data points into the file, keep it mapped until DragonBonesData::_onClear
+        data->binaryReleaser = [file](const char * /*binary*/) {};
+    }
+    return data;
+}
+
 DragonBonesData *CCFactory::parseDragonBonesDataByPath(const std::string &filePath, const std::string &name, float scale) {
     if (!name.empty()) {
         const auto existedData = getDragonBonesData(name);
@@ -118,11 +127,7 @@ DragonBonesData *CCFactory::parseDragonBonesDataByPath(const std::string &filePa
     if (dbbinPos != std::string::npos) {
         const auto fullpath = cc::FileUtils::getInstance()->fullPathForFilename(filePath);
         if (cc::FileUtils::getInstance()->isFileExist(filePath)) {
-            cc::Data cocos2dData;
-            cc::FileUtils::getInstance()->getContents(fullpath, &cocos2dData);
-            uint8_t *binary = cocos2dData.takeBuffer();
-            // NOTE: binary is freed in DragonBonesData::_onClear
-            return parseDragonBonesData(reinterpret_cast<char *>(binary), name, scale);
+            return parseDragonBonesDataFromMappedFile(fullpath, name, scale);
         }
     } else {
         return parseDragonBonesData(filePath.c_str(), name, scale);
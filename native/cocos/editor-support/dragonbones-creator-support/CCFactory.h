@@ -132,6 +132,7 @@ protected:
     virtual TextureAtlasData *_buildTextureAtlasData(TextureAtlasData *textureAtlasData, void *textureAtlas) const override;
     virtual Armature *_buildArmature(const BuildArmaturePackage &dataPackage) const override;
     virtual Slot *_buildSlot(const BuildArmaturePackage &dataPackage, const SlotData *slotData, Armature *armature) const override;
+    DragonBonesData *parseDragonBonesDataFromMappedFile(const std::string &fullpath, const std::string &name, float scale);
 
 public:
     virtual DragonBonesData *loadDragonBonesData(const std::string &filePath, const std::string &name = "", float scale = 1.0f);
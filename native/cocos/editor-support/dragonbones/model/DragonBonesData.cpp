@@ -9,10 +9,13 @@ void DragonBonesData::_onClear() {
         pair.second->returnToPool();
     }
 
-    if (binary != nullptr) {
+    if (binaryReleaser) {
+        binaryReleaser(binary);
+        binaryReleaser = nullptr;
+    } else if (binary != nullptr) {
         free(const_cast<char*>(binary));
-        binary = nullptr;
     }
+    binary = nullptr;
 
     if (userData != nullptr) {
         userData->returnToPool();
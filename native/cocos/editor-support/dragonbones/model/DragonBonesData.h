@@ -23,6 +23,7 @@
 #ifndef DRAGONBONES_DRAGONBONES_DATA_H
 #define DRAGONBONES_DRAGONBONES_DATA_H
 
+#include <functional>
 #include "../core/BaseObject.h"
 #include "ArmatureData.h"
 
@@ -111,6 +112,11 @@ public:
      * @internal
      */
     const char* binary;
+    /**
+     * - Releases the binary instead of free() when it is not owned by the data, e.g. a mapped file.
+     * @internal
+     */
+    std::function<void(const char*)> binaryReleaser;
     /**
      * @internal
      */
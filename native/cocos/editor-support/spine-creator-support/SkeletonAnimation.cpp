@@ -135,6 +135,11 @@ void SkeletonAnimation::update(float deltaTime) {
     }
 }
 
+bool SkeletonAnimation::isParallelUpdateSafe() const {
+    return !_startListener && !_interruptListener && !_endListener && !_disposeListener &&
+           !_completeListener && !_eventListener && !_hasTrackEntryListeners;
+}
+
 void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
     CC_ASSERT(stateData);
 
@@ -299,27 +304,33 @@ void SkeletonAnimation::setEventListener(const EventListener &listener) {
     _eventListener = listener;
 }
 
-void SkeletonAnimation::setTrackStartListener(TrackEntry *entry, const StartListener &listener) { // NOLINT(readability-convert-member-functions-to-static)
+void SkeletonAnimation::setTrackStartListener(TrackEntry *entry, const StartListener &listener) {
+    _hasTrackEntryListeners = true;
     getListeners(entry)->startListener = listener;
 }
 
-void SkeletonAnimation::setTrackInterruptListener(TrackEntry *entry, const InterruptListener &listener) { // NOLINT(readability-convert-member-functions-to-static)
+void SkeletonAnimation::setTrackInterruptListener(TrackEntry *entry, const InterruptListener &listener) {
+    _hasTrackEntryListeners = true;
     getListeners(entry)->interruptListener = listener;
 }
 
-void SkeletonAnimation::setTrackEndListener(TrackEntry *entry, const EndListener &listener) { // NOLINT(readability-convert-member-functions-to-static)
+void SkeletonAnimation::setTrackEndListener(TrackEntry *entry, const EndListener &listener) {
+    _hasTrackEntryListeners = true;
     getListeners(entry)->endListener = listener;
 }
 
-void SkeletonAnimation::setTrackDisposeListener(TrackEntry *entry, const DisposeListener &listener) { // NOLINT(readability-convert-member-functions-to-static)
+void SkeletonAnimation::setTrackDisposeListener(TrackEntry *entry, const DisposeListener &listener) {
+    _hasTrackEntryListeners = true;
     getListeners(entry)->disposeListener = listener;
 }
 
-void SkeletonAnimation::setTrackCompleteListener(TrackEntry *entry, const CompleteListener &listener) { // NOLINT(readability-convert-member-functions-to-static)
+void SkeletonAnimation::setTrackCompleteListener(TrackEntry *entry, const CompleteListener &listener) {
+    _hasTrackEntryListeners = true;
     getListeners(entry)->completeListener = listener;
 }
 
-void SkeletonAnimation::setTrackEventListener(TrackEntry *entry, const EventListener &listener) { // NOLINT(readability-convert-member-functions-to-static)
+void SkeletonAnimation::setTrackEventListener(TrackEntry *entry, const EventListener &listener) {
+    _hasTrackEntryListeners = true;
     getListeners(entry)->eventListener = listener;
 }
 
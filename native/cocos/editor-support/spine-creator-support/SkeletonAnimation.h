@@ -51,6 +51,8 @@ public:
     static void setGlobalTimeScale(float timeScale);
 
     virtual void update(float deltaTime) override;
+    // animation events reach the listeners from update, so only skeletons without listeners update in parallel
+    bool isParallelUpdateSafe() const override;
 
     void setAnimationStateData(spine::AnimationStateData *stateData);
     void setMix(const std::string &fromAnimation, const std::string &toAnimation, float duration);
@@ -100,6 +102,7 @@ protected:
     DisposeListener _disposeListener = nullptr;
     CompleteListener _completeListener = nullptr;
     EventListener _eventListener = nullptr;
+    bool _hasTrackEntryListeners = false;
 
 private:
     typedef cc::SkeletonRenderer super;
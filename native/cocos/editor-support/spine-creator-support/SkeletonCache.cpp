@@ -28,6 +28,10 @@
  *****************************************************************************/
 
 #include "SkeletonCache.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include "base/ThreadPool.h"
 #include "base/memory/Memory.h"
 #include "spine-creator-support/AttachmentVertices.h"
 
@@ -38,6 +42,41 @@ namespace cc {
 
 float SkeletonCache::FrameTime = 1.0F / 60.0F;
 float SkeletonCache::MaxCacheTime = 120.0F;
+bool SkeletonCache::UseCompactFrames = false;
+
+struct SkeletonCache::PrebakeTask {
+    SkeletonCache *baker = nullptr;
+    uint32_t generation = 0;
+    std::promise<void> promise;
+    std::future<void> finished;
+};
+
+namespace {
+constexpr std::size_t VERTEX_FLOATS = sizeof(V3F_T2F_C4B_C4B) / sizeof(float);
+constexpr float QUANTIZE_MAX = 65535.0F;
+
+std::size_t alignSection(std::size_t offset) {
+    return (offset + 7U) & ~static_cast<std::size_t>(7U);
+}
+
+uint16_t quantize(float value, float min, float scale) {
+    if (scale <= 0.0F) return 0;
+    return static_cast<uint16_t>(std::clamp(std::round((value - min) / scale), 0.0F, QUANTIZE_MAX));
+}
+
+uint16_t quantizeUV(float value) {
+    return static_cast<uint16_t>(std::round(std::clamp(value, 0.0F, 1.0F) * QUANTIZE_MAX));
+}
+
+// segments baked without retaining their textures, see SkeletonCache::_retainTextures
+void retainSegmentTextures(const std::vector<SkeletonCache::FrameData *> &frames) {
+    for (const auto *frame : frames) {
+        for (const auto *segment : frame->getSegments()) {
+            CC_SAFE_ADD_REF(segment->getTexture());
+        }
+    }
+}
+} // namespace
 
 SkeletonCache::SegmentData::SegmentData() = default;
 
@@ -113,23 +152,185 @@ std::size_t SkeletonCache::FrameData::getSegmentCount() const {
     return _segments.size();
 }
 
+SkeletonCache::CompactFrames::~CompactFrames() {
+    if (_retainsTextures) {
+        for (auto *texture : _textures) {
+            CC_SAFE_RELEASE(texture);
+        }
+    }
+}
+
+void SkeletonCache::CompactFrames::retainTextures() {
+    if (_retainsTextures) return;
+    for (auto *texture : _textures) {
+        CC_SAFE_ADD_REF(texture);
+    }
+    _retainsTextures = true;
+}
+
+std::unique_ptr<SkeletonCache::CompactFrames> SkeletonCache::CompactFrames::build(const std::vector<FrameData *> &frames) {
+    auto compact = std::make_unique<CompactFrames>();
+    std::size_t vertexCount = 0;
+    std::size_t indexCount = 0;
+    std::size_t colorCount = 0;
+    std::size_t segmentCount = 0;
+    std::size_t boneCount = 0;
+    float minX = FLT_MAX;
+    float minY = FLT_MAX;
+    float maxX = -FLT_MAX;
+    float maxY = -FLT_MAX;
+
+    for (const auto *frame : frames) {
+        const auto frameVertexCount = frame->vb.getCurPos() / sizeof(V3F_T2F_C4B_C4B);
+        const auto *verts = reinterpret_cast<const V3F_T2F_C4B_C4B *>(frame->vb.getBuffer());
+        for (std::size_t i = 0; i < frameVertexCount; ++i) {
+            minX = std::min(minX, verts[i].vertex.x);
+            minY = std::min(minY, verts[i].vertex.y);
+            maxX = std::max(maxX, verts[i].vertex.x);
+            maxY = std::max(maxY, verts[i].vertex.y);
+        }
+        vertexCount += frameVertexCount;
+        indexCount += frame->ib.getCurPos() / sizeof(uint16_t);
+        colorCount += frame->getColorCount();
+        segmentCount += frame->getSegmentCount();
+        boneCount += frame->getBoneCount();
+    }
+    if (vertexCount > 0) {
+        compact->_positionMin[0] = minX;
+        compact->_positionMin[1] = minY;
+        compact->_positionScale[0] = (maxX - minX) / QUANTIZE_MAX;
+        compact->_positionScale[1] = (maxY - minY) / QUANTIZE_MAX;
+    }
+
+    // frames | vertices | indices | colors | segments | bones
+    compact->_frameCount = frames.size();
+    compact->_vertexOffset = alignSection(frames.size() * sizeof(CompactFrame));
+    compact->_indexOffset = alignSection(compact->_vertexOffset + vertexCount * sizeof(CompactVertex));
+    compact->_colorOffset = alignSection(compact->_indexOffset + indexCount * sizeof(uint16_t));
+    compact->_segmentOffset = alignSection(compact->_colorOffset + colorCount * sizeof(CompactColor));
+    compact->_boneOffset = alignSection(compact->_segmentOffset + segmentCount * sizeof(CompactSegment));
+    compact->_arena.resize(compact->_boneOffset + boneCount * sizeof(CompactBone));
+
+    uint8_t *arena = compact->_arena.data();
+    auto *dstFrames = reinterpret_cast<CompactFrame *>(arena);
+    auto *dstVertices = reinterpret_cast<CompactVertex *>(arena + compact->_vertexOffset);
+    auto *dstIndices = reinterpret_cast<uint16_t *>(arena + compact->_indexOffset);
+    auto *dstColors = reinterpret_cast<CompactColor *>(arena + compact->_colorOffset);
+    auto *dstSegments = reinterpret_cast<CompactSegment *>(arena + compact->_segmentOffset);
+    auto *dstBones = reinterpret_cast<CompactBone *>(arena + compact->_boneOffset);
+
+    CompactFrame cursor;
+    for (std::size_t frameIdx = 0; frameIdx < frames.size(); ++frameIdx) {
+        const auto *frame = frames[frameIdx];
+        auto &dstFrame = dstFrames[frameIdx];
+        dstFrame = cursor;
+
+        const auto frameVertexCount = frame->vb.getCurPos() / sizeof(V3F_T2F_C4B_C4B);
+        const auto *verts = reinterpret_cast<const V3F_T2F_C4B_C4B *>(frame->vb.getBuffer());
+        for (std::size_t i = 0; i < frameVertexCount; ++i) {
+            auto &dst = dstVertices[cursor.vertexBegin + i];
+            dst.x = quantize(verts[i].vertex.x, compact->_positionMin[0], compact->_positionScale[0]);
+            dst.y = quantize(verts[i].vertex.y, compact->_positionMin[1], compact->_positionScale[1]);
+            dst.u = quantizeUV(verts[i].texCoord.u);
+            dst.v = quantizeUV(verts[i].texCoord.v);
+        }
+
+        const auto frameIndexCount = frame->ib.getCurPos() / sizeof(uint16_t);
+        memcpy(dstIndices + cursor.indexBegin, frame->ib.getBuffer(), frameIndexCount * sizeof(uint16_t));
+
+        const auto &colors = frame->getColors();
+        for (std::size_t i = 0; i < colors.size(); ++i) {
+            auto &dst = dstColors[cursor.colorBegin + i];
+            dst.finalColor = colors[i]->finalColor;
+            dst.darkColor = colors[i]->darkColor;
+            dst.vertexEnd = static_cast<uint32_t>(colors[i]->vertexFloatOffset / VERTEX_FLOATS);
+        }
+
+        const auto &segments = frame->getSegments();
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            auto *texture = segments[i]->getTexture();
+            auto it = std::find(compact->_textures.begin(), compact->_textures.end(), texture);
+            if (it == compact->_textures.end()) {
+                it = compact->_textures.insert(it, texture);
+            }
+            auto &dst = dstSegments[cursor.segmentBegin + i];
+            dst.textureIndex = static_cast<uint32_t>(it - compact->_textures.begin());
+            dst.blendMode = segments[i]->blendMode;
+            dst.indexCount = static_cast<uint32_t>(segments[i]->indexCount);
+            dst.vertexCount = static_cast<uint32_t>(segments[i]->vertexFloatCount / VERTEX_FLOATS);
+        }
+
+        const auto &bones = frame->getBones();
+        for (std::size_t i = 0; i < bones.size(); ++i) {
+            const auto &matm = bones[i]->globalTransformMatrix.m;
+            auto &dst = dstBones[cursor.boneBegin + i];
+            dst.a = matm[0];
+            dst.c = matm[1];
+            dst.b = matm[4];
+            dst.d = matm[5];
+            dst.worldX = matm[12];
+            dst.worldY = matm[13];
+        }
+
+        dstFrame.colorCount = static_cast<uint32_t>(colors.size());
+        dstFrame.segmentCount = static_cast<uint32_t>(segments.size());
+        dstFrame.boneCount = static_cast<uint32_t>(bones.size());
+        cursor.vertexBegin += static_cast<uint32_t>(frameVertexCount);
+        cursor.indexBegin += static_cast<uint32_t>(frameIndexCount);
+        cursor.colorBegin += dstFrame.colorCount;
+        cursor.segmentBegin += dstFrame.segmentCount;
+        cursor.boneBegin += dstFrame.boneCount;
+    }
+    return compact;
+}
+
 SkeletonCache::AnimationData::AnimationData() = default;
 
 SkeletonCache::AnimationData::~AnimationData() {
     reset();
+    if (_prebakeTask) {
+        // the baker must be released on this thread
+        _prebakeTask->finished.wait();
+        if (auto *baked = _prebakeTask->baker->getAnimationData(_animationName)) {
+            retainSegmentTextures(baked->_frames);
+        }
+        _prebakeTask->baker->release();
+        _prebakeTask = nullptr;
+    }
 }
 
 void SkeletonCache::AnimationData::reset() {
+    clearFrames();
+    _isComplete = false;
+    _totalTime = 0.0F;
+    // a running prebake is discarded when it is polled
+    ++_generation;
+}
+
+void SkeletonCache::AnimationData::clearFrames() {
     for (auto &frame : _frames) {
         delete frame;
     }
     _frames.clear();
-    _isComplete = false;
-    _totalTime = 0.0F;
+    _compactFrames = nullptr;
+}
+
+void SkeletonCache::AnimationData::compact(bool segmentsRetainTextures) {
+    if (_compactFrames) return;
+    _compactFrames = CompactFrames::build(_frames);
+    for (auto &frame : _frames) {
+        if (!segmentsRetainTextures) {
+            for (auto *segment : frame->_segments) {
+                segment->_texture = nullptr;
+            }
+        }
+        delete frame;
+    }
+    _frames.clear();
 }
 
 bool SkeletonCache::AnimationData::needUpdate(int toFrameIdx) const {
-    return !_isComplete && _totalTime <= MaxCacheTime && (toFrameIdx == -1 || _frames.size() < toFrameIdx + 1);
+    return !_isComplete && _totalTime <= MaxCacheTime && (toFrameIdx == -1 || getFrameCount() < toFrameIdx + 1);
 }
 
 SkeletonCache::FrameData *SkeletonCache::AnimationData::buildFrameData(std::size_t frameIdx) {
@@ -151,7 +352,7 @@ SkeletonCache::FrameData *SkeletonCache::AnimationData::getFrameData(std::size_t
 }
 
 std::size_t SkeletonCache::AnimationData::getFrameCount() const {
-    return _frames.size();
+    return _compactFrames ? _compactFrames->getFrameCount() : _frames.size();
 }
 
 SkeletonCache::SkeletonCache() = default;
@@ -206,7 +407,7 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
     }
 
     AnimationData *animationData = it->second;
-    if (!animationData || !animationData->needUpdate(toFrameIdx)) {
+    if (!animationData || !pollPrebake(animationData) || !animationData->needUpdate(toFrameIdx)) {
         return;
     }
 
@@ -225,6 +426,71 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
         renderAnimationFrame(animationData);
         animationData->_totalTime += FrameTime;
     } while (animationData->needUpdate(toFrameIdx));
+
+    if (UseCompactFrames && !animationData->needUpdate(-1)) {
+        animationData->compact(_retainTextures);
+        if (_retainTextures) {
+            animationData->_compactFrames->retainTextures();
+        }
+    }
+}
+
+void SkeletonCache::prebakeAnimation(const std::string &animationName) {
+    AnimationData *animationData = buildAnimationData(animationName);
+    if (!animationData || animationData->_prebakeTask || !animationData->needUpdate(-1)) {
+        return;
+    }
+
+    auto task = std::make_shared<PrebakeTask>();
+    task->baker = new SkeletonCache();
+    task->baker->addRef();
+    task->baker->_retainTextures = false;
+    task->baker->initWithUUID(_uuid);
+    if (!task->baker->_skeleton) {
+        task->baker->release();
+        return;
+    }
+    if (auto *skin = _skeleton ? _skeleton->getSkin() : nullptr) {
+        task->baker->setSkin(skin->getName().buffer());
+    }
+    task->baker->buildAnimationData(animationName);
+    task->generation = animationData->_generation;
+    task->finished = task->promise.get_future();
+    animationData->_prebakeTask = task;
+
+    LegacyThreadPool::getDefaultThreadPool()->pushTask([task, animationName](int /*threadId*/) {
+        task->baker->updateToFrame(animationName);
+        task->promise.set_value();
+    });
+}
+
+bool SkeletonCache::pollPrebake(AnimationData *animationData) {
+    auto task = animationData->_prebakeTask;
+    if (!task) {
+        return true;
+    }
+    if (task->finished.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    animationData->_prebakeTask = nullptr;
+
+    AnimationData *baked = task->baker->getAnimationData(animationData->_animationName);
+    if (baked && task->generation == animationData->_generation) {
+        animationData->clearFrames();
+        std::swap(animationData->_frames, baked->_frames);
+        std::swap(animationData->_compactFrames, baked->_compactFrames);
+        animationData->_isComplete = baked->_isComplete;
+        animationData->_totalTime = baked->_totalTime;
+        retainSegmentTextures(animationData->_frames);
+        if (animationData->_compactFrames) {
+            animationData->_compactFrames->retainTextures();
+        }
+    } else if (baked) {
+        // discarded, the segments release what they did not retain
+        retainSegmentTextures(baked->_frames);
+    }
+    task->baker->release();
+    return true;
 }
 
 void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
@@ -280,7 +546,12 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
         }
 
         SegmentData *segmentData = frameData->buildSegmentData(materialLen);
-        segmentData->setTexture(texture);
+        if (_retainTextures) {
+            segmentData->setTexture(texture);
+        } else {
+            // textures are not thread safe reference counted, they are retained on hand over
+            segmentData->_texture = texture;
+        }
         segmentData->blendMode = slot->getData().getBlendMode();
 
         // save new segment count pos field
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <future>
+#include <memory>
 #include <vector>
 #include "IOBuffer.h"
 #include "SkeletonAnimation.h"
@@ -103,6 +105,101 @@ public:
         cc::middleware::IOBuffer vb;
     };
 
+    // Vertex of a compact frame, position and uv are quantized to 16 bits.
+    struct CompactVertex {
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint16_t u = 0;
+        uint16_t v = 0;
+    };
+
+    struct CompactColor {
+        cc::middleware::Color4B finalColor;
+        cc::middleware::Color4B darkColor;
+        // end of the color run, in vertices from the beginning of the frame
+        uint32_t vertexEnd = 0;
+    };
+
+    struct CompactSegment {
+        uint32_t textureIndex = 0;
+        int32_t blendMode = 0;
+        uint32_t indexCount = 0;
+        uint32_t vertexCount = 0;
+    };
+
+    struct CompactBone {
+        float a = 1.0F;
+        float b = 0.0F;
+        float c = 0.0F;
+        float d = 1.0F;
+        float worldX = 0.0F;
+        float worldY = 0.0F;
+    };
+
+    struct CompactFrame {
+        uint32_t vertexBegin = 0;
+        uint32_t indexBegin = 0;
+        uint32_t colorBegin = 0;
+        uint32_t colorCount = 0;
+        uint32_t segmentBegin = 0;
+        uint32_t segmentCount = 0;
+        uint32_t boneBegin = 0;
+        uint32_t boneCount = 0;
+    };
+
+    /**
+     * All frames of one animation packed in a single arena.
+     * Positions are quantized against the bounds of the whole animation, uvs are normalized,
+     * vertex colors are kept once per color run. It is read only once built,
+     * so every SkeletonCacheAnimation sharing the cache reads it directly.
+     */
+    class CompactFrames {
+    public:
+        CompactFrames() = default;
+        ~CompactFrames();
+        CompactFrames(const CompactFrames &) = delete;
+        CompactFrames &operator=(const CompactFrames &) = delete;
+
+        static std::unique_ptr<CompactFrames> build(const std::vector<FrameData *> &frames);
+
+        std::size_t getFrameCount() const { return _frameCount; }
+        const CompactFrame &getFrame(std::size_t frameIdx) const { return section<CompactFrame>(0)[frameIdx]; }
+        const CompactVertex *getVertices(const CompactFrame &frame) const { return section<CompactVertex>(_vertexOffset) + frame.vertexBegin; }
+        const uint16_t *getIndices(const CompactFrame &frame) const { return section<uint16_t>(_indexOffset) + frame.indexBegin; }
+        const CompactColor *getColors(const CompactFrame &frame) const { return section<CompactColor>(_colorOffset) + frame.colorBegin; }
+        const CompactSegment *getSegments(const CompactFrame &frame) const { return section<CompactSegment>(_segmentOffset) + frame.segmentBegin; }
+        const CompactBone *getBones(const CompactFrame &frame) const { return section<CompactBone>(_boneOffset) + frame.boneBegin; }
+        cc::middleware::Texture2D *getTexture(uint32_t textureIndex) const { return _textures[textureIndex]; }
+        std::size_t getMemorySize() const { return _arena.size(); }
+
+        float decodeX(uint16_t x) const { return _positionMin[0] + static_cast<float>(x) * _positionScale[0]; }
+        float decodeY(uint16_t y) const { return _positionMin[1] + static_cast<float>(y) * _positionScale[1]; }
+        static float decodeUV(uint16_t uv) { return static_cast<float>(uv) * (1.0F / 65535.0F); }
+
+        // textures are referenced once the frames are handed to the main thread
+        void retainTextures();
+
+    private:
+        template <typename T>
+        const T *section(std::size_t offset) const {
+            return reinterpret_cast<const T *>(_arena.data() + offset);
+        }
+
+        std::vector<uint8_t> _arena;
+        std::size_t _frameCount = 0;
+        std::size_t _vertexOffset = 0;
+        std::size_t _indexOffset = 0;
+        std::size_t _colorOffset = 0;
+        std::size_t _segmentOffset = 0;
+        std::size_t _boneOffset = 0;
+        float _positionMin[2] = {0.0F, 0.0F};
+        float _positionScale[2] = {0.0F, 0.0F};
+        std::vector<cc::middleware::Texture2D *> _textures;
+        bool _retainsTextures = false;
+    };
+
+    struct PrebakeTask;
+
     struct AnimationData {
         friend class SkeletonCache;
 
@@ -112,6 +209,8 @@ public:
 
         FrameData *getFrameData(std::size_t frameIdx) const;
         std::size_t getFrameCount() const;
+        // not null once the frames have been packed, getFrameData returns null then.
+        const CompactFrames *getCompactFrames() const { return _compactFrames.get(); }
 
         bool isComplete() const { return _isComplete; }
         bool needUpdate(int toFrameIdx) const;
@@ -119,12 +218,19 @@ public:
     private:
         // if frame is empty, it will build new one.
         FrameData *buildFrameData(std::size_t frameIdx);
+        void clearFrames();
+        // segments baked without retaining their textures must not release them
+        void compact(bool segmentsRetainTextures);
 
     private:
         std::string _animationName = "";
         bool _isComplete = false;
         float _totalTime = 0.0f;
         std::vector<FrameData *> _frames;
+        std::unique_ptr<CompactFrames> _compactFrames;
+        // incremented by reset, a prebake started before is discarded
+        uint32_t _generation = 0;
+        std::shared_ptr<PrebakeTask> _prebakeTask;
     };
 
     SkeletonCache();
@@ -143,15 +249,28 @@ public:
     void resetAllAnimationData();
     void resetAnimationData(const std::string &animationName);
 
+    /**
+     * Bakes every frame of the animation on a worker thread with a private skeleton.
+     * The frames are handed over the next time updateToFrame is called after the bake finished,
+     * until then the animation is not baked lazily on the main thread.
+     */
+    void prebakeAnimation(const std::string &animationName);
+
 private:
     void renderAnimationFrame(AnimationData *animationData);
+    // takes over the frames of a finished prebake, returns false while it is still running.
+    bool pollPrebake(AnimationData *animationData);
 
 public:
     static float FrameTime;
     static float MaxCacheTime;
+    // pack complete animations into CompactFrames
+    static bool UseCompactFrames;
 
 private:
     std::string _curAnimationName = "";
     std::map<std::string, AnimationData *> _animationCaches;
+    // a prebaking cache does not reference the textures of its segments, see CompactFrames::retainTextures
+    bool _retainTextures = true;
 };
 } // namespace cc
@@ -47,6 +47,46 @@ using namespace spine;
 static const std::string TECH_STAGE = "opaque";
 static const std::string TEXTURE_KEY = "texture";
 
+static void getBlendFactors(int blendMode, bool premultipliedAlpha, int &blendSrc, int &blendDst) {
+    switch (blendMode) {
+        case BlendMode_Additive:
+            blendSrc = static_cast<int>(premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE);
+            break;
+        case BlendMode_Multiply:
+            blendSrc = static_cast<int>(BlendFactor::DST_COLOR);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode_Screen:
+            blendSrc = static_cast<int>(premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
+            break;
+        default:
+            blendSrc = static_cast<int>(premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+// tints the cached colors with the node color and opacity
+static void applyNodeColor(const Color4B &srcColor, const Color4B &srcDarkColor, const Color4F &nodeColor, float opacity,
+                           bool premultipliedAlpha, Color4B &finalColor, Color4B &darkColor) {
+    float tempA = srcColor.a * opacity;
+    float multiplier = premultipliedAlpha ? tempA / 255 : 1;
+    float tempR = nodeColor.r * multiplier;
+    float tempG = nodeColor.g * multiplier;
+    float tempB = nodeColor.b * multiplier;
+
+    finalColor.r = static_cast<uint8_t>(std::round(srcColor.r * tempR));
+    finalColor.g = static_cast<uint8_t>(std::round(srcColor.g * tempG));
+    finalColor.b = static_cast<uint8_t>(std::round(srcColor.b * tempB));
+    finalColor.a = static_cast<uint8_t>(std::round(tempA));
+
+    darkColor.r = static_cast<uint8_t>(std::round(srcDarkColor.r * tempR));
+    darkColor.g = static_cast<uint8_t>(std::round(srcDarkColor.g * tempG));
+    darkColor.b = static_cast<uint8_t>(std::round(srcDarkColor.b * tempB));
+    darkColor.a = premultipliedAlpha ? 255 : 0;
+}
+
 namespace cc {
 
 SkeletonCacheAnimation::SkeletonCacheAnimation(const std::string &uuid, bool isShare) {
@@ -157,6 +197,10 @@ void SkeletonCacheAnimation::update(float dt) {
 
 void SkeletonCacheAnimation::render(float /*dt*/) {
     if (!_animationData) return;
+    if (const auto *compactFrames = _animationData->getCompactFrames()) {
+        renderCompactFrame(*compactFrames);
+        return;
+    }
     SkeletonCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
     if (!frameData) return;
     auto *entity = _entity;
@@ -205,11 +249,6 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
 
     Color4B finalColor;
     Color4B darkColor;
-    float tempR = 0.0F;
-    float tempG = 0.0F;
-    float tempB = 0.0F;
-    float tempA = 0.0F;
-    float multiplier = 1.0F;
     int srcVertexBytesOffset = 0;
     int srcVertexBytes = 0;
     int vertexBytes = 0;
@@ -239,21 +278,7 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
     }
 
     auto handleColor = [&](SkeletonCache::ColorData *colorData) {
-        tempA = colorData->finalColor.a * _entity->getOpacity();
-        multiplier = _premultipliedAlpha ? tempA / 255 : 1;
-        tempR = _nodeColor.r * multiplier;
-        tempG = _nodeColor.g * multiplier;
-        tempB = _nodeColor.b * multiplier;
-
-        finalColor.r = static_cast<uint8_t>(std::round(colorData->finalColor.r * tempR));
-        finalColor.g = static_cast<uint8_t>(std::round(colorData->finalColor.g * tempG));
-        finalColor.b = static_cast<uint8_t>(std::round(colorData->finalColor.b * tempB));
-        finalColor.a = static_cast<uint8_t>(std::round(tempA));
-
-        darkColor.r = static_cast<uint8_t>(std::round(colorData->darkColor.r * tempR));
-        darkColor.g = static_cast<uint8_t>(std::round(colorData->darkColor.g * tempG));
-        darkColor.b = static_cast<uint8_t>(std::round(colorData->darkColor.b * tempB));
-        darkColor.a = _premultipliedAlpha ? 255 : 0;
+        applyNodeColor(colorData->finalColor, colorData->darkColor, _nodeColor, _entity->getOpacity(), _premultipliedAlpha, finalColor, darkColor);
     };
 
     handleColor(nowColor);
@@ -278,23 +303,7 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
         curDrawInfo->setSampler(sampler);
 
         blendMode = segment->blendMode;
-        switch (blendMode) {
-            case BlendMode_Additive:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE);
-                break;
-            case BlendMode_Multiply:
-                curBlendSrc = static_cast<int>(BlendFactor::DST_COLOR);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-                break;
-            case BlendMode_Screen:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
-                break;
-            default:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-        }
+        getBlendFactors(blendMode, _premultipliedAlpha, curBlendSrc, curBlendDst);
         // fill new blend src and dst
         auto *material = requestMaterial(curBlendSrc, curBlendDst);
         curDrawInfo->setMaterial(material);
@@ -382,6 +391,133 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
     }
 }
 
+void SkeletonCacheAnimation::renderCompactFrame(const SkeletonCache::CompactFrames &compactFrames) {
+    if (_curFrameIndex < 0 || _curFrameIndex >= static_cast<int>(compactFrames.getFrameCount())) return;
+    const auto &frame = compactFrames.getFrame(_curFrameIndex);
+    auto *entity = _entity;
+    entity->clearDynamicRenderDrawInfos();
+    if (frame.segmentCount == 0 || frame.colorCount == 0) return;
+
+    auto *mgr = MiddlewareManager::getInstance();
+
+    _sharedBufferOffset->reset();
+    _sharedBufferOffset->clear();
+
+    auto *attachMgr = mgr->getAttachInfoMgr();
+    auto *attachInfo = attachMgr->getBuffer();
+    if (!attachInfo) return;
+
+    // store attach info offset
+    _sharedBufferOffset->writeUint32(static_cast<uint32_t>(attachInfo->getCurPos()) / sizeof(uint32_t));
+
+    auto vertexFormat = _useTint ? VF_XYZUVCC : VF_XYZUVC;
+    middleware::MeshBuffer *mb = mgr->getMeshBuffer(vertexFormat);
+    middleware::IOBuffer &vb = mb->getVB();
+    middleware::IOBuffer &ib = mb->getIB();
+    auto &nodeWorldMat = entity->getNode()->getWorldMatrix();
+    const int vbs = _useTint ? sizeof(V3F_T2F_C4B_C4B) : sizeof(V3F_T2F_C4B);
+
+    const bool needColor = abs(_nodeColor.r - 1.0F) > 0.0001F ||
+                           abs(_nodeColor.g - 1.0F) > 0.0001F ||
+                           abs(_nodeColor.b - 1.0F) > 0.0001F ||
+                           abs(_nodeColor.a - 1.0F) > 0.0001F ||
+                           _premultipliedAlpha;
+
+    const auto *srcVertices = compactFrames.getVertices(frame);
+    const auto *srcIndices = compactFrames.getIndices(frame);
+    const auto *colors = compactFrames.getColors(frame);
+    const auto *segments = compactFrames.getSegments(frame);
+
+    uint32_t colorIndex = 0;
+    Color4B finalColor;
+    Color4B darkColor;
+    auto handleColor = [&](const SkeletonCache::CompactColor &colorData) {
+        if (needColor) {
+            applyNodeColor(colorData.finalColor, colorData.darkColor, _nodeColor, _entity->getOpacity(), _premultipliedAlpha, finalColor, darkColor);
+        } else {
+            finalColor = colorData.finalColor;
+            darkColor = colorData.darkColor;
+        }
+    };
+    handleColor(colors[colorIndex]);
+
+    uint32_t srcVertex = 0;
+    int curBlendSrc = -1;
+    int curBlendDst = -1;
+    for (uint32_t segmentIndex = 0; segmentIndex < frame.segmentCount; ++segmentIndex) {
+        const auto &segment = segments[segmentIndex];
+        auto *curDrawInfo = requestDrawInfo(static_cast<int>(segmentIndex));
+        entity->addDynamicRenderDrawInfo(curDrawInfo);
+        auto *curTexture = static_cast<cc::Texture2D *>(compactFrames.getTexture(segment.textureIndex)->getRealTexture());
+        curDrawInfo->setTexture(curTexture->getGFXTexture());
+        curDrawInfo->setSampler(curTexture->getGFXSampler());
+        getBlendFactors(segment.blendMode, _premultipliedAlpha, curBlendSrc, curBlendDst);
+        curDrawInfo->setMaterial(requestMaterial(curBlendSrc, curBlendDst));
+
+        // expand quantized vertices
+        const auto vertexBytes = static_cast<int>(segment.vertexCount * vbs);
+        vb.checkSpace(vertexBytes, true);
+        const auto dstVertexOffset = static_cast<uint32_t>(vb.getCurPos() / vbs);
+        uint8_t *dstVertexBuffer = vb.getCurBuffer();
+        for (uint32_t i = 0; i < segment.vertexCount; ++i, ++srcVertex) {
+            while (srcVertex >= colors[colorIndex].vertexEnd && colorIndex + 1 < frame.colorCount) {
+                handleColor(colors[++colorIndex]);
+            }
+            const auto &src = srcVertices[srcVertex];
+            cc::Vec3 position(compactFrames.decodeX(src.x), compactFrames.decodeY(src.y), 0.0F);
+            if (_enableBatch) {
+                position.transformMat4(position, nodeWorldMat);
+            }
+            if (_useTint) {
+                auto *dst = reinterpret_cast<V3F_T2F_C4B_C4B *>(dstVertexBuffer) + i;
+                dst->vertex = position;
+                dst->texCoord.u = SkeletonCache::CompactFrames::decodeUV(src.u);
+                dst->texCoord.v = SkeletonCache::CompactFrames::decodeUV(src.v);
+                dst->color = finalColor;
+                dst->color2 = darkColor;
+            } else {
+                auto *dst = reinterpret_cast<V3F_T2F_C4B *>(dstVertexBuffer) + i;
+                dst->vertex = position;
+                dst->texCoord.u = SkeletonCache::CompactFrames::decodeUV(src.u);
+                dst->texCoord.v = SkeletonCache::CompactFrames::decodeUV(src.v);
+                dst->color = finalColor;
+            }
+        }
+        vb.move(vertexBytes);
+
+        // fill index buffer
+        const auto indexBytes = static_cast<int>(segment.indexCount * sizeof(uint16_t));
+        ib.checkSpace(indexBytes, true);
+        const auto dstIndexOffset = static_cast<uint32_t>(ib.getCurPos() / sizeof(uint16_t));
+        auto *dstIndexBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
+        for (uint32_t i = 0; i < segment.indexCount; ++i) {
+            dstIndexBuffer[i] = static_cast<uint16_t>(srcIndices[i] + dstVertexOffset);
+        }
+        ib.move(indexBytes);
+        srcIndices += segment.indexCount;
+
+        curDrawInfo->setMeshBuffer(mb->getUIMeshBuffer());
+        curDrawInfo->setIndexOffset(dstIndexOffset);
+        curDrawInfo->setIbCount(segment.indexCount);
+    }
+
+    if (_useAttach) {
+        const auto *bones = compactFrames.getBones(frame);
+        cc::Mat4 boneMatrix;
+        for (uint32_t i = 0; i < frame.boneCount; ++i) {
+            auto &matm = boneMatrix.m;
+            matm[0] = bones[i].a;
+            matm[1] = bones[i].c;
+            matm[4] = bones[i].b;
+            matm[5] = bones[i].d;
+            matm[12] = bones[i].worldX;
+            matm[13] = bones[i].worldY;
+            attachInfo->checkSpace(sizeof(cc::Mat4), true);
+            attachInfo->writeBytes(reinterpret_cast<const char *>(&boneMatrix), sizeof(cc::Mat4));
+        }
+    }
+}
+
 Skeleton *SkeletonCacheAnimation::getSkeleton() const {
     return _skeletonCache->getSkeleton();
 }
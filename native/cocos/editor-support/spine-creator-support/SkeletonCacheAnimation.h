@@ -106,6 +106,8 @@ public:
     void setMaterial(cc::Material *material);
     void setRenderEntity(cc::RenderEntity* entity);
 private:
+    void renderCompactFrame(const SkeletonCache::CompactFrames &compactFrames);
+
     float _timeScale = 1;
     bool _paused = false;
     bool _useAttach = false;
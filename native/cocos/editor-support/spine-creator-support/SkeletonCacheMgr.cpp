@@ -44,6 +44,10 @@ SkeletonCache *SkeletonCacheMgr::buildSkeletonCache(const std::string &uuid) {
     return animation;
 }
 
+void SkeletonCacheMgr::prebakeAnimation(const std::string &uuid, const std::string &animationName) {
+    buildSkeletonCache(uuid)->prebakeAnimation(animationName);
+}
+
 void SkeletonCacheMgr::removeSkeletonCache(const std::string &uuid) {
     auto it = _caches.find(uuid);
     if (it != _caches.end()) {
@@ -51,6 +51,11 @@ public:
 
     void removeSkeletonCache(const std::string &uuid);
     cc::SkeletonCache *buildSkeletonCache(const std::string &uuid);
+    // bakes the shared cache of the animation on a worker thread, see SkeletonCache::prebakeAnimation
+    void prebakeAnimation(const std::string &uuid, const std::string &animationName);
+    // complete animations of every cache are packed with quantized vertices
+    void setCompactFramesEnabled(bool enabled) { SkeletonCache::UseCompactFrames = enabled; }
+    bool isCompactFramesEnabled() const { return SkeletonCache::UseCompactFrames; }
 
 private:
     static SkeletonCacheMgr *instance;
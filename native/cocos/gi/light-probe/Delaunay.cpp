@@ -25,7 +25,12 @@
 
 #include "Delaunay.h"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include "base/Log.h"
+#include "base/job-system/ForEachChunk.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
 #include "core/platform/Debug.h"
 #include "math/Mat3.h"
 #define CC_USE_TETGEN 1
@@ -36,6 +41,75 @@
 namespace cc {
 namespace gi {
 
+namespace {
+// below this count adjacency and matrices are computed on the calling thread
+constexpr uint32_t PARALLEL_THRESHOLD = 1024;
+// above this share of changed probes the incremental mesh is rebuilt from scratch
+constexpr float REBUILD_RATIO = 0.25F;
+// points on a circumsphere within this relative tolerance are in conflict, so cavities never leave flat cells behind
+constexpr double SPHERE_EPSILON = 1e-10;
+// cells flatter than this are rejected and the incremental update falls back to a full build
+constexpr double DEGENERATE_EPSILON = 1e-10;
+// points this close to a vertex, relative to the size of the cell they fall in, are duplicates
+constexpr double DUPLICATE_EPSILON = 1e-6;
+
+// face i of a cell is opposite to vertex i
+constexpr int32_t FACE_VERTICES[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+
+struct FaceKey {
+    int32_t vertex0{-1};
+    int32_t vertex1{-1};
+    int32_t vertex2{-1};
+
+    FaceKey(int32_t v0, int32_t v1, int32_t v2) {
+        if (v0 > v1) std::swap(v0, v1);
+        if (v1 > v2) std::swap(v1, v2);
+        if (v0 > v1) std::swap(v0, v1);
+        vertex0 = v0;
+        vertex1 = v1;
+        vertex2 = v2;
+    }
+
+    inline bool operator==(const FaceKey &other) const {
+        return vertex0 == other.vertex0 && vertex1 == other.vertex1 && vertex2 == other.vertex2;
+    }
+};
+
+struct FaceKeyHash {
+    inline size_t operator()(const FaceKey &key) const {
+        auto hash = static_cast<size_t>(key.vertex0) * 73856093U;
+        hash ^= static_cast<size_t>(key.vertex1) * 19349663U;
+        hash ^= static_cast<size_t>(key.vertex2) * 83492791U;
+        return hash;
+    }
+};
+
+struct PositionHash {
+    inline size_t operator()(const Vec3 &position) const {
+        // +0.0F folds -0.0F into 0.0F, both compare equal
+        const float values[3] = {position.x + 0.0F, position.y + 0.0F, position.z + 0.0F};
+        uint32_t bits[3];
+        memcpy(bits, values, sizeof(bits));
+        return static_cast<size_t>(bits[0]) * 73856093U ^ static_cast<size_t>(bits[1]) * 19349663U ^ static_cast<size_t>(bits[2]) * 83492791U;
+    }
+};
+
+inline uint64_t edgeKey(int32_t v0, int32_t v1) {
+    if (v0 > v1) std::swap(v0, v1);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(v0)) << 32U) | static_cast<uint32_t>(v1);
+}
+
+void computeBounds(const ccstd::vector<Vertex> &probes, Vec3 &minPos, Vec3 &maxPos) {
+    minPos.set(INFINITY, INFINITY, INFINITY);
+    maxPos.set(-INFINITY, -INFINITY, -INFINITY);
+    for (const auto &probe : probes) {
+        const auto &position = probe.position;
+        minPos.set(std::min(minPos.x, position.x), std::min(minPos.y, position.y), std::min(minPos.z, position.z));
+        maxPos.set(std::max(maxPos.x, position.x), std::max(maxPos.y, position.y), std::max(maxPos.z, position.z));
+    }
+}
+} // namespace
+
 void CircumSphere::init(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) {
     // calculate circumsphere of 4 points in R^3 space.
     Mat3 mat(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z,
@@ -75,10 +149,141 @@ ccstd::vector<Tetrahedron> Delaunay::build() {
     return std::move(_tetrahedrons);
 }
 
+ccstd::vector<Tetrahedron> Delaunay::update() {
+    reset();
+    if (!updateMesh() && !rebuildMesh()) {
+        CC_LOG_WARNING("Incremental light probe tetrahedralization failed, rebuilding all tetrahedrons.");
+        _lastUpdateResult = UpdateResult::FALLBACK;
+        _mesh.clear();
+        _meshProbes.clear();
+        return build();
+    }
+
+    collectTetrahedrons();
+    computeAdjacency();
+    computeMatrices();
+
+    return std::move(_tetrahedrons);
+}
+
 void Delaunay::reset() {
     _tetrahedrons.clear();
     _triangles.clear();
     _edges.clear();
+
+    for (auto &probe : _probes) {
+        probe.normal.setZero();
+    }
+}
+
+bool Delaunay::updateMesh() {
+    if (_mesh.empty()) {
+        return rebuildMesh();
+    }
+
+    // match probes to mesh points by position, everything left unmatched was added, removed or moved
+    const auto pointCount = _mesh.getPointCount();
+    ccstd::unordered_map<Vec3, int32_t, PositionHash> points;
+    points.reserve(pointCount);
+    for (auto i = DelaunayMesh::INFINITE_POINT + 1; i < pointCount; i++) {
+        if (!_mesh.isFree(i)) {
+            points.emplace(_mesh.getPosition(i), i);
+        }
+    }
+
+    ccstd::vector<int32_t> added;
+    ccstd::vector<int32_t> removed;
+    _meshProbes.assign(pointCount, -1);
+
+    const auto probeCount = static_cast<int32_t>(_probes.size());
+    for (auto i = 0; i < probeCount; i++) {
+        const auto &position = _probes[i].position;
+        auto iter = points.find(position);
+        if (iter != points.end()) {
+            // duplicated probes share the first one's point
+            const auto point = iter->second;
+            if (_meshProbes[point] < 0) {
+                _meshProbes[point] = i;
+                if (!_mesh.isInserted(point)) {
+                    added.push_back(point);
+                }
+            }
+            continue;
+        }
+
+        const auto point = _mesh.addPoint(position);
+        if (point >= static_cast<int32_t>(_meshProbes.size())) {
+            _meshProbes.resize(point + 1, -1);
+        }
+        _meshProbes[point] = i;
+        points.emplace(position, point);
+        added.push_back(point);
+    }
+
+    for (auto i = DelaunayMesh::INFINITE_POINT + 1; i < pointCount; i++) {
+        if (!_mesh.isFree(i) && _meshProbes[i] < 0) {
+            removed.push_back(i);
+        }
+    }
+
+    if (static_cast<float>(added.size() + removed.size()) > static_cast<float>(probeCount) * REBUILD_RATIO) {
+        return rebuildMesh();
+    }
+
+    _lastUpdateResult = UpdateResult::INCREMENTAL;
+    if (!_mesh.remove(removed)) {
+        return false;
+    }
+
+    for (const auto point : added) {
+        if (!_mesh.insert(point)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Delaunay::rebuildMesh() {
+    _lastUpdateResult = UpdateResult::REBUILT;
+    _mesh.init();
+
+    _meshProbes.assign(1, -1);
+    const auto probeCount = static_cast<int32_t>(_probes.size());
+    for (auto i = 0; i < probeCount; i++) {
+        const auto point = _mesh.addPoint(_probes[i].position);
+        _meshProbes.push_back(i);
+        if (!_mesh.insert(point)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Delaunay::collectTetrahedrons() {
+    // ghost cells only close the convex hull
+    const auto &cells = _mesh.getCells();
+    ccstd::vector<uint32_t> tetrahedronCells;
+    for (auto i = 0U; i < static_cast<uint32_t>(cells.size()); i++) {
+        if (cells[i].alive && !cells[i].isGhost()) {
+            tetrahedronCells.push_back(i);
+        }
+    }
+
+    const auto tetrahedronCount = static_cast<uint32_t>(tetrahedronCells.size());
+    _tetrahedrons.resize(tetrahedronCount);
+    forEachChunk(tetrahedronCount, PARALLEL_THRESHOLD, [&](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            const auto &vertices = cells[tetrahedronCells[i]].vertices;
+            _tetrahedrons[i] = Tetrahedron(this, _meshProbes[vertices[0]], _meshProbes[vertices[1]], _meshProbes[vertices[2]], _meshProbes[vertices[3]]);
+        }
+    });
+
+    Vec3 minPos;
+    Vec3 maxPos;
+    computeBounds(_probes, minPos, maxPos);
+    reorder((maxPos + minPos) * 0.5F);
 }
 
 #if CC_USE_TETGEN
@@ -257,43 +462,85 @@ void Delaunay::addProbe(int32_t vertexIndex) {
 
 void Delaunay::reorder(const Vec3 &center) {
     // The tetrahedron in the middle is placed at the front of the vector
-    std::sort(_tetrahedrons.begin(), _tetrahedrons.end(), [center](Tetrahedron &a, Tetrahedron &b) {
-        return a.sphere.center.distanceSquared(center) < b.sphere.center.distanceSquared(center);
+    const auto tetrahedronCount = static_cast<uint32_t>(_tetrahedrons.size());
+    ccstd::vector<std::pair<float, uint32_t>> distances(tetrahedronCount);
+    forEachChunk(tetrahedronCount, PARALLEL_THRESHOLD, [&](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            distances[i] = {_tetrahedrons[i].sphere.center.distanceSquared(center), i};
+        }
     });
+    std::sort(distances.begin(), distances.end());
+
+    ccstd::vector<Tetrahedron> tetrahedrons(tetrahedronCount);
+    forEachChunk(tetrahedronCount, PARALLEL_THRESHOLD, [&](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            tetrahedrons[i] = _tetrahedrons[distances[i].second];
+        }
+    });
+    _tetrahedrons.swap(tetrahedrons);
 }
 
 void Delaunay::computeAdjacency() {
     Vec3 normal;
 
     const auto tetrahedronCount = static_cast<int32_t>(_tetrahedrons.size());
+    const auto triangleCount = static_cast<uint32_t>(tetrahedronCount) * 4;
+    _triangles.resize(triangleCount);
+
+    forEachChunk(static_cast<uint32_t>(tetrahedronCount), PARALLEL_THRESHOLD, [this](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            const auto &tetrahedron = _tetrahedrons[i];
+            const auto tet = static_cast<int32_t>(i);
+
+            _triangles[i * 4].set(tet, 0, tetrahedron.vertex1, tetrahedron.vertex3, tetrahedron.vertex2, tetrahedron.vertex0);
+            _triangles[i * 4 + 1].set(tet, 1, tetrahedron.vertex0, tetrahedron.vertex2, tetrahedron.vertex3, tetrahedron.vertex1);
+            _triangles[i * 4 + 2].set(tet, 2, tetrahedron.vertex0, tetrahedron.vertex3, tetrahedron.vertex1, tetrahedron.vertex2);
+            _triangles[i * 4 + 3].set(tet, 3, tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3);
+        }
+    });
 
-    auto triangleIndex = 0;
-    for (auto i = 0; i < static_cast<int32_t>(_tetrahedrons.size()); i++) {
-        const auto &tetrahedron = _tetrahedrons[i];
-
-        addTriangle(triangleIndex, i, 0, tetrahedron.vertex1, tetrahedron.vertex3, tetrahedron.vertex2, tetrahedron.vertex0);
-        addTriangle(triangleIndex + 1, i, 1, tetrahedron.vertex0, tetrahedron.vertex2, tetrahedron.vertex3, tetrahedron.vertex1);
-        addTriangle(triangleIndex + 2, i, 2, tetrahedron.vertex0, tetrahedron.vertex3, tetrahedron.vertex1, tetrahedron.vertex2);
-        addTriangle(triangleIndex + 3, i, 3, tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3);
-        triangleIndex += 4;
+    // bucket the triangles by their smallest vertex, a shared face ends up twice in the same small bucket
+    const auto probeCount = static_cast<uint32_t>(_probes.size());
+    _bucketOffsets.assign(probeCount + 1, 0);
+    for (const auto &triangle : _triangles) {
+        _bucketOffsets[triangle.vertex0 + 1]++;
+    }
+    for (auto i = 0U; i < probeCount; i++) {
+        _bucketOffsets[i + 1] += _bucketOffsets[i];
     }
 
-    for (auto i = 0; i < triangleIndex; i++) {
-        if (!_triangles[i].isOuterFace) {
-            continue;
-        }
+    _bucketTriangles.resize(triangleCount);
+    _bucketCursors.assign(_bucketOffsets.begin(), _bucketOffsets.end() - 1);
+    for (auto i = 0U; i < triangleCount; i++) {
+        const auto &triangle = _triangles[i];
+        const auto key = (static_cast<uint64_t>(triangle.vertex1) << 32U) | static_cast<uint32_t>(triangle.vertex2);
+        _bucketTriangles[_bucketCursors[triangle.vertex0]++] = {key, i};
+    }
 
-        for (auto k = i + 1; k < triangleIndex; k++) {
-            if (_triangles[i].isSame(_triangles[k])) {
-                // update adjacency between tetrahedrons
-                _tetrahedrons[_triangles[i].tetrahedron].neighbours[_triangles[i].index] = _triangles[k].tetrahedron;
-                _tetrahedrons[_triangles[k].tetrahedron].neighbours[_triangles[k].index] = _triangles[i].tetrahedron;
-                _triangles[i].isOuterFace = false;
-                _triangles[k].isOuterFace = false;
-                break;
+    forEachChunk(probeCount, PARALLEL_THRESHOLD, [this](uint32_t begin, uint32_t end) {
+        for (auto vertex = begin; vertex < end; vertex++) {
+            auto *first = _bucketTriangles.data() + _bucketOffsets[vertex];
+            auto *last = _bucketTriangles.data() + _bucketOffsets[vertex + 1];
+            std::sort(first, last);
+
+            for (auto *iter = first; iter + 1 < last; iter++) {
+                // only the first two triangles of a run of equal faces are paired
+                if ((iter > first && (iter - 1)->first == iter->first) || iter->first != (iter + 1)->first) {
+                    continue;
+                }
+
+                // triangle i is face i % 4 of tetrahedron i / 4
+                const auto triangle0 = iter->second;
+                const auto triangle1 = (iter + 1)->second;
+                _tetrahedrons[triangle0 / 4].neighbours[triangle0 % 4] = static_cast<int32_t>(triangle1 / 4);
+                _tetrahedrons[triangle1 / 4].neighbours[triangle1 % 4] = static_cast<int32_t>(triangle0 / 4);
+                _triangles[triangle0].isOuterFace = false;
+                _triangles[triangle1].isOuterFace = false;
             }
         }
+    });
 
+    for (auto i = 0U; i < triangleCount; i++) {
         if (_triangles[i].isOuterFace) {
             auto &probe0 = _probes[_triangles[i].vertex0];
             auto &probe1 = _probes[_triangles[i].vertex1];
@@ -329,7 +576,7 @@ void Delaunay::computeAdjacency() {
     }
 
     // start from outer cell index
-    auto edgeIndex = 0;
+    auto edgeIndex = 0U;
     for (auto i = tetrahedronCount; i < static_cast<int32_t>(_tetrahedrons.size()); i++) {
         const auto &tetrahedron = _tetrahedrons[i];
 
@@ -339,13 +586,31 @@ void Delaunay::computeAdjacency() {
         edgeIndex += 3;
     }
 
-    for (auto i = 0; i < edgeIndex; i++) {
-        for (auto k = i + 1; k < edgeIndex; k++) {
-            if (_edges[i].isSame(_edges[k])) {
-                // update adjacency between outer cells
-                _tetrahedrons[_edges[i].tetrahedron].neighbours[_edges[i].index] = _edges[k].tetrahedron;
-                _tetrahedrons[_edges[k].tetrahedron].neighbours[_edges[k].index] = _edges[i].tetrahedron;
-            }
+    // hull edges are few, sorting them by vertices is enough
+    ccstd::vector<uint32_t> sortedEdges(edgeIndex);
+    for (auto i = 0U; i < edgeIndex; i++) {
+        sortedEdges[i] = i;
+    }
+
+    std::sort(sortedEdges.begin(), sortedEdges.end(), [this](uint32_t a, uint32_t b) {
+        const auto &e0 = _edges[a];
+        const auto &e1 = _edges[b];
+        if (e0.vertex0 != e1.vertex0) {
+            return e0.vertex0 < e1.vertex0;
+        }
+        if (e0.vertex1 != e1.vertex1) {
+            return e0.vertex1 < e1.vertex1;
+        }
+        return a < b;
+    });
+
+    for (auto i = 0U; i + 1 < edgeIndex; i++) {
+        const auto &edge0 = _edges[sortedEdges[i]];
+        const auto &edge1 = _edges[sortedEdges[i + 1]];
+        if (edge0.isSame(edge1)) {
+            // update adjacency between outer cells
+            _tetrahedrons[edge0.tetrahedron].neighbours[edge0.index] = edge1.tetrahedron;
+            _tetrahedrons[edge1.tetrahedron].neighbours[edge1.index] = edge0.tetrahedron;
         }
     }
 
@@ -358,13 +623,16 @@ void Delaunay::computeAdjacency() {
 }
 
 void Delaunay::computeMatrices() {
-    for (auto &tetrahedron : _tetrahedrons) {
-        if (tetrahedron.vertex3 >= 0) {
-            computeTetrahedronMatrix(tetrahedron);
-        } else {
-            computeOuterCellMatrix(tetrahedron);
+    forEachChunk(static_cast<uint32_t>(_tetrahedrons.size()), PARALLEL_THRESHOLD, [this](uint32_t begin, uint32_t end) {
+        for (auto i = begin; i < end; i++) {
+            auto &tetrahedron = _tetrahedrons[i];
+            if (tetrahedron.vertex3 >= 0) {
+                computeTetrahedronMatrix(tetrahedron);
+            } else {
+                computeOuterCellMatrix(tetrahedron);
+            }
         }
-    }
+    });
 }
 
 void Delaunay::computeTetrahedronMatrix(Tetrahedron &tetrahedron) {
@@ -442,5 +710,666 @@ void Delaunay::computeOuterCellMatrix(Tetrahedron &tetrahedron) {
     tetrahedron.offset.set(m[9], m[10], m[11]);
 }
 
+void DelaunayMesh::init() {
+    clear();
+    addPoint(Vec3::ZERO);
+    _pointStates[INFINITE_POINT] = POINT_PENDING;
+}
+
+void DelaunayMesh::clear() {
+    _points.clear();
+    _pointStates.clear();
+    _freePoints.clear();
+    _startPoints.clear();
+    _cells.clear();
+    _freeCells.clear();
+    _lastCell = -1;
+}
+
+int32_t DelaunayMesh::addPoint(const Vec3 &position) {
+    if (!_freePoints.empty()) {
+        const auto point = _freePoints.back();
+        _freePoints.pop_back();
+        _points[point] = position;
+        _pointStates[point] = POINT_PENDING;
+        return point;
+    }
+
+    _points.push_back(position);
+    _pointStates.push_back(POINT_PENDING);
+    return static_cast<int32_t>(_points.size()) - 1;
+}
+
+void DelaunayMesh::freePoint(int32_t point) {
+    if (_pointStates[point] == POINT_PENDING) {
+        _startPoints.erase(std::remove(_startPoints.begin(), _startPoints.end(), point), _startPoints.end());
+    }
+    _pointStates[point] = POINT_FREE;
+    _freePoints.push_back(point);
+}
+
+double DelaunayMesh::orient(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) const {
+    const double ax = static_cast<double>(p1.x) - p0.x;
+    const double ay = static_cast<double>(p1.y) - p0.y;
+    const double az = static_cast<double>(p1.z) - p0.z;
+    const double bx = static_cast<double>(p2.x) - p0.x;
+    const double by = static_cast<double>(p2.y) - p0.y;
+    const double bz = static_cast<double>(p2.z) - p0.z;
+    const double cx = static_cast<double>(p3.x) - p0.x;
+    const double cy = static_cast<double>(p3.y) - p0.y;
+    const double cz = static_cast<double>(p3.z) - p0.z;
+
+    return ax * (by * cz - bz * cy) - ay * (bx * cz - bz * cx) + az * (bx * cy - by * cx);
+}
+
+double DelaunayMesh::orient(const Cell &cell, int32_t i, const Vec3 &position) const {
+    const Vec3 *p[4] = {&position, &position, &position, &position};
+    for (auto k = 0; k < 4; k++) {
+        if (k != i) {
+            p[k] = &_points[cell.vertices[k]];
+        }
+    }
+
+    return orient(*p[0], *p[1], *p[2], *p[3]);
+}
+
+bool DelaunayMesh::isValidCell(const ccstd::array<int32_t, 4> &vertices) const {
+    const auto ghost = static_cast<int32_t>(std::find(vertices.begin(), vertices.end(), INFINITE_POINT) - vertices.begin());
+    if (ghost < 4) {
+        // the hull face of a ghost cell must not collapse
+        const auto *face = FACE_VERTICES[ghost];
+        const auto &p0 = _points[vertices[face[0]]];
+        const Vec3 edge1 = _points[vertices[face[1]]] - p0;
+        const Vec3 edge2 = _points[vertices[face[2]]] - p0;
+        Vec3 normal;
+        Vec3::cross(edge1, edge2, &normal);
+        return static_cast<double>(normal.length()) > static_cast<double>(edge1.length()) * edge2.length() * DEGENERATE_EPSILON;
+    }
+
+    const auto &p0 = _points[vertices[0]];
+    const double scale = static_cast<double>(_points[vertices[1]].distance(p0)) * _points[vertices[2]].distance(p0) * _points[vertices[3]].distance(p0);
+    return orient(p0, _points[vertices[1]], _points[vertices[2]], _points[vertices[3]]) > scale * DEGENERATE_EPSILON;
+}
+
+bool DelaunayMesh::isInConflict(const Cell &cell, const Vec3 &position) const {
+    const auto ghost = static_cast<int32_t>(std::find(cell.vertices.begin(), cell.vertices.end(), INFINITE_POINT) - cell.vertices.begin());
+    if (ghost < 4) {
+        // ghost cells conflict with points beyond their hull face, where they are positive
+        const auto *face = FACE_VERTICES[ghost];
+        const auto &p0 = _points[cell.vertices[face[0]]];
+        const auto &p1 = _points[cell.vertices[face[1]]];
+        const auto &p2 = _points[cell.vertices[face[2]]];
+        const double scale = static_cast<double>(p0.distance(position)) * p1.distance(position) * p2.distance(position);
+        const double side = orient(cell, ghost, position);
+        if (side > scale * SPHERE_EPSILON) {
+            return true;
+        }
+        if (side < -scale * SPHERE_EPSILON) {
+            return false;
+        }
+
+        // on the hull plane, in conflict within the face's circumcircle
+        const double u[3] = {static_cast<double>(p1.x) - p0.x, static_cast<double>(p1.y) - p0.y, static_cast<double>(p1.z) - p0.z};
+        const double v[3] = {static_cast<double>(p2.x) - p0.x, static_cast<double>(p2.y) - p0.y, static_cast<double>(p2.z) - p0.z};
+        const double w[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        const double ww = w[0] * w[0] + w[1] * w[1] + w[2] * w[2];
+        if (ww <= 0.0) {
+            return false;
+        }
+
+        const double uu = u[0] * u[0] + u[1] * u[1] + u[2] * u[2];
+        const double vv = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+        const double t[3] = {uu * v[0] - vv * u[0], uu * v[1] - vv * u[1], uu * v[2] - vv * u[2]};
+        const double center[3] = {(t[1] * w[2] - t[2] * w[1]) / (2.0 * ww), (t[2] * w[0] - t[0] * w[2]) / (2.0 * ww), (t[0] * w[1] - t[1] * w[0]) / (2.0 * ww)};
+        const double d[3] = {position.x - p0.x - center[0], position.y - p0.y - center[1], position.z - p0.z - center[2]};
+        const double radiusSquared = center[0] * center[0] + center[1] * center[1] + center[2] * center[2];
+        return d[0] * d[0] + d[1] * d[1] + d[2] * d[2] <= radiusSquared * (1.0 + SPHERE_EPSILON);
+    }
+
+    // insphere determinant relative to the point, negative inside the circumsphere of a positive cell
+    double e[4][3];
+    double lift[4];
+    double maxLift = 0.0;
+    for (auto i = 0; i < 4; i++) {
+        const auto &p = _points[cell.vertices[i]];
+        e[i][0] = static_cast<double>(p.x) - position.x;
+        e[i][1] = static_cast<double>(p.y) - position.y;
+        e[i][2] = static_cast<double>(p.z) - position.z;
+        lift[i] = e[i][0] * e[i][0] + e[i][1] * e[i][1] + e[i][2] * e[i][2];
+        maxLift = std::max(maxLift, lift[i]);
+    }
+
+    const double ab = e[0][0] * e[1][1] - e[1][0] * e[0][1];
+    const double bc = e[1][0] * e[2][1] - e[2][0] * e[1][1];
+    const double cd = e[2][0] * e[3][1] - e[3][0] * e[2][1];
+    const double da = e[3][0] * e[0][1] - e[0][0] * e[3][1];
+    const double ac = e[0][0] * e[2][1] - e[2][0] * e[0][1];
+    const double bd = e[1][0] * e[3][1] - e[3][0] * e[1][1];
+    const double abc = e[0][2] * bc - e[1][2] * ac + e[2][2] * ab;
+    const double bcd = e[1][2] * cd - e[2][2] * bd + e[3][2] * bc;
+    const double cda = e[2][2] * da + e[3][2] * ac + e[0][2] * cd;
+    const double dab = e[3][2] * ab + e[0][2] * bd + e[1][2] * da;
+    const double det = (lift[3] * abc - lift[2] * dab) + (lift[1] * cda - lift[0] * bcd);
+
+    return det <= maxLift * maxLift * std::sqrt(maxLift) * SPHERE_EPSILON;
+}
+
+bool DelaunayMesh::start(int32_t point) {
+    if (std::find(_startPoints.begin(), _startPoints.end(), point) == _startPoints.end()) {
+        _startPoints.push_back(point);
+    }
+
+    // the mesh starts from the first four points spanning a tetrahedron
+    const auto &p0 = _points[_startPoints[0]];
+    ccstd::array<int32_t, 4> vertices{_startPoints[0], -1, -1, -1};
+    for (const auto candidate : _startPoints) {
+        const auto &position = _points[candidate];
+        if (vertices[1] < 0) {
+            if (position != p0) {
+                vertices[1] = candidate;
+            }
+        } else if (vertices[2] < 0) {
+            const Vec3 edge1 = _points[vertices[1]] - p0;
+            const Vec3 edge2 = position - p0;
+            Vec3 normal;
+            Vec3::cross(edge1, edge2, &normal);
+            if (static_cast<double>(normal.length()) > static_cast<double>(edge1.length()) * edge2.length() * DEGENERATE_EPSILON) {
+                vertices[2] = candidate;
+            }
+        } else {
+            auto tetrahedron = vertices;
+            tetrahedron[3] = candidate;
+            if (!isValidCell(tetrahedron)) {
+                std::swap(tetrahedron[2], tetrahedron[3]);
+            }
+            if (isValidCell(tetrahedron)) {
+                vertices = tetrahedron;
+                break;
+            }
+        }
+    }
+
+    if (vertices[3] < 0) {
+        return true;
+    }
+
+    // a tetrahedron closed by four ghost cells, a ghost cell is positive for points beyond its hull face
+    ccstd::array<int32_t, 5> cells{allocateCell(vertices), -1, -1, -1, -1};
+    for (auto i = 0; i < 4; i++) {
+        auto ghostVertices = vertices;
+        ghostVertices[i] = INFINITE_POINT;
+        std::swap(ghostVertices[(i + 1) & 3], ghostVertices[(i + 2) & 3]);
+        cells[i + 1] = allocateCell(ghostVertices);
+    }
+
+    for (const auto cell : cells) {
+        for (auto i = 0; i < 4; i++) {
+            const auto *face = FACE_VERTICES[i];
+            const auto &vertices = _cells[cell].vertices;
+            const FaceKey key(vertices[face[0]], vertices[face[1]], vertices[face[2]]);
+            for (const auto other : cells) {
+                const auto &otherVertices = _cells[other].vertices;
+                for (auto j = 0; j < 4 && other != cell; j++) {
+                    const auto *otherFace = FACE_VERTICES[j];
+                    if (FaceKey(otherVertices[otherFace[0]], otherVertices[otherFace[1]], otherVertices[otherFace[2]]) == key) {
+                        _cells[cell].neighbours[i] = other;
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto vertex : vertices) {
+        _pointStates[vertex] = cells[0];
+    }
+    _lastCell = cells[0];
+
+    ccstd::vector<int32_t> remaining;
+    remaining.swap(_startPoints);
+    for (const auto other : remaining) {
+        if (std::find(vertices.begin(), vertices.end(), other) == vertices.end() && !insert(other)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int32_t DelaunayMesh::locate(const Vec3 &position) const {
+    const auto cellCount = static_cast<int32_t>(_cells.size());
+    auto cell = _lastCell;
+    if (cell < 0 || !_cells[cell].alive) {
+        cell = static_cast<int32_t>(std::find_if(_cells.begin(), _cells.end(), [](const Cell &c) { return c.alive; }) - _cells.begin());
+    }
+
+    // visibility walk, the rotating start face avoids cycling on degenerate configurations
+    for (auto step = 0; step < cellCount && cell < cellCount; step++) {
+        if (_cells[cell].isGhost()) {
+            break;
+        }
+
+        auto next = cell;
+        for (auto k = 0; k < 4; k++) {
+            const auto i = (k + step) & 3;
+            if (orient(_cells[cell], i, position) < 0.0) {
+                next = _cells[cell].neighbours[i];
+                break;
+            }
+        }
+
+        if (next == cell) {
+            break;
+        }
+        cell = next;
+    }
+
+    if (cell < cellCount && isInConflict(_cells[cell], position)) {
+        return cell;
+    }
+
+    for (auto i = 0; i < cellCount; i++) {
+        if (_cells[i].alive && isInConflict(_cells[i], position)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int32_t DelaunayMesh::findCell(int32_t point) const {
+    const auto contains = [point](const Cell &cell) {
+        return cell.alive && std::find(cell.vertices.begin(), cell.vertices.end(), point) != cell.vertices.end();
+    };
+
+    const auto hint = _pointStates[point];
+    if (hint >= 0 && contains(_cells[hint])) {
+        return hint;
+    }
+
+    const auto iter = std::find_if(_cells.begin(), _cells.end(), contains);
+    return iter != _cells.end() ? static_cast<int32_t>(iter - _cells.begin()) : -1;
+}
+
+int32_t DelaunayMesh::allocateCell(const ccstd::array<int32_t, 4> &vertices) {
+    int32_t index = 0;
+    if (!_freeCells.empty()) {
+        index = _freeCells.back();
+        _freeCells.pop_back();
+    } else {
+        index = static_cast<int32_t>(_cells.size());
+        _cells.emplace_back();
+    }
+
+    auto &cell = _cells[index];
+    cell.alive = true;
+    cell.vertices = vertices;
+    cell.neighbours = {-1, -1, -1, -1};
+
+    return index;
+}
+
+void DelaunayMesh::freeCell(int32_t cell) {
+    _cells[cell].alive = false;
+    _freeCells.push_back(cell);
+}
+
+bool DelaunayMesh::insert(int32_t point) {
+    if (_lastCell < 0) {
+        return start(point);
+    }
+
+    const auto &position = _points[point];
+    const auto seed = locate(position);
+    if (seed < 0) {
+        return false;
+    }
+
+    // duplicated points stay out of the mesh, like tetgen drops them
+    float farthest = 0.0F;
+    float nearest = std::numeric_limits<float>::max();
+    for (const auto vertex : _cells[seed].vertices) {
+        if (vertex != INFINITE_POINT) {
+            const auto distance = position.distanceSquared(_points[vertex]);
+            farthest = std::max(farthest, distance);
+            nearest = std::min(nearest, distance);
+        }
+    }
+    if (static_cast<double>(nearest) <= static_cast<double>(farthest) * DUPLICATE_EPSILON * DUPLICATE_EPSILON) {
+        return true;
+    }
+
+    // gather the cavity of all cells in conflict with the point
+    if (++_mark == 0) {
+        std::fill(_cellMarks.begin(), _cellMarks.end(), 0);
+        _mark = 1;
+    }
+    _cellMarks.resize(_cells.size(), 0);
+    _cavity.clear();
+    _cavity.push_back(seed);
+    _cellMarks[seed] = _mark;
+    for (size_t i = 0; i < _cavity.size(); i++) {
+        for (const auto neighbour : _cells[_cavity[i]].neighbours) {
+            if (_cellMarks[neighbour] != _mark && isInConflict(_cells[neighbour], position)) {
+                _cellMarks[neighbour] = _mark;
+                _cavity.push_back(neighbour);
+            }
+        }
+    }
+
+    // every boundary face of the cavity forms a new cell with the point,
+    // all of them are validated before the mesh is touched
+    struct BoundaryFace {
+        ccstd::array<int32_t, 4> vertices;
+        int32_t face;
+        int32_t outside;
+        int32_t outsideFace;
+    };
+    ccstd::vector<BoundaryFace> faces;
+    for (const auto cell : _cavity) {
+        for (auto i = 0; i < 4; i++) {
+            const auto outside = _cells[cell].neighbours[i];
+            if (_cellMarks[outside] == _mark) {
+                continue;
+            }
+
+            auto vertices = _cells[cell].vertices;
+            vertices[i] = point;
+            if (!isValidCell(vertices)) {
+                return false;
+            }
+
+            const auto &neighbours = _cells[outside].neighbours;
+            const auto outsideFace = static_cast<int32_t>(std::find(neighbours.begin(), neighbours.end(), cell) - neighbours.begin());
+            faces.push_back({vertices, i, outside, outsideFace});
+        }
+    }
+
+    // the other three faces of a new cell contain the point, neighbouring new cells share the edge opposite to it
+    ccstd::vector<std::pair<uint64_t, int32_t>> links;
+    links.reserve(faces.size() * 3);
+    for (auto f = 0; f < static_cast<int32_t>(faces.size()); f++) {
+        const auto &face = faces[f];
+        for (auto j = 0; j < 4; j++) {
+            if (j == face.face) {
+                continue;
+            }
+            const auto *edge = FACE_VERTICES[j];
+            const auto v0 = edge[0] == face.face ? edge[2] : edge[0];
+            const auto v1 = edge[1] == face.face ? edge[2] : edge[1];
+            links.emplace_back(edgeKey(face.vertices[v0], face.vertices[v1]), f * 4 + j);
+        }
+    }
+
+    std::sort(links.begin(), links.end());
+    for (size_t i = 0; i < links.size(); i += 2) {
+        if (i + 1 >= links.size() || links[i].first != links[i + 1].first) {
+            return false;
+        }
+    }
+
+    for (const auto cell : _cavity) {
+        freeCell(cell);
+    }
+
+    ccstd::vector<int32_t> cells(faces.size());
+    for (size_t f = 0; f < faces.size(); f++) {
+        const auto &face = faces[f];
+        cells[f] = allocateCell(face.vertices);
+        _cells[cells[f]].neighbours[face.face] = face.outside;
+        _cells[face.outside].neighbours[face.outsideFace] = cells[f];
+    }
+
+    for (size_t i = 0; i < links.size(); i += 2) {
+        const auto first = links[i].second;
+        const auto second = links[i + 1].second;
+        _cells[cells[first / 4]].neighbours[first % 4] = cells[second / 4];
+        _cells[cells[second / 4]].neighbours[second % 4] = cells[first / 4];
+    }
+
+    for (const auto cell : cells) {
+        for (const auto vertex : _cells[cell].vertices) {
+            _pointStates[vertex] = cell;
+        }
+    }
+    _lastCell = cells.back();
+
+    return true;
+}
+
+bool DelaunayMesh::remove(const ccstd::vector<int32_t> &points) {
+    if (++_mark == 0) {
+        std::fill(_cellMarks.begin(), _cellMarks.end(), 0);
+        std::fill(_pointMarks.begin(), _pointMarks.end(), 0);
+        _mark = 1;
+    }
+    _cellMarks.resize(_cells.size(), 0);
+    _pointMarks.resize(_points.size(), 0);
+
+    for (const auto point : points) {
+        _pointMarks[point] = _mark;
+    }
+
+    const auto isRemoved = [this](const Cell &cell) {
+        return std::any_of(cell.vertices.begin(), cell.vertices.end(), [this](int32_t vertex) { return _pointMarks[vertex] == _mark; });
+    };
+
+    // the region to retriangulate is the union of the removed points' stars
+    _cavity.clear();
+    for (const auto point : points) {
+        if (!isInserted(point)) {
+            continue;
+        }
+
+        const auto seed = findCell(point);
+        if (seed < 0) {
+            return false;
+        }
+        if (_cellMarks[seed] == _mark) {
+            continue;
+        }
+
+        auto first = _cavity.size();
+        _cavity.push_back(seed);
+        _cellMarks[seed] = _mark;
+        for (; first < _cavity.size(); first++) {
+            for (const auto neighbour : _cells[_cavity[first]].neighbours) {
+                if (_cellMarks[neighbour] != _mark && isRemoved(_cells[neighbour])) {
+                    _cellMarks[neighbour] = _mark;
+                    _cavity.push_back(neighbour);
+                }
+            }
+        }
+    }
+
+    if (_cavity.empty()) {
+        for (const auto point : points) {
+            freePoint(point);
+        }
+        return true;
+    }
+
+    // remaining vertices and boundary faces of the region
+    struct BoundaryFace {
+        int32_t outside;
+        int32_t outsideFace;
+        int32_t cell;
+        int32_t face;
+    };
+    ccstd::vector<BoundaryFace> faces;
+    ccstd::unordered_map<FaceKey, int32_t, FaceKeyHash> faceIndices;
+    ccstd::vector<int32_t> regionPoints;
+    ccstd::unordered_set<int32_t> regionPointSet;
+    int32_t startCell = -1;
+    int32_t startFace = -1;
+    for (const auto cell : _cavity) {
+        const auto vertices = _cells[cell].vertices;
+        for (auto i = 0; i < 4; i++) {
+            if (vertices[i] != INFINITE_POINT && _pointMarks[vertices[i]] != _mark && regionPointSet.insert(vertices[i]).second) {
+                regionPoints.push_back(vertices[i]);
+            }
+
+            const auto outside = _cells[cell].neighbours[i];
+            if (_cellMarks[outside] == _mark) {
+                continue;
+            }
+
+            // a boundary face of a finite cell tells on which side the region lies
+            if (startCell < 0 && !_cells[cell].isGhost()) {
+                startCell = cell;
+                startFace = i;
+            }
+
+            const auto &neighbours = _cells[outside].neighbours;
+            const auto outsideFace = static_cast<int32_t>(std::find(neighbours.begin(), neighbours.end(), cell) - neighbours.begin());
+            const auto *face = FACE_VERTICES[i];
+            faceIndices.emplace(FaceKey(vertices[face[0]], vertices[face[1]], vertices[face[2]]), static_cast<int32_t>(faces.size()));
+            faces.push_back({outside, outsideFace, -1, -1});
+        }
+    }
+
+    if (startCell < 0) {
+        return false;
+    }
+
+    // triangulate the remaining vertices on their own, the infinite point maps onto itself
+    DelaunayMesh local;
+    local.init();
+    for (const auto point : regionPoints) {
+        local.addPoint(_points[point]);
+    }
+    for (auto i = 1; i < local.getPointCount(); i++) {
+        if (!local.insert(i)) {
+            return false;
+        }
+    }
+    for (auto i = 1; i < local.getPointCount(); i++) {
+        if (!local.isInserted(i)) {
+            return false;
+        }
+    }
+
+    const auto &localCells = local._cells;
+    const auto localCellCount = static_cast<int32_t>(localCells.size());
+    const auto globalPoint = [&regionPoints](int32_t localPoint) {
+        return localPoint == INFINITE_POINT ? INFINITE_POINT : regionPoints[localPoint - 1];
+    };
+    const auto findFace = [&](int32_t cell, int32_t i) {
+        const auto &vertices = localCells[cell].vertices;
+        const auto *face = FACE_VERTICES[i];
+        const auto iter = faceIndices.find(FaceKey(globalPoint(vertices[face[0]]), globalPoint(vertices[face[1]]), globalPoint(vertices[face[2]])));
+        return iter != faceIndices.end() ? iter->second : -1;
+    };
+
+    // locate the start face in the local triangulation and pick the side of its finite cell
+    const auto &startVertices = _cells[startCell].vertices;
+    const auto *startTriangle = FACE_VERTICES[startFace];
+    const FaceKey startKey(startVertices[startTriangle[0]], startVertices[startTriangle[1]], startVertices[startTriangle[2]]);
+    const auto &s0 = _points[startVertices[startTriangle[0]]];
+    const auto &s1 = _points[startVertices[startTriangle[1]]];
+    const auto &s2 = _points[startVertices[startTriangle[2]]];
+    const bool regionSide = orient(s0, s1, s2, _points[startVertices[startFace]]) > 0.0;
+
+    ccstd::vector<int8_t> inside(localCellCount, -1);
+    ccstd::vector<int32_t> queue;
+    for (auto cell = 0; cell < localCellCount && queue.empty(); cell++) {
+        if (!localCells[cell].alive || localCells[cell].isGhost()) {
+            continue;
+        }
+        for (auto i = 0; i < 4; i++) {
+            const auto &vertices = localCells[cell].vertices;
+            const auto *face = FACE_VERTICES[i];
+            if (FaceKey(globalPoint(vertices[face[0]]), globalPoint(vertices[face[1]]), globalPoint(vertices[face[2]])) == startKey) {
+                inside[cell] = (orient(s0, s1, s2, local._points[vertices[i]]) > 0.0) == regionSide ? 1 : 0;
+                queue.push_back(cell);
+                break;
+            }
+        }
+    }
+
+    if (queue.empty()) {
+        return false;
+    }
+
+    // the boundary faces split the local triangulation into the region and the rest, flip sides on every one
+    for (size_t q = 0; q < queue.size(); q++) {
+        const auto cell = queue[q];
+        for (auto i = 0; i < 4; i++) {
+            const auto neighbour = localCells[cell].neighbours[i];
+            const int8_t side = findFace(cell, i) >= 0 ? 1 - inside[cell] : inside[cell];
+            if (inside[neighbour] < 0) {
+                inside[neighbour] = side;
+                queue.push_back(neighbour);
+            } else if (inside[neighbour] != side) {
+                return false;
+            }
+        }
+    }
+
+    for (auto cell = 0; cell < localCellCount; cell++) {
+        if (inside[cell] != 1) {
+            continue;
+        }
+
+        for (auto i = 0; i < 4; i++) {
+            if (inside[localCells[cell].neighbours[i]] == 1) {
+                continue;
+            }
+
+            const auto face = findFace(cell, i);
+            if (face < 0 || faces[face].cell >= 0) {
+                return false;
+            }
+            faces[face].cell = cell;
+            faces[face].face = i;
+        }
+    }
+
+    if (std::any_of(faces.begin(), faces.end(), [](const BoundaryFace &face) { return face.cell < 0; })) {
+        return false;
+    }
+
+    // replace the region by the inner local cells
+    for (const auto cell : _cavity) {
+        freeCell(cell);
+    }
+
+    ccstd::vector<int32_t> cells(localCellCount, -1);
+    for (auto cell = 0; cell < localCellCount; cell++) {
+        if (inside[cell] == 1) {
+            const auto &vertices = localCells[cell].vertices;
+            cells[cell] = allocateCell({globalPoint(vertices[0]), globalPoint(vertices[1]), globalPoint(vertices[2]), globalPoint(vertices[3])});
+        }
+    }
+
+    for (auto cell = 0; cell < localCellCount; cell++) {
+        if (cells[cell] < 0) {
+            continue;
+        }
+
+        for (auto i = 0; i < 4; i++) {
+            const auto neighbour = cells[localCells[cell].neighbours[i]];
+            if (neighbour >= 0) {
+                _cells[cells[cell]].neighbours[i] = neighbour;
+            }
+        }
+        for (const auto vertex : _cells[cells[cell]].vertices) {
+            _pointStates[vertex] = cells[cell];
+        }
+        _lastCell = cells[cell];
+    }
+
+    for (const auto &face : faces) {
+        const auto cell = cells[face.cell];
+        _cells[cell].neighbours[face.face] = face.outside;
+        _cells[face.outside].neighbours[face.outsideFace] = cell;
+    }
+
+    for (const auto point : points) {
+        freePoint(point);
+    }
+
+    return true;
+}
+
 } // namespace gi
 } // namespace cc
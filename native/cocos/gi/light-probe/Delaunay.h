@@ -214,13 +214,97 @@ struct Tetrahedron {
     }
 };
 
+/**
+ * Bowyer-Watson tetrahedralization with face adjacency, kept alive between incremental updates.
+ * Hull faces are closed by ghost cells sharing the symbolic INFINITE_POINT, so the mesh always covers
+ * the exact convex hull and points may be inserted anywhere.
+ */
+class DelaunayMesh {
+public:
+    struct Cell {
+        bool alive{false};
+        ccstd::array<int32_t, 4> vertices{-1, -1, -1, -1};
+        ccstd::array<int32_t, 4> neighbours{-1, -1, -1, -1}; // across the face opposite to vertices[i]
+
+        inline bool isGhost() const {
+            return vertices[0] == INFINITE_POINT || vertices[1] == INFINITE_POINT ||
+                   vertices[2] == INFINITE_POINT || vertices[3] == INFINITE_POINT;
+        }
+    };
+
+    static constexpr int32_t INFINITE_POINT = 0;
+
+    DelaunayMesh() = default;
+    ~DelaunayMesh() = default;
+
+    void init();
+    void clear();
+
+    int32_t addPoint(const Vec3 &position);
+    void freePoint(int32_t point);
+
+    // false if the cavity can't be retriangulated, duplicated points stay out of the mesh
+    bool insert(int32_t point);
+    bool remove(const ccstd::vector<int32_t> &points);
+
+    inline bool empty() const { return _points.empty(); }
+    inline int32_t getPointCount() const { return static_cast<int32_t>(_points.size()); }
+    inline const Vec3 &getPosition(int32_t point) const { return _points[point]; }
+    inline bool isFree(int32_t point) const { return _pointStates[point] == POINT_FREE; }
+    inline bool isInserted(int32_t point) const { return _pointStates[point] >= 0; }
+    inline const ccstd::vector<Cell> &getCells() const { return _cells; }
+
+private:
+    static constexpr int32_t POINT_FREE = -2;
+    static constexpr int32_t POINT_PENDING = -1;
+
+    double orient(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) const;
+    double orient(const Cell &cell, int32_t i, const Vec3 &position) const;
+    bool isValidCell(const ccstd::array<int32_t, 4> &vertices) const;
+    bool isInConflict(const Cell &cell, const Vec3 &position) const;
+    bool start(int32_t point);
+    int32_t locate(const Vec3 &position) const;
+    int32_t findCell(int32_t point) const;
+    int32_t allocateCell(const ccstd::array<int32_t, 4> &vertices);
+    void freeCell(int32_t cell);
+
+    ccstd::vector<Vec3> _points;
+    ccstd::vector<int32_t> _pointStates; // a cell containing the point, or POINT_FREE / POINT_PENDING
+    ccstd::vector<int32_t> _freePoints;
+    ccstd::vector<int32_t> _startPoints; // pending until four of them span a tetrahedron
+    ccstd::vector<Cell> _cells;
+    ccstd::vector<int32_t> _freeCells;
+    int32_t _lastCell{-1};
+
+    // scratch, reused by every insertion and removal
+    ccstd::vector<uint32_t> _cellMarks;
+    ccstd::vector<uint32_t> _pointMarks;
+    uint32_t _mark{0};
+    ccstd::vector<int32_t> _cavity;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(DelaunayMesh);
+};
+
 class Delaunay {
 public:
+    enum class UpdateResult {
+        INCREMENTAL, // only the cavities around changed probes were re-tetrahedralized
+        REBUILT,     // too many probes changed, the kept mesh was rebuilt from scratch
+        FALLBACK,    // the kept mesh could not be updated, build() was used instead
+    };
+
     explicit Delaunay(ccstd::vector<Vertex> &probes) : _probes(probes) {}
     ~Delaunay() = default;
 
     ccstd::vector<Tetrahedron> build();
 
+    /**
+     * incremental build, the triangulation is kept between calls and only the cavities around
+     * added, removed or moved probes are re-tetrahedralized, falls back to build() when that is not possible
+     */
+    ccstd::vector<Tetrahedron> update();
+    inline UpdateResult getLastUpdateResult() const { return _lastUpdateResult; }
+
 private:
     void reset();
     void tetrahedralize(); // Bowyer-Watson algorithm
@@ -234,11 +318,22 @@ private:
     void computeTetrahedronMatrix(Tetrahedron &tetrahedron);
     void computeOuterCellMatrix(Tetrahedron &tetrahedron);
 
+    bool updateMesh();
+    bool rebuildMesh();
+    void collectTetrahedrons();
+
     ccstd::vector<Vertex> &_probes;
     ccstd::vector<Tetrahedron> _tetrahedrons;
 
     ccstd::vector<Triangle> _triangles;
     ccstd::vector<Edge> _edges;
+    ccstd::vector<uint32_t> _bucketOffsets;
+    ccstd::vector<uint32_t> _bucketCursors;
+    ccstd::vector<std::pair<uint64_t, uint32_t>> _bucketTriangles; // remaining two vertices and index of triangles grouped by their smallest vertex
+
+    DelaunayMesh _mesh;
+    ccstd::vector<int32_t> _meshProbes; // probe index of every mesh point, -1 if none
+    UpdateResult _lastUpdateResult{UpdateResult::REBUILT};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Delaunay);
     friend class Tetrahedron;
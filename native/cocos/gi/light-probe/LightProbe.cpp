@@ -24,6 +24,8 @@
 ****************************************************************************/
 
 #include "LightProbe.h"
+#include <algorithm>
+#include <cmath>
 #include "PolynomialSolver.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
@@ -35,6 +37,16 @@
 namespace cc {
 namespace gi {
 
+namespace {
+constexpr int32_t MAX_GRID_SIZE = 64;
+constexpr float GRID_CONTAIN_EPSILON = -1e-4F;
+
+inline bool isInside(const Vec4 &weights) {
+    return weights.x >= GRID_CONTAIN_EPSILON && weights.y >= GRID_CONTAIN_EPSILON &&
+           weights.z >= GRID_CONTAIN_EPSILON && weights.w >= GRID_CONTAIN_EPSILON;
+}
+} // namespace
+
 void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
     _probes.clear();
 
@@ -45,9 +57,158 @@ void LightProbesData::updateProbes(ccstd::vector<Vec3> &points) {
     }
 }
 
-void LightProbesData::updateTetrahedrons() {
-    Delaunay delaunay(_probes);
-    _tetrahedrons = delaunay.build();
+void LightProbesData::updateTetrahedrons(bool incremental /* = false*/) {
+    if (!incremental) {
+        _delaunay.reset();
+        Delaunay delaunay(_probes);
+        _tetrahedrons = delaunay.build();
+        _tetrahedronUpdateStats.fullBuilds++;
+    } else {
+        if (!_delaunay) {
+            _delaunay = std::make_unique<Delaunay>(_probes);
+        }
+        _tetrahedrons = _delaunay->update();
+        switch (_delaunay->getLastUpdateResult()) {
+            case Delaunay::UpdateResult::INCREMENTAL:
+                _tetrahedronUpdateStats.incrementalUpdates++;
+                break;
+            case Delaunay::UpdateResult::REBUILT:
+                _tetrahedronUpdateStats.meshRebuilds++;
+                break;
+            case Delaunay::UpdateResult::FALLBACK:
+                _tetrahedronUpdateStats.fallbacks++;
+                break;
+        }
+    }
+
+    updateSpatialIndex();
+}
+
+void LightProbesData::updateSpatialIndex() {
+    _gridCells.clear();
+    _gridTetrahedronCount = 0;
+    if (empty()) {
+        return;
+    }
+
+    size_t innerCount = 0;
+    for (const auto &tetrahedron : _tetrahedrons) {
+        innerCount += tetrahedron.isInnerTetrahedron() ? 1 : 0;
+    }
+    if (innerCount == 0) {
+        return;
+    }
+
+    Vec3 minPos{INFINITY, INFINITY, INFINITY};
+    Vec3 maxPos{-INFINITY, -INFINITY, -INFINITY};
+    for (const auto &probe : _probes) {
+        minPos.set(std::min(minPos.x, probe.position.x), std::min(minPos.y, probe.position.y), std::min(minPos.z, probe.position.z));
+        maxPos.set(std::max(maxPos.x, probe.position.x), std::max(maxPos.y, probe.position.y), std::max(maxPos.z, probe.position.z));
+    }
+
+    // about one cell per tetrahedron, flat probe layouts still get a few cells on the thin axis
+    Vec3 extent = maxPos - minPos;
+    const float minExtent = std::max(std::max(extent.x, std::max(extent.y, extent.z)) * 0.01F, static_cast<float>(mathutils::EPSILON));
+    extent.set(std::max(extent.x, minExtent), std::max(extent.y, minExtent), std::max(extent.z, minExtent));
+    const auto cellCount = static_cast<float>(std::min<size_t>(innerCount, MAX_GRID_SIZE * MAX_GRID_SIZE * MAX_GRID_SIZE));
+    const float cellSize = std::cbrt(extent.x * extent.y * extent.z / cellCount);
+    const float extents[3] = {extent.x, extent.y, extent.z};
+    for (auto i = 0; i < 3; i++) {
+        _gridSize[i] = std::min(std::max(static_cast<int32_t>(std::ceil(extents[i] / cellSize)), 1), MAX_GRID_SIZE);
+    }
+    _gridMin = minPos;
+    _gridInvCellSize.set(static_cast<float>(_gridSize[0]) / extent.x, static_cast<float>(_gridSize[1]) / extent.y, static_cast<float>(_gridSize[2]) / extent.z);
+
+    const Vec3 cellExtent{extent.x / static_cast<float>(_gridSize[0]), extent.y / static_cast<float>(_gridSize[1]), extent.z / static_cast<float>(_gridSize[2])};
+    const auto strideY = _gridSize[0];
+    const auto strideZ = _gridSize[0] * _gridSize[1];
+    _gridCells.assign(static_cast<size_t>(strideZ) * _gridSize[2], -1);
+    ccstd::vector<bool> contained(_gridCells.size(), false);
+
+    // rasterize the bounds of every inner tetrahedron, preferring the one containing the cell center
+    Vec4 weights;
+    const auto tetrahedronCount = static_cast<int32_t>(_tetrahedrons.size());
+    for (auto t = 0; t < tetrahedronCount; t++) {
+        const auto &tetrahedron = _tetrahedrons[t];
+        if (!tetrahedron.isInnerTetrahedron()) {
+            continue;
+        }
+
+        int32_t lo[3] = {MAX_GRID_SIZE, MAX_GRID_SIZE, MAX_GRID_SIZE};
+        int32_t hi[3] = {-1, -1, -1};
+        for (const auto vertex : {tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3}) {
+            const Vec3 local = _probes[vertex].position - _gridMin;
+            const float coords[3] = {local.x * _gridInvCellSize.x, local.y * _gridInvCellSize.y, local.z * _gridInvCellSize.z};
+            for (auto i = 0; i < 3; i++) {
+                const auto cell = std::min(std::max(static_cast<int32_t>(coords[i]), 0), _gridSize[i] - 1);
+                lo[i] = std::min(lo[i], cell);
+                hi[i] = std::max(hi[i], cell);
+            }
+        }
+
+        for (auto z = lo[2]; z <= hi[2]; z++) {
+            for (auto y = lo[1]; y <= hi[1]; y++) {
+                for (auto x = lo[0]; x <= hi[0]; x++) {
+                    const auto index = x + y * strideY + z * strideZ;
+                    if (contained[index]) {
+                        continue;
+                    }
+
+                    const Vec3 center{_gridMin.x + (static_cast<float>(x) + 0.5F) * cellExtent.x,
+                                      _gridMin.y + (static_cast<float>(y) + 0.5F) * cellExtent.y,
+                                      _gridMin.z + (static_cast<float>(z) + 0.5F) * cellExtent.z};
+                    getTetrahedronBarycentricCoord(center, tetrahedron, weights);
+                    if (isInside(weights)) {
+                        _gridCells[index] = t;
+                        contained[index] = true;
+                    } else if (_gridCells[index] < 0) {
+                        _gridCells[index] = t;
+                    }
+                }
+            }
+        }
+    }
+
+    // cells outside of the probes' hull inherit a seed from their neighbours
+    ccstd::vector<int32_t> queue;
+    queue.reserve(_gridCells.size());
+    for (size_t i = 0; i < _gridCells.size(); i++) {
+        if (_gridCells[i] >= 0) {
+            queue.push_back(static_cast<int32_t>(i));
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        const auto index = queue[head];
+        const int32_t x = index % strideY;
+        const int32_t y = (index / strideY) % _gridSize[1];
+        const int32_t z = index / strideZ;
+        const int32_t neighbours[6][2] = {{x - 1, index - 1}, {_gridSize[0] - 2 - x, index + 1},
+                                          {y - 1, index - strideY}, {_gridSize[1] - 2 - y, index + strideY},
+                                          {z - 1, index - strideZ}, {_gridSize[2] - 2 - z, index + strideZ}};
+        for (const auto &neighbour : neighbours) {
+            if (neighbour[0] >= 0 && _gridCells[neighbour[1]] < 0) {
+                _gridCells[neighbour[1]] = _gridCells[index];
+                queue.push_back(neighbour[1]);
+            }
+        }
+    }
+
+    _gridTetrahedronCount = _tetrahedrons.size();
+}
+
+int32_t LightProbesData::getSeedTetrahedron(const Vec3 &position) const {
+    if (_gridCells.empty() || _gridTetrahedronCount != _tetrahedrons.size()) {
+        return -1;
+    }
+
+    const Vec3 local = position - _gridMin;
+    const float coords[3] = {local.x * _gridInvCellSize.x, local.y * _gridInvCellSize.y, local.z * _gridInvCellSize.z};
+    int32_t cell[3];
+    for (auto i = 0; i < 3; i++) {
+        cell[i] = static_cast<int32_t>(std::min(std::max(coords[i], 0.0F), static_cast<float>(_gridSize[i] - 1)));
+    }
+
+    return _gridCells[cell[0] + (cell[1] + cell[2] * _gridSize[1]) * _gridSize[0]];
 }
 
 bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const {
@@ -55,8 +216,29 @@ bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec
         return false;
     }
 
+    coefficients.resize(SH::getBasisCount());
+    interpolateSHCoefficients(tetIndex, weights, coefficients.data());
+
+    return true;
+}
+
+bool LightProbesData::evaluateSHCoefficients(const Vec3 *positions, int32_t *tetIndices, Vec3 *coefficients, uint32_t count) const {
+    if (!hasCoefficients()) {
+        return false;
+    }
+
+    const auto length = SH::getBasisCount();
+    Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
+    for (uint32_t i = 0; i < count; i++) {
+        tetIndices[i] = getInterpolationWeights(positions[i], tetIndices[i], weights);
+        interpolateSHCoefficients(tetIndices[i], weights, coefficients + i * length);
+    }
+
+    return true;
+}
+
+void LightProbesData::interpolateSHCoefficients(int32_t tetIndex, const Vec4 &weights, Vec3 *coefficients) const {
     const auto length = SH::getBasisCount();
-    coefficients.resize(length);
 
     const auto &tetrahedron = _tetrahedrons[tetIndex];
     const auto &c0 = _probes[tetrahedron.vertex0].coefficients;
@@ -74,13 +256,23 @@ bool LightProbesData::getInterpolationSHCoefficients(int32_t tetIndex, const Vec
             coefficients[i] = c0[i] * weights.x + c1[i] * weights.y + c2[i] * weights.z;
         }
     }
-
-    return true;
 }
 
 int32_t LightProbesData::getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const {
     const auto tetrahedronCount = _tetrahedrons.size();
-    if (tetIndex < 0 || tetIndex >= tetrahedronCount) {
+    if (tetIndex >= 0 && static_cast<size_t>(tetIndex) < tetrahedronCount) {
+        // coherent movement mostly stays inside the cached tetrahedron
+        getBarycentricCoord(position, _tetrahedrons[tetIndex], weights);
+        if (weights.x >= 0.0F && weights.y >= 0.0F && weights.z >= 0.0F && weights.w >= 0.0F) {
+            return tetIndex;
+        }
+    }
+
+    // otherwise start walking from the grid cell to keep the walk short
+    const auto seedIndex = getSeedTetrahedron(position);
+    if (seedIndex >= 0 && static_cast<size_t>(seedIndex) < tetrahedronCount) {
+        tetIndex = seedIndex;
+    } else if (tetIndex < 0 || static_cast<size_t>(tetIndex) >= tetrahedronCount) {
         tetIndex = 0;
     }
 
@@ -269,7 +461,7 @@ void LightProbeInfo::syncData(Node *node, const ccstd::vector<Vec3> &probes) {
     }
 }
 
-void LightProbeInfo::update(bool updateTet) {
+void LightProbeInfo::update(bool updateTet, bool incremental) {
     if (!_data) {
         _data = new LightProbesData();
         if (_resource) {
@@ -300,7 +492,7 @@ void LightProbeInfo::update(bool updateTet) {
 
     if (updateTet) {
         resetAllTetraIndices();
-        _data->updateTetrahedrons();
+        _data->updateTetrahedrons(incremental);
     }
 }
 
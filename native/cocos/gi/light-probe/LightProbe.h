@@ -25,11 +25,13 @@
 
 #pragma once
 
+#include <memory>
 #include "Delaunay.h"
 #include "SH.h"
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/std/container/array.h"
 #include "base/std/container/vector.h"
 #include "math/Vec3.h"
 #include "math/Vec4.h"
@@ -42,33 +44,79 @@ namespace gi {
 
 class LightProbeInfo;
 
+// how the tetrahedrons of a LightProbesData were updated so far
+struct TetrahedronUpdateStats {
+    uint32_t fullBuilds{0};
+    uint32_t incrementalUpdates{0};
+    uint32_t meshRebuilds{0};
+    uint32_t fallbacks{0}; // incremental updates that failed and were built from scratch
+};
+
 class LightProbesData : public RefCounted {
 public:
     LightProbesData() = default;
 
     inline ccstd::vector<Vertex> &getProbes() { return _probes; }
-    inline void setProbes(const ccstd::vector<Vertex> &probes) { _probes = probes; }
+    inline void setProbes(const ccstd::vector<Vertex> &probes) {
+        _probes = probes;
+        updateSpatialIndex();
+    }
     inline ccstd::vector<Tetrahedron> &getTetrahedrons() { return _tetrahedrons; }
-    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) { _tetrahedrons = tetrahedrons; }
+    inline void setTetrahedrons(const ccstd::vector<Tetrahedron> &tetrahedrons) {
+        _tetrahedrons = tetrahedrons;
+        updateSpatialIndex();
+    }
 
     inline bool empty() const { return _probes.empty() || _tetrahedrons.empty(); }
     inline void reset() {
         _probes.clear();
         _tetrahedrons.clear();
+        _delaunay.reset();
+        updateSpatialIndex();
     }
     void updateProbes(ccstd::vector<Vec3> &points);
-    void updateTetrahedrons();
+
+    /**
+     * incremental keeps the triangulation alive between calls and only re-tetrahedralizes around
+     * added, removed or moved probes, otherwise everything is rebuilt
+     */
+    void updateTetrahedrons(bool incremental = false);
+    inline const TetrahedronUpdateStats &getTetrahedronUpdateStats() const { return _tetrahedronUpdateStats; }
+
+    /**
+     * rebuild the grid seeding tetrahedron lookups, needed after probes or tetrahedrons are modified in place
+     */
+    void updateSpatialIndex();
 
     inline bool hasCoefficients() const { return !empty() && !_probes[0].coefficients.empty(); }
     bool getInterpolationSHCoefficients(int32_t tetIndex, const Vec4 &weights, ccstd::vector<Vec3> &coefficients) const;
     int32_t getInterpolationWeights(const Vec3 &position, int32_t tetIndex, Vec4 &weights) const;
 
+    /**
+     * evaluate SH coefficients at count positions without allocation,
+     * tetIndices holds the cached tetrahedron index of each position and is updated in place,
+     * coefficients receives SH_BASIS_COUNT entries per position
+     */
+    bool evaluateSHCoefficients(const Vec3 *positions, int32_t *tetIndices, Vec3 *coefficients, uint32_t count) const;
+
 private:
+    void interpolateSHCoefficients(int32_t tetIndex, const Vec4 &weights, Vec3 *coefficients) const;
+    int32_t getSeedTetrahedron(const Vec3 &position) const;
     static Vec3 getTriangleBarycentricCoord(const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &position);
     void getBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getTetrahedronBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
     void getOuterCellBarycentricCoord(const Vec3 &position, const Tetrahedron &tetrahedron, Vec4 &weights) const;
 
+    // uniform grid over the probes, every cell holds a tetrahedron near its center
+    Vec3 _gridMin;
+    Vec3 _gridInvCellSize;
+    ccstd::array<int32_t, 3> _gridSize{0, 0, 0};
+    ccstd::vector<int32_t> _gridCells;
+    size_t _gridTetrahedronCount{0};
+
+    std::unique_ptr<Delaunay> _delaunay;
+    TetrahedronUpdateStats _tetrahedronUpdateStats;
+
 public:
     ccstd::vector<Vertex> _probes;
     ccstd::vector<Tetrahedron> _tetrahedrons;
@@ -148,7 +196,7 @@ public:
     bool addNode(Node *node);
     bool removeNode(Node *node);
     void syncData(Node *node, const ccstd::vector<Vec3> &probes);
-    void update(bool updateTet = true);
+    void update(bool updateTet = true, bool incremental = false);
 
     inline void setGIScale(float val) {
         if (_giScale == val) {
@@ -87,7 +87,7 @@ ccstd::vector<float> SH::basisOverPI = {
     0.173884F,  // 0.546274 / Math.PI
 };
 
-void SH::updateUBOData(Float32Array& data, int32_t offset, ccstd::vector<Vec3>& coefficients) {
+void SH::updateUBOData(Float32Array& data, int32_t offset, const Vec3* coefficients) {
     // cc_sh_linear_const_r
     data[offset++] = coefficients[3].x * basisOverPI[3];
     data[offset++] = coefficients[1].x * basisOverPI[1];
@@ -27,6 +27,10 @@
 
 #include <curl/curl.h>
 #include <string.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <thread>
 
 #include "application/ApplicationManager.h"
@@ -51,6 +55,11 @@
 namespace cc {
 namespace network {
 
+// curl hands over at most this many bytes per write callback, they go to the file without being copied
+static const long RECEIVE_BUFFER_SIZE = 64 * 1024;
+// the rest of a large file after the first range is split in at most this many parallel requests
+static const uint32_t MAX_RANGE_REQUESTS_PER_TASK = 8;
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Implementation DownloadTaskCURL
 
@@ -138,6 +147,9 @@ public:
                 _errCodeInternal = 0;
                 _errDescription = "Can't open file:";
                 _errDescription.append(_tempFileName);
+            } else {
+                // the receive buffer of curl is large, writing it through another buffer only adds a copy
+                setvbuf(_fp, nullptr, _IONBF, 0);
             }
             ret = true;
         } while (0);
@@ -157,6 +169,28 @@ public:
         _errDescription = desc;
     }
 
+    // range requests of one task may fail one after another, the first failure is the one reported
+    void setFirstErrorProc(int code, int codeInternal, const char *desc) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (DownloadTask::ERROR_NO_ERROR == _errCode) {
+            _errCode = code;
+            _errCodeInternal = codeInternal;
+            _errDescription = desc;
+        }
+    }
+
+    // the temp file is written at the offsets of the ranges from now on instead of appended
+    bool openForRangesProc() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _fp = freopen(FileUtils::getInstance()->getSuitableFOpen(_tempFileName).c_str(), "r+b", _fp);
+        if (nullptr == _fp) {
+            return false;
+        }
+        setvbuf(_fp, nullptr, _IONBF, 0);
+        _ranged = true;
+        return true;
+    }
+
     size_t writeDataProc(unsigned char *buffer, size_t size, size_t count) {
         std::lock_guard<std::mutex> lock(_mutex);
         size_t ret = 0;
@@ -178,6 +212,16 @@ public:
         return ret;
     }
 
+    size_t writeRangeDataProc(FILE *fp, unsigned char *buffer, size_t size, size_t count) {
+        size_t ret = fwrite(buffer, size, count, fp);
+        if (ret) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _bytesReceived += ret;
+            _totalBytesReceived += ret;
+        }
+        return ret;
+    }
+
 private:
     friend class DownloaderCURL;
 
@@ -206,6 +250,15 @@ private:
     ccstd::vector<unsigned char> _buf;
     FILE *_fp;
 
+    // only used in thread proc
+    CURL *_curlHandle;
+    uint32_t _rangeEnd;         // end of the first range request, 0 if the whole file is requested
+    uint32_t _rangeSplitTotal;  // file size reported for the first range, the remaining ranges are not requested yet
+    uint32_t _pendingRanges;
+    bool _contentDone;
+    // the temp file is written at range offsets, it has holes until every range finished
+    bool _ranged;
+
     void _initInternal() {
         _acceptRanges = (false);
         _headerAchieved = (false);
@@ -216,6 +269,12 @@ private:
         _errCodeInternal = (CURLE_OK);
         _header.resize(0);
         _header.reserve(384); // pre alloc header string buffer
+        _curlHandle = nullptr;
+        _rangeEnd = 0;
+        _rangeSplitTotal = 0;
+        _pendingRanges = 0;
+        _contentDone = false;
+        _ranged = false;
     }
 };
 int DownloadTaskCURL::_sSerialId;
@@ -223,6 +282,12 @@ ccstd::set<ccstd::string> DownloadTaskCURL::_sStoragePathSet;
 
 typedef std::pair<std::shared_ptr<const DownloadTask>, DownloadTaskCURL *> TaskWrapper;
 
+// one of the parallel range requests of a file task
+struct RangeRequestCURL {
+    TaskWrapper wrapper;
+    FILE *fp;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Implementation DownloaderCURL::Impl
 // This class shared by DownloaderCURL and work thread.
@@ -237,6 +302,9 @@ public:
     }
 
     ~Impl() {
+        if (_curlmHandle) {
+            curl_multi_cleanup(_curlmHandle);
+        }
         DLLOG("Destruct DownloaderCURL::Impl %p %d", this, _thread.joinable());
     }
 
@@ -300,6 +368,56 @@ private:
         return coTask->writeDataProc((unsigned char *)buffer, size, count);
     }
 
+    static size_t _outputRangeDataCallbackProc(void *buffer, size_t size, size_t count, void *userdata) {
+        RangeRequestCURL *range = (RangeRequestCURL *)userdata;
+        return range->wrapper.second->writeRangeDataProc(range->fp, (unsigned char *)buffer, size, count);
+    }
+
+    // header callback of a content request which was not preceded by a header request
+    static size_t _contentHeaderCallbackProc(char *buffer, size_t size, size_t count, void *userdata) {
+        size_t len = size * count;
+        DownloadTaskCURL &coTask = *((DownloadTaskCURL *)(userdata));
+        // a redirect is followed by the header block of another response
+        if (len >= 5 && 0 == strncmp(buffer, "HTTP/", 5)) {
+            coTask._header.resize(0);
+        }
+        coTask._header.append(buffer, len);
+        if (len <= 2 && (buffer[0] == '\r' || buffer[0] == '\n')) {
+            _onContentHeadersProc(coTask);
+        }
+        return len;
+    }
+
+    static void _onContentHeadersProc(DownloadTaskCURL &coTask) {
+        long httpResponseCode = 0;
+        curl_easy_getinfo(coTask._curlHandle, CURLINFO_RESPONSE_CODE, &httpResponseCode);
+        uint32_t totalBytesExpected = 0;
+        if (206 == httpResponseCode) {
+            // Content-Range: bytes 0-1048575/5242880, header names are lower case on HTTP/2
+            ccstd::string header = coTask._header;
+            std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+            size_t found = header.find("content-range:");
+            if (ccstd::string::npos != found) {
+                found = header.find('/', found);
+            }
+            if (ccstd::string::npos != found) {
+                totalBytesExpected = static_cast<uint32_t>(strtoul(header.c_str() + found + 1, nullptr, 10));
+            }
+            if (totalBytesExpected > coTask._rangeEnd + 1) {
+                coTask._rangeSplitTotal = totalBytesExpected;
+            }
+        } else if (200 == httpResponseCode) {
+            double contentLen = 0;
+            if (CURLE_OK == curl_easy_getinfo(coTask._curlHandle, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &contentLen) && contentLen > 0) {
+                totalBytesExpected = static_cast<uint32_t>(contentLen);
+            }
+        } else {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(coTask._mutex);
+        coTask._totalBytesExpected = totalBytesExpected;
+    }
+
     // this function designed call in work thread
     // the curl handle destroyed in _threadProc
     // handle inited for get header
@@ -325,6 +443,13 @@ private:
 
         curl_easy_setopt(handle, CURLOPT_FAILONERROR, true);
         curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(handle, CURLOPT_BUFFERSIZE, RECEIVE_BUFFER_SIZE);
+
+        if (hints.useHttp2) {
+            // wait for a connection to multiplex on instead of opening another one
+            curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        }
 
         if (forContent) {
             /** if server acceptRanges and local has part of file, we continue to download **/
@@ -360,6 +485,86 @@ private:
         }
     }
 
+    // only a partly downloaded file needs the header request, it tells whether the server can resume it
+    bool _needHeaderRequestProc(const DownloadTaskCURL &coTask) {
+        return coTask._fp && FileUtils::getInstance()->getFileSize(coTask._tempFileName) > 0;
+    }
+
+    // handle inited for download content without a header request
+    bool _initContentCurlHandleProc(CURL *handle, TaskWrapper &wrapper) {
+        DownloadTaskCURL &coTask = *wrapper.second;
+        _initCurlHandleProc(handle, wrapper, true);
+        curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, DownloaderCURL::Impl::_contentHeaderCallbackProc);
+        curl_easy_setopt(handle, CURLOPT_HEADERDATA, &coTask);
+
+        // the first range tells the file size, the rest is requested in parallel once it is known
+        if (hints.rangeChunkSize && coTask._fp) {
+            if (!coTask.openForRangesProc()) {
+                coTask.setErrorProc(DownloadTask::ERROR_FILE_OP_FAILED, 0, "Can't reopen file for range requests.");
+                return false;
+            }
+            coTask._rangeEnd = hints.rangeChunkSize - 1;
+            char range[32] = {0};
+            snprintf(range, sizeof(range), "0-%u", coTask._rangeEnd);
+            curl_easy_setopt(handle, CURLOPT_RANGE, range);
+        }
+        std::lock_guard<std::mutex> lock(coTask._mutex);
+        coTask._headerAchieved = true;
+        return true;
+    }
+
+    void _addRangeRequestsProc(TaskWrapper &wrapper, ccstd::unordered_map<CURL *, RangeRequestCURL> &rangeMap) {
+        DownloadTaskCURL &coTask = *wrapper.second;
+        const uint32_t begin = coTask._rangeEnd + 1;
+        const uint32_t total = coTask._rangeSplitTotal;
+        coTask._rangeSplitTotal = 0;
+
+        const uint32_t rest = total - begin;
+        uint32_t count = (rest + hints.rangeChunkSize - 1) / hints.rangeChunkSize;
+        count = std::min(count, MAX_RANGE_REQUESTS_PER_TASK);
+        const uint32_t rangeSize = (rest + count - 1) / count;
+        for (uint32_t offset = begin; offset < total; offset += rangeSize) {
+            const uint32_t last = std::min(offset + rangeSize, total) - 1;
+            FILE *fp = fopen(FileUtils::getInstance()->getSuitableFOpen(coTask._tempFileName).c_str(), "r+b");
+            if (nullptr == fp || 0 != fseek(fp, static_cast<long>(offset), SEEK_SET)) {
+                if (fp) {
+                    fclose(fp);
+                }
+                coTask.setFirstErrorProc(DownloadTask::ERROR_FILE_OP_FAILED, 0, "Can't open file for range request.");
+                return;
+            }
+            setvbuf(fp, nullptr, _IONBF, 0);
+
+            CURL *curlHandle = curl_easy_init();
+            if (nullptr == curlHandle) {
+                fclose(fp);
+                coTask.setFirstErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, 0, "Alloc curl handle failed.");
+                return;
+            }
+            // the map owns the range request, its address is stable for the write callback
+            RangeRequestCURL &range = rangeMap[curlHandle];
+            range.wrapper = wrapper;
+            range.fp = fp;
+
+            _initCurlHandleProc(curlHandle, wrapper, true);
+            curl_easy_setopt(curlHandle, CURLOPT_WRITEFUNCTION, DownloaderCURL::Impl::_outputRangeDataCallbackProc);
+            curl_easy_setopt(curlHandle, CURLOPT_WRITEDATA, &range);
+            char rangeStr[32] = {0};
+            snprintf(rangeStr, sizeof(rangeStr), "%u-%u", offset, last);
+            curl_easy_setopt(curlHandle, CURLOPT_RANGE, rangeStr);
+
+            CURLMcode mcode = curl_multi_add_handle(_curlmHandle, curlHandle);
+            if (CURLM_OK != mcode) {
+                fclose(fp);
+                rangeMap.erase(curlHandle);
+                curl_easy_cleanup(curlHandle);
+                coTask.setFirstErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
+                return;
+            }
+            ++coTask._pendingRanges;
+        }
+    }
+
     // get header info, if success set handle to content download state
     bool _getHeaderInfoProc(CURL *handle, TaskWrapper &wrapper) {
         DownloadTaskCURL &coTask = *wrapper.second;
@@ -408,18 +613,49 @@ private:
         return coTask._headerAchieved;
     }
 
+    // the task is finished once its content request and all of its range requests are
+    void _finishTaskProc(ccstd::unordered_map<CURL *, TaskWrapper> &coTaskMap, TaskWrapper wrapper) {
+        CURL *curlHandle = wrapper.second->_curlHandle;
+        curl_easy_cleanup(curlHandle);
+        wrapper.second->_curlHandle = nullptr;
+        DLLOG("    _threadProc task clean cur handle :%p", curlHandle);
+
+        // remove from coTaskMap
+        coTaskMap.erase(curlHandle);
+
+        // remove from _processSet
+        {
+            std::lock_guard<std::mutex> lock(_processMutex);
+            if (_processSet.end() != _processSet.find(wrapper)) {
+                _processSet.erase(wrapper);
+            }
+        }
+
+        // add to finishedQueue
+        {
+            std::lock_guard<std::mutex> lock(_finishedMutex);
+            _finishedQueue.push_back(wrapper);
+        }
+    }
+
     void _threadProc() {
         DLLOG("++++DownloaderCURL::Impl::_threadProc begin %p", this);
         // the holder prevent DownloaderCURL::Impl class instance be destruct in main thread
         auto holder = this->shared_from_this();
         auto thisThreadId = std::this_thread::get_id();
         uint32_t countOfMaxProcessingTasks = this->hints.countOfMaxProcessingTasks;
-        // init curl content
-        CURLM *curlmHandle = curl_multi_init();
+        // the multi handle outlives the thread, so the connections it keeps are reused by the next tasks
+        if (nullptr == _curlmHandle) {
+            _curlmHandle = curl_multi_init();
+            curl_multi_setopt(_curlmHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            curl_multi_setopt(_curlmHandle, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(hints.countOfMaxConnectionsPerHost));
+        }
+        CURLM *curlmHandle = _curlmHandle;
+        // the content requests, they stay here until their range requests finished as well
         ccstd::unordered_map<CURL *, TaskWrapper> coTaskMap;
+        ccstd::unordered_map<CURL *, RangeRequestCURL> rangeMap;
         int runningHandles = 0;
         CURLMcode mcode = CURLM_OK;
-        int rc = 0; // select return code
 
         do {
             // check the thread should exit or not
@@ -436,40 +672,19 @@ private:
                 long timeoutMS = -1;
                 curl_multi_timeout(curlmHandle, &timeoutMS);
 
-                if (timeoutMS < 0) {
-                    timeoutMS = 1000;
+                // wake up often enough to pick up new requests
+                if (timeoutMS < 0 || timeoutMS > CC_CURL_POLL_TIMEOUT_MS) {
+                    timeoutMS = CC_CURL_POLL_TIMEOUT_MS;
                 }
 
-                /* get file descriptors from the transfers */
-                fd_set fdread;
-                fd_set fdwrite;
-                fd_set fdexcep;
-                int maxfd = -1;
-
-                FD_ZERO(&fdread);
-                FD_ZERO(&fdwrite);
-                FD_ZERO(&fdexcep);
-
-                mcode = curl_multi_fdset(curlmHandle, &fdread, &fdwrite, &fdexcep, &maxfd);
+                int numfds = 0;
+                mcode = curl_multi_wait(curlmHandle, nullptr, 0, static_cast<int>(timeoutMS), &numfds);
                 if (CURLM_OK != mcode) {
                     break;
                 }
-
-                // do wait action
-                if (maxfd == -1) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(CC_CURL_POLL_TIMEOUT_MS));
-                    rc = 0;
-                } else {
-                    struct timeval timeout;
-
-                    timeout.tv_sec = timeoutMS / 1000;
-                    timeout.tv_usec = (timeoutMS % 1000) * 1000;
-
-                    rc = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
-                }
-
-                if (rc < 0) {
-                    DLLOG("    _threadProc: select return unexpect code: %d", rc);
+                // nothing to wait on, curl is e.g. resolving a host name
+                if (0 == numfds && timeoutMS > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(std::min(timeoutMS, 10L)));
                 }
             }
 
@@ -482,6 +697,13 @@ private:
                     break;
                 }
 
+                // the first range of these tasks reported the file size
+                for (auto &item : coTaskMap) {
+                    if (item.second.second->_rangeSplitTotal) {
+                        _addRangeRequestsProc(item.second, rangeMap);
+                    }
+                }
+
                 struct CURLMsg *m;
                 do {
                     int msgq = 0;
@@ -490,19 +712,44 @@ private:
                         CURL *curlHandle = m->easy_handle;
                         CURLcode errCode = m->data.result;
 
-                        TaskWrapper wrapper = coTaskMap[curlHandle];
-
                         // remove from multi-handle
                         curl_multi_remove_handle(curlmHandle, curlHandle);
+
+                        auto rangeIter = rangeMap.find(curlHandle);
+                        if (rangeMap.end() != rangeIter) {
+                            TaskWrapper wrapper = rangeIter->second.wrapper;
+                            fclose(rangeIter->second.fp);
+                            rangeMap.erase(rangeIter);
+                            curl_easy_cleanup(curlHandle);
+
+                            DownloadTaskCURL &coTask = *wrapper.second;
+                            if (CURLE_OK != errCode) {
+                                coTask.setFirstErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, curl_easy_strerror(errCode));
+                            }
+                            if (0 == --coTask._pendingRanges && coTask._contentDone) {
+                                _finishTaskProc(coTaskMap, wrapper);
+                            }
+                            continue;
+                        }
+
+                        TaskWrapper wrapper = coTaskMap[curlHandle];
+                        DownloadTaskCURL &coTask = *wrapper.second;
+
                         bool reinited = false;
                         do {
                             if (CURLE_OK != errCode) {
-                                wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, curl_easy_strerror(errCode));
+                                // an empty file can't satisfy the first range request
+                                long httpResponseCode = 0;
+                                curl_easy_getinfo(curlHandle, CURLINFO_RESPONSE_CODE, &httpResponseCode);
+                                if (coTask._rangeEnd && 416 == httpResponseCode) {
+                                    break;
+                                }
+                                coTask.setFirstErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, curl_easy_strerror(errCode));
                                 break;
                             }
 
                             // if the task is content download task, cleanup the handle
-                            if (wrapper.second->_headerAchieved) {
+                            if (coTask._headerAchieved) {
                                 break;
                             }
 
@@ -516,8 +763,8 @@ private:
                             // after get header info success
                             // wrapper.second->_totalBytesReceived inited by local file size
                             // if the local file size equal with the content size from header, the file has downloaded finish
-                            if (wrapper.second->_totalBytesReceived &&
-                                wrapper.second->_totalBytesReceived == wrapper.second->_totalBytesExpected) {
+                            if (coTask._totalBytesReceived &&
+                                coTask._totalBytesReceived == coTask._totalBytesExpected) {
                                 // the file has download complete
                                 // break to move this task to finish queue
                                 break;
@@ -527,7 +774,7 @@ private:
                             _initCurlHandleProc(curlHandle, wrapper, true);
                             mcode = curl_multi_add_handle(curlmHandle, curlHandle);
                             if (CURLM_OK != mcode) {
-                                wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
+                                coTask.setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
                                 break;
                             }
                             reinited = true;
@@ -536,24 +783,9 @@ private:
                         if (reinited) {
                             continue;
                         }
-                        curl_easy_cleanup(curlHandle);
-                        DLLOG("    _threadProc task clean cur handle :%p with errCode:%d", curlHandle, errCode);
-
-                        // remove from coTaskMap
-                        coTaskMap.erase(curlHandle);
-
-                        // remove from _processSet
-                        {
-                            std::lock_guard<std::mutex> lock(_processMutex);
-                            if (_processSet.end() != _processSet.find(wrapper)) {
-                                _processSet.erase(wrapper);
-                            }
-                        }
-
-                        // add to finishedQueue
-                        {
-                            std::lock_guard<std::mutex> lock(_finishedMutex);
-                            _finishedQueue.push_back(wrapper);
+                        coTask._contentDone = true;
+                        if (0 == coTask._pendingRanges) {
+                            _finishTaskProc(coTaskMap, wrapper);
                         }
                     }
                 } while (m);
@@ -588,13 +820,22 @@ private:
                     _finishedQueue.push_back(wrapper);
                     continue;
                 }
+                wrapper.second->_curlHandle = curlHandle;
 
-                // init curl handle for get header info
-                _initCurlHandleProc(curlHandle, wrapper);
+                if (_needHeaderRequestProc(*wrapper.second)) {
+                    // init curl handle for get header info
+                    _initCurlHandleProc(curlHandle, wrapper);
+                } else if (!_initContentCurlHandleProc(curlHandle, wrapper)) {
+                    curl_easy_cleanup(curlHandle);
+                    std::lock_guard<std::mutex> lock(_finishedMutex);
+                    _finishedQueue.push_back(wrapper);
+                    continue;
+                }
 
                 // add curl handle to process list
                 mcode = curl_multi_add_handle(curlmHandle, curlHandle);
                 if (CURLM_OK != mcode) {
+                    curl_easy_cleanup(curlHandle);
                     wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, mcode, curl_multi_strerror(mcode));
                     std::lock_guard<std::mutex> lock(_finishedMutex);
                     _finishedQueue.push_back(wrapper);
@@ -603,17 +844,28 @@ private:
 
                 DLLOG("    _threadProc task create curl handle:%p", curlHandle);
                 coTaskMap[curlHandle] = wrapper;
+                ++size;
                 std::lock_guard<std::mutex> lock(_processMutex);
                 _processSet.insert(wrapper);
             }
         } while (coTaskMap.size());
 
-        curl_multi_cleanup(curlmHandle);
+        // only left over when the downloader is destroyed while downloading
+        for (auto &item : rangeMap) {
+            curl_multi_remove_handle(curlmHandle, item.first);
+            curl_easy_cleanup(item.first);
+            fclose(item.second.fp);
+        }
+        for (auto &item : coTaskMap) {
+            curl_multi_remove_handle(curlmHandle, item.first);
+            curl_easy_cleanup(item.first);
+        }
         this->stop();
         DLLOG("----DownloaderCURL::Impl::_threadProc end");
     }
 
     std::thread _thread;
+    CURLM *_curlmHandle{nullptr};
     ccstd::deque<TaskWrapper> _requestQueue;
     ccstd::set<TaskWrapper> _processSet;
     ccstd::deque<TaskWrapper> _finishedQueue;
@@ -744,6 +996,12 @@ void DownloaderCURL::onSchedule(float) {
                     break;
                 }
 
+                // a failed range download has holes, it must neither become the file nor be resumed
+                if (coTask._ranged && DownloadTask::ERROR_NO_ERROR != coTask._errCode) {
+                    FileUtils::getInstance()->removeFile(coTask._tempFileName);
+                    break;
+                }
+
                 auto util = FileUtils::getInstance();
                 // if file already exist, remove it
                 if (util->isFileExist(coTask._fileName)) {
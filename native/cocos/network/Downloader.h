@@ -65,6 +65,13 @@ struct CC_DLL DownloaderHints {
     uint32_t countOfMaxProcessingTasks{6};
     uint32_t timeoutInSeconds{45};
     ccstd::string tempFileNameSuffix{".tmp"};
+    // connections opened to one host, 0 means no limit. Tasks beyond it wait for a free connection,
+    // or share one when the server speaks HTTP/2.
+    uint32_t countOfMaxConnectionsPerHost{6};
+    // file tasks larger than this are downloaded in parallel range requests, 0 downloads every file in one request
+    uint32_t rangeChunkSize{0};
+    // negotiate HTTP/2 on https urls so that the tasks to one host are multiplexed over a single connection
+    bool useHttp2{true};
 };
 
 class CC_DLL Downloader final {
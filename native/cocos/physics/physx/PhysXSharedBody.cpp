@@ -199,6 +199,8 @@ void PhysXSharedBody::initDynamicActor() {
         PxPhysics &phy = PxGetPhysics();
         _mDynamicActor = phy.createRigidDynamic(transform);
         _mDynamicActor->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, isKinematic());
+        // PhysXWorld::syncPhysicsToScene maps active actors back to their bodies
+        _mDynamicActor->userData = this;
     }
 }
 
@@ -23,6 +23,11 @@
 ****************************************************************************/
 
 #include "physics/physx/PhysXWorld.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include "base/Log.h"
+#include "base/job-system/ForEachChunk.h"
 #include "base/memory/Memory.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
@@ -38,6 +43,85 @@
 namespace cc {
 namespace physics {
 
+namespace {
+// below this count the batch queries run on the calling thread, scene queries are expensive enough to split small batches
+constexpr uint32_t PARALLEL_QUERY_THRESHOLD = 32;
+
+bool checkBatchDesc(const BatchQueryDesc &desc, uint32_t queryStride) {
+    if (desc.queryCount == 0) return false;
+    if (!desc.isValid(queryStride)) {
+        CC_LOG_ERROR("Batch query buffers are too small for %u queries.", desc.queryCount);
+        return false;
+    }
+    return true;
+}
+
+physx::PxSceneQueryFilterData batchFilterData(const BatchQueryDesc &desc) {
+    physx::PxSceneQueryFilterData filterData;
+    filterData.data.word0 = desc.mask;
+    filterData.data.word3 = QUERY_FILTER | (desc.queryTrigger ? 0 : QUERY_CHECK_TRIGGER) | QUERY_SINGLE_HIT;
+    filterData.flags = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+    return filterData;
+}
+
+// returns whether a hit was written, a miss or an unknown shape leaves shape id 0
+bool writeBatchHit(float *out, bool blocked, const physx::PxLocationHit &hit) {
+    uint32_t shape = 0;
+    if (blocked) {
+        const auto &shapeMap = getPxShapeMap();
+        const auto &shapeIter = shapeMap.find(reinterpret_cast<uintptr_t>(hit.shape));
+        if (shapeIter != shapeMap.end()) shape = shapeIter->second;
+    }
+    memcpy(out, &shape, sizeof(shape));
+    if (shape == 0) return false;
+    out[1] = hit.distance;
+    out[2] = hit.position.x;
+    out[3] = hit.position.y;
+    out[4] = hit.position.z;
+    out[5] = hit.normal.x;
+    out[6] = hit.normal.y;
+    out[7] = hit.normal.z;
+    return true;
+}
+} // namespace
+
+// The scene keeps the dispatcher it was created with,
+// this one forwards to a default dispatcher which can be recreated with another worker count.
+class PhysXWorld::CpuDispatcher final : public physx::PxCpuDispatcher {
+public:
+    explicit CpuDispatcher(uint32_t workerCount) {
+        setWorkerCount(workerCount);
+        applyWorkerCount();
+    }
+    ~CpuDispatcher() override {
+        PX_RELEASE(_dispatcher);
+    }
+
+    void submitTask(physx::PxBaseTask &task) override {
+        _dispatcher->submitTask(task);
+    }
+    uint32_t getWorkerCount() const override {
+        return _dispatcher->getWorkerCount();
+    }
+
+    // the change is applied by applyWorkerCount, tasks of a running simulation may still use the current dispatcher
+    void setWorkerCount(uint32_t workerCount) {
+        _workerCount = workerCount;
+    }
+    uint32_t getRequestedWorkerCount() const { return _workerCount; }
+
+    // must not be called while the scene is simulating
+    void applyWorkerCount() {
+        if (_dispatcher && _dispatcher->getWorkerCount() == _workerCount) return;
+        PX_RELEASE(_dispatcher);
+        _dispatcher = physx::PxDefaultCpuDispatcherCreate(_workerCount);
+    }
+
+private:
+    physx::PxDefaultCpuDispatcher *_dispatcher{nullptr};
+    uint32_t _workerCount{0};
+};
+
 PhysXWorld *PhysXWorld::instance = nullptr;
 uint32_t PhysXWorld::_msWrapperObjectID = 1; // starts from 1 because 0 means null
 uint32_t PhysXWorld::_msPXObjectID = 0;
@@ -78,7 +162,7 @@ PhysXWorld::PhysXWorld() {
 #endif
     _mPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *_mFoundation, scale, true, pvd);
     PxInitExtensions(*_mPhysics, pvd);
-    _mDispatcher = physx::PxDefaultCpuDispatcherCreate(0);
+    _mDispatcher = ccnew CpuDispatcher(0);
 
     _mEventMgr = ccnew PhysXEventManager();
 
@@ -88,6 +172,8 @@ PhysXWorld::PhysXWorld() {
     sceneDesc.kineKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.staticKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
     sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD;
+    // syncPhysicsToScene only visits the actors moved by the simulation
+    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_ACTIVE_ACTORS;
     sceneDesc.filterShader = simpleFilterShader;
     sceneDesc.simulationEventCallback = &_mEventMgr->getEventCallback();
     _mScene = _mPhysics->createScene(sceneDesc);
@@ -109,7 +195,8 @@ PhysXWorld::~PhysXWorld() {
     PhysXJoint::releaseTempRigidActor();
     PX_RELEASE(_mControllerManager);
     PX_RELEASE(_mScene);
-    PX_RELEASE(_mDispatcher);
+    delete _mDispatcher;
+    _mDispatcher = nullptr;
     PX_RELEASE(_mPhysics);
 #ifdef CC_DEBUG
     physx::PxPvdTransport *transport = _mPvd->getTransport();
@@ -126,6 +213,8 @@ PhysXWorld::~PhysXWorld() {
 void PhysXWorld::step(float fixedTimeStep) {
     _mScene->simulate(fixedTimeStep);
     _mScene->fetchResults(true);
+    // no simulation task is in flight until the next simulate
+    _mDispatcher->applyWorkerCount();
     syncPhysicsToScene();
 #if CC_USE_GEOMETRY_RENDERER
     debugDraw();
@@ -134,7 +223,10 @@ void PhysXWorld::step(float fixedTimeStep) {
 
 #if CC_USE_GEOMETRY_RENDERER
 pipeline::GeometryRenderer* PhysXWorld::getDebugRenderer () {
-    auto cameras = Root::getInstance()->getMainWindow()->getCameras();
+    // the world can step without a renderer, e.g. in the unit tests
+    auto *root = Root::getInstance();
+    if (!root || !root->getMainWindow()) return nullptr;
+    auto cameras = root->getMainWindow()->getCameras();
     scene::Camera* camera = nullptr;
     for (int c = 0; c < cameras.size(); c++) {
         if (!cameras[c])
@@ -330,6 +422,14 @@ void PhysXWorld::emitEvents() {
     _mEventMgr->refreshPairs();
 }
 
+void PhysXWorld::setWorkerThreadCount(uint32_t count) {
+    _mDispatcher->setWorkerCount(count);
+}
+
+uint32_t PhysXWorld::getWorkerThreadCount() const {
+    return _mDispatcher->getRequestedWorkerCount();
+}
+
 void PhysXWorld::syncSceneToPhysics() {
     for (auto const &sb : _mSharedBodies) {
         sb->syncSceneToPhysics();
@@ -345,8 +445,13 @@ uint32_t PhysXWorld::getMaskByIndex(uint32_t i) {
 }
 
 void PhysXWorld::syncPhysicsToScene() {
-    for (auto const &sb : _mSharedBodies) {
-        sb->syncPhysicsToScene();
+    // dynamic actors of shared bodies carry the body in userData, character controllers do not
+    physx::PxU32 count = 0;
+    physx::PxActor **actors = _mScene->getActiveActors(count);
+    for (physx::PxU32 i = 0; i < count; ++i) {
+        if (auto *sb = static_cast<PhysXSharedBody *>(actors[i]->userData)) {
+            sb->syncPhysicsToScene();
+        }
     }
 }
 
@@ -573,6 +678,72 @@ RaycastResult &PhysXWorld::sweepClosestResult() {
     return hit;
 }
 
+// Batched queries only read the scene, which PhysX allows from several threads while it is not simulating.
+// Every chunk keeps its hit on its own stack and writes disjoint ranges of the result buffer.
+uint32_t PhysXWorld::raycastClosestBatch(BatchQueryDesc &desc) {
+    if (!checkBatchDesc(desc, BatchQueryDesc::RAY_STRIDE)) return 0;
+    const auto *queries = static_cast<const float *>(desc.queries);
+    auto *results = static_cast<float *>(desc.results);
+    const auto filterData = batchFilterData(desc);
+    const physx::PxHitFlags flags = physx::PxHitFlag::ePOSITION | physx::PxHitFlag::eNORMAL;
+    std::atomic<uint32_t> hitCount{0};
+    forEachChunk(desc.queryCount, PARALLEL_QUERY_THRESHOLD, [&](uint32_t begin, uint32_t end) {
+        uint32_t chunkHits = 0;
+        physx::PxRaycastHit hit;
+        for (uint32_t i = begin; i < end; ++i) {
+            const float *q = queries + i * BatchQueryDesc::RAY_STRIDE;
+            physx::PxVec3 unitDir{q[3], q[4], q[5]};
+            unitDir.normalize();
+            const bool blocked = physx::PxSceneQueryExt::raycastSingle(
+                getScene(), physx::PxVec3{q[0], q[1], q[2]}, unitDir, q[6], flags,
+                hit, filterData, &getQueryFilterShader(), nullptr);
+            chunkHits += writeBatchHit(results + i * BatchQueryDesc::RESULT_STRIDE, blocked, hit);
+        }
+        hitCount.fetch_add(chunkHits, std::memory_order_relaxed);
+    });
+    return hitCount.load(std::memory_order_relaxed);
+}
+
+uint32_t PhysXWorld::sweepClosestBatch(BatchQueryDesc &desc, const physx::PxGeometry &geometry, const physx::PxQuat &localOrientation) {
+    if (!checkBatchDesc(desc, BatchQueryDesc::SWEEP_STRIDE)) return 0;
+    const auto *queries = static_cast<const float *>(desc.queries);
+    auto *results = static_cast<float *>(desc.results);
+    const auto filterData = batchFilterData(desc);
+    const physx::PxHitFlags flags = physx::PxHitFlag::ePOSITION | physx::PxHitFlag::eNORMAL;
+    std::atomic<uint32_t> hitCount{0};
+    forEachChunk(desc.queryCount, PARALLEL_QUERY_THRESHOLD, [&](uint32_t begin, uint32_t end) {
+        uint32_t chunkHits = 0;
+        physx::PxSweepHit hit;
+        for (uint32_t i = begin; i < end; ++i) {
+            const float *q = queries + i * BatchQueryDesc::SWEEP_STRIDE;
+            physx::PxVec3 unitDir{q[3], q[4], q[5]};
+            unitDir.normalize();
+            const physx::PxTransform pose{physx::PxVec3{q[0], q[1], q[2]},
+                                          physx::PxQuat(q[8], q[9], q[10], q[7]) * localOrientation};
+            const bool blocked = physx::PxSceneQueryExt::sweepSingle(
+                getScene(), geometry, pose, unitDir, q[6], flags,
+                hit, filterData, &getQueryFilterShader(), nullptr, 0);
+            chunkHits += writeBatchHit(results + i * BatchQueryDesc::RESULT_STRIDE, blocked, hit);
+        }
+        hitCount.fetch_add(chunkHits, std::memory_order_relaxed);
+    });
+    return hitCount.load(std::memory_order_relaxed);
+}
+
+uint32_t PhysXWorld::sweepBoxClosestBatch(BatchQueryDesc &desc, float halfExtentX, float halfExtentY, float halfExtentZ) {
+    return sweepClosestBatch(desc, physx::PxBoxGeometry{halfExtentX, halfExtentY, halfExtentZ}, physx::PxQuat(physx::PxIdentity));
+}
+
+uint32_t PhysXWorld::sweepSphereClosestBatch(BatchQueryDesc &desc, float radius) {
+    return sweepClosestBatch(desc, physx::PxSphereGeometry{radius}, physx::PxQuat(physx::PxIdentity));
+}
+
+uint32_t PhysXWorld::sweepCapsuleClosestBatch(BatchQueryDesc &desc, float radius, float height) {
+    //add an extra 90 degree rotation to PxCapsuleGeometry whose axis is originally along the X axis
+    return sweepClosestBatch(desc, physx::PxCapsuleGeometry{radius, height / 2.F},
+                             physx::PxQuat(physx::PxPiDivTwo, physx::PxVec3{0.F, 0.F, 1.F}));
+}
+
 uint32_t PhysXWorld::addPXObject(uintptr_t PXObjectPtr) {
     uint32_t pxObjectID = _msPXObjectID;
     _msPXObjectID++;
@@ -74,6 +74,11 @@ public:
                              float orientationW, float orientationX, float orientationY, float orientationZ) override;
     ccstd::vector<RaycastResult> &sweepResult() override;
     RaycastResult &sweepClosestResult() override;
+    uint32_t raycastClosestBatch(BatchQueryDesc &desc) override;
+    uint32_t sweepClosestBatch(BatchQueryDesc &desc, const physx::PxGeometry &geometry, const physx::PxQuat &localOrientation);
+    uint32_t sweepBoxClosestBatch(BatchQueryDesc &desc, float halfExtentX, float halfExtentY, float halfExtentZ) override;
+    uint32_t sweepSphereClosestBatch(BatchQueryDesc &desc, float radius) override;
+    uint32_t sweepCapsuleClosestBatch(BatchQueryDesc &desc, float radius, float height) override;
 
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
@@ -125,6 +130,10 @@ public:
     float getFixedTimeStep() const override { return _fixedTimeStep; }
     void setFixedTimeStep(float fixedTimeStep) override { _fixedTimeStep = fixedTimeStep; }
 
+    // 0 runs the simulation tasks on the thread calling step, a new count takes effect after the current step
+    void setWorkerThreadCount(uint32_t count) override;
+    uint32_t getWorkerThreadCount() const override;
+
 #if CC_USE_GEOMETRY_RENDERER
     void setDebugDrawFlags(EPhysicsDrawFlags flags) override;
     EPhysicsDrawFlags getDebugDrawFlags() override;
@@ -144,6 +153,8 @@ private:
     float getDebugDrawConstraintSize() override { return 0.0; };
 #endif
 private:
+    class CpuDispatcher;
+
     static PhysXWorld *instance;
     physx::PxFoundation *_mFoundation;
     physx::PxCooking *_mCooking;
@@ -153,7 +164,7 @@ private:
 #ifdef CC_DEBUG
     physx::PxPvd *_mPvd;
 #endif
-    physx::PxDefaultCpuDispatcher *_mDispatcher;
+    CpuDispatcher *_mDispatcher;
     physx::PxScene *_mScene;
     PhysXEventManager *_mEventMgr;
     uint32_t _mCollisionMatrix[31] = {0};
@@ -142,6 +142,14 @@ void World::setFixedTimeStep(float fixedTimeStep) {
     _impl->setFixedTimeStep(fixedTimeStep);
 }
 
+void World::setWorkerThreadCount(uint32_t count) {
+    _impl->setWorkerThreadCount(count);
+}
+
+uint32_t World::getWorkerThreadCount() const {
+    return _impl->getWorkerThreadCount();
+}
+
 bool World::sweepBox(RaycastOptions &opt, float halfExtentX, float halfExtentY, float halfExtentZ,
         float orientationW, float orientationX, float orientationY, float orientationZ){
     return _impl->sweepBox(opt, halfExtentX, halfExtentY, halfExtentZ, orientationW, orientationX, orientationY, orientationZ);
@@ -178,5 +186,21 @@ ccstd::vector<RaycastResult> &World::sweepResult() {
     return _impl->sweepResult();
 }
 
+uint32_t World::raycastClosestBatch(BatchQueryDesc &desc) {
+    return _impl->raycastClosestBatch(desc);
+}
+
+uint32_t World::sweepBoxClosestBatch(BatchQueryDesc &desc, float halfExtentX, float halfExtentY, float halfExtentZ) {
+    return _impl->sweepBoxClosestBatch(desc, halfExtentX, halfExtentY, halfExtentZ);
+}
+
+uint32_t World::sweepSphereClosestBatch(BatchQueryDesc &desc, float radius) {
+    return _impl->sweepSphereClosestBatch(desc, radius);
+}
+
+uint32_t World::sweepCapsuleClosestBatch(BatchQueryDesc &desc, float radius, float height) {
+    return _impl->sweepCapsuleClosestBatch(desc, radius, height);
+}
+
 } // namespace physics
 } // namespace cc
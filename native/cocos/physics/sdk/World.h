@@ -65,6 +65,10 @@ public:
         float orientationW, float orientationX, float orientationY, float orientationZ) override;
     RaycastResult &sweepClosestResult() override;
     ccstd::vector<RaycastResult> &sweepResult() override;
+    uint32_t raycastClosestBatch(BatchQueryDesc &desc) override;
+    uint32_t sweepBoxClosestBatch(BatchQueryDesc &desc, float halfExtentX, float halfExtentY, float halfExtentZ) override;
+    uint32_t sweepSphereClosestBatch(BatchQueryDesc &desc, float radius) override;
+    uint32_t sweepCapsuleClosestBatch(BatchQueryDesc &desc, float radius, float height) override;
 
     uint32_t createConvex(ConvexDesc &desc) override;
     uint32_t createTrimesh(TrimeshDesc &desc) override;
@@ -73,6 +77,8 @@ public:
                         uint8_t m0, uint8_t m1) override;
     float getFixedTimeStep() const override;
     void setFixedTimeStep(float fixedTimeStep) override;
+    void setWorkerThreadCount(uint32_t count) override;
+    uint32_t getWorkerThreadCount() const override;
 
     void destroy() override;
 
@@ -141,6 +141,33 @@ struct RaycastResult {
     RaycastResult() = default;
 };
 
+/**
+ * Batched closest-hit scene queries. `queries` and `results` point into typed arrays owned by the caller.
+ * Each ray is RAY_STRIDE floats: origin xyz, unit direction xyz, distance.
+ * Each sweep is SWEEP_STRIDE floats: the ray layout followed by the orientation wxyz.
+ * Each result is RESULT_STRIDE floats: shape id (uint32 bits, 0 for no hit), distance, hit point xyz, hit normal xyz.
+ */
+struct BatchQueryDesc {
+    static constexpr uint32_t RAY_STRIDE = 7;
+    static constexpr uint32_t SWEEP_STRIDE = 11;
+    static constexpr uint32_t RESULT_STRIDE = 8;
+
+    void *queries{nullptr};
+    uint32_t queryLength{0}; // in floats
+    uint32_t queryCount{0};
+    void *results{nullptr};
+    uint32_t resultLength{0}; // in floats
+    uint32_t mask{0};
+    bool queryTrigger{false};
+
+    // whether both buffers hold queryCount entries, queryStride is RAY_STRIDE or SWEEP_STRIDE
+    inline bool isValid(uint32_t queryStride) const {
+        return queryCount > 0 && queries && results &&
+               static_cast<uint64_t>(queryLength) >= static_cast<uint64_t>(queryCount) * queryStride &&
+               static_cast<uint64_t>(resultLength) >= static_cast<uint64_t>(queryCount) * RESULT_STRIDE;
+    }
+};
+
 class IPhysicsWorld {
 public:
     virtual ~IPhysicsWorld() = default;
@@ -177,6 +204,10 @@ public:
         float orientationW, float orientationX, float orientationY, float orientationZ) = 0;
     virtual RaycastResult &sweepClosestResult() = 0;
     virtual ccstd::vector<RaycastResult> &sweepResult() = 0;
+    virtual uint32_t raycastClosestBatch(BatchQueryDesc &desc) = 0;
+    virtual uint32_t sweepBoxClosestBatch(BatchQueryDesc &desc, float halfExtentX, float halfExtentY, float halfExtentZ) = 0;
+    virtual uint32_t sweepSphereClosestBatch(BatchQueryDesc &desc, float radius) = 0;
+    virtual uint32_t sweepCapsuleClosestBatch(BatchQueryDesc &desc, float radius, float height) = 0;
     virtual uint32_t createConvex(ConvexDesc &desc) = 0;
     virtual uint32_t createTrimesh(TrimeshDesc &desc) = 0;
     virtual uint32_t createHeightField(HeightFieldDesc &desc) = 0;
@@ -184,6 +215,8 @@ public:
                                 uint8_t m0, uint8_t m1) = 0;
     virtual void setFixedTimeStep(float v) = 0;
     virtual float getFixedTimeStep() const = 0;
+    virtual void setWorkerThreadCount(uint32_t count) = 0;
+    virtual uint32_t getWorkerThreadCount() const = 0;
 };
 
 } // namespace physics
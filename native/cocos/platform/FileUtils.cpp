@@ -38,10 +38,17 @@
 #endif
 #include <sys/stat.h>
 #include <regex>
+#if (CC_PLATFORM != CC_PLATFORM_WINDOWS)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 #include "base/Data.h"
 #include "base/Log.h"
+#include "base/job-system/ForEachChunk.h"
 #include "base/memory/Memory.h"
+#include "base/std/container/unordered_set.h"
 #include "platform/SAXParser.h"
 
 #include "tinydir/tinydir.h"
@@ -489,8 +496,60 @@ void FileUtils::setDelegate(FileUtils *delegate) {
     FileUtils::sharedFileUtils = delegate;
 }
 
+struct SearchPathManifest {
+    ccstd::vector<ccstd::string> searchPaths;
+    // whether the search path with the same index could be enumerated
+    ccstd::vector<uint8_t> indexed;
+    // normalized search paths the indexed files are relative to
+    ccstd::vector<ccstd::string> roots;
+    // files under each indexed search path, relative to it
+    ccstd::vector<ccstd::unordered_set<ccstd::string>> files;
+    // directories under each indexed search path, relative to it and without the trailing '/'
+    ccstd::vector<ccstd::unordered_set<ccstd::string>> directories;
+};
+
+namespace {
+constexpr uint32_t MIN_FILES_PER_RESOLVE_JOB = 32;
+
+// the manifest keeps plain relative paths only, anything else is resolved on the file system
+bool isIndexablePath(const ccstd::string &path) {
+    if (path.find("//") != ccstd::string::npos || path.find('\\') != ccstd::string::npos) {
+        return false;
+    }
+    size_t start = 0;
+    while (start < path.size()) {
+        // '.' and '..' segments need normalizing and hidden files are not enumerated
+        if (path[start] == '.') {
+            return false;
+        }
+        const size_t slash = path.find('/', start);
+        if (slash == ccstd::string::npos) {
+            break;
+        }
+        start = slash + 1;
+    }
+    return true;
+}
+
+ccstd::string stripTrailingSlash(const ccstd::string &path) {
+    return !path.empty() && path.back() == '/' ? path.substr(0, path.size() - 1) : path;
+}
+
+ccstd::string collapseSlashes(const ccstd::string &path) {
+    ccstd::string ret;
+    ret.reserve(path.size());
+    for (const char c : path) {
+        if (c != '/' || ret.empty() || ret.back() != '/') {
+            ret += c;
+        }
+    }
+    return ret;
+}
+} // namespace
+
 FileUtils::FileUtils() {
     FileUtils::sharedFileUtils = this;
+    _searchPathManifest = std::make_shared<const SearchPathManifest>();
 }
 
 FileUtils::~FileUtils() {
@@ -536,6 +595,7 @@ bool FileUtils::init() {
     addSearchPath("Resources", true);
     addSearchPath("data", true);
     _searchPathArray.push_back(_defaultResRootPath);
+    updateSearchPathManifest();
     return true;
 }
 
@@ -543,6 +603,63 @@ void FileUtils::purgeCachedEntries() {
     _fullPathCache.clear();
 }
 
+void FileUtils::setSearchPathManifestEnabled(bool enabled) {
+    if (_searchPathManifestEnabled != enabled) {
+        _searchPathManifestEnabled = enabled;
+        updateSearchPathManifest();
+    }
+}
+
+void FileUtils::rebuildSearchPathManifest() {
+    _fullPathCache.clear();
+    updateSearchPathManifest();
+}
+
+void FileUtils::updateSearchPathManifest() {
+    auto manifest = std::make_shared<SearchPathManifest>();
+    manifest->searchPaths = _searchPathArray;
+    manifest->indexed.resize(_searchPathArray.size(), 0);
+    manifest->roots.resize(_searchPathArray.size());
+    manifest->files.resize(_searchPathArray.size());
+    manifest->directories.resize(_searchPathArray.size());
+
+    if (_searchPathManifestEnabled) {
+        ccstd::vector<ccstd::string> entries;
+        for (size_t i = 0; i < _searchPathArray.size(); ++i) {
+            const auto &searchPath = _searchPathArray[i];
+            if (searchPath.empty()) {
+                continue;
+            }
+            entries.clear();
+            listFilesRecursively(searchPath, &entries);
+            // nothing is listed for directories that can't be enumerated, e.g. in packages
+            if (entries.empty()) {
+                continue;
+            }
+            // listed entries are normalized, e.g. 'res/../assets/' is listed as 'assets/'
+            manifest->roots[i] = normalizePath(searchPath);
+            const ccstd::string prefix = collapseSlashes(manifest->roots[i]);
+            auto &files = manifest->files[i];
+            auto &directories = manifest->directories[i];
+            files.reserve(entries.size());
+            for (const auto &entry : entries) {
+                ccstd::string path = collapseSlashes(normalizePath(entry));
+                if (path.compare(0, prefix.size(), prefix) != 0) {
+                    continue;
+                }
+                if (path.back() == '/') {
+                    directories.emplace(stripTrailingSlash(path.substr(prefix.size())));
+                } else {
+                    files.emplace(path.substr(prefix.size()));
+                }
+            }
+            manifest->indexed[i] = 1;
+        }
+    }
+
+    std::atomic_store(&_searchPathManifest, std::shared_ptr<const SearchPathManifest>(std::move(manifest)));
+}
+
 ccstd::string FileUtils::getStringFromFile(const ccstd::string &filename) {
     ccstd::string s;
     getContents(filename, &s);
@@ -596,6 +713,78 @@ FileUtils::Status FileUtils::getContents(const ccstd::string &filename, Resizabl
     return Status::OK;
 }
 
+MappedFile::MappedFile(const uint8_t *bytes, uint32_t size, Releaser releaser, bool mapped)
+: _bytes(bytes), _size(size), _releaser(std::move(releaser)), _mapped(mapped) {}
+
+MappedFile::~MappedFile() {
+    if (_releaser) {
+        _releaser(_bytes, _size);
+    }
+}
+
+IntrusivePtr<MappedFile> FileUtils::mapFile(const ccstd::string &filename, Status *status) {
+    Status ret = Status::NOT_EXISTS;
+    IntrusivePtr<MappedFile> file;
+    do {
+        CC_BREAK_IF(filename.empty());
+
+        auto *fs = FileUtils::getInstance();
+        const ccstd::string fullPath = fs->fullPathForFilename(filename);
+        CC_BREAK_IF(fullPath.empty());
+
+#if (CC_PLATFORM != CC_PLATFORM_WINDOWS)
+        const int fd = open(fs->getSuitableFOpen(fullPath).c_str(), O_RDONLY);
+        if (fd != -1) {
+            struct stat statBuf;
+            if (fstat(fd, &statBuf) == -1) {
+                close(fd);
+                ret = Status::OBTAIN_SIZE_FAILED;
+                break;
+            }
+            if (static_cast<uint64_t>(statBuf.st_size) > UINT32_MAX) {
+                close(fd);
+                ret = Status::TOO_LARGE;
+                break;
+            }
+            const auto size = static_cast<uint32_t>(statBuf.st_size);
+            // mmap does not accept empty files, which are represented by an empty view
+            void *addr = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+            // the mapping keeps its own reference to the file
+            close(fd);
+            if (addr != MAP_FAILED) {
+                file = ccnew MappedFile(
+                    static_cast<const uint8_t *>(addr), size,
+                    [](const uint8_t *bytes, uint32_t size) {
+                        if (bytes) {
+                            munmap(const_cast<uint8_t *>(bytes), size);
+                        }
+                    },
+                    true);
+                ret = Status::OK;
+                break;
+            }
+        }
+#endif
+
+        // fall back to a heap copy, e.g. files in packages or platforms without mmap
+        Data data;
+        ret = fs->getContents(fullPath, &data);
+        CC_BREAK_IF(ret != Status::OK);
+        const uint32_t size = data.getSize();
+        file = ccnew MappedFile(
+            data.takeBuffer(), size,
+            [](const uint8_t *bytes, uint32_t /*size*/) {
+                free(const_cast<uint8_t *>(bytes));
+            },
+            false);
+    } while (false);
+
+    if (status) {
+        *status = ret;
+    }
+    return file;
+}
+
 unsigned char *FileUtils::getFileDataFromZip(const ccstd::string &zipFilePath, const ccstd::string &filename, uint32_t *size) {
     unsigned char *buffer = nullptr;
     unzFile file = nullptr;
@@ -662,15 +851,27 @@ ccstd::string FileUtils::fullPathForFilename(const ccstd::string &filename) cons
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end()) {
-        return cacheIter->second;
-    }
-
     ccstd::string fullpath;
+    if (_fullPathCache.find(filename, &fullpath)) {
+        return fullpath;
+    }
 
-    for (const auto &searchIt : _searchPathArray) {
-        fullpath = this->getPathForFilename(filename, searchIt);
+    const auto manifest = std::atomic_load(&_searchPathManifest);
+    const bool indexable = isIndexablePath(filename);
+    for (size_t i = 0; i < manifest->searchPaths.size(); ++i) {
+        const auto &searchPath = manifest->searchPaths[i];
+        if (indexable && manifest->indexed[i]) {
+            if (manifest->files[i].count(filename) != 0) {
+                fullpath = manifest->roots[i] + filename;
+            } else if (manifest->directories[i].count(stripTrailingSlash(filename)) != 0) {
+                // directories resolve the way the platform does without the manifest
+                fullpath = this->getPathForFilename(filename, searchPath);
+            } else {
+                continue;
+            }
+        } else {
+            fullpath = this->getPathForFilename(filename, searchPath);
+        }
 
         if (!fullpath.empty()) {
             // Using the filename passed in as key.
@@ -683,6 +884,19 @@ ccstd::string FileUtils::fullPathForFilename(const ccstd::string &filename) cons
     return "";
 }
 
+ccstd::vector<ccstd::string> FileUtils::fullPathsForFilenames(const ccstd::vector<ccstd::string> &filenames) const {
+    const auto count = static_cast<uint32_t>(filenames.size());
+    ccstd::vector<ccstd::string> fullPaths(count);
+    forEachChunk(
+        count, 0U, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                fullPaths[i] = fullPathForFilename(filenames[i]);
+            }
+        },
+        MIN_FILES_PER_RESOLVE_JOB);
+    return fullPaths;
+}
+
 ccstd::string FileUtils::fullPathFromRelativeFile(const ccstd::string &filename, const ccstd::string &relativeFile) {
     return relativeFile.substr(0, relativeFile.rfind('/') + 1) + filename;
 }
@@ -744,6 +958,7 @@ void FileUtils::setSearchPaths(const ccstd::vector<ccstd::string> &searchPaths)
         // CC_LOG_DEBUG("Default root path doesn't exist, adding it.");
         _searchPathArray.push_back(_defaultResRootPath);
     }
+    updateSearchPathManifest();
 }
 
 void FileUtils::addSearchPath(const ccstd::string &searchpath, bool front) {
@@ -763,6 +978,7 @@ void FileUtils::addSearchPath(const ccstd::string &searchpath, bool front) {
         _originalSearchPaths.push_back(searchpath);
         _searchPathArray.push_back(path);
     }
+    updateSearchPathManifest();
 }
 
 ccstd::string FileUtils::getFullPathForDirectoryAndFilename(const ccstd::string &directory, const ccstd::string &filename) const {
@@ -801,13 +1017,24 @@ bool FileUtils::isDirectoryExist(const ccstd::string &dirPath) const {
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if (cacheIter != _fullPathCache.end()) {
-        return isDirectoryExistInternal(cacheIter->second);
+    ccstd::string fullpath;
+    if (_fullPathCache.find(dirPath, &fullpath)) {
+        return isDirectoryExistInternal(fullpath);
     }
 
-    ccstd::string fullpath;
-    for (const auto &searchIt : _searchPathArray) {
+    const auto manifest = std::atomic_load(&_searchPathManifest);
+    const bool indexable = isIndexablePath(dirPath);
+    for (size_t i = 0; i < manifest->searchPaths.size(); ++i) {
+        const auto &searchIt = manifest->searchPaths[i];
+        if (indexable && manifest->indexed[i]) {
+            if (manifest->directories[i].count(stripTrailingSlash(dirPath)) == 0) {
+                continue;
+            }
+            fullpath = manifest->roots[i] + dirPath;
+            _fullPathCache.emplace(dirPath, fullpath);
+            return true;
+        }
+
         // searchPath + file_path
         fullpath = fullPathForFilename(searchIt + dirPath);
         if (isDirectoryExistInternal(fullpath)) {
@@ -24,16 +24,23 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <type_traits>
 #include "base/Data.h"
 #include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
 #include "base/Value.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
+#include "platform/FullPathCache.h"
 
 namespace cc {
 
+struct SearchPathManifest;
+
 class ResizableBuffer {
 public:
     ~ResizableBuffer() = default;
@@ -99,6 +106,34 @@ public:
     }
 };
 
+/**
+ * Read-only view of a whole file. The bytes are mapped from the file when the platform supports it,
+ * otherwise they are owned by the view. The bytes stay valid as long as the view is referenced.
+ */
+class CC_DLL MappedFile final : public RefCounted {
+public:
+    using Releaser = std::function<void(const uint8_t *bytes, uint32_t size)>;
+
+    /**
+     *  @param releaser Invoked with the bytes when the view is destroyed, may be empty.
+     *  @param mapped Whether the bytes are mapped from the file instead of copied to the heap.
+     */
+    MappedFile(const uint8_t *bytes, uint32_t size, Releaser releaser, bool mapped);
+    ~MappedFile() override;
+
+    inline const uint8_t *getBytes() const { return _bytes; }
+    inline uint32_t getSize() const { return _size; }
+    inline bool isMapped() const { return _mapped; }
+
+private:
+    const uint8_t *_bytes{nullptr};
+    uint32_t _size{0};
+    Releaser _releaser;
+    bool _mapped{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(MappedFile);
+};
+
 /** Helper class to handle file operations. */
 class CC_DLL FileUtils {
 public:
@@ -228,6 +263,18 @@ public:
     }
     virtual Status getContents(const ccstd::string &filename, ResizableBuffer *buffer);
 
+    /**
+     *  Maps whole file contents into memory without copying them.
+     *
+     *  The file is mapped read-only with mmap where it is supported, so the pages are backed by the
+     *  file and can be dropped by the kernel under memory pressure. Platforms or files that can not be
+     *  mapped fall back to reading the contents with getContents.
+     *
+     *  @param[out] status The status of the operation, may be nullptr.
+     *  @return The mapped view, nullptr on failure.
+     */
+    virtual IntrusivePtr<MappedFile> mapFile(const ccstd::string &filename, Status *status = nullptr);
+
     /**
      *  Gets resource file data from a zip file.
      *
@@ -281,10 +328,35 @@ public:
      This method was added to simplify multiplatform support. Whether you are using cocos2d-js or any cross-compilation toolchain like StellaSDK or Apportable,
      you might need to load different resources for a given file in the different platforms.
 
+     @note It is safe to call from any thread, as long as search paths are only modified on the main thread.
+
      @since v2.1
      */
     virtual ccstd::string fullPathForFilename(const ccstd::string &filename) const;
 
+    /**
+     *  Resolves the full paths of many files in parallel with the job system, see fullPathForFilename.
+     *  @return The full paths in the order of filenames, empty strings for files that are not found.
+     */
+    ccstd::vector<ccstd::string> fullPathsForFilenames(const ccstd::vector<ccstd::string> &filenames) const;
+
+    /**
+     *  Enables the search path manifest.
+     *
+     *  When enabled, every search path that can be enumerated is indexed whenever search paths change,
+     *  and files and directories under indexed search paths are resolved from the index without touching the file system.
+     *  Search paths that can not be enumerated, e.g. assets in the Android package, are still checked on the file system.
+     *
+     *  @note Files and directories created in indexed search paths afterwards are only found after rebuildSearchPathManifest is called.
+     */
+    void setSearchPathManifestEnabled(bool enabled);
+    bool isSearchPathManifestEnabled() const { return _searchPathManifestEnabled; }
+
+    /**
+     *  Re-indexes the search paths, e.g. after downloading files into them.
+     */
+    void rebuildSearchPathManifest();
+
     /**
      *  Gets full path from a file name and the path of the relative file.
      *  @param filename The file name.
@@ -535,8 +607,8 @@ public:
      */
     virtual long getFileSize(const ccstd::string &filepath); //NOLINT(google-runtime-int)
 
-    /** Returns the full path cache. */
-    const ccstd::unordered_map<ccstd::string, ccstd::string> &getFullPathCache() const { return _fullPathCache; }
+    /** Returns a copy of the full path cache. */
+    ccstd::unordered_map<ccstd::string, ccstd::string> getFullPathCache() const { return _fullPathCache.snapshot(); }
 
     virtual ccstd::string normalizePath(const ccstd::string &path) const;
     virtual ccstd::string getFileDir(const ccstd::string &path) const;
@@ -587,6 +659,12 @@ protected:
      */
     virtual ccstd::string getFullPathForDirectoryAndFilename(const ccstd::string &directory, const ccstd::string &filename) const;
 
+    /**
+     *  Publishes the current search paths to the resolver used by fullPathForFilename, indexing them if the manifest is enabled.
+     *  Must be called whenever _searchPathArray is modified.
+     */
+    void updateSearchPathManifest();
+
     /**
      * The vector contains search paths.
      * The lower index of the element in this vector, the higher priority for this search path.
@@ -611,7 +689,14 @@ protected:
      *  The full path cache. When a file is found, it will be added into this cache.
      *  This variable is used for improving the performance of file search.
      */
-    mutable ccstd::unordered_map<ccstd::string, ccstd::string> _fullPathCache;
+    mutable FullPathCache _fullPathCache;
+
+    /**
+     *  Immutable snapshot of the search paths and their index, replaced atomically so that
+     *  lookups from other threads never observe a partially updated state.
+     */
+    std::shared_ptr<const SearchPathManifest> _searchPathManifest;
+    bool _searchPathManifestEnabled{false};
 
     /**
      * Writable path.
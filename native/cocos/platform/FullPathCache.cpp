@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/FullPathCache.h"
+#include <functional>
+
+namespace cc {
+
+FullPathCache::Stripe &FullPathCache::getStripe(const ccstd::string &filename) const {
+    return _stripes[std::hash<ccstd::string>{}(filename) % STRIPE_COUNT];
+}
+
+bool FullPathCache::find(const ccstd::string &filename, ccstd::string *fullPath) const {
+    auto &stripe = getStripe(filename);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto iter = stripe.entries.find(filename);
+    if (iter == stripe.entries.end()) {
+        return false;
+    }
+    *fullPath = iter->second;
+    return true;
+}
+
+void FullPathCache::emplace(const ccstd::string &filename, const ccstd::string &fullPath) {
+    auto &stripe = getStripe(filename);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    stripe.entries.emplace(filename, fullPath);
+}
+
+void FullPathCache::clear() {
+    for (auto &stripe : _stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        stripe.entries.clear();
+    }
+}
+
+size_t FullPathCache::size() const {
+    size_t count = 0;
+    for (const auto &stripe : _stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        count += stripe.entries.size();
+    }
+    return count;
+}
+
+ccstd::unordered_map<ccstd::string, ccstd::string> FullPathCache::snapshot() const {
+    ccstd::unordered_map<ccstd::string, ccstd::string> entries;
+    for (const auto &stripe : _stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        entries.insert(stripe.entries.begin(), stripe.entries.end());
+    }
+    return entries;
+}
+
+} // namespace cc
@@ -0,0 +1,72 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+
+namespace cc {
+
+/**
+ * Thread-safe cache from file names to full paths.
+ * The entries are spread over lock stripes by hash, so concurrent lookups of different
+ * file names rarely contend on the same mutex.
+ */
+class CC_DLL FullPathCache final {
+public:
+    static constexpr uint32_t STRIPE_COUNT = 16;
+
+    FullPathCache() = default;
+    ~FullPathCache() = default;
+
+    /**
+     *  Looks up the full path of a file name.
+     *  @return true if the file name is cached, the full path is written to fullPath.
+     */
+    bool find(const ccstd::string &filename, ccstd::string *fullPath) const;
+    void emplace(const ccstd::string &filename, const ccstd::string &fullPath);
+    void clear();
+    size_t size() const;
+
+    /** Returns a copy of all entries. */
+    ccstd::unordered_map<ccstd::string, ccstd::string> snapshot() const;
+
+private:
+    struct Stripe {
+        mutable std::mutex mutex;
+        ccstd::unordered_map<ccstd::string, ccstd::string> entries;
+    };
+
+    Stripe &getStripe(const ccstd::string &filename) const;
+
+    mutable Stripe _stripes[STRIPE_COUNT];
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(FullPathCache);
+};
+
+} // namespace cc
@@ -278,10 +278,11 @@ bool Image::initWithImageFile(const ccstd::string &path) {
     //    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
     _filePath = path;
 
-    const Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    // decode straight from the mapped file to avoid holding an extra copy of the encoded image
+    const IntrusivePtr<MappedFile> file = FileUtils::getInstance()->mapFile(_filePath);
 
-    if (!data.isNull()) {
-        ret = initWithImageData(data.getBytes(), data.getSize());
+    if (file && file->getSize() > 0) {
+        ret = initWithImageData(file->getBytes(), file->getSize());
     }
 
     return ret;
@@ -0,0 +1,185 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/ImageDecodeQueue.h"
+#include <algorithm>
+#include "base/memory/Memory.h"
+#include "platform/FileUtils.h"
+#include "profiler/TraceRecorder.h"
+
+namespace cc {
+
+ImageDecodeQueue::ImageDecodeQueue(uint32_t threadCount, uint32_t memoryBudget)
+: _memoryBudget(memoryBudget) {
+    if (threadCount == 0) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    }
+    _workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&ImageDecodeQueue::workerLoop, this);
+    }
+}
+
+ImageDecodeQueue::~ImageDecodeQueue() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exiting = true;
+        _tasks.clear();
+    }
+    _taskCondition.notify_all();
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+void ImageDecodeQueue::decode(ccstd::vector<Data> &&buffers, const Completion &completion) {
+    auto batch = std::make_shared<Batch>(Batch{completion});
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (uint32_t i = 0; i < buffers.size(); ++i) {
+            Task task;
+            task.batch = batch;
+            task.index = i;
+            task.data = std::move(buffers[i]);
+            _tasks.emplace_back(std::move(task));
+        }
+    }
+    buffers.clear();
+    _taskCondition.notify_all();
+}
+
+void ImageDecodeQueue::decodeFiles(const ccstd::vector<ccstd::string> &fullPaths, const Completion &completion) {
+    auto batch = std::make_shared<Batch>(Batch{completion});
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (uint32_t i = 0; i < fullPaths.size(); ++i) {
+            Task task;
+            task.batch = batch;
+            task.index = i;
+            task.path = fullPaths[i];
+            _tasks.emplace_back(std::move(task));
+        }
+    }
+    _taskCondition.notify_all();
+}
+
+IntrusivePtr<Image> ImageDecodeQueue::decodeTask(const Task &task) {
+    CC_TRACE_SCOPE("DecodeImage");
+    IntrusivePtr<Image> image = ccnew Image();
+    bool succeed = false;
+    if (task.path.empty()) {
+        succeed = image->initWithImageData(task.data.getBytes(), task.data.getSize());
+    } else {
+        // the encoded file is only mapped while it is decoded
+        const IntrusivePtr<MappedFile> file = FileUtils::getInstance()->mapFile(task.path);
+        if (file && file->getSize() > 0) {
+            succeed = image->initWithImageData(file->getBytes(), file->getSize());
+        }
+    }
+    return succeed ? image : nullptr;
+}
+
+void ImageDecodeQueue::workerLoop() {
+    CC_TRACE_THREAD_NAME("ImageDecoder");
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        // hold back while decoded images waiting for delivery exceed the budget
+        _taskCondition.wait(lock, [this]() {
+            return _exiting || (!_tasks.empty() && _decodedBytes < _memoryBudget);
+        });
+        if (_exiting) {
+            return;
+        }
+
+        Task task = std::move(_tasks.front());
+        _tasks.pop_front();
+        ++_decodingCount;
+        lock.unlock();
+
+        IntrusivePtr<Image> image = decodeTask(task);
+        const uint32_t bytes = image ? image->getDataLen() : 0;
+        // release the encoded data before waiting for the lock
+        task.data.clear();
+
+        lock.lock();
+        --_decodingCount;
+        _decodedBytes += bytes;
+        _results.push_back({std::move(task.batch), task.index, std::move(image), bytes});
+        _resultCondition.notify_all();
+    }
+}
+
+uint32_t ImageDecodeQueue::deliver(uint32_t maxCount) {
+    uint32_t delivered = 0;
+    while (delivered < maxCount) {
+        Result result;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_results.empty()) {
+                break;
+            }
+            result = std::move(_results.front());
+            _results.pop_front();
+        }
+
+        if (result.batch->completion) {
+            result.batch->completion(result.index, result.image.get());
+        }
+        result.image = nullptr;
+        ++delivered;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _decodedBytes -= result.bytes;
+        }
+        _taskCondition.notify_all();
+    }
+    return delivered;
+}
+
+void ImageDecodeQueue::flush() {
+    while (true) {
+        deliver();
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_tasks.empty() && _decodingCount == 0 && _results.empty()) {
+            return;
+        }
+        _resultCondition.wait(lock, [this]() {
+            return !_results.empty() || (_tasks.empty() && _decodingCount == 0);
+        });
+    }
+}
+
+uint32_t ImageDecodeQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<uint32_t>(_tasks.size() + _results.size()) + _decodingCount;
+}
+
+uint32_t ImageDecodeQueue::getDecodedBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _decodedBytes;
+}
+
+} // namespace cc
@@ -0,0 +1,140 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "base/Data.h"
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "platform/Image.h"
+
+namespace cc {
+
+/**
+ * Decodes batches of encoded images on a pool of worker threads.
+ *
+ * Every worker decodes into its own Image objects, so decoders never share state. Decoded images
+ * are queued in completion order until deliver() hands them to the caller, usually the thread
+ * that uploads textures. Workers stop taking new images while the decoded images waiting for
+ * delivery exceed the memory budget, so a large batch never holds all of its pixels at once.
+ */
+class CC_DLL ImageDecodeQueue final : public RefCounted {
+public:
+    static constexpr uint32_t DEFAULT_MEMORY_BUDGET = 128 * 1024 * 1024;
+
+    /**
+     *  Called by deliver() for every image of a batch.
+     *  @param index The index of the image in the batch.
+     *  @param image The decoded image, nullptr if decoding failed. It is released after the call, retain it to keep it.
+     */
+    using Completion = std::function<void(uint32_t index, Image *image)>;
+
+    /**
+     *  @param threadCount The number of worker threads, 0 to use all but one hardware thread.
+     *  @param memoryBudget The maximum bytes of decoded images waiting for delivery.
+     */
+    explicit ImageDecodeQueue(uint32_t threadCount = 0, uint32_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    ~ImageDecodeQueue() override;
+
+    /**
+     *  Decodes encoded images held in memory.
+     */
+    void decode(ccstd::vector<Data> &&buffers, const Completion &completion);
+
+    /**
+     *  Decodes image files, which are mapped by the workers when they are decoded.
+     *  @param fullPaths Full paths of the files, see FileUtils::fullPathForFilename.
+     */
+    void decodeFiles(const ccstd::vector<ccstd::string> &fullPaths, const Completion &completion);
+
+    /**
+     *  Hands decoded images to their completions in the order they finished.
+     *  @param maxCount The maximum number of images to deliver.
+     *  @return The number of delivered images.
+     */
+    uint32_t deliver(uint32_t maxCount = UINT32_MAX);
+
+    /**
+     *  Blocks until all queued images are decoded, then delivers them.
+     */
+    void flush();
+
+    /** The number of images queued or decoded but not delivered yet. */
+    uint32_t getPendingCount() const;
+
+    /** The bytes of decoded images waiting for delivery. */
+    uint32_t getDecodedBytes() const;
+
+    inline uint32_t getMemoryBudget() const { return _memoryBudget; }
+    inline uint32_t getThreadCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+private:
+    struct Batch {
+        Completion completion;
+    };
+
+    struct Task {
+        std::shared_ptr<Batch> batch;
+        uint32_t index{0};
+        Data data;
+        ccstd::string path;
+    };
+
+    struct Result {
+        std::shared_ptr<Batch> batch;
+        uint32_t index{0};
+        IntrusivePtr<Image> image;
+        uint32_t bytes{0};
+    };
+
+    void workerLoop();
+    static IntrusivePtr<Image> decodeTask(const Task &task);
+
+    ccstd::vector<std::thread> _workers;
+    ccstd::deque<Task> _tasks;
+    ccstd::deque<Result> _results;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _taskCondition;
+    std::condition_variable _resultCondition;
+
+    uint32_t _memoryBudget{DEFAULT_MEMORY_BUDGET};
+    uint32_t _decodedBytes{0};
+    uint32_t _decodingCount{0};
+    bool _exiting{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(ImageDecodeQueue);
+};
+
+} // namespace cc
@@ -217,6 +217,47 @@ FileUtils::Status FileUtilsAndroid::getContents(const ccstd::string &filename, R
     return FileUtils::Status::OK;
 }
 
+IntrusivePtr<MappedFile> FileUtilsAndroid::mapFile(const ccstd::string &filename, Status *status) {
+    ccstd::string fullPath = filename.empty() ? filename : fullPathForFilename(filename);
+    // files outside of the apk and inside of the obb file are handled by the default implementation
+    if (fullPath.empty() || fullPath[0] == '/' || obbfile || nullptr == assetmanager) {
+        return FileUtils::mapFile(filename, status);
+    }
+
+    ccstd::string relativePath;
+    if (0 == fullPath.find(ASSETS_FOLDER_NAME)) {
+        relativePath = fullPath.substr(strlen(ASSETS_FOLDER_NAME));
+    } else {
+        relativePath = fullPath;
+    }
+
+    // AASSET_MODE_BUFFER maps uncompressed assets from the apk instead of copying them
+    AAsset *asset = AAssetManager_open(assetmanager, relativePath.data(), AASSET_MODE_BUFFER);
+    if (nullptr == asset) {
+        LOGD("asset (%s) is nullptr", filename.c_str());
+        if (status) {
+            *status = FileUtils::Status::OPEN_FAILED;
+        }
+        return nullptr;
+    }
+
+    const auto *bytes = static_cast<const uint8_t *>(AAsset_getBuffer(asset));
+    if (nullptr == bytes) {
+        AAsset_close(asset);
+        return FileUtils::mapFile(filename, status);
+    }
+    const auto size = static_cast<uint32_t>(AAsset_getLength(asset));
+    if (status) {
+        *status = FileUtils::Status::OK;
+    }
+    return ccnew MappedFile(
+        bytes, size,
+        [asset](const uint8_t * /*bytes*/, uint32_t /*size*/) {
+            AAsset_close(asset);
+        },
+        !AAsset_isAllocated(asset));
+}
+
 ccstd::string FileUtilsAndroid::getWritablePath() const {
     if (!_writablePath.empty()) {
         return _writablePath;
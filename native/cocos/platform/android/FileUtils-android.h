@@ -56,6 +56,7 @@ public:
     /* override functions */
     bool init() override;
     FileUtils::Status getContents(const ccstd::string &filename, ResizableBuffer *buffer) override;
+    IntrusivePtr<MappedFile> mapFile(const ccstd::string &filename, Status *status) override;
 
     ccstd::string getWritablePath() const override;
     bool isAbsolutePath(const ccstd::string &strPath) const override;
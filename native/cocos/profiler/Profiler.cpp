@@ -130,6 +130,7 @@ Profiler *Profiler::getInstance() {
 Profiler::Profiler() {
     _mainThreadId = std::this_thread::get_id();
     _root = ccnew ProfilerBlock(nullptr, "MainThread");
+    TraceRecorder::setThreadName("MainThread");
     _current = _root;
 
     Profiler::instance = this;
@@ -389,6 +390,8 @@ void Profiler::printStats() {
 }
 
 void Profiler::beginBlock(const std::string_view &name) {
+    // the trace covers all threads, the stats tree only the main thread
+    TraceRecorder::begin(name);
     if (isMainThread()) {
         _current = _current->getOrCreateChild(name);
         _current->begin();
@@ -400,6 +403,7 @@ void Profiler::endBlock() {
         _current->end();
         _current = _current->_parent;
     }
+    TraceRecorder::end();
 }
 
 void Profiler::gatherBlocks(ProfilerBlock *parent, uint32_t depth, std::vector<ProfilerBlockDepth> &outBlocks) { //NOLINT(misc-no-recursion)
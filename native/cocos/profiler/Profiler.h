@@ -26,6 +26,7 @@
 #include <string_view>
 #include <thread>
 #include "GameStats.h"
+#include "TraceRecorder.h"
 #include "base/Config.h"
 #include "base/Timer.h"
 #include "gfx-base/GFXDef-common.h"
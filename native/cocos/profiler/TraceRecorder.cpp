@@ -0,0 +1,252 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "profiler/TraceRecorder.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace {
+
+struct TraceEvent {
+    const char *name{nullptr};
+    uint32_t nameLength{0};
+    char phase{'B'};
+    int64_t timestamp{0}; // nanoseconds since the capture started
+};
+
+struct ThreadTraceBuffer {
+    uint32_t threadIndex{0};
+    ccstd::string threadName;
+    std::unique_ptr<TraceEvent[]> events;
+    uint32_t capacity{0};
+    std::atomic<uint32_t> generation{0};
+    // published by the owning thread, read by the exporter
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> dropped{0};
+    // set under registryMutex when the owning thread exits
+    bool exited{false};
+};
+
+std::atomic<bool> recording{false};
+std::atomic<uint32_t> generation{0};
+std::atomic<uint32_t> eventsPerThread{TraceRecorder::DEFAULT_EVENTS_PER_THREAD};
+std::atomic<int64_t> startTime{0};
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// guards the registry, thread names and buffer resets against the exporter
+std::mutex registryMutex;
+ccstd::vector<std::unique_ptr<ThreadTraceBuffer>> registry;
+uint32_t nextThreadIndex{1};
+
+// buffers of exited threads are kept for the capture they recorded into,
+// and freed when the next capture starts
+struct LocalBufferHolder {
+    ThreadTraceBuffer *buffer{nullptr};
+
+    ~LocalBufferHolder() {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffer->exited = true;
+        }
+    }
+};
+
+thread_local LocalBufferHolder localBufferHolder;
+
+ThreadTraceBuffer *getLocalBuffer() {
+    auto *&localBuffer = localBufferHolder.buffer;
+    if (!localBuffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.emplace_back(std::make_unique<ThreadTraceBuffer>());
+        localBuffer = registry.back().get();
+        localBuffer->threadIndex = nextThreadIndex++;
+    }
+
+    // only the owning thread resets its buffer, when it records the first event of a new capture,
+    // and never while the previous capture is being exported
+    const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+    if (localBuffer->generation.load(std::memory_order_relaxed) != currentGeneration) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        const uint32_t capacity = eventsPerThread.load(std::memory_order_relaxed);
+        if (localBuffer->capacity != capacity) {
+            localBuffer->events = std::make_unique<TraceEvent[]>(capacity);
+            localBuffer->capacity = capacity;
+        }
+        localBuffer->count.store(0, std::memory_order_relaxed);
+        localBuffer->dropped.store(0, std::memory_order_relaxed);
+        localBuffer->generation.store(currentGeneration, std::memory_order_release);
+    }
+    return localBuffer;
+}
+
+void record(const char *name, uint32_t nameLength, char phase) {
+    auto *buffer = getLocalBuffer();
+    const uint32_t index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= buffer->capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    auto &event = buffer->events[index];
+    event.name = name;
+    event.nameLength = nameLength;
+    event.phase = phase;
+    event.timestamp = now() - startTime.load(std::memory_order_relaxed);
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+void appendEscaped(ccstd::string &out, const char *str, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        const char c = str[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+}
+
+} // namespace
+
+void TraceRecorder::start(uint32_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        registry.erase(std::remove_if(registry.begin(), registry.end(), [](const auto &buffer) {
+                           return buffer->exited;
+                       }),
+                       registry.end());
+    }
+    eventsPerThread.store(capacity > 0 ? capacity : DEFAULT_EVENTS_PER_THREAD, std::memory_order_relaxed);
+    startTime.store(now(), std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_acq_rel);
+    recording.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop() {
+    recording.store(false, std::memory_order_release);
+}
+
+bool TraceRecorder::isRecording() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::setThreadName(const char *name) {
+    // register the thread even if nothing is recorded yet, so that it shows up in the timeline
+    auto *buffer = getLocalBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+void TraceRecorder::begin(const std::string_view &name) {
+    if (isRecording()) {
+        record(name.data(), static_cast<uint32_t>(name.size()), 'B');
+    }
+}
+
+void TraceRecorder::end() {
+    if (isRecording()) {
+        record(nullptr, 0, 'E');
+    }
+}
+
+ccstd::string TraceRecorder::exportChromeTrace() {
+    const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+    ccstd::string out;
+    out.reserve(1024 * 1024);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char line[128];
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto &buffer : registry) {
+        if (!buffer->threadName.empty()) {
+            out += first ? "" : ",";
+            first = false;
+            snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", buffer->threadIndex);
+            out += line;
+            appendEscaped(out, buffer->threadName.data(), buffer->threadName.size());
+            out += "\"}}";
+        }
+        if (buffer->generation.load(std::memory_order_acquire) != currentGeneration) {
+            continue;
+        }
+
+        const uint32_t count = buffer->count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto &event = buffer->events[i];
+            out += first ? "" : ",";
+            first = false;
+            out += "{";
+            if (event.phase == 'B') {
+                out += "\"name\":\"";
+                appendEscaped(out, event.name, event.nameLength);
+                out += "\",";
+            }
+            // timestamps are in microseconds
+            snprintf(line, sizeof(line), "\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                     event.phase, buffer->threadIndex, static_cast<double>(event.timestamp) / 1000.0);
+            out += line;
+        }
+    }
+    out += "]}";
+    return out;
+}
+
+bool TraceRecorder::saveChromeTrace(const ccstd::string &path) {
+    const ccstd::string trace = exportChromeTrace();
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    const size_t written = fwrite(trace.data(), 1, trace.size(), fp);
+    fclose(fp);
+    return written == trace.size();
+}
+
+uint32_t TraceRecorder::getDroppedEventCount() {
+    const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+    uint32_t dropped = 0;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto &buffer : registry) {
+        if (buffer->generation.load(std::memory_order_acquire) == currentGeneration) {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return dropped;
+}
+
+} // namespace cc
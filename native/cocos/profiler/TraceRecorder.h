@@ -0,0 +1,105 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <string_view>
+#include "base/Config.h"
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+
+namespace cc {
+
+/**
+ * Records begin/end events of every thread into per-thread buffers and exports them in the
+ * Chrome trace event format, which can be opened with chrome://tracing or Perfetto.
+ *
+ * Each thread appends to its own buffer without locking. A thread registers its buffer once,
+ * when it records its first event, and the buffer of an exited thread is freed when the next
+ * capture starts. Exporting may run concurrently with recording and starting a capture. Event names are not copied and must stay valid until the
+ * trace is exported, which holds for the string literals used by the profiling macros.
+ */
+class CC_DLL TraceRecorder final {
+public:
+    static constexpr uint32_t DEFAULT_EVENTS_PER_THREAD = 1U << 16;
+
+    /**
+     *  Starts a new capture, discarding the previous one.
+     *  @param eventsPerThread The capacity of each thread buffer, events beyond it are dropped.
+     */
+    static void start(uint32_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+    static void stop();
+    static bool isRecording();
+
+    /** Names the calling thread in the exported trace. */
+    static void setThreadName(const char *name);
+
+    static void begin(const std::string_view &name);
+    static void end();
+
+    /**
+     *  Exports the last capture as Chrome trace JSON. Call it after stop().
+     */
+    static ccstd::string exportChromeTrace();
+    static bool saveChromeTrace(const ccstd::string &path);
+
+    /** The number of events dropped by full buffers in the last capture. */
+    static uint32_t getDroppedEventCount();
+
+private:
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TraceRecorder);
+};
+
+/**
+ * AutoTraceScope: records a block of the calling thread
+ */
+class AutoTraceScope {
+public:
+    explicit AutoTraceScope(const std::string_view &name)
+    : _recording(TraceRecorder::isRecording()) {
+        if (_recording) {
+            TraceRecorder::begin(name);
+        }
+    }
+
+    ~AutoTraceScope() {
+        if (_recording) {
+            TraceRecorder::end();
+        }
+    }
+
+private:
+    bool _recording{false};
+};
+
+} // namespace cc
+
+#if CC_USE_PROFILER
+    #define CC_TRACE_THREAD_NAME(name) cc::TraceRecorder::setThreadName(name)
+    #define CC_TRACE_SCOPE(name)       cc::AutoTraceScope auto_trace_scope(name)
+#else
+    #define CC_TRACE_THREAD_NAME(name)
+    #define CC_TRACE_SCOPE(name)
+#endif
@@ -115,25 +115,47 @@ void BufferAgent::doDestroy() {
 }
 
 void BufferAgent::update(const void *buffer, uint32_t size) {
-    uint8_t *actorBuffer{nullptr};
-    bool needFreeing{false};
-    auto *mq{DeviceAgent::getInstance()->getMessageQueue()};
+    if (isMapped(buffer)) { // filled in place by the producer
+        CC_ASSERT(size <= _mappedSize);
+        _mappedSize = size;
+        unmap();
+        return;
+    }
 
-    getActorBuffer(this, mq, size, &actorBuffer, &needFreeing);
+    uint8_t *actorBuffer = getActorBuffer(this, size);
     memcpy(actorBuffer, buffer, size);
 
-    ENQUEUE_MESSAGE_4(
-        mq, BufferUpdate,
+    ENQUEUE_MESSAGE_3(
+        DeviceAgent::getInstance()->getMessageQueue(), BufferUpdate,
         actor, getActor(),
         buffer, actorBuffer,
         size, size,
-        needFreeing, needFreeing,
         {
             actor->update(buffer, size);
-            if (needFreeing) free(buffer);
         });
 }
 
+uint8_t *BufferAgent::map(uint32_t size) {
+    CC_ASSERT(!_mappedBuffer);
+    _mappedBuffer = getActorBuffer(this, size);
+    _mappedSize = size;
+    return _mappedBuffer;
+}
+
+void BufferAgent::unmap() {
+    CC_ASSERT(_mappedBuffer);
+    ENQUEUE_MESSAGE_3(
+        DeviceAgent::getInstance()->getMessageQueue(), BufferUpdate,
+        actor, getActor(),
+        buffer, _mappedBuffer,
+        size, _mappedSize,
+        {
+            actor->update(buffer, size);
+        });
+    _mappedBuffer = nullptr;
+    _mappedSize = 0;
+}
+
 void BufferAgent::flush(const uint8_t *buffer) {
     auto *mq = DeviceAgent::getInstance()->getMessageQueue();
     ENQUEUE_MESSAGE_3(
@@ -146,16 +168,13 @@ void BufferAgent::flush(const uint8_t *buffer) {
         });
 }
 
-void BufferAgent::getActorBuffer(const BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing) {
+uint8_t *BufferAgent::getActorBuffer(const BufferAgent *buffer, uint32_t size) {
     if (buffer->_stagingBuffer) { // for frequent updates on big buffers
         uint32_t frameIndex = DeviceAgent::getInstance()->getCurrentIndex();
-        *pActorBuffer = buffer->_stagingBuffer.get() + frameIndex * buffer->_size;
-    } else if (size > STAGING_BUFFER_THRESHOLD) { // less frequent updates on big buffers
-        *pActorBuffer = reinterpret_cast<uint8_t *>(malloc(size));
-        *pNeedFreeing = true;
-    } else { // for small enough buffers
-        *pActorBuffer = mq->allocate<uint8_t>(size);
+        return buffer->_stagingBuffer.get() + frameIndex * buffer->_size;
     }
+    // consumed in place by the render thread, recycled once the frame is done
+    return DeviceAgent::getInstance()->allocateStaging(size);
 }
 
 uint8_t *BufferAgent::getStagingAddress() const {
@@ -41,7 +41,16 @@ public:
 
     void update(const void *buffer, uint32_t size) override;
 
-    static void getActorBuffer(const BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing);
+    /**
+     * Returns memory for the producer to write the next @p size bytes of update data into directly.
+     * The matching unmap call hands it over to the actor in place, and so do update and
+     * CommandBufferAgent::updateBuffer when called with the returned pointer; any other data is copied.
+     */
+    uint8_t *map(uint32_t size);
+    void unmap();
+    bool isMapped(const void *buffer) const { return _mappedBuffer && _mappedBuffer == buffer; }
+
+    static uint8_t *getActorBuffer(const BufferAgent *buffer, uint32_t size);
 
 private:
     void doInit(const BufferInfo &info) override;
@@ -55,6 +64,10 @@ private:
     static constexpr uint32_t STAGING_BUFFER_THRESHOLD = MessageQueue::MEMORY_CHUNK_SIZE / 2;
 
     std::unique_ptr<uint8_t[]> _stagingBuffer;
+    uint8_t *_mappedBuffer{nullptr};
+    uint32_t _mappedSize{0};
+
+    friend class CommandBufferAgent;
 };
 
 } // namespace gfx
@@ -25,6 +25,7 @@
 #include "CommandBufferAgent.h"
 #include <cstring>
 #include "BufferAgent.h"
+#include "CommandBufferQueue.h"
 #include "DescriptorSetAgent.h"
 #include "DeviceAgent.h"
 #include "FramebufferAgent.h"
@@ -90,7 +91,11 @@ void CommandBufferAgent::initMessageQueue() {
     DeviceAgent *device = DeviceAgent::getInstance();
     device->_cmdBuffRefs.insert(this);
 
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    _messageQueue = ccnew CommandBufferQueue(getActor());
+#else
     _messageQueue = ccnew MessageQueue;
+#endif
     if (device->_multithreaded) _messageQueue->setImmediateMode(false);
 }
 
@@ -247,6 +252,11 @@ void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
 }
 
 void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    auto *cmd = _messageQueue->allocateCommand<CommandBufferQueue::BindPipelineStateCommand>(CommandBufferQueue::BIND_PIPELINE_STATE);
+    cmd->pso = static_cast<PipelineStateAgent *>(pso)->getActor();
+    _messageQueue->submit();
+#else
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindPipelineState,
         actor, getActor(),
@@ -254,9 +264,20 @@ void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
         {
             actor->bindPipelineState(pso);
         });
+#endif
 }
 
 void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    auto *cmd = _messageQueue->allocateCommand<CommandBufferQueue::BindDescriptorSetCommand>(CommandBufferQueue::BIND_DESCRIPTOR_SET, dynamicOffsetCount * sizeof(uint32_t));
+    cmd->descriptorSet = static_cast<DescriptorSetAgent *>(descriptorSet)->getActor();
+    cmd->set = set;
+    cmd->dynamicOffsetCount = dynamicOffsetCount;
+    if (dynamicOffsetCount) {
+        memcpy(cmd + 1, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+    }
+    _messageQueue->submit();
+#else
     uint32_t *actorDynamicOffsets = nullptr;
     if (dynamicOffsetCount) {
         actorDynamicOffsets = _messageQueue->allocate<uint32_t>(dynamicOffsetCount);
@@ -273,9 +294,15 @@ void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descript
         {
             actor->bindDescriptorSet(set, descriptorSet, dynamicOffsetCount, dynamicOffsets);
         });
+#endif
 }
 
 void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    auto *cmd = _messageQueue->allocateCommand<CommandBufferQueue::BindInputAssemblerCommand>(CommandBufferQueue::BIND_INPUT_ASSEMBLER);
+    cmd->ia = static_cast<InputAssemblerAgent *>(ia)->getActor();
+    _messageQueue->submit();
+#else
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindInputAssembler,
         actor, getActor(),
@@ -283,9 +310,14 @@ void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
         {
             actor->bindInputAssembler(ia);
         });
+#endif
 }
 
 void CommandBufferAgent::setViewport(const Viewport &vp) {
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    _messageQueue->allocateCommand<CommandBufferQueue::SetViewportCommand>(CommandBufferQueue::SET_VIEWPORT)->vp = vp;
+    _messageQueue->submit();
+#else
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetViewport,
         actor, getActor(),
@@ -293,9 +325,14 @@ void CommandBufferAgent::setViewport(const Viewport &vp) {
         {
             actor->setViewport(vp);
         });
+#endif
 }
 
 void CommandBufferAgent::setScissor(const Rect &rect) {
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    _messageQueue->allocateCommand<CommandBufferQueue::SetScissorCommand>(CommandBufferQueue::SET_SCISSOR)->rect = rect;
+    _messageQueue->submit();
+#else
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetScissor,
         actor, getActor(),
@@ -303,6 +340,7 @@ void CommandBufferAgent::setScissor(const Rect &rect) {
         {
             actor->setScissor(rect);
         });
+#endif
 }
 
 void CommandBufferAgent::setLineWidth(float width) {
@@ -381,6 +419,10 @@ void CommandBufferAgent::nextSubpass() {
 }
 
 void CommandBufferAgent::draw(const DrawInfo &info) {
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    _messageQueue->allocateCommand<CommandBufferQueue::DrawCommand>(CommandBufferQueue::DRAW)->info = info;
+    _messageQueue->submit();
+#else
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferDraw,
         actor, getActor(),
@@ -388,28 +430,40 @@ void CommandBufferAgent::draw(const DrawInfo &info) {
         {
             actor->draw(info);
         });
+#endif
 }
 
 void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
     auto *bufferAgent = static_cast<BufferAgent *>(buff);
 
-    uint8_t *actorBuffer{nullptr};
-    bool needFreeing{false};
-
-    BufferAgent::getActorBuffer(bufferAgent, _messageQueue, size, &actorBuffer, &needFreeing);
-    memcpy(actorBuffer, data, size);
+    uint8_t *actorBuffer = nullptr;
+    if (bufferAgent->isMapped(data)) { // filled in place by the producer
+        CC_ASSERT(size <= bufferAgent->_mappedSize);
+        actorBuffer = bufferAgent->_mappedBuffer;
+        bufferAgent->_mappedBuffer = nullptr;
+        bufferAgent->_mappedSize = 0;
+    } else {
+        actorBuffer = BufferAgent::getActorBuffer(bufferAgent, size);
+        memcpy(actorBuffer, data, size);
+    }
 
-    ENQUEUE_MESSAGE_5(
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+    auto *cmd = _messageQueue->allocateCommand<CommandBufferQueue::UpdateBufferCommand>(CommandBufferQueue::UPDATE_BUFFER);
+    cmd->buffer = bufferAgent->getActor();
+    cmd->data = actorBuffer;
+    cmd->size = size;
+    _messageQueue->submit();
+#else
+    ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferUpdateBuffer,
         actor, getActor(),
         buff, bufferAgent->getActor(),
         data, actorBuffer,
         size, size,
-        needFreeing, needFreeing,
         {
             actor->updateBuffer(buff, data, size);
-            if (needFreeing) free(data);
         });
+#endif
 }
 
 void CommandBufferAgent::resolveTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
@@ -33,6 +33,13 @@ class MessageQueue;
 
 namespace gfx {
 
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+class CommandBufferQueue;
+using CommandBufferMessageQueue = CommandBufferQueue;
+#else
+using CommandBufferMessageQueue = MessageQueue;
+#endif
+
 class CC_DLL CommandBufferAgent final : public Agent<CommandBuffer> {
 public:
     explicit CommandBufferAgent(CommandBuffer *actor);
@@ -78,7 +85,7 @@ public:
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t getNumTris() const override { return _actor->getNumTris(); }
 
-    inline MessageQueue *getMessageQueue() { return _messageQueue; }
+    inline CommandBufferMessageQueue *getMessageQueue() { return _messageQueue; }
 
 protected:
     friend class DeviceAgent;
@@ -91,7 +98,7 @@ protected:
 
     void initMessageQueue();
     void destroyMessageQueue();
-    MessageQueue *_messageQueue = nullptr;
+    CommandBufferMessageQueue *_messageQueue = nullptr;
 };
 
 } // namespace gfx
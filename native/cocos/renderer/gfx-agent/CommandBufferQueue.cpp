@@ -0,0 +1,108 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "CommandBufferQueue.h"
+#include "DeviceAgent.h"
+#include "gfx-base/GFXCommandBuffer.h"
+
+namespace cc {
+namespace gfx {
+
+CommandBufferQueue::CommandBufferQueue(CommandBuffer *actor, uint32_t capacity) noexcept
+: _queue(capacity),
+  _actor(actor) {
+}
+
+void CommandBufferQueue::submit() noexcept {
+    if (!_immediateMode) return;
+
+    _queue.kick();
+    _queue.execute([this](uint32_t type, const void *payload) {
+        execute(type, payload);
+    });
+}
+
+void CommandBufferQueue::finishWriting() noexcept {
+    if (_immediateMode) return;
+
+    allocateCommand<uint32_t>(FLUSH);
+    _queue.kick();
+}
+
+void CommandBufferQueue::flushMessages() noexcept {
+    bool flushed = false;
+    while (!flushed) {
+        _queue.execute([this, &flushed](uint32_t type, const void *payload) {
+            flushed = !execute(type, payload);
+            return !flushed;
+        });
+    }
+}
+
+uint8_t *CommandBufferQueue::allocateData(uint32_t size) noexcept {
+    // recycled once the render thread is done with the frame, like buffer updates
+    return DeviceAgent::getInstance()->allocateStaging(size);
+}
+
+bool CommandBufferQueue::execute(uint32_t type, const void *payload) noexcept {
+    switch (type) {
+        case MESSAGE: {
+            Message *msg = static_cast<const MessageCommand *>(payload)->message;
+            msg->execute();
+            msg->~Message();
+        } break;
+        case FLUSH:
+            return false;
+        case BIND_PIPELINE_STATE:
+            _actor->bindPipelineState(static_cast<const BindPipelineStateCommand *>(payload)->pso);
+            break;
+        case BIND_DESCRIPTOR_SET: {
+            const auto *cmd = static_cast<const BindDescriptorSetCommand *>(payload);
+            _actor->bindDescriptorSet(cmd->set, cmd->descriptorSet, cmd->dynamicOffsetCount, reinterpret_cast<const uint32_t *>(cmd + 1));
+        } break;
+        case BIND_INPUT_ASSEMBLER:
+            _actor->bindInputAssembler(static_cast<const BindInputAssemblerCommand *>(payload)->ia);
+            break;
+        case SET_VIEWPORT:
+            _actor->setViewport(static_cast<const SetViewportCommand *>(payload)->vp);
+            break;
+        case SET_SCISSOR:
+            _actor->setScissor(static_cast<const SetScissorCommand *>(payload)->rect);
+            break;
+        case DRAW:
+            _actor->draw(static_cast<const DrawCommand *>(payload)->info);
+            break;
+        case UPDATE_BUFFER: {
+            const auto *cmd = static_cast<const UpdateBufferCommand *>(payload);
+            _actor->updateBuffer(cmd->buffer, cmd->data, cmd->size);
+        } break;
+        default:
+            CC_ABORT();
+            break;
+    }
+    return true;
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,166 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include "base/threading/CommandQueue.h"
+#include "base/threading/MessageQueue.h"
+#include "gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace gfx {
+
+class Buffer;
+class CommandBuffer;
+class DescriptorSet;
+class InputAssembler;
+class PipelineState;
+
+// The recording stream of a CommandBufferAgent on top of CommandQueue, enabled by CC_USE_GFX_AGENT_COMMAND_QUEUE.
+// Frequent commands are POD records dispatched through a switch, everything else is recorded
+// through the ENQUEUE_MESSAGE macros as before, with the message object stored in place in the ring.
+// Array data of those messages lives in the staging ring of the device agent.
+// All commands recorded between two flushes have to fit into the ring, the consumer only starts on them once flushed.
+class CommandBufferQueue final {
+public:
+    enum CommandType : uint32_t {
+        MESSAGE,
+        FLUSH,
+        BIND_PIPELINE_STATE,
+        BIND_DESCRIPTOR_SET,
+        BIND_INPUT_ASSEMBLER,
+        SET_VIEWPORT,
+        SET_SCISSOR,
+        DRAW,
+        UPDATE_BUFFER,
+    };
+
+    struct MessageCommand {
+        Message *message;
+        // followed by the message object
+    };
+    struct BindPipelineStateCommand {
+        PipelineState *pso;
+    };
+    struct BindDescriptorSetCommand {
+        DescriptorSet *descriptorSet;
+        uint32_t set;
+        uint32_t dynamicOffsetCount;
+        // followed by dynamicOffsetCount offsets
+    };
+    struct BindInputAssemblerCommand {
+        InputAssembler *ia;
+    };
+    struct SetViewportCommand {
+        Viewport vp;
+    };
+    struct SetScissorCommand {
+        Rect rect;
+    };
+    struct DrawCommand {
+        DrawInfo info;
+    };
+    struct UpdateBufferCommand {
+        Buffer *buffer;
+        const void *data;
+        uint32_t size;
+    };
+
+    CommandBufferQueue(CommandBuffer *actor, uint32_t capacity = CommandQueue::DEFAULT_CAPACITY) noexcept;
+    ~CommandBufferQueue() = default;
+    CommandBufferQueue(CommandBufferQueue const &) = delete;
+    CommandBufferQueue(CommandBufferQueue &&) = delete;
+    CommandBufferQueue &operator=(CommandBufferQueue const &) = delete;
+    CommandBufferQueue &operator=(CommandBufferQueue &&) = delete;
+
+    // record a POD command, call submit once it is filled
+    template <typename T>
+    T *allocateCommand(CommandType type, uint32_t extraSize = 0) noexcept;
+    // executes the recorded commands right away in immediate mode
+    void submit() noexcept;
+
+    // the MessageQueue interface used by ENQUEUE_MESSAGE and the command buffer agent
+    template <typename T>
+    std::enable_if_t<std::is_base_of<Message, T>::value, T *>
+    allocate(uint32_t count) noexcept;
+    template <typename T>
+    std::enable_if_t<!std::is_base_of<Message, T>::value, T *>
+    allocate(uint32_t count) noexcept;
+    template <typename T>
+    T *allocateAndZero(uint32_t count) noexcept;
+
+    // publish the commands recorded since the last flush
+    void finishWriting() noexcept;
+    // execute the commands of the next flush, on the consumer side
+    void flushMessages() noexcept;
+
+    inline bool isImmediateMode() const noexcept { return _immediateMode; }
+    inline void setImmediateMode(bool immediateMode) noexcept { _immediateMode = immediateMode; }
+
+private:
+    static uint8_t *allocateData(uint32_t size) noexcept;
+    bool execute(uint32_t type, const void *payload) noexcept;
+
+    CommandQueue _queue;
+    CommandBuffer *_actor{nullptr};
+    bool _immediateMode{true};
+};
+
+template <typename T>
+T *CommandBufferQueue::allocateCommand(CommandType type, uint32_t extraSize) noexcept {
+    CC_ASSERT(_queue.getUnpublishedSize() < _queue.getCapacity() / 2);
+    return _queue.allocate<T>(type, extraSize);
+}
+
+template <typename T>
+std::enable_if_t<std::is_base_of<Message, T>::value, T *>
+CommandBufferQueue::allocate(uint32_t const /*count*/) noexcept {
+    static_assert(alignof(T) <= CommandQueue::COMMAND_ALIGNMENT, "messages are stored in place");
+    static_assert(sizeof(MessageCommand) <= CommandQueue::COMMAND_ALIGNMENT, "messages are stored in place");
+
+    // the message starts at the next command alignment boundary after the record
+    auto *const command = allocateCommand<MessageCommand>(MESSAGE, CommandQueue::COMMAND_ALIGNMENT - sizeof(MessageCommand) + sizeof(T));
+    auto *const msg = reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(command) + CommandQueue::COMMAND_ALIGNMENT);
+    command->message = msg;
+    return msg;
+}
+
+template <typename T>
+std::enable_if_t<!std::is_base_of<Message, T>::value, T *>
+CommandBufferQueue::allocate(uint32_t const count) noexcept {
+    static_assert(alignof(T) <= CommandQueue::COMMAND_ALIGNMENT, "staging memory is 16 bytes aligned");
+    return reinterpret_cast<T *>(allocateData(sizeof(T) * count));
+}
+
+template <typename T>
+T *CommandBufferQueue::allocateAndZero(uint32_t const count) noexcept {
+    T *const allocatedMemory = allocate<T>(count);
+    memset(allocatedMemory, 0, sizeof(T) * count);
+    return allocatedMemory;
+}
+
+} // namespace gfx
+} // namespace cc
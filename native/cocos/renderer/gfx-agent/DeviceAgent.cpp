@@ -22,6 +22,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <boost/align/align_up.hpp>
 #include <cstring>
 #include "application/ApplicationManager.h"
@@ -32,6 +33,7 @@
 
 #include "BufferAgent.h"
 #include "CommandBufferAgent.h"
+#include "CommandBufferQueue.h"
 #include "DescriptorSetAgent.h"
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
@@ -49,6 +51,13 @@
 namespace cc {
 namespace gfx {
 
+namespace {
+constexpr size_t STAGING_ALIGNMENT = 16;
+constexpr size_t STAGING_BLOCK_SIZE = 1U << 20;
+// frames uploading more than this won't keep their memory around for the next round
+constexpr size_t STAGING_MAX_RETAINED_SIZE = 16U << 20;
+} // namespace
+
 DeviceAgent *DeviceAgent::instance = nullptr;
 
 DeviceAgent *DeviceAgent::getInstance() {
@@ -79,6 +88,7 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
     _caps = _actor->_caps;
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
     memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
+    _multithreadedCommandRecording = _actor->_multithreadedCommandRecording;
 
     _mainMessageQueue = ccnew MessageQueue;
 
@@ -125,6 +135,8 @@ void DeviceAgent::doDestroy() {
         delete _mainMessageQueue;
         _mainMessageQueue = nullptr;
     }
+
+    destroyStaging();
 }
 
 void DeviceAgent::acquire(Swapchain *const *swapchains, uint32_t count) {
@@ -167,6 +179,7 @@ void DeviceAgent::present() {
         _mainMessageQueue->finishWriting();
         _currentIndex = (_currentIndex + 1) % MAX_FRAME_INDEX;
         _frameBoundarySemaphore.wait();
+        recycleStaging();
     }
 }
 
@@ -292,7 +305,41 @@ BufferBarrier *DeviceAgent::getBufferBarrier(const BufferBarrierInfo &info) {
 }
 
 template <typename T>
-void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count, MessageQueue *mq, T *actor) {
+void enqueueBufferTextureCopy(MessageQueue *mq, T *actor, const uint8_t **actorBuffers, Texture *actorTexture, BufferTextureCopy *actorRegions, uint32_t count, ThreadSafeLinearAllocator *allocator) {
+    ENQUEUE_MESSAGE_6(
+        mq, DeviceCopyBuffersToTexture,
+        actor, actor,
+        buffers, actorBuffers,
+        dst, actorTexture,
+        regions, actorRegions,
+        count, count,
+        allocator, allocator,
+        {
+            actor->copyBuffersToTexture(buffers, dst, regions, count);
+            delete allocator;
+        });
+}
+
+#if CC_USE_GFX_AGENT_COMMAND_QUEUE
+template <typename T>
+void enqueueBufferTextureCopy(CommandBufferQueue *mq, T *actor, const uint8_t **actorBuffers, Texture *actorTexture, BufferTextureCopy *actorRegions, uint32_t count, ThreadSafeLinearAllocator *allocator) {
+    ENQUEUE_MESSAGE_6(
+        mq, CommandBufferCopyBuffersToTexture,
+        actor, actor,
+        buffers, actorBuffers,
+        dst, actorTexture,
+        regions, actorRegions,
+        count, count,
+        allocator, allocator,
+        {
+            actor->copyBuffersToTexture(buffers, dst, regions, count);
+            delete allocator;
+        });
+}
+#endif
+
+template <typename Q, typename T>
+void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count, Q *mq, T *actor) {
     uint32_t bufferCount = 0U;
     for (uint32_t i = 0U; i < count; i++) {
         bufferCount += regions[i].texSubres.layerCount;
@@ -349,18 +396,7 @@ void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const
         actorRegions[i].buffTexHeight = 0;
     }
 
-    ENQUEUE_MESSAGE_6(
-        mq, DeviceCopyBuffersToTexture,
-        actor, actor,
-        buffers, actorBuffers,
-        dst, static_cast<TextureAgent *>(texture)->getActor(),
-        regions, actorRegions,
-        count, count,
-        allocator, allocator,
-        {
-            actor->copyBuffersToTexture(buffers, dst, regions, count);
-            delete allocator;
-        });
+    enqueueBufferTextureCopy(mq, actor, actorBuffers, static_cast<TextureAgent *>(texture)->getActor(), actorRegions, count, allocator);
 }
 
 void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) {
@@ -394,7 +430,9 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count)
 
     for (uint32_t i = 0; i < count; ++i) {
         agentCmdBuffs[i] = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
+#if !CC_USE_GFX_AGENT_COMMAND_QUEUE
         MessageQueue::freeChunksInFreeQueue(agentCmdBuffs[i]->_messageQueue);
+#endif
         agentCmdBuffs[i]->_messageQueue->finishWriting();
     }
 
@@ -444,6 +482,69 @@ void DeviceAgent::presentWait() {
     _mainMessageQueue->finishWriting();
     _currentIndex = (_currentIndex + 1) % MAX_FRAME_INDEX;
     _frameBoundarySemaphore.wait();
+    recycleStaging();
+}
+
+uint8_t *DeviceAgent::allocateStaging(uint32_t size) {
+    if (!size) return nullptr;
+
+    auto &frame = _stagingFrames[_currentIndex];
+    auto *block = frame.block.load(std::memory_order_acquire);
+    if (block) {
+        if (auto *buffer = block->allocate<uint8_t>(size, STAGING_ALIGNMENT)) return buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(_stagingMutex);
+    block = frame.block.load(std::memory_order_relaxed);
+    if (block) { // may have been grown by another recording thread
+        if (auto *buffer = block->allocate<uint8_t>(size, STAGING_ALIGNMENT)) return buffer;
+    }
+
+    if (size > STAGING_BLOCK_SIZE / 2) { // dedicated block, keep the current one for smaller updates
+        auto *dedicated = ccnew ThreadSafeLinearAllocator(size, STAGING_ALIGNMENT);
+        frame.blocks.push_back(dedicated);
+        return dedicated->allocate<uint8_t>(size, STAGING_ALIGNMENT);
+    }
+
+    block = ccnew ThreadSafeLinearAllocator(STAGING_BLOCK_SIZE, STAGING_ALIGNMENT);
+    frame.blocks.push_back(block);
+    frame.block.store(block, std::memory_order_release);
+    return block->allocate<uint8_t>(size, STAGING_ALIGNMENT);
+}
+
+void DeviceAgent::recycleStaging() {
+    // the render thread is done with the frame that last used this slot
+    auto &frame = _stagingFrames[_currentIndex];
+    if (frame.blocks.empty()) return;
+
+    if (frame.blocks.size() == 1 && frame.blocks[0] == frame.block.load(std::memory_order_relaxed)) {
+        frame.blocks[0]->recycle();
+        return;
+    }
+
+    // merge into a single block so steady frames allocate without locking
+    size_t usedSize = 0;
+    for (auto *block : frame.blocks) {
+        usedSize += block->getUsedSize();
+        delete block;
+    }
+    frame.blocks.clear();
+
+    size_t capacity = boost::alignment::align_up(std::max(usedSize, STAGING_BLOCK_SIZE), STAGING_BLOCK_SIZE);
+    capacity = std::min(capacity, STAGING_MAX_RETAINED_SIZE);
+    auto *block = ccnew ThreadSafeLinearAllocator(capacity, STAGING_ALIGNMENT);
+    frame.blocks.push_back(block);
+    frame.block.store(block, std::memory_order_release);
+}
+
+void DeviceAgent::destroyStaging() {
+    for (auto &frame : _stagingFrames) {
+        for (auto *block : frame.blocks) {
+            delete block;
+        }
+        frame.blocks.clear();
+        frame.block.store(nullptr, std::memory_order_relaxed);
+    }
 }
 
 void DeviceAgent::frameSync() {
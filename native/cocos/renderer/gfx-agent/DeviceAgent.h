@@ -24,14 +24,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include "base/Agent.h"
 #include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
 #include "base/threading/Semaphore.h"
 #include "gfx-base/GFXDevice.h"
 
 namespace cc {
 class IXRInterface;
 class MessageQueue;
+class ThreadSafeLinearAllocator;
 
 namespace gfx {
 
@@ -102,6 +106,13 @@ public:
 
     inline MessageQueue *getMessageQueue() const { return _mainMessageQueue; }
 
+    /**
+     * Allocates memory of the current frame from the staging ring shared with the render thread.
+     * The memory stays valid until the render thread has finished this frame,
+     * so producers can fill it in place and hand it over to the actor without another copy.
+     */
+    uint8_t *allocateStaging(uint32_t size);
+
     void presentWait();
     void presentSignal();
 
@@ -118,6 +129,9 @@ protected:
     bool doInit(const DeviceInfo &info) override;
     void doDestroy() override;
 
+    void recycleStaging();
+    void destroyStaging();
+
     bool _multithreaded{false};
     MessageQueue *_mainMessageQueue{nullptr};
 
@@ -128,6 +142,13 @@ protected:
     Semaphore _frameBoundarySemaphore{MAX_CPU_FRAME_AHEAD};
 #endif
 
+    struct StagingFrame {
+        std::atomic<ThreadSafeLinearAllocator *> block{nullptr};
+        ccstd::vector<ThreadSafeLinearAllocator *> blocks;
+    };
+    StagingFrame _stagingFrames[MAX_FRAME_INDEX];
+    std::mutex _stagingMutex;
+
     ccstd::unordered_set<CommandBufferAgent *> _cmdBuffRefs;
     IXRInterface *_xr{nullptr};
 };
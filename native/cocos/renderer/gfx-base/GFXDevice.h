@@ -112,6 +112,7 @@ public:
     inline const ccstd::string &getRenderer() const { return _renderer; }
     inline const ccstd::string &getVendor() const { return _vendor; }
     inline bool hasFeature(Feature feature) const { return _features[toNumber(feature)]; }
+    inline bool isMultithreadedCommandRecordingSupported() const { return _multithreadedCommandRecording; }
     inline FormatFeature getFormatFeatures(Format format) const { return _formatFeatures[toNumber(format)]; }
 
     inline const BindingMappingInfo &bindingMappingInfo() const { return _bindingMappingInfo; }
@@ -174,7 +175,8 @@ protected:
     BindingMappingInfo _bindingMappingInfo;
     DeviceOptions _options;
 
-    bool _multithreadedCommandRecording{true};
+    // only backends whose command recording is known to be thread-safe opt in
+    bool _multithreadedCommandRecording{false};
 
     ccstd::array<bool, static_cast<size_t>(Feature::COUNT)> _features;
     ccstd::array<FormatFeature, static_cast<size_t>(Format::COUNT)> _formatFeatures;
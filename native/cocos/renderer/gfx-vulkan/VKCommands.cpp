@@ -50,10 +50,12 @@ constexpr bool ENABLE_LAZY_ALLOCATION = true;
 
 CCVKGPUCommandBufferPool *CCVKGPUDevice::getCommandBufferPool() {
     static thread_local size_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-    if (!_commandBufferPools.count(threadID)) {
-        _commandBufferPools[threadID] = ccnew CCVKGPUCommandBufferPool(this);
+    std::lock_guard<std::mutex> lock(_commandBufferPoolsMutex);
+    auto iter = _commandBufferPools.find(threadID);
+    if (iter == _commandBufferPools.end()) {
+        iter = _commandBufferPools.emplace(threadID, ccnew CCVKGPUCommandBufferPool(this)).first;
     }
-    return _commandBufferPools[threadID];
+    return iter->second;
 }
 
 CCVKGPUDescriptorSetPool *CCVKGPUDevice::getDescriptorSetPool(uint32_t layoutID) {
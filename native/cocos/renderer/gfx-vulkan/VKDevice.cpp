@@ -87,6 +87,7 @@ CCVKDevice::CCVKDevice() {
     _deviceName = "Vulkan";
 
     _caps.supportQuery = true;
+    _multithreadedCommandRecording = true;
     _caps.clipSpaceMinZ = 0.0F;
     _caps.screenSpaceSignY = -1.0F;
     _caps.clipSpaceSignY = -1.0F;
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "VKStd.h"
 #include "VKUtils.h"
 #include "base/Log.h"
@@ -477,6 +478,8 @@ private:
     // cannot use thread_local here because we need explicit control over their destruction
     using CommandBufferPools = tbb::concurrent_unordered_map<size_t, CCVKGPUCommandBufferPool *, std::hash<size_t>>;
     CommandBufferPools _commandBufferPools;
+    // command buffers may begin on several recording threads at once
+    std::mutex _commandBufferPoolsMutex;
 
     ccstd::unordered_map<uint32_t, std::unique_ptr<CCVKGPUDescriptorSetPool>> _descriptorSetPools;
 };
@@ -70,6 +70,11 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         ? descriptorSet->getTexture(REFLECTIONPROBEBLENDCUBEMAP::BINDING)
         : nullptr;
     const uint32_t reflectionProbeType = subModel->getReflectionProbeType();
+    // baked skinning instances sample their animation from the bound joint texture
+    auto *jointTexture = descriptorSet->getTexture(JOINTTEXTURE::BINDING);
+    // batched instances are appended in bulk and may exceed the capacity limit of a single draw
+    const uint32_t batchedCount = subModel->getBatchedInstanceCount();
+    const uint32_t instanceCount = 1 + batchedCount;
     auto *shader = shaderImplant;
     if (!shader) {
         shader = subModel->getShader(passIdx);
@@ -82,7 +87,7 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
     _sortRender.shaderID = shaderId;
     _sortRender.passIndex = passIdx;
     for (auto &instance : _instances) {
-        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.drawInfo.instanceCount >= MAX_CAPACITY) {
+        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || (!batchedCount && instance.drawInfo.instanceCount >= MAX_CAPACITY)) {
             continue;
         }
 
@@ -103,12 +108,17 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         if (instance.reflectionProbeBlendCubemap != reflectionProbeBlendCubemap) {
             continue;
         }
+        if (instance.jointTexture != jointTexture) {
+            continue;
+        }
 
         if (instance.stride != stride) {
             continue;
         }
-        if (instance.drawInfo.instanceCount >= instance.capacity) { // resize buffers
-            instance.capacity <<= 1;
+        if (instance.drawInfo.instanceCount + instanceCount > instance.capacity) { // resize buffers
+            while (instance.drawInfo.instanceCount + instanceCount > instance.capacity) {
+                instance.capacity <<= 1;
+            }
             const auto newSize = instance.stride * instance.capacity;
             // NOLINTNEXTLINE(bugprone-suspicious-realloc-usage)
             instance.data = static_cast<uint8_t *>(CC_REALLOC(instance.data, newSize));
@@ -120,13 +130,22 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
         if (instance.descriptorSet != descriptorSet) {
             instance.descriptorSet = descriptorSet;
         }
-        memcpy(instance.data + static_cast<size_t>(instance.stride) * instance.drawInfo.instanceCount++, attrs.buffer.buffer()->getData(), stride);
+        uint8_t *dst = instance.data + static_cast<size_t>(instance.stride) * instance.drawInfo.instanceCount;
+        memcpy(dst, attrs.buffer.buffer()->getData(), stride);
+        if (batchedCount) {
+            memcpy(dst + stride, subModel->getBatchedInstanceData(), static_cast<size_t>(stride) * batchedCount);
+        }
+        instance.drawInfo.instanceCount += instanceCount;
         _hasPendingModels = true;
         return;
     }
 
     // Create a new instance
-    const auto newSize = stride * INITIAL_CAPACITY;
+    uint32_t capacity = INITIAL_CAPACITY;
+    while (capacity < instanceCount) {
+        capacity <<= 1;
+    }
+    const auto newSize = stride * capacity;
     auto *vb = _device->createBuffer({
         gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
         gfx::MemoryUsageBit::DEVICE,
@@ -150,13 +169,16 @@ void InstancedBuffer::merge(scene::SubModel *subModel, uint32_t passIdx, gfx::Sh
 
     auto *data = static_cast<uint8_t *>(CC_MALLOC(newSize));
     memcpy(data, attrs.buffer.buffer()->getData(), stride);
+    if (batchedCount) {
+        memcpy(data + stride, subModel->getBatchedInstanceData(), static_cast<size_t>(stride) * batchedCount);
+    }
     vertexBuffers.emplace_back(vb);
     const gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto *ia = _device->createInputAssembler(iaInfo);
-    InstancedItem item = {INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet,
+    InstancedItem item = {capacity, vb, data, ia, stride, shader, descriptorSet,
                           lightingMap, reflectionProbeCubemap, reflectionProbePlanarMap, reflectionProbeType, reflectionProbeBlendCubemap,
-                          ia->getDrawInfo()};
-    item.drawInfo.instanceCount = 1;
+                          jointTexture, ia->getDrawInfo()};
+    item.drawInfo.instanceCount = instanceCount;
     _instances.emplace_back(item);
     _hasPendingModels = true;
 }
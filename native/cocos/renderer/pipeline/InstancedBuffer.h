@@ -50,6 +50,7 @@ struct CC_DLL InstancedItem {
     gfx::Texture *reflectionProbePlanarMap = nullptr;
     uint32_t reflectionProbeType = 0;
     gfx::Texture *reflectionProbeBlendCubemap = nullptr;
+    gfx::Texture *jointTexture = nullptr;
     gfx::DrawInfo drawInfo;
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
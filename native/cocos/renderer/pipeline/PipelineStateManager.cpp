@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include "PipelineStateManager.h"
+#include <mutex>
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
 #include "scene/Pass.h"
@@ -30,6 +31,11 @@
 namespace cc {
 namespace pipeline {
 
+namespace {
+// pipeline states may be requested from several recording threads
+std::mutex psoMutex;
+} // namespace
+
 ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> PipelineStateManager::psoHashMap;
 
 gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *pass,
@@ -46,6 +52,7 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
         hash = hash << subpass;
     }
 
+    std::lock_guard<std::mutex> lock(psoMutex);
     auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
     if (!pso) {
         auto *pipelineLayout = pass->getPipelineLayout();
@@ -69,6 +76,7 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
 }
 
 void PipelineStateManager::destroyAll() {
+    std::lock_guard<std::mutex> lock(psoMutex);
     for (auto &pair : psoHashMap) {
         CC_SAFE_DESTROY_NULL(pair.second);
     }
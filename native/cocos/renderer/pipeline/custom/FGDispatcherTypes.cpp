@@ -166,7 +166,10 @@ FrameGraphDispatcher::FrameGraphDispatcher(ResourceGraph& resourceGraphIn, const
   renderGraph(renderGraphIn),
   layoutGraph(layoutGraphIn),
   scratch(scratchIn),
-  relationGraph(alloc) {}
+  relationGraph(alloc),
+  memorySlots(alloc),
+  memorySlotIndex(alloc),
+  passOrder(alloc) {}
 
 } // namespace render
 
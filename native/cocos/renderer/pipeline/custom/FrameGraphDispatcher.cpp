@@ -117,6 +117,11 @@ ResourceGraph::vertex_descriptor FrameGraphDispatcher::realResourceID(const ccst
     return resourceAccessGraph.resourceIndex.at(name);
 }
 
+uint32_t FrameGraphDispatcher::getMemorySlot(ResourceGraph::vertex_descriptor r) const {
+    auto iter = memorySlotIndex.find(r);
+    return iter == memorySlotIndex.end() ? 0xFFFFFFFF : iter->second;
+}
+
 [[nodiscard]] ccstd::pmr::string concatResName(
     std::string_view name0,
     std::string_view name1,
@@ -1891,6 +1896,35 @@ gfx::ResourceRange getOriginRange(ResourceGraph::vertex_descriptor v, const gfx:
     return ret;
 }
 
+ccstd::pmr::vector<uint32_t> getExecPositions(
+    const ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> &order,
+    uint32_t numVertices,
+    boost::container::pmr::memory_resource *scratch);
+
+gfx::GFXObject *getGFXBarrier(const Barrier &barrier, const ResourceGraph &resourceGraph) {
+    gfx::GFXObject *gfxBarrier{nullptr};
+    const auto &desc = get(ResourceGraph::DescTag{}, resourceGraph, barrier.resourceID);
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        gfx::BufferBarrierInfo info;
+        info.prevAccesses = barrier.beginStatus.accessFlag;
+        info.nextAccesses = barrier.endStatus.accessFlag;
+        const auto &range = barrier.endStatus.range;
+        info.offset = 0;
+        info.size = range.depthOrArraySize;
+        info.type = barrier.type;
+        gfxBarrier = gfx::Device::getInstance()->getBufferBarrier(info);
+    } else {
+        const auto &originRange = getOriginRange(barrier.resourceID, barrier.endStatus.range, resourceGraph);
+        gfx::TextureBarrierInfo info;
+        info.prevAccesses = barrier.beginStatus.accessFlag;
+        info.nextAccesses = barrier.endStatus.accessFlag;
+        info.range = originRange;
+        info.type = barrier.type;
+        gfxBarrier = gfx::Device::getInstance()->getTextureBarrier(info);
+    }
+    return gfxBarrier;
+}
+
 void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
     auto *scratch = fgDispatcher.scratch;
     const auto &renderGraph = fgDispatcher.renderGraph;
@@ -1906,29 +1940,11 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         fgDispatcher._accessGraphBuilt = true;
     }
 
-    auto getGFXBarrier = [&resourceGraph](const Barrier &barrier) {
-        gfx::GFXObject *gfxBarrier{nullptr};
-        const auto &desc = get(ResourceGraph::DescTag{}, resourceGraph, barrier.resourceID);
-        if (desc.dimension == ResourceDimension::BUFFER) {
-            gfx::BufferBarrierInfo info;
-            info.prevAccesses = barrier.beginStatus.accessFlag;
-            info.nextAccesses = barrier.endStatus.accessFlag;
-            const auto &range = barrier.endStatus.range;
-            info.offset = 0;
-            info.size = range.depthOrArraySize;
-            info.type = barrier.type;
-            gfxBarrier = gfx::Device::getInstance()->getBufferBarrier(info);
-        } else {
-            const auto &originRange = getOriginRange(barrier.resourceID, barrier.endStatus.range, resourceGraph);
-            gfx::TextureBarrierInfo info;
-            info.prevAccesses = barrier.beginStatus.accessFlag;
-            info.nextAccesses = barrier.endStatus.accessFlag;
-            info.range = originRange;
-            info.type = barrier.type;
-            gfxBarrier = gfx::Device::getInstance()->getTextureBarrier(info);
-        }
-        return gfxBarrier;
-    };
+    // accesses are walked in execution order, without reorder vertices keep their id order
+    const ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> noReorder(scratch);
+    const auto execPositions = getExecPositions(
+        fgDispatcher.passOrder.empty() ? noReorder : rag.topologicalOrder,
+        static_cast<uint32_t>(num_vertices(rag)), scratch);
 
     // found pass id in this map ? barriers you should commit when run into this pass
     // : or no extra barrier needed.
@@ -1940,11 +1956,19 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         const auto &desc = get(ResourceGraph::DescTag{}, resourceGraph, resID);
         bool isBuffer = desc.dimension == ResourceDimension::BUFFER;
 
-        const auto &accessRecord = accessPair.second;
-        auto iter = accessRecord.begin();
-        auto nextIter = iter;
-        std::advance(nextIter, 1);
-        for (; nextIter != accessRecord.end(); ++iter, ++nextIter) {
+        using AccessRecord = std::decay_t<decltype(accessPair.second)>::value_type;
+        ccstd::pmr::vector<const AccessRecord *> accessRecord(scratch);
+        accessRecord.reserve(accessPair.second.size());
+        for (const auto &record : accessPair.second) {
+            accessRecord.emplace_back(&record);
+        }
+        std::stable_sort(accessRecord.begin(), accessRecord.end(), [&execPositions](const AccessRecord *lhs, const AccessRecord *rhs) {
+            return execPositions[lhs->first] < execPositions[rhs->first];
+        });
+        const AccessRecord *iter = accessRecord.front();
+        for (size_t i = 1; i < accessRecord.size(); ++i) {
+            iter = accessRecord[i - 1];
+            const AccessRecord *nextIter = accessRecord[i];
             auto srcRagVertID = iter->first;
             auto dstRagVertID = nextIter->first;
             auto srcPassID = get(ResourceAccessGraph::PassIDTag{}, rag, srcRagVertID);
@@ -2007,7 +2031,7 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
                 firstMeetBarrier.endVert = dstPassID;
                 firstMeetBarrier.beginStatus = iter->second;
                 firstMeetBarrier.endStatus = nextIter->second;
-                firstMeetBarrier.barrier = getGFXBarrier(firstMeetBarrier);
+                firstMeetBarrier.barrier = getGFXBarrier(firstMeetBarrier, resourceGraph);
             } else if (accessDependent(iter->second.accessFlag, nextIter->second.accessFlag, isBuffer)) {
                 auto &srcBarrierNode = get(ResourceAccessGraph::BarrierTag{}, rag, srcRagVertID);
                 auto &beginBarrier = srcBarrierNode.rearBarriers.emplace_back();
@@ -2016,7 +2040,7 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
                 beginBarrier.endVert = dstPassID;
                 beginBarrier.beginStatus = iter->second;
                 beginBarrier.endStatus = nextIter->second;
-                if (isPassExecAdjecent(iter->first, nextIter->first)) {
+                if (isPassExecAdjecent(execPositions[iter->first], execPositions[nextIter->first])) {
                     beginBarrier.type = gfx::BarrierType::FULL;
                 } else {
                     beginBarrier.type = gfx::BarrierType::SPLIT_BEGIN;
@@ -2029,11 +2053,12 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
                     endBarrier.endVert = dstPassID;
                     endBarrier.beginStatus = iter->second;
                     endBarrier.endStatus = nextIter->second;
-                    endBarrier.barrier = getGFXBarrier(endBarrier);
+                    endBarrier.barrier = getGFXBarrier(endBarrier, resourceGraph);
                 }
-                beginBarrier.barrier = getGFXBarrier(beginBarrier);
+                beginBarrier.barrier = getGFXBarrier(beginBarrier, resourceGraph);
             }
         }
+        iter = accessRecord.back();
         const auto &traits = get(ResourceGraph::TraitsTag{}, resourceGraph, realResourceID);
         auto &states = get(ResourceGraph::StatesTag{}, resourceGraph, realResourceID);
         if (traits.hasSideEffects()) {
@@ -2048,7 +2073,7 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
                 presentBarrier.endVert = lastAccessPassID;
                 presentBarrier.beginStatus = iter->second;
                 presentBarrier.endStatus = {gfx::AccessFlagBit::PRESENT, iter->second.range};
-                presentBarrier.barrier = getGFXBarrier(presentBarrier);
+                presentBarrier.barrier = getGFXBarrier(presentBarrier, resourceGraph);
 
                 states.states = gfx::AccessFlagBit::NONE;
             }
@@ -2146,7 +2171,10 @@ struct PassVisitor : boost::dfs_visitor<> {
             }
             rootEdge = false;
         }
-        assert(foundIntersect);
+        if (!foundIntersect) {
+            // not a closed walk, nothing to merge
+            return;
+        }
 
         using LhsRangePair = std::pair<RelationGraph::out_edge_iterator, OutEdgeRange>;
         auto branchVert = source(rhsPath.first, g);
@@ -2177,7 +2205,9 @@ struct PassVisitor : boost::dfs_visitor<> {
             }
             rootEdge = true;
         }
-        assert(found);
+        if (!found) {
+            return;
+        }
         lhsPath.second = e;
 
         _circuits.emplace_back(CloseCircuit{lhsPath, rhsPath});
@@ -2217,6 +2247,7 @@ auto evaluateHeaviness(const ResourceAccessGraph &rag, const ResourceGraph &resc
                 eval = gfx::formatSize(desc.format, desc.width, desc.height, desc.depthOrArraySize);
                 break;
         }
+        score += eval;
 
         if (traits.residency == ResourceResidency::MEMORYLESS) {
             forceAdjacent = true;
@@ -2488,6 +2519,206 @@ void applyRelation(RelationGraph &relationGraph, const TargetGraph &targetGraph)
     }
 }
 
+// execution position of each access graph vertex,
+// vertices missing from the order (culled passes) are placed after all scheduled ones.
+ccstd::pmr::vector<uint32_t> getExecPositions(
+    const ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> &order,
+    uint32_t numVertices,
+    boost::container::pmr::memory_resource *scratch) {
+    ccstd::pmr::vector<uint32_t> positions(numVertices, INVALID_ID, scratch);
+    for (uint32_t i = 0; i != order.size(); ++i) {
+        positions[order[i]] = i;
+    }
+    for (uint32_t v = 0; v != numVertices; ++v) {
+        if (positions[v] == INVALID_ID) {
+            positions[v] = numVertices + v;
+        }
+    }
+    return positions;
+}
+
+bool isRasterPass(const ResourceAccessGraph &rag, const RenderGraph &rg, ResourceAccessGraph::vertex_descriptor ragVert) {
+    if (ragVert == EXPECT_START_ID) {
+        return false;
+    }
+    const auto passID = get(ResourceAccessGraph::PassIDTag{}, rag, ragVert);
+    if (passID == RenderGraph::null_vertex()) {
+        return false;
+    }
+    return holds<RasterPassTag>(passID, rg) || holds<RasterSubpassTag>(passID, rg);
+}
+
+struct ScheduleCost {
+    uint32_t barriers{0};
+    uint32_t renderPassBreaks{0};
+};
+
+// Mirrors buildBarriers: walks the accesses of every resource in execution order,
+// each dependent transition costs one barrier, or a split pair if the passes are not adjacent.
+ScheduleCost evaluateSchedule(
+    const RenderGraph &rg, const ResourceGraph &resg, const ResourceAccessGraph &rag,
+    const ccstd::pmr::vector<uint32_t> &positions) {
+    ScheduleCost cost;
+    ccstd::vector<std::pair<uint32_t, gfx::AccessFlagBit>> accesses;
+    for (const auto &[resName, accessRecord] : rag.resourceAccess) {
+        const auto resID = findVertex(resName, resg);
+        const bool isBuffer = get(ResourceGraph::DescTag{}, resg, resID).dimension == ResourceDimension::BUFFER;
+        accesses.clear();
+        for (const auto &[ragVert, status] : accessRecord) {
+            accesses.emplace_back(ragVert, status.accessFlag);
+        }
+        std::stable_sort(accesses.begin(), accesses.end(), [&positions](const auto &lhs, const auto &rhs) {
+            return positions[lhs.first] < positions[rhs.first];
+        });
+        for (size_t i = 1; i < accesses.size(); ++i) {
+            const auto &[srcVert, srcAccess] = accesses[i - 1];
+            const auto &[dstVert, dstAccess] = accesses[i];
+            if (srcVert == EXPECT_START_ID) {
+                ++cost.barriers;
+                continue;
+            }
+            if (!accessDependent(srcAccess, dstAccess, isBuffer)) {
+                continue;
+            }
+            const bool adjacent = isPassExecAdjecent(positions[srcVert], positions[dstVert]);
+            cost.barriers += adjacent ? 1 : 2;
+            if (!adjacent && isAttachmentAccess(srcAccess) &&
+                isRasterPass(rag, rg, srcVert) && isRasterPass(rag, rg, dstVert)) {
+                ++cost.renderPassBreaks;
+            }
+        }
+    }
+    return cost;
+}
+
+// A schedule is valid if it keeps every original dependency, every hazardous pair of
+// resource accesses and keeps subpasses right behind their render pass or previous sibling.
+bool isValidSchedule(
+    const RenderGraph &rg, const ResourceGraph &resg, const ResourceAccessGraph &rag,
+    const ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> &schedule,
+    const ccstd::pmr::vector<uint32_t> &positions,
+    const ccstd::pmr::vector<uint32_t> &originalPositions,
+    const ccstd::pmr::vector<std::pair<ResourceAccessGraph::vertex_descriptor, ResourceAccessGraph::vertex_descriptor>> &dependencies) {
+    if (schedule.empty() || schedule.front() != EXPECT_START_ID) {
+        return false;
+    }
+    for (const auto &[srcVert, dstVert] : dependencies) {
+        if (positions[srcVert] >= positions[dstVert]) {
+            return false;
+        }
+    }
+    for (const auto &[resName, accessRecord] : rag.resourceAccess) {
+        const auto resID = findVertex(resName, resg);
+        const bool isBuffer = get(ResourceGraph::DescTag{}, resg, resID).dimension == ResourceDimension::BUFFER;
+        for (auto lhs = accessRecord.begin(); lhs != accessRecord.end(); ++lhs) {
+            for (auto rhs = std::next(lhs); rhs != accessRecord.end(); ++rhs) {
+                if (!accessDependent(lhs->second.accessFlag, rhs->second.accessFlag, isBuffer)) {
+                    continue;
+                }
+                const bool wasBefore = originalPositions[lhs->first] < originalPositions[rhs->first];
+                const bool isBefore = positions[lhs->first] < positions[rhs->first];
+                if (wasBefore != isBefore) {
+                    return false;
+                }
+            }
+        }
+    }
+    for (uint32_t i = 1; i < schedule.size(); ++i) {
+        const auto ragVert = schedule[i];
+        const auto passID = get(ResourceAccessGraph::PassIDTag{}, rag, ragVert);
+        if (passID == RenderGraph::null_vertex() ||
+            !(holds<RasterSubpassTag>(passID, rg) || holds<ComputeSubpassTag>(passID, rg))) {
+            continue;
+        }
+        const auto parentID = parent(passID, rg);
+        const auto prevVert = schedule[i - 1];
+        if (prevVert == rag.passIndex.at(parentID)) {
+            continue;
+        }
+        if (prevVert == EXPECT_START_ID) {
+            return false;
+        }
+        const auto prevPassID = get(ResourceAccessGraph::PassIDTag{}, rag, prevVert);
+        if (prevPassID == RenderGraph::null_vertex() || parent(prevPassID, rg) != parentID ||
+            originalPositions[prevVert] > originalPositions[ragVert]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Kahn's algorithm over the reduced relation graph. Among ready passes, prefer the ones
+// consuming what the last scheduled pass produced, so producer and consumer stay adjacent,
+// then the lighter ones, then the original order. Returns false on a cycle.
+bool scheduleRelationGraph(
+    const ResourceAccessGraph &rag, const ResourceGraph &resourceGraph,
+    const RelationGraph &relationGraph,
+    ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> &schedule) {
+    const auto numVerts = static_cast<uint32_t>(num_vertices(relationGraph));
+    auto *scratch = schedule.get_allocator().resource();
+    ccstd::pmr::vector<uint32_t> inDegrees(numVerts, 0, scratch);
+    for (const auto vert : makeRange(vertices(relationGraph))) {
+        inDegrees[vert] = static_cast<uint32_t>(in_degree(vert, relationGraph));
+    }
+
+    ScoreMap scoreMap;
+    auto getWeight = [&](RelationVert vert) {
+        auto iter = scoreMap.find(vert);
+        if (iter == scoreMap.end()) {
+            const auto ragVert = get(RelationGraph::DescIDTag{}, relationGraph, vert);
+            const auto backward = std::get<1>(evaluateHeaviness(rag, resourceGraph, ragVert, false));
+            const auto forward = std::get<1>(evaluateHeaviness(rag, resourceGraph, ragVert, true));
+            iter = scoreMap.emplace(vert, std::pair<int64_t, int64_t>{backward, forward}).first;
+        }
+        return iter->second.first - iter->second.second;
+    };
+
+    RelationVerts candidates;
+    auto retire = [&](RelationVert vert) {
+        schedule.emplace_back(get(RelationGraph::DescIDTag{}, relationGraph, vert));
+        for (const auto e : makeRange(out_edges(vert, relationGraph))) {
+            const auto targetID = target(e, relationGraph);
+            if (--inDegrees[targetID] == 0) {
+                candidates.emplace_back(targetID);
+            }
+        }
+    };
+
+    schedule.clear();
+    schedule.reserve(numVerts);
+    // passes touching nothing produced in this graph (e.g. present) have no incoming edge at all
+    for (const auto vert : makeRange(vertices(relationGraph))) {
+        if (vert != EXPECT_START_ID && !inDegrees[vert]) {
+            candidates.emplace_back(vert);
+        }
+    }
+    retire(EXPECT_START_ID);
+    RelationVert lastVert = EXPECT_START_ID;
+    while (!candidates.empty()) {
+        auto best = candidates.begin();
+        for (auto iter = std::next(candidates.begin()); iter != candidates.end(); ++iter) {
+            const bool lhsAdjacent = edge(lastVert, *iter, relationGraph).second;
+            const bool rhsAdjacent = edge(lastVert, *best, relationGraph).second;
+            if (lhsAdjacent != rhsAdjacent) {
+                if (lhsAdjacent) {
+                    best = iter;
+                }
+                continue;
+            }
+            const auto lhsWeight = getWeight(*iter);
+            const auto rhsWeight = getWeight(*best);
+            if (lhsWeight < rhsWeight || (lhsWeight == rhsWeight && *iter < *best)) {
+                best = iter;
+            }
+        }
+        const auto vert = *best;
+        candidates.erase(best);
+        retire(vert);
+        lastVert = vert;
+    }
+    return schedule.size() == numVerts;
+}
+
 void passReorder(FrameGraphDispatcher &fgDispatcher) {
     auto *scratch = fgDispatcher.scratch;
     const auto &renderGraph = fgDispatcher.renderGraph;
@@ -2502,6 +2733,22 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
         fgDispatcher._accessGraphBuilt = true;
     }
 
+    auto &stats = fgDispatcher.passReorderStats;
+    stats = {};
+    fgDispatcher.passOrder.clear();
+
+    // schedule and dependencies before reduction, the reordered schedule is checked against them
+    const ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> originalOrder(
+        rag.topologicalOrder.begin(), rag.topologicalOrder.end(), scratch);
+    ccstd::pmr::vector<std::pair<ResourceAccessGraph::vertex_descriptor, ResourceAccessGraph::vertex_descriptor>> dependencies(scratch);
+    for (const auto rlgVert : makeRange(vertices(relationGraph))) {
+        for (const auto e : makeRange(out_edges(rlgVert, relationGraph))) {
+            dependencies.emplace_back(
+                get(RelationGraph::DescIDTag{}, relationGraph, rlgVert),
+                get(RelationGraph::DescIDTag{}, relationGraph, target(e, relationGraph)));
+        }
+    }
+
     {
         // determine do mem saving how many times
         RelationGraph relationGraphTc(fgDispatcher.get_allocator());
@@ -2529,78 +2776,73 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
             }
         }
 
-        // topological sort
-        rag.topologicalOrder.clear();
-        bool empty = relationGraph._vertices.empty();
-        ScoreMap scoreMap;
-        RelationVerts candidates;
-        candidates.push_back(EXPECT_START_ID);
-
-        ccstd::vector<RelationVert> candidateBuffer;
-        uint32_t coloredVerts = 0;
-        while (coloredVerts < relationGraph._vertices.size()) {
-            // decreasing order, pop back from vector, push into queue, then it's ascending order.
-            std::sort(candidates.begin(), candidates.end(), [&](RelationVert lhsVert, RelationVert rhsVert) {
-                int64_t lhsForwardScore{0};
-                int64_t rhsForwardScore{0};
-                int64_t lhsBackwardScore{0};
-                int64_t rhsBackwardScore{0};
-                if (scoreMap.find(lhsVert) == scoreMap.end()) {
-                    auto lhsRagVert = get(RelationGraph::DescIDTag{}, relationGraph, lhsVert);
-                    const auto &lhsForwardStatus = evaluateHeaviness(rag, resourceGraph, lhsRagVert, true);
-                    lhsForwardScore = get<1>(lhsForwardStatus);
-                    const auto &lhsBackwardStatus = evaluateHeaviness(rag, resourceGraph, lhsRagVert, false);
-                    lhsBackwardScore = get<1>(lhsBackwardStatus);
-                    scoreMap.emplace(lhsVert, std::pair<int64_t, int64_t>{lhsBackwardScore, lhsForwardScore});
-                } else {
-                    lhsBackwardScore = scoreMap[lhsVert].first;
-                    lhsForwardScore = scoreMap[lhsVert].second;
-                }
-
-                if (scoreMap.find(rhsVert) == scoreMap.end()) {
-                    auto rhsRagVert = get(RelationGraph::DescIDTag{}, relationGraph, rhsVert);
-                    const auto &rhsForwardStatus = evaluateHeaviness(rag, resourceGraph, rhsRagVert, true);
-                    rhsForwardScore = get<1>(rhsForwardStatus);
-                    const auto &rhsBackwardStatus = evaluateHeaviness(rag, resourceGraph, rhsRagVert, false);
-                    rhsBackwardScore = get<1>(rhsBackwardStatus);
-                    scoreMap.emplace(rhsVert, std::pair<int64_t, int64_t>{rhsBackwardScore, rhsForwardScore});
-                } else {
-                    rhsBackwardScore = scoreMap[rhsVert].first;
-                    rhsForwardScore = scoreMap[rhsVert].second;
-                }
-                return lhsBackwardScore - lhsForwardScore > rhsBackwardScore - rhsForwardScore;
-            });
+        // snapshot of the reduced relation, kept as the access graph edges if the schedule is accepted
+        ccstd::pmr::vector<std::pair<ResourceAccessGraph::vertex_descriptor, ResourceAccessGraph::vertex_descriptor>> reducedEdges(scratch);
+        for (const auto rlgVert : makeRange(vertices(relationGraph))) {
+            for (const auto e : makeRange(out_edges(rlgVert, relationGraph))) {
+                reducedEdges.emplace_back(
+                    get(RelationGraph::DescIDTag{}, relationGraph, rlgVert),
+                    get(RelationGraph::DescIDTag{}, relationGraph, target(e, relationGraph)));
+            }
+        }
 
-            const auto vert = candidates.back();
-            candidates.pop_back();
+        ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> schedule(scratch);
+        if (!scheduleRelationGraph(rag, resourceGraph, relationGraph, schedule)) {
+            stats.rejected = true;
+            return;
+        }
 
-            auto ragVert = get(RelationGraph::DescIDTag{}, relationGraph, vert);
-            rag.topologicalOrder.emplace_back(ragVert);
-            if (!candidateBuffer.empty()) {
-                candidates.insert(candidates.end(), candidateBuffer.begin(), candidateBuffer.end());
-                candidateBuffer.clear();
+        const auto numVerts = static_cast<uint32_t>(num_vertices(rag));
+        const auto originalPositions = getExecPositions(originalOrder, numVerts, scratch);
+        const auto positions = getExecPositions(schedule, numVerts, scratch);
+        for (uint32_t i = 0; i != schedule.size(); ++i) {
+            if (schedule[i] != originalOrder[i]) {
+                ++stats.numMovedPasses;
             }
+        }
 
-            for (const auto nextGeneration : makeRange(out_edges(vert, relationGraph))) {
-                auto targetID = target(nextGeneration, relationGraph);
-                if (in_degree(targetID, relationGraph) == 1) {
-                    candidateBuffer.emplace_back(targetID);
-                }
-            }
+        const auto before = evaluateSchedule(renderGraph, resourceGraph, rag, originalPositions);
+        stats.barriersBefore = before.barriers;
+        stats.barriersAfter = before.barriers;
+        stats.renderPassBreaksBefore = before.renderPassBreaks;
+        stats.renderPassBreaksAfter = before.renderPassBreaks;
+        if (!stats.numMovedPasses) {
+            return;
+        }
 
-            auto deprecatedEdges = out_edges(vert, relationGraph);
-            for (auto iter = deprecatedEdges.first; iter < deprecatedEdges.second;) {
-                remove_edge(*iter, relationGraph);
-                deprecatedEdges = out_edges(vert, relationGraph);
-                iter = deprecatedEdges.first;
-            }
+        if (!isValidSchedule(renderGraph, resourceGraph, rag, schedule, positions, originalPositions, dependencies)) {
+            stats.numMovedPasses = 0;
+            stats.rejected = true;
+            return;
+        }
 
-            if (candidates.empty()) {
-                candidates.insert(candidates.end(), candidateBuffer.begin(), candidateBuffer.end());
-                candidateBuffer.clear();
+        // only keep schedules which strictly pay off
+        const auto after = evaluateSchedule(renderGraph, resourceGraph, rag, positions);
+        const bool noWorse = after.barriers <= before.barriers &&
+                             after.renderPassBreaks <= before.renderPassBreaks;
+        const bool better = after.barriers < before.barriers ||
+                            after.renderPassBreaks < before.renderPassBreaks;
+        if (!noWorse || !better) {
+            stats.numMovedPasses = 0;
+            stats.rejected = true;
+            return;
+        }
+        stats.barriersAfter = after.barriers;
+        stats.renderPassBreaksAfter = after.renderPassBreaks;
+
+        rag.topologicalOrder.assign(schedule.begin(), schedule.end());
+        auto &passOrder = fgDispatcher.passOrder;
+        passOrder.reserve(schedule.size());
+        for (const auto ragVert : schedule) {
+            if (ragVert == EXPECT_START_ID) {
+                continue;
             }
-
-            coloredVerts++;
+            const auto passID = get(ResourceAccessGraph::PassIDTag{}, rag, ragVert);
+            if (passID == RenderGraph::null_vertex() || parent(passID, renderGraph) != RenderGraph::null_vertex()) {
+                // present node or subpass
+                continue;
+            }
+            passOrder.emplace_back(passID);
         }
 
         // remove all edges
@@ -2610,22 +2852,239 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
         }
 
         // apply relation
-        for (auto rlgVert : makeRange(vertices(relationGraph))) {
-            auto ragVert = get(RelationGraph::DescIDTag{}, relationGraph, rlgVert);
-            auto inEdges = in_edges(rlgVert, relationGraph);
-            for (auto e : makeRange(inEdges)) {
-                auto srcRlgVert = source(e, relationGraph);
-                auto srcRagVert = get(RelationGraph::DescIDTag{}, relationGraph, srcRlgVert);
-                add_edge(srcRagVert, ragVert, rag);
-            }
+        for (const auto &[srcRagVert, dstRagVert] : reducedEdges) {
+            add_edge(srcRagVert, dstRagVert, rag);
         }
     }
 }
 
 #pragma endregion PASS_REORDER
 
+#pragma region MEMORY_ALIASING
+namespace {
+
+constexpr uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+struct TransientLifetime {
+    ResourceGraph::vertex_descriptor resID{ResourceGraph::null_vertex()};
+    // execution positions of the first and last pass accessing the resource
+    uint32_t start{0xFFFFFFFF};
+    uint32_t end{0};
+    ResourceAccessGraph::vertex_descriptor firstPass{ResourceAccessGraph::null_vertex()};
+    ResourceAccessGraph::vertex_descriptor lastPass{ResourceAccessGraph::null_vertex()};
+    gfx::AccessFlagBit firstAccess{gfx::AccessFlagBit::NONE};
+    gfx::AccessFlagBit lastAccess{gfx::AccessFlagBit::NONE};
+    uint64_t size{0};
+    bool buffer{false};
+};
+
+uint64_t getResourceMemorySize(const ResourceDesc &desc) {
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        return desc.width;
+    }
+    uint32_t width = desc.width;
+    uint32_t height = desc.height;
+    uint32_t depth = desc.depthOrArraySize ? desc.depthOrArraySize : 1;
+    const uint32_t mipLevels = desc.mipLevels ? desc.mipLevels : 1;
+    uint64_t size = 0;
+    for (uint32_t mip = 0; mip != mipLevels; ++mip) {
+        size += gfx::formatSize(desc.format, width, height, depth);
+        width = std::max(width >> 1, 1U);
+        height = std::max(height >> 1, 1U);
+        if (desc.dimension == ResourceDimension::TEXTURE3D) {
+            depth = std::max(depth >> 1, 1U);
+        }
+    }
+    return size * static_cast<uint64_t>(desc.sampleCount);
+}
+
+ResourceGraph::vertex_descriptor rootResourceID(ResourceGraph::vertex_descriptor resID, const ResourceGraph &resg) {
+    auto parentID = parent(resID, resg);
+    while (parentID != ResourceGraph::null_vertex()) {
+        resID = parentID;
+        parentID = parent(resID, resg);
+    }
+    return resID;
+}
+
+// the next occupant of a slot must not start before the previous one is done with the memory,
+// the barrier goes in front of the pass first accessing the next occupant.
+void addAliasingBarrier(FrameGraphDispatcher &fgDispatcher, const TransientLifetime &prev, const TransientLifetime &next) {
+    const auto &renderGraph = fgDispatcher.renderGraph;
+    const auto &resourceGraph = fgDispatcher.resourceGraph;
+    auto &rag = fgDispatcher.resourceAccessGraph;
+
+    auto ragVertID = next.firstPass;
+    auto passID = get(ResourceAccessGraph::PassIDTag{}, rag, ragVertID);
+    // subpasses do not submit barriers, their render pass does
+    if (holds<RasterSubpassTag>(passID, renderGraph) || holds<ComputeSubpassTag>(passID, renderGraph)) {
+        passID = parent(passID, renderGraph);
+        ragVertID = rag.passIndex.at(passID);
+    }
+
+    const auto range = getResourceRange(next.resID, resourceGraph);
+    auto &barrierNode = get(ResourceAccessGraph::BarrierTag{}, rag, ragVertID);
+    auto &aliasingBarrier = barrierNode.frontBarriers.emplace_back();
+    aliasingBarrier.resourceID = next.resID;
+    aliasingBarrier.type = gfx::BarrierType::FULL;
+    aliasingBarrier.beginVert = get(ResourceAccessGraph::PassIDTag{}, rag, prev.lastPass);
+    aliasingBarrier.endVert = passID;
+    aliasingBarrier.beginStatus = {prev.lastAccess, range};
+    aliasingBarrier.endStatus = {next.firstAccess, range};
+    aliasingBarrier.barrier = getGFXBarrier(aliasingBarrier, resourceGraph);
+}
+
+} // namespace
+
+// Lifetime-interval aliasing of transient (managed) resources.
+// Passes are numbered by their execution position, the same order buildBarriers walks,
+// each transient resource lives from the first to the last pass accessing it. Resources are then packed
+// greedily into memory slots, a slot can be reused once its last occupant is dead.
+// Textures and buffers never share a slot, not all backends support mixing them in a heap.
+// Consecutive occupants of a slot are separated by an aliasing barrier.
 void memoryAliasing(FrameGraphDispatcher &fgDispatcher) {
+    const auto &renderGraph = fgDispatcher.renderGraph;
+    const auto &layoutGraph = fgDispatcher.layoutGraph;
+    auto &resourceGraph = fgDispatcher.resourceGraph;
+    auto &relationGraph = fgDispatcher.relationGraph;
+    auto &rag = fgDispatcher.resourceAccessGraph;
+    auto *scratch = fgDispatcher.scratch;
+
+    if (!fgDispatcher._accessGraphBuilt) {
+        Graphs graphs{renderGraph, layoutGraph, resourceGraph, rag, relationGraph};
+        buildAccessGraph(graphs);
+        fgDispatcher._accessGraphBuilt = true;
+    }
+
+    auto &slots = fgDispatcher.memorySlots;
+    auto &slotIndex = fgDispatcher.memorySlotIndex;
+    auto &stats = fgDispatcher.memoryAliasingStats;
+    slots.clear();
+    slotIndex.clear();
+    stats = {};
+
+    const ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> noReorder(scratch);
+    const auto numVertices = static_cast<uint32_t>(num_vertices(rag));
+    const auto execPositions = getExecPositions(
+        fgDispatcher.passOrder.empty() ? noReorder : rag.topologicalOrder,
+        numVertices, scratch);
+
+    // collect lifetimes
+    ccstd::pmr::vector<TransientLifetime> lifetimes(scratch);
+    PmrFlatMap<ResourceGraph::vertex_descriptor, uint32_t> lifetimeIndex(scratch);
+    rag.resourceLifeRecord.clear();
+    for (const auto &[name, accesses] : rag.resourceAccess) {
+        const auto resID = findVertex(name, resourceGraph);
+        if (resID == ResourceGraph::null_vertex()) {
+            continue;
+        }
+        for (const auto &[ragVertID, status] : accesses) {
+            if (ragVertID == EXPECT_START_ID) {
+                continue;
+            }
+            const auto position = execPositions[ragVertID];
+            auto recordIter = rag.resourceLifeRecord.find(name);
+            if (recordIter == rag.resourceLifeRecord.end()) {
+                rag.resourceLifeRecord.emplace(name, ResourceLifeRecord{position, position});
+            } else {
+                recordIter->second.start = std::min(recordIter->second.start, position);
+                recordIter->second.end = std::max(recordIter->second.end, position);
+            }
+
+            const auto rootID = rootResourceID(resID, resourceGraph);
+            const auto &traits = get(ResourceGraph::TraitsTag{}, resourceGraph, rootID);
+            if (traits.residency != ResourceResidency::MANAGED) {
+                continue;
+            }
+            auto iter = lifetimeIndex.find(rootID);
+            if (iter == lifetimeIndex.end()) {
+                const auto &desc = get(ResourceGraph::DescTag{}, resourceGraph, rootID);
+                iter = lifetimeIndex.emplace(rootID, static_cast<uint32_t>(lifetimes.size())).first;
+                auto &lifetime = lifetimes.emplace_back();
+                lifetime.resID = rootID;
+                lifetime.size = getResourceMemorySize(desc);
+                lifetime.buffer = desc.dimension == ResourceDimension::BUFFER;
+            }
+            auto &lifetime = lifetimes[iter->second];
+            if (position < lifetime.start) {
+                lifetime.start = position;
+                lifetime.firstPass = ragVertID;
+                lifetime.firstAccess = status.accessFlag;
+            } else if (position == lifetime.start) {
+                lifetime.firstAccess |= status.accessFlag;
+            }
+            if (lifetime.lastPass == ResourceAccessGraph::null_vertex() || position > lifetime.end) {
+                lifetime.end = position;
+                lifetime.lastPass = ragVertID;
+                lifetime.lastAccess = status.accessFlag;
+            } else if (position == lifetime.end) {
+                lifetime.lastAccess |= status.accessFlag;
+            }
+        }
+    }
+
+    // memory alive at each pass, without aliasing every allocation lives for the whole frame.
+    // passes missing from the execution order are placed after it, see getExecPositions.
+    ccstd::pmr::vector<uint64_t> liveMemory(2 * static_cast<size_t>(numVertices), 0, scratch);
+    for (const auto &lifetime : lifetimes) {
+        stats.transientMemory += lifetime.size;
+        for (uint32_t position = lifetime.start; position <= lifetime.end; ++position) {
+            liveMemory[position] += lifetime.size;
+        }
+    }
+    for (const auto live : liveMemory) {
+        stats.liveTransientMemory = std::max(stats.liveTransientMemory, live);
+    }
+    stats.numTransientResources = static_cast<uint32_t>(lifetimes.size());
+
+    // earlier first, larger first if starting at the same pass, resource id keeps it deterministic
+    std::sort(lifetimes.begin(), lifetimes.end(), [](const TransientLifetime &lhs, const TransientLifetime &rhs) {
+        return std::forward_as_tuple(lhs.start, rhs.size, lhs.resID) < std::forward_as_tuple(rhs.start, lhs.size, rhs.resID);
+    });
+
+    // last occupant of each slot, in lifetimes
+    ccstd::pmr::vector<uint32_t> lastOccupants(scratch);
+    for (uint32_t lifetimeID = 0; lifetimeID != lifetimes.size(); ++lifetimeID) {
+        const auto &lifetime = lifetimes[lifetimeID];
+        // best fit among free slots: the smallest one large enough,
+        // otherwise grow the largest one.
+        uint32_t bestFit = INVALID_SLOT;
+        uint32_t largest = INVALID_SLOT;
+        for (uint32_t slotID = 0; slotID != slots.size(); ++slotID) {
+            const auto &slot = slots[slotID];
+            if (slot.buffer != lifetime.buffer || slot.lastUse >= lifetime.start) {
+                continue;
+            }
+            if (slot.size >= lifetime.size) {
+                if (bestFit == INVALID_SLOT || slot.size < slots[bestFit].size) {
+                    bestFit = slotID;
+                }
+            } else if (largest == INVALID_SLOT || slot.size > slots[largest].size) {
+                largest = slotID;
+            }
+        }
+        auto slotID = bestFit != INVALID_SLOT ? bestFit : largest;
+        if (slotID == INVALID_SLOT) {
+            slotID = static_cast<uint32_t>(slots.size());
+            slots.emplace_back(TransientMemorySlot{0, 0, lifetime.buffer});
+            lastOccupants.emplace_back(lifetimeID);
+        } else {
+            addAliasingBarrier(fgDispatcher, lifetimes[lastOccupants[slotID]], lifetime);
+            lastOccupants[slotID] = lifetimeID;
+            ++stats.numAliasingBarriers;
+        }
+        auto &slot = slots[slotID];
+        slot.size = std::max(slot.size, lifetime.size);
+        slot.lastUse = lifetime.end;
+        slotIndex.emplace(lifetime.resID, slotID);
+    }
+
+    for (const auto &slot : slots) {
+        stats.aliasedTransientMemory += slot.size;
+    }
+    stats.numMemorySlots = static_cast<uint32_t>(slots.size());
 }
+#pragma endregion MEMORY_ALIASING
 
 #pragma region assisstantFuncDefinition
 template <typename Graph>
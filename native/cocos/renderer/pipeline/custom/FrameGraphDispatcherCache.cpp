@@ -0,0 +1,324 @@
+/****************************************************************************
+ Copyright (c) 2021-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/FrameGraphDispatcherCache.h"
+#include <algorithm>
+#include "cocos/renderer/pipeline/custom/LayoutGraphGraphs.h"
+#include "cocos/renderer/pipeline/custom/RenderGraphGraphs.h"
+#include "cocos/renderer/pipeline/custom/details/Range.h"
+
+namespace cc {
+
+namespace render {
+
+namespace {
+
+using ccstd::hash_combine;
+
+void hashDesc(ccstd::hash_t &seed, const ResourceDesc &desc) {
+    hash_combine(seed, desc.dimension);
+    hash_combine(seed, desc.alignment);
+    hash_combine(seed, desc.width);
+    hash_combine(seed, desc.height);
+    hash_combine(seed, desc.depthOrArraySize);
+    hash_combine(seed, desc.mipLevels);
+    hash_combine(seed, desc.format);
+    hash_combine(seed, desc.sampleCount);
+    hash_combine(seed, desc.textureFlags);
+    hash_combine(seed, desc.flags);
+    hash_combine(seed, desc.viewType);
+}
+
+template <class Views>
+void hashRasterViews(ccstd::hash_t &seed, const Views &rasterViews) {
+    for (const auto &[name, view] : rasterViews) {
+        hash_combine(seed, name);
+        hash_combine(seed, view);
+        hash_combine(seed, view.slotID);
+    }
+}
+
+template <class Pair>
+void hashPairRange(ccstd::hash_t &seed, const Pair &pair) {
+    hash_combine(seed, pair.target);
+    hash_combine(seed, pair.mipLevels);
+    hash_combine(seed, pair.numSlices);
+    hash_combine(seed, pair.targetMostDetailedMip);
+    hash_combine(seed, pair.targetFirstSlice);
+    hash_combine(seed, pair.targetPlaneSlice);
+}
+
+void hashPass(ccstd::hash_t &seed, RenderGraph::vertex_descriptor v, const RenderGraph &rg) {
+    if (const auto *pass = get_if<RasterPass>(v, &rg)) {
+        hash_combine(seed, *pass);
+        hashRasterViews(seed, pass->rasterViews);
+        hash_combine(seed, pass->attachmentIndexMap);
+    } else if (const auto *subpass = get_if<RasterSubpass>(v, &rg)) {
+        hashRasterViews(seed, subpass->rasterViews);
+        hash_combine(seed, subpass->computeViews);
+        hash_combine(seed, subpass->resolvePairs);
+        hash_combine(seed, subpass->subpassID);
+        hash_combine(seed, subpass->count);
+        hash_combine(seed, subpass->quality);
+    } else if (const auto *computeSubpass = get_if<ComputeSubpass>(v, &rg)) {
+        hashRasterViews(seed, computeSubpass->rasterViews);
+        hash_combine(seed, computeSubpass->computeViews);
+        hash_combine(seed, computeSubpass->subpassID);
+    } else if (const auto *compute = get_if<ComputePass>(v, &rg)) {
+        hash_combine(seed, compute->computeViews);
+        hash_combine(seed, compute->textures);
+    } else if (const auto *resolve = get_if<ResolvePass>(v, &rg)) {
+        hash_combine(seed, resolve->resolvePairs);
+    } else if (const auto *copy = get_if<CopyPass>(v, &rg)) {
+        for (const auto &pair : copy->copyPairs) {
+            hash_combine(seed, pair.source);
+            hash_combine(seed, pair.sourceMostDetailedMip);
+            hash_combine(seed, pair.sourceFirstSlice);
+            hash_combine(seed, pair.sourcePlaneSlice);
+            hashPairRange(seed, pair);
+        }
+        for (const auto &pair : copy->uploadPairs) {
+            // upload contents are consumed by the executor, not by the dispatcher
+            hashPairRange(seed, pair);
+        }
+    } else if (const auto *move = get_if<MovePass>(v, &rg)) {
+        for (const auto &pair : move->movePairs) {
+            hash_combine(seed, pair.source);
+            hashPairRange(seed, pair);
+        }
+    } else if (const auto *raytrace = get_if<RaytracePass>(v, &rg)) {
+        hash_combine(seed, raytrace->computeViews);
+    }
+}
+
+uint32_t getViewCount(RenderGraph::vertex_descriptor v, const RenderGraph &rg) {
+    if (const auto *pass = get_if<RasterPass>(v, &rg)) {
+        return static_cast<uint32_t>(pass->rasterViews.size() + pass->computeViews.size());
+    }
+    if (const auto *subpass = get_if<RasterSubpass>(v, &rg)) {
+        return static_cast<uint32_t>(subpass->rasterViews.size() + subpass->computeViews.size() + subpass->resolvePairs.size());
+    }
+    if (const auto *computeSubpass = get_if<ComputeSubpass>(v, &rg)) {
+        return static_cast<uint32_t>(computeSubpass->rasterViews.size() + computeSubpass->computeViews.size());
+    }
+    if (const auto *compute = get_if<ComputePass>(v, &rg)) {
+        return static_cast<uint32_t>(compute->computeViews.size());
+    }
+    if (const auto *resolve = get_if<ResolvePass>(v, &rg)) {
+        return static_cast<uint32_t>(resolve->resolvePairs.size());
+    }
+    if (const auto *copy = get_if<CopyPass>(v, &rg)) {
+        return static_cast<uint32_t>(copy->copyPairs.size() + copy->uploadPairs.size());
+    }
+    if (const auto *move = get_if<MovePass>(v, &rg)) {
+        return static_cast<uint32_t>(move->movePairs.size());
+    }
+    if (const auto *raytrace = get_if<RaytracePass>(v, &rg)) {
+        return static_cast<uint32_t>(raytrace->computeViews.size());
+    }
+    return 0;
+}
+
+void appendPointer(ccstd::vector<uint32_t> &signature, const void *ptr) {
+    const auto value = reinterpret_cast<uintptr_t>(ptr);
+    signature.emplace_back(static_cast<uint32_t>(value));
+    signature.emplace_back(static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32));
+}
+
+} // namespace
+
+ccstd::hash_t hashRenderGraphStructure(
+    const RenderGraph &rg,
+    const ResourceGraph &resg,
+    const LayoutGraphData &lg) {
+    ccstd::hash_t seed = 0;
+
+    // cached dispatchers keep references to the graphs
+    hash_combine(seed, &rg);
+    hash_combine(seed, &resg);
+    hash_combine(seed, &lg);
+    hash_combine(seed, num_vertices(lg));
+    hash_combine(seed, lg.attributeIndex.size());
+
+    hash_combine(seed, num_vertices(rg));
+    for (const auto v : makeRange(vertices(rg))) {
+        hash_combine(seed, rg._vertices[v].handle.index());
+        hash_combine(seed, parent(v, rg));
+        hash_combine(seed, get(RenderGraph::LayoutTag{}, rg, v));
+        hashPass(seed, v, rg);
+    }
+    for (const auto v : rg.sortedVertices) {
+        hash_combine(seed, v);
+    }
+
+    hash_combine(seed, num_vertices(resg));
+    for (const auto v : makeRange(vertices(resg))) {
+        hash_combine(seed, resg._vertices[v].handle.index());
+        hash_combine(seed, parent(v, resg));
+        hash_combine(seed, get(ResourceGraph::NameTag{}, resg, v));
+        hashDesc(seed, get(ResourceGraph::DescTag{}, resg, v));
+        const auto &traits = get(ResourceGraph::TraitsTag{}, resg, v);
+        hash_combine(seed, traits.residency);
+        if (traits.hasSideEffects()) {
+            // initial barriers of external resources depend on their current states
+            hash_combine(seed, get(ResourceGraph::StatesTag{}, resg, v).states);
+        }
+    }
+    return seed;
+}
+
+void buildRenderGraphSignature(
+    const RenderGraph &rg,
+    const ResourceGraph &resg,
+    const LayoutGraphData &lg,
+    ccstd::vector<uint32_t> &signature) {
+    signature.clear();
+    appendPointer(signature, &rg);
+    appendPointer(signature, &resg);
+    appendPointer(signature, &lg);
+    signature.emplace_back(static_cast<uint32_t>(num_vertices(lg)));
+
+    signature.emplace_back(static_cast<uint32_t>(num_vertices(rg)));
+    for (const auto v : makeRange(vertices(rg))) {
+        signature.emplace_back(static_cast<uint32_t>(rg._vertices[v].handle.index()));
+        signature.emplace_back(static_cast<uint32_t>(parent(v, rg)));
+        signature.emplace_back(getViewCount(v, rg));
+    }
+    for (const auto v : rg.sortedVertices) {
+        signature.emplace_back(static_cast<uint32_t>(v));
+    }
+
+    signature.emplace_back(static_cast<uint32_t>(num_vertices(resg)));
+    for (const auto v : makeRange(vertices(resg))) {
+        signature.emplace_back(static_cast<uint32_t>(resg._vertices[v].handle.index()));
+        signature.emplace_back(static_cast<uint32_t>(parent(v, resg)));
+        const auto &desc = get(ResourceGraph::DescTag{}, resg, v);
+        signature.emplace_back(desc.width);
+        signature.emplace_back(desc.height);
+        signature.emplace_back(desc.depthOrArraySize);
+        signature.emplace_back(desc.mipLevels);
+        signature.emplace_back(static_cast<uint32_t>(desc.format));
+        signature.emplace_back(static_cast<uint32_t>(desc.flags));
+        const auto &traits = get(ResourceGraph::TraitsTag{}, resg, v);
+        signature.emplace_back(static_cast<uint32_t>(traits.residency));
+        if (traits.hasSideEffects()) {
+            signature.emplace_back(static_cast<uint32_t>(get(ResourceGraph::StatesTag{}, resg, v).states));
+        }
+    }
+}
+
+FrameGraphDispatcher &FrameGraphDispatcherCache::compile(
+    ResourceGraph &resg,
+    const RenderGraph &rg,
+    const LayoutGraphData &lg,
+    boost::container::pmr::memory_resource *scratch) {
+    ++_frame;
+
+    ccstd::hash_t key = 0;
+    if (_enabled) {
+        key = hashRenderGraphStructure(rg, resg, lg);
+        buildRenderGraphSignature(rg, resg, lg, _signature);
+        for (auto &entry : _entries) {
+            // on a hash collision the signatures differ, compile again
+            if (entry.dispatcher && entry.key == key && entry.signature == _signature) {
+                entry.lastUse = _frame;
+                for (const auto &[resID, states] : entry.finalStates) {
+                    get(ResourceGraph::StatesTag{}, resg, resID).states = states;
+                }
+                ++_hitCount;
+                return *entry.dispatcher;
+            }
+        }
+    }
+    ++_missCount;
+
+    auto &entry = acquireEntry();
+    entry.key = key;
+    entry.lastUse = _frame;
+    entry.finalStates.clear();
+    entry.dispatcher.reset();
+    entry.dispatcher = std::make_unique<FrameGraphDispatcher>(resg, rg, lg, scratch, scratch);
+
+    auto &fgd = *entry.dispatcher;
+    fgd.enableMemoryAliasing(_memoryAliasing);
+    fgd.enablePassReorder(_passReorder);
+    fgd.setParalellWeight(0);
+    fgd.run();
+
+    if (_enabled) {
+        entry.signature = _signature;
+        for (const auto v : makeRange(vertices(resg))) {
+            if (get(ResourceGraph::TraitsTag{}, resg, v).hasSideEffects()) {
+                entry.finalStates.emplace_back(v, get(ResourceGraph::StatesTag{}, resg, v).states);
+            }
+        }
+    }
+    return fgd;
+}
+
+FrameGraphDispatcherCache::Entry &FrameGraphDispatcherCache::acquireEntry() {
+    const uint32_t capacity = _enabled ? std::max(_capacity, 1U) : 1U;
+    if (_entries.size() < capacity) {
+        return _entries.emplace_back();
+    }
+    return *std::min_element(_entries.begin(), _entries.end(), [](const Entry &lhs, const Entry &rhs) {
+        return lhs.lastUse < rhs.lastUse;
+    });
+}
+
+void FrameGraphDispatcherCache::clear() {
+    _entries.clear();
+}
+
+void FrameGraphDispatcherCache::setEnabled(bool enabled) {
+    if (_enabled != enabled) {
+        _enabled = enabled;
+        clear();
+    }
+}
+
+void FrameGraphDispatcherCache::setPassReorder(bool enabled) {
+    if (_passReorder != enabled) {
+        _passReorder = enabled;
+        clear();
+    }
+}
+
+void FrameGraphDispatcherCache::setMemoryAliasing(bool enabled) {
+    if (_memoryAliasing != enabled) {
+        _memoryAliasing = enabled;
+        clear();
+    }
+}
+
+void FrameGraphDispatcherCache::setCapacity(uint32_t capacity) {
+    if (_capacity != capacity) {
+        _capacity = capacity;
+        clear();
+    }
+}
+
+} // namespace render
+
+} // namespace cc
@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2021-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include <memory>
+#include "cocos/base/std/container/vector.h"
+#include "cocos/base/std/hash/hash.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
+
+namespace cc {
+
+namespace render {
+
+// Structural hash of everything FrameGraphDispatcher::run() consumes:
+// pass topology and views of the render graph, descriptors, traits and
+// side-effect states of the resource graph, and the identity of the layout graph.
+ccstd::hash_t hashRenderGraphStructure(
+    const RenderGraph &rg,
+    const ResourceGraph &resg,
+    const LayoutGraphData &lg);
+
+// Compact structural signature of the same graphs: topology, view counts and
+// resource descriptors as plain integers. Compared on a hash hit, so a hash
+// collision falls back to a full compile instead of reusing another graph's barriers.
+void buildRenderGraphSignature(
+    const RenderGraph &rg,
+    const ResourceGraph &resg,
+    const LayoutGraphData &lg,
+    ccstd::vector<uint32_t> &signature);
+
+// Keeps compiled FrameGraphDispatchers across frames.
+// Render graphs are usually identical from frame to frame, when the structural hash
+// matches a cached entry its barriers, render pass infos and culled passes are reused
+// and only the resource states written back by buildBarriers are replayed.
+class FrameGraphDispatcherCache {
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 4;
+
+    FrameGraphDispatcherCache() = default;
+    FrameGraphDispatcherCache(FrameGraphDispatcherCache &&) = delete;
+    FrameGraphDispatcherCache(FrameGraphDispatcherCache const &) = delete;
+    FrameGraphDispatcherCache &operator=(FrameGraphDispatcherCache &&) = delete;
+    FrameGraphDispatcherCache &operator=(FrameGraphDispatcherCache const &) = delete;
+
+    // returns a dispatcher which has already run on rg,
+    // the reference stays valid until the next call to compile or clear.
+    FrameGraphDispatcher &compile(
+        ResourceGraph &resg,
+        const RenderGraph &rg,
+        const LayoutGraphData &lg,
+        boost::container::pmr::memory_resource *scratch);
+
+    void clear();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const noexcept { return _enabled; }
+
+    // compiled dispatchers reorder passes to shorten producer-consumer distances,
+    // see FrameGraphDispatcher::passReorderStats.
+    void setPassReorder(bool enabled);
+    bool isPassReorderEnabled() const noexcept { return _passReorder; }
+
+    // compiled dispatchers pack transient resources with disjoint lifetimes into shared memory slots,
+    // see FrameGraphDispatcher::memoryAliasingStats.
+    void setMemoryAliasing(bool enabled);
+    bool isMemoryAliasingEnabled() const noexcept { return _memoryAliasing; }
+
+    void setCapacity(uint32_t capacity);
+    uint32_t getCapacity() const noexcept { return _capacity; }
+
+    uint32_t getHitCount() const noexcept { return _hitCount; }
+    uint32_t getMissCount() const noexcept { return _missCount; }
+
+private:
+    struct Entry {
+        ccstd::hash_t key{0};
+        ccstd::vector<uint32_t> signature;
+        uint64_t lastUse{0};
+        std::unique_ptr<FrameGraphDispatcher> dispatcher;
+        // states of side-effect resources after buildBarriers
+        ccstd::vector<std::pair<ResourceGraph::vertex_descriptor, gfx::AccessFlagBit>> finalStates;
+    };
+
+    Entry &acquireEntry();
+
+    ccstd::vector<Entry> _entries;
+    ccstd::vector<uint32_t> _signature;
+    uint64_t _frame{0};
+    uint32_t _capacity{DEFAULT_CAPACITY};
+    uint32_t _hitCount{0};
+    uint32_t _missCount{0};
+    bool _enabled{true};
+    bool _passReorder{false};
+    bool _memoryAliasing{false};
+};
+
+} // namespace render
+
+} // namespace cc
@@ -32,6 +32,7 @@
 #include "PrivateTypes.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
+#include "cocos/base/job-system/JobSystem.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
 #include "cocos/renderer/pipeline/Define.h"
@@ -1037,6 +1038,36 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         // not supported yet
     }
 
+    // Mounts resources, uploads descriptors and creates framebuffers of a top-level pass,
+    // so that recording the pass afterwards only reads shared state.
+    void prepare(RenderGraph::vertex_descriptor vertID) const {
+        visitObject(
+            vertID, ctx.g,
+            [&](const RasterPass& pass) {
+                mountResources(pass);
+                NativePipeline::prepareDescriptors(ctx, vertID);
+                ctx.currentInFlightPassID = vertID;
+                fetchOrCreateFramebuffer(ctx, pass, ctx.scratch);
+            },
+            [&](const ComputePass& pass) {
+                mountResources(pass);
+                NativePipeline::prepareDescriptors(ctx, vertID);
+            },
+            [&](const ResolvePass& pass) {
+                mountResources(pass);
+            },
+            [&](const CopyPass& pass) {
+                mountResources(pass);
+            },
+            [&](const MovePass& pass) {
+                mountResources(pass);
+            },
+            [&](const RaytracePass& pass) {
+                mountResources(pass);
+            },
+            [&](const auto& /*subpassOrLeaf*/) {});
+    }
+
     void discover_vertex(
         RenderGraph::vertex_descriptor vertID,
         const boost::filtered_graph<AddressableView<RenderGraph>, boost::keep_all, RenderGraphFilter>& gv) const {
@@ -1048,9 +1079,10 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
 #if CC_DEBUG
                 ctx.cmdBuff->beginMarker(makeMarkerInfo(get(RenderGraph::NameTag{}, ctx.g, vertID).c_str(), RASTER_COLOR));
 #endif
-                mountResources(pass);
-
-                NativePipeline::prepareDescriptors(ctx, vertID);
+                if (!ctx.resourcesPrepared) {
+                    mountResources(pass);
+                    NativePipeline::prepareDescriptors(ctx, vertID);
+                }
 
                 // execute render pass
                 frontBarriers(vertID);
@@ -1063,30 +1095,39 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
                 begin(subpass, vertID);
             },
             [&](const ComputePass& pass) {
-                mountResources(pass);
-
-                NativePipeline::prepareDescriptors(ctx, vertID);
+                if (!ctx.resourcesPrepared) {
+                    mountResources(pass);
+                    NativePipeline::prepareDescriptors(ctx, vertID);
+                }
 
                 frontBarriers(vertID);
                 begin(pass, vertID);
             },
             [&](const ResolvePass& pass) {
-                mountResources(pass);
+                if (!ctx.resourcesPrepared) {
+                    mountResources(pass);
+                }
                 frontBarriers(vertID);
                 begin(pass, vertID);
             },
             [&](const CopyPass& pass) {
-                mountResources(pass);
+                if (!ctx.resourcesPrepared) {
+                    mountResources(pass);
+                }
                 frontBarriers(vertID);
                 begin(pass, vertID);
             },
             [&](const MovePass& pass) {
-                mountResources(pass);
+                if (!ctx.resourcesPrepared) {
+                    mountResources(pass);
+                }
                 frontBarriers(vertID);
                 begin(pass, vertID);
             },
             [&](const RaytracePass& pass) {
-                mountResources(pass);
+                if (!ctx.resourcesPrepared) {
+                    mountResources(pass);
+                }
                 frontBarriers(vertID);
                 begin(pass, vertID);
             },
@@ -1197,11 +1238,109 @@ struct CommandSubmitter {
         device->flushCommands(cmdBuffers);
         device->getQueue()->submit(cmdBuffers);
     }
+    // Command buffers recorded elsewhere, submitted after the primary in the order added.
+    void append(gfx::CommandBuffer* cmdBuff) {
+        cmdBuffers.emplace_back(cmdBuff);
+    }
     gfx::Device* device = nullptr;
-    const std::vector<gfx::CommandBuffer*>& cmdBuffers;
+    std::vector<gfx::CommandBuffer*> cmdBuffers;
     gfx::CommandBuffer* primaryCommandBuffer = nullptr;
 };
 
+// Records the top-level passes, in graph order, into contiguous partitions on job
+// system workers. The first partition goes into the primary command buffer and the
+// others into their own primary command buffers, which are submitted right after it
+// in partition order. Submission order keeps every inter-pass dependency and its
+// barriers intact, so partitions do not have to be independent of each other.
+void recordPassesInParallel(
+    NativePipeline& ppl,
+    RenderGraphVisitorContext& ctx,
+    const boost::filtered_graph<AddressableView<RenderGraph>, boost::keep_all, RenderGraphFilter>& fg,
+    const ccstd::pmr::vector<RenderGraph::vertex_descriptor>& passes,
+    CommandSubmitter& submit) {
+    // mounting, uploading and framebuffer creation touch shared caches
+    {
+        RenderGraphVisitor visitor{{}, ctx};
+        for (const auto passID : passes) {
+            visitor.prepare(passID);
+        }
+        ctx.resourcesPrepared = true;
+    }
+
+    // split passes into partitions of similar cost
+    ccstd::pmr::vector<uint32_t> costs(ctx.scratch);
+    estimateRecordingCosts(ctx.g, ctx.validPasses, ctx.context.sceneCulling, costs);
+    auto* jobSystem = JobSystem::getInstance();
+    ccstd::pmr::vector<uint32_t> partitionEnds(ctx.scratch);
+    partitionPassesByCost(passes, costs, jobSystem->threadCount(), partitionEnds);
+
+    // command buffers of the secondary partitions are reused across frames
+    const auto numJobs = static_cast<uint32_t>(partitionEnds.size());
+    auto& cmdBuffs = ppl.parallelCommandBuffers;
+    while (cmdBuffs.size() + 1 < numJobs) {
+        cmdBuffs.emplace_back(ppl.device->createCommandBuffer(
+            gfx::CommandBufferInfo{ppl.device->getQueue(), gfx::CommandBufferType::PRIMARY}));
+    }
+
+    auto recordPartition = [&](uint32_t jobID) {
+        const auto beginPass = jobID ? partitionEnds[jobID - 1] : 0;
+        const auto endPass = partitionEnds[jobID];
+        auto* cmdBuff = jobID ? cmdBuffs[jobID - 1].get() : submit.primaryCommandBuffer;
+
+        boost::container::pmr::unsynchronized_pool_resource pool;
+        ccstd::pmr::vector<ccstd::optional<gfx::Viewport>> viewportStack(&pool);
+        viewportStack.reserve(4);
+        RenderGraphVisitorContext partitionCtx{
+            ctx.context,
+            ctx.lg, ctx.g, ctx.resourceGraph,
+            ctx.fgd,
+            ctx.validPasses,
+            ctx.device, cmdBuff,
+            ctx.ppl,
+            ctx.perPassResourceIndex,
+            ctx.renderGraphDescriptorSet,
+            ctx.uiDescriptorSet,
+            ctx.profilerPerPassDescriptorSets,
+            ctx.perInstanceDescriptorSets,
+            ctx.programLib,
+            viewportStack,
+            CustomRenderGraphContext{
+                ctx.customContext.pipelineContext,
+                ctx.customContext.renderGraph,
+                ctx.customContext.resourceGraph,
+                cmdBuff,
+            },
+            &pool};
+        partitionCtx.resourcesPrepared = true;
+
+        if (jobID) {
+            cmdBuff->begin();
+        }
+        RenderGraphVisitor visitor{{}, partitionCtx};
+        auto colors = ctx.g.colors(&pool);
+        for (auto i = beginPass; i != endPass; ++i) {
+            boost::depth_first_visit(fg, passes[i], visitor, get(colors, ctx.g));
+        }
+        if (jobID) {
+            cmdBuff->end();
+        }
+    };
+
+    if (numJobs > 1) {
+        JobGraph g(jobSystem);
+        g.createForEachIndexJob(1U, numJobs, 1U, recordPartition);
+        g.run();
+        recordPartition(0);
+        g.waitForAll();
+    } else {
+        recordPartition(0);
+    }
+
+    for (uint32_t jobID = 1; jobID != numJobs; ++jobID) {
+        submit.append(cmdBuffs[jobID - 1].get());
+    }
+}
+
 void extendResourceLifetime(const NativeRenderQueue& queue, ResourceGroup& group) {
     // keep instanceBuffers
     for (const auto& batch : queue.opaqueInstancingQueue.sortedBatches) {
@@ -1250,8 +1389,103 @@ void collectStatistics(const NativePipeline& ppl, PipelineStatistics& stats) {
     }
 }
 
+RenderGraph::vertex_descriptor getTopLevelPass(
+    RenderGraph::vertex_descriptor vertID, const RenderGraph& rg) {
+    auto passID = vertID;
+    for (auto parentID = parent(passID, rg);
+         parentID != RenderGraph::null_vertex();
+         parentID = parent(passID, rg)) {
+        passID = parentID;
+    }
+    return passID;
+}
+
 } // namespace
 
+// Custom callbacks, profiler statistics, compute dispatches, reflection probes and
+// geometry rendering mutate shared state while recording, so they keep the frame serial.
+bool isParallelRecordable(const RenderGraph& rg) {
+    for (RenderGraph::vertex_descriptor vertID = 0; vertID != num_vertices(rg); ++vertID) {
+        if (!get(RenderGraph::DataTag{}, rg, vertID).custom.empty()) {
+            return false;
+        }
+        if (holds<RasterPassTag>(vertID, rg) && get(RasterPassTag{}, vertID, rg).showStatistics) {
+            return false;
+        }
+        if (holds<DispatchTag>(vertID, rg)) {
+            return false;
+        }
+        if (holds<SceneTag>(vertID, rg) &&
+            any(get(SceneTag{}, vertID, rg).flags & (SceneFlags::REFLECTION_PROBE | SceneFlags::GEOMETRY))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Estimated recording cost of each top-level pass: one per vertex, plus the draws
+// of its render queues.
+void estimateRecordingCosts(
+    const RenderGraph& rg,
+    const ccstd::pmr::vector<bool>& validPasses,
+    const SceneCulling& sceneCulling,
+    ccstd::pmr::vector<uint32_t>& costs) {
+    costs.assign(num_vertices(rg), 0);
+    for (RenderGraph::vertex_descriptor vertID = 0; vertID != num_vertices(rg); ++vertID) {
+        if (!validPasses[vertID]) {
+            continue;
+        }
+        auto cost = 1U;
+        if (holds<SceneTag>(vertID, rg)) {
+            auto iter = sceneCulling.renderQueueQueryIndex.find(vertID);
+            if (iter != sceneCulling.renderQueueQueryIndex.end()) {
+                const auto& queue = sceneCulling.renderQueues[iter->second.renderQueueTarget.value];
+                cost += static_cast<uint32_t>(
+                    queue.opaqueQueue.instances.size() +
+                    queue.transparentQueue.instances.size() +
+                    queue.opaqueInstancingQueue.sortedBatches.size() +
+                    queue.transparentInstancingQueue.sortedBatches.size());
+            }
+        }
+        costs[getTopLevelPass(vertID, rg)] += cost;
+    }
+}
+
+void partitionPassesByCost(
+    const ccstd::pmr::vector<RenderGraph::vertex_descriptor>& passes,
+    const ccstd::pmr::vector<uint32_t>& costs,
+    uint32_t maxPartitions,
+    ccstd::pmr::vector<uint32_t>& partitionEnds) {
+    partitionEnds.clear();
+    uint32_t totalCost = 0;
+    for (const auto passID : passes) {
+        totalCost += costs[passID];
+    }
+    const auto numPartitions = std::min(
+        std::min(maxPartitions, static_cast<uint32_t>(passes.size())),
+        totalCost / MIN_PARALLEL_RECORDING_COST);
+
+    if (numPartitions > 1) {
+        partitionEnds.reserve(numPartitions);
+        const auto targetCost = (totalCost + numPartitions - 1) / numPartitions;
+        uint32_t cost = 0;
+        for (uint32_t i = 0; i != passes.size(); ++i) {
+            cost += costs[passes[i]];
+            const auto remainingPasses = static_cast<uint32_t>(passes.size()) - (i + 1);
+            const auto remainingPartitions = numPartitions - static_cast<uint32_t>(partitionEnds.size()) - 1;
+            if ((cost >= targetCost && remainingPasses >= remainingPartitions) ||
+                remainingPasses == remainingPartitions) {
+                partitionEnds.emplace_back(i + 1);
+                cost = 0;
+                if (partitionEnds.size() + 1 == numPartitions) {
+                    break;
+                }
+            }
+        }
+    }
+    partitionEnds.emplace_back(static_cast<uint32_t>(passes.size()));
+}
+
 void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     auto& ppl = *this;
     auto* scratch = &ppl.unsyncPool;
@@ -1262,13 +1496,11 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     ResourceCleaner cleaner(ppl.resourceGraph);
 
     auto& lg = ppl.programLibrary->layoutGraph;
-    FrameGraphDispatcher fgd(
-        ppl.resourceGraph, rg,
-        lg, &ppl.unsyncPool, scratch);
-    fgd.enableMemoryAliasing(false);
-    fgd.enablePassReorder(false);
-    fgd.setParalellWeight(0);
-    fgd.run();
+    // reuses last compilation when the render graph is structurally unchanged
+    ppl.dispatcherCache.setPassReorder(ppl.enablePassReorder);
+    ppl.dispatcherCache.setMemoryAliasing(ppl.enableMemoryAliasing);
+    const auto& fgd = ppl.dispatcherCache.compile(
+        ppl.resourceGraph, rg, lg, &ppl.unsyncPool);
 
     AddressableView<RenderGraph> graphView(rg);
     ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, scratch);
@@ -1404,11 +1636,26 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
             },
             scratch};
 
-        RenderGraphVisitor visitor{{}, ctx};
-        auto colors = rg.colors(scratch);
-        for (const auto vertID : ctx.g.sortedVertices) {
-            if (holds<RasterPassTag>(vertID, ctx.g) || holds<ComputeTag>(vertID, ctx.g) || holds<CopyTag>(vertID, ctx.g)) {
-                boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
+        // reordered passes follow the dispatcher's schedule
+        const auto& passOrder = fgd.passOrder.empty() ? rg.sortedVertices : fgd.passOrder;
+        if (ppl.enableParallelRecording &&
+            ppl.device->isMultithreadedCommandRecordingSupported() &&
+            isParallelRecordable(rg)) {
+            ccstd::pmr::vector<RenderGraph::vertex_descriptor> passes(scratch);
+            passes.reserve(passOrder.size());
+            for (const auto vertID : passOrder) {
+                if (holds<RasterPassTag>(vertID, ctx.g) || holds<ComputeTag>(vertID, ctx.g) || holds<CopyTag>(vertID, ctx.g)) {
+                    passes.emplace_back(vertID);
+                }
+            }
+            recordPassesInParallel(ppl, ctx, fg, passes, submit);
+        } else {
+            RenderGraphVisitor visitor{{}, ctx};
+            auto colors = rg.colors(scratch);
+            for (const auto vertID : passOrder) {
+                if (holds<RasterPassTag>(vertID, ctx.g) || holds<ComputeTag>(vertID, ctx.g) || holds<CopyTag>(vertID, ctx.g)) {
+                    boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
+                }
             }
         }
     }
@@ -79,8 +79,31 @@ struct RenderGraphVisitorContext {
     uint32_t subpassIndex = 0;
     RenderGraph::vertex_descriptor currentInFlightPassID = RenderGraph::null_vertex();
     Mat4 currentProjMatrix;
+    // resources are mounted and descriptors uploaded before recording starts
+    bool resourcesPrepared = false;
 };
 
+// Below this many estimated draws per frame, recording on one thread is cheaper
+// than the fork-join and the extra submissions.
+constexpr uint32_t MIN_PARALLEL_RECORDING_COST = 256;
+
+bool isParallelRecordable(const RenderGraph& rg);
+
+// Fills the estimated recording cost of every top-level pass, indexed by vertex.
+void estimateRecordingCosts(
+    const RenderGraph& rg,
+    const ccstd::pmr::vector<bool>& validPasses,
+    const SceneCulling& sceneCulling,
+    ccstd::pmr::vector<uint32_t>& costs);
+
+// Splits passes, in order, into at most maxPartitions contiguous partitions of similar cost.
+// Fills the end index of each partition, a single partition when the frame is too cheap.
+void partitionPassesByCost(
+    const ccstd::pmr::vector<RenderGraph::vertex_descriptor>& passes,
+    const ccstd::pmr::vector<uint32_t>& costs,
+    uint32_t maxPartitions,
+    ccstd::pmr::vector<uint32_t>& partitionEnds);
+
 } // namespace render
 
 } // namespace cc
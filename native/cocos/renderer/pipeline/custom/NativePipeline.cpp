@@ -147,6 +147,30 @@ void NativePipeline::setEnableCpuLightCulling(bool enable) {
     nativeContext.sceneCulling.enableLightCulling = enable;
 }
 
+bool NativePipeline::getEnableParallelRecording() const {
+    return enableParallelRecording;
+}
+
+void NativePipeline::setEnableParallelRecording(bool enable) {
+    enableParallelRecording = enable;
+}
+
+bool NativePipeline::getEnablePassReorder() const {
+    return enablePassReorder;
+}
+
+void NativePipeline::setEnablePassReorder(bool enable) {
+    enablePassReorder = enable;
+}
+
+bool NativePipeline::getEnableMemoryAliasing() const {
+    return enableMemoryAliasing;
+}
+
+void NativePipeline::setEnableMemoryAliasing(bool enable) {
+    enableMemoryAliasing = enable;
+}
+
 bool NativePipeline::containsResource(const ccstd::string &name) const {
     return contains(name.c_str(), resourceGraph);
 }
@@ -1504,6 +1528,8 @@ bool NativePipeline::destroy() noexcept {
         pipelineSceneData = {};
     }
     pipeline::PipelineStateManager::destroyAll();
+    dispatcherCache.clear();
+    parallelCommandBuffers.clear();
     return true;
 }
 
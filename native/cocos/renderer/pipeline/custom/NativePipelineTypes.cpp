@@ -199,6 +199,7 @@ SceneCulling::SceneCulling(SceneCulling&& rhs, const allocator_type& alloc)
   renderQueueIndex(std::move(rhs.renderQueueIndex), alloc),
   renderQueues(std::move(rhs.renderQueues), alloc),
   renderQueueQueryIndex(std::move(rhs.renderQueueQueryIndex), alloc),
+  modelVisibility(std::move(rhs.modelVisibility)),
   numFrustumCulling(rhs.numFrustumCulling),
   numLightBoundsCulling(rhs.numLightBoundsCulling),
   numRenderQueues(rhs.numRenderQueues),
@@ -40,6 +40,7 @@
 #include "cocos/renderer/pipeline/GlobalDescriptorSetManager.h"
 #include "cocos/renderer/pipeline/InstancedBuffer.h"
 #include "cocos/renderer/pipeline/custom/CustomTypes.h"
+#include "cocos/renderer/pipeline/custom/FrameGraphDispatcherCache.h"
 #include "cocos/renderer/pipeline/custom/NativePipelineFwd.h"
 #include "cocos/renderer/pipeline/custom/NativeTypes.h"
 #include "cocos/renderer/pipeline/custom/details/Map.h"
@@ -1359,6 +1360,7 @@ public:
     ccstd::pmr::unordered_map<NativeRenderQueueKey, NativeRenderQueueID> renderQueueIndex;
     ccstd::pmr::vector<NativeRenderQueue> renderQueues;
     PmrFlatMap<RenderGraph::vertex_descriptor, NativeRenderQueueQuery> renderQueueQueryIndex;
+    ccstd::vector<uint8_t> modelVisibility;
     uint32_t numFrustumCulling{0};
     uint32_t numLightBoundsCulling{0};
     uint32_t numRenderQueues{0};
@@ -1626,6 +1628,12 @@ public:
     void endSetup() override;
     bool getEnableCpuLightCulling() const override;
     void setEnableCpuLightCulling(bool enable) override;
+    bool getEnableParallelRecording() const override;
+    void setEnableParallelRecording(bool enable) override;
+    bool getEnablePassReorder() const override;
+    void setEnablePassReorder(bool enable) override;
+    bool getEnableMemoryAliasing() const override;
+    void setEnableMemoryAliasing(bool enable) override;
     bool containsResource(const ccstd::string &name) const override;
     uint32_t addRenderWindow(const ccstd::string &name, gfx::Format format, uint32_t width, uint32_t height, scene::RenderWindow *renderWindow, const ccstd::string &depthStencilName) override;
     void updateRenderWindow(const ccstd::string &name, scene::RenderWindow *renderWindow, const ccstd::string &depthStencilName) override;
@@ -1697,8 +1705,13 @@ public:
     RenderGraph renderGraph;
     mutable PmrFlatMap<BuiltinCascadedShadowMapKey, BuiltinCascadedShadowMap> builtinCSMs;
     PipelineStatistics statistics;
+    FrameGraphDispatcherCache dispatcherCache;
     PipelineCustomization custom;
+    ccstd::vector<IntrusivePtr<gfx::CommandBuffer>> parallelCommandBuffers;
     bool defaultFramebufferHasDepthStencil{false};
+    bool enableParallelRecording{false};
+    bool enablePassReorder{false};
+    bool enableMemoryAliasing{false};
 };
 
 class NativeProgramProxy final : public ProgramProxy {
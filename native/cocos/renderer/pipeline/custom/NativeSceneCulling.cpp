@@ -247,20 +247,48 @@ bool isFrustumCulled(const scene::Model& model, const geometry::Frustum& frustum
     return !transWorldBounds.aabbFrustum(frustum);
 }
 
+struct OctreeCullingQuery {
+    const geometry::Frustum* frustum{nullptr};
+    ccstd::vector<const scene::Model*>* models{nullptr};
+};
+
+// queries of the same camera and shadow state, e.g. csm levels, are culled in one octree traversal
+struct OctreeCullingBatch {
+    const scene::Camera* camera{nullptr};
+    bool castShadow{false};
+    ccstd::vector<OctreeCullingQuery> queries;
+};
+
+void addOctreeCullingQuery(
+    ccstd::vector<OctreeCullingBatch>& batches,
+    const scene::Camera& camera,
+    bool bCastShadow,
+    const geometry::Frustum& cameraOrLightFrustum,
+    ccstd::vector<const scene::Model*>& models) {
+    auto iter = std::find_if(
+        batches.begin(), batches.end(),
+        [&](const OctreeCullingBatch& batch) {
+            return batch.camera == &camera && batch.castShadow == bCastShadow;
+        });
+    if (iter == batches.end()) {
+        iter = batches.emplace(batches.end(), OctreeCullingBatch{&camera, bCastShadow, {}});
+    }
+    iter->queries.emplace_back(OctreeCullingQuery{&cameraOrLightFrustum, &models});
+}
+
 void octreeCulling(
     const scene::Octree& octree,
     const scene::Model* skyboxModel,
     const scene::RenderScene& scene,
-    const scene::Camera& camera,
-    const geometry::Frustum& cameraOrLightFrustum,
-    bool bCastShadow,
-    ccstd::vector<const scene::Model*>& models) {
+    const OctreeCullingBatch& batch) {
+    const auto& camera = *batch.camera;
+    const auto bCastShadow = batch.castShadow;
     const auto visibility = camera.getVisibility();
     const auto camSkyboxFlag = (static_cast<int32_t>(camera.getClearFlag()) & scene::Camera::SKYBOX_FLAG);
-    if (!bCastShadow && skyboxModel && camSkyboxFlag) {
-        models.emplace_back(skyboxModel);
-    }
+    const bool bSkybox = !bCastShadow && skyboxModel && camSkyboxFlag;
+
     // add instances without world bounds
+    ccstd::vector<const scene::Model*> unboundedModels;
     for (const auto& pModel : scene.getModels()) {
         CC_EXPECTS(pModel);
         const auto& model = *pModel;
@@ -269,19 +297,37 @@ void octreeCulling(
         }
         // filter model by view visibility
         if (isNodeVisible(model.getNode(), visibility) || isModelVisible(model, visibility)) {
-            models.emplace_back(&model);
+            unboundedModels.emplace_back(&model);
         }
     }
+
+    ccstd::vector<const geometry::Frustum*> frustums;
+    ccstd::vector<ccstd::vector<const scene::Model*>*> results;
+    frustums.reserve(batch.queries.size());
+    results.reserve(batch.queries.size());
+    for (const auto& query : batch.queries) {
+        auto& models = *query.models;
+        if (bSkybox) {
+            models.emplace_back(skyboxModel);
+        }
+        models.insert(models.end(), unboundedModels.begin(), unboundedModels.end());
+        frustums.emplace_back(query.frustum);
+        results.emplace_back(query.models);
+    }
+
     // add instances with world bounds
-    octree.queryVisibility(&camera, cameraOrLightFrustum, bCastShadow, models);
+    octree.queryVisibilityBatched(
+        &camera, frustums.data(), static_cast<uint32_t>(frustums.size()), bCastShadow, results.data());
 
     // TODO(zhouzhenglong): move lod culling into octree query
-    auto iter = std::remove_if(
-        models.begin(), models.end(),
-        [&](const scene::Model* model) {
-            return scene.isCulledByLod(&camera, model);
-        });
-    models.erase(iter, models.end());
+    for (auto* models : results) {
+        auto iter = std::remove_if(
+            models->begin(), models->end(),
+            [&](const scene::Model* model) {
+                return scene.isCulledByLod(&camera, model);
+            });
+        models->erase(iter, models->end());
+    }
 }
 
 void bruteForceCulling(
@@ -292,13 +338,30 @@ void bruteForceCulling(
     bool bCastShadow,
     bool bProbePass,
     const scene::ReflectionProbe* probe,
+    ccstd::vector<uint8_t>& modelVisibility,
     ccstd::vector<const scene::Model*>& models) {
     const auto visibility = camera.getVisibility();
     const auto camSkyboxFlag = (static_cast<int32_t>(camera.getClearFlag()) & scene::Camera::SKYBOX_FLAG);
     if (!bCastShadow && skyboxModel && camSkyboxFlag) {
         models.emplace_back(skyboxModel);
     }
-    for (const auto& pModel : scene.getModels()) {
+
+    // Test the packed world bounds gathered by RenderScene::update first, so culled models are never touched.
+    // Planar shadow casters are tested with projected bounds, keep them on the per-model path.
+    const auto& modelBounds = scene.getModelBounds();
+    const bool bPlanarShadow = bCastShadow && kPipelineSceneData->getShadows()->getType() == scene::ShadowType::PLANAR;
+    const bool bPackedBounds = !bProbePass && !probe && !bPlanarShadow &&
+                               modelBounds.size() == scene.getModels().size();
+    if (bPackedBounds) {
+        modelBounds.cullFrustum(cameraOrLightFrustum, modelVisibility);
+    }
+
+    const auto& sceneModels = scene.getModels();
+    for (size_t i = 0; i != sceneModels.size(); ++i) {
+        if (bPackedBounds && !modelVisibility[i]) {
+            continue;
+        }
+        const auto& pModel = sceneModels[i];
         CC_EXPECTS(pModel);
         const auto& model = *pModel;
         if (!model.isEnabled() || !model.getNode() || (bCastShadow && !model.isCastShadow())) {
@@ -313,7 +376,7 @@ void bruteForceCulling(
             if (isNodeVisible(model.getNode(), visibility) || isModelVisible(model, visibility)) {
                 const auto* const wBounds = model.getWorldBounds();
                 // frustum culling
-                if (wBounds && ((!probe && isFrustumCulled(model, cameraOrLightFrustum, bCastShadow)) ||
+                if (wBounds && ((!probe && !bPackedBounds && isFrustumCulled(model, cameraOrLightFrustum, bCastShadow)) ||
                                 (probe && isIntersectAABB(*wBounds, *probe->getBoundingBox())))) {
                     continue;
                 }
@@ -326,28 +389,6 @@ void bruteForceCulling(
     }
 }
 
-void sceneCulling(
-    const scene::Model* skyboxModel,
-    const scene::RenderScene& scene,
-    const scene::Camera& camera,
-    const geometry::Frustum& cameraOrLightFrustum,
-    bool bCastShadow,
-    bool bProbePass,
-    const scene::ReflectionProbe* probe,
-    ccstd::vector<const scene::Model*>& models) {
-    CC_EXPECTS(bProbePass || !probe);
-    const auto* const octree = scene.getOctree();
-    if (octree && octree->isEnabled() && !probe) {
-        octreeCulling(
-            *octree, skyboxModel,
-            scene, camera, cameraOrLightFrustum, bCastShadow, models);
-    } else {
-        bruteForceCulling(
-            skyboxModel,
-            scene, camera, cameraOrLightFrustum, bCastShadow, bProbePass, probe, models);
-    }
-}
-
 } // namespace
 
 void SceneCulling::batchFrustumCulling(const NativePipeline& ppl) {
@@ -355,8 +396,12 @@ void SceneCulling::batchFrustumCulling(const NativePipeline& ppl) {
     const auto* const skybox = pplSceneData.getSkybox();
     const auto* const skyboxModel = skybox && skybox->isEnabled() ? skybox->getModel() : nullptr;
 
+    ccstd::vector<OctreeCullingBatch> octreeBatches;
     for (const auto& [scene, queries] : frustumCullings) {
         CC_ENSURES(scene);
+        const auto* const octree = scene->getOctree();
+        const bool bOctree = octree && octree->isEnabled();
+        octreeBatches.clear();
         for (const auto& [key, frustomCulledResultID] : queries.resultIndex) {
             CC_EXPECTS(key.camera);
             CC_EXPECTS(key.camera->getScene() == nullptr || key.camera->getScene() == scene);
@@ -370,58 +415,56 @@ void SceneCulling::batchFrustumCulling(const NativePipeline& ppl) {
             auto& models = frustumCullingResults[frustomCulledResultID.value];
 
             if (probe) {
-                sceneCulling(
+                CC_EXPECTS(bProbePass);
+                bruteForceCulling(
                     skyboxModel,
                     *scene, camera,
                     camera.getFrustum(),
                     bCastShadow,
                     bProbePass,
                     probe,
+                    modelVisibility,
                     models);
                 continue;
             }
 
+            const geometry::Frustum* frustum = &camera.getFrustum();
             if (light) {
                 switch (light->getType()) {
                     case scene::LightType::SPOT:
-                        sceneCulling(
-                            skyboxModel,
-                            *scene, camera,
-                            dynamic_cast<const scene::SpotLight*>(light)->getFrustum(),
-                            bCastShadow,
-                            bProbePass,
-                            nullptr,
-                            models);
+                        frustum = &dynamic_cast<const scene::SpotLight*>(light)->getFrustum();
                         break;
                     case scene::LightType::DIRECTIONAL: {
                         const auto* mainLight = dynamic_cast<const scene::DirectionalLight*>(light);
-                        const auto* frustum = getBuiltinShadowFrustum(ppl, camera, mainLight, level);
-                        if (frustum) {
-                            sceneCulling(
-                                skyboxModel,
-                                *scene, camera,
-                                *frustum,
-                                bCastShadow,
-                                bProbePass,
-                                nullptr,
-                                models);
-                        }
+                        frustum = getBuiltinShadowFrustum(ppl, camera, mainLight, level);
                     } break;
                     default:
-                        // noop
+                        frustum = nullptr;
                         break;
                 }
+            }
+            if (!frustum) {
+                continue;
+            }
+
+            if (bOctree) {
+                // culled below, after all queries of the scene are gathered
+                addOctreeCullingQuery(octreeBatches, camera, bCastShadow, *frustum, models);
             } else {
-                sceneCulling(
+                bruteForceCulling(
                     skyboxModel,
                     *scene, camera,
-                    camera.getFrustum(),
+                    *frustum,
                     bCastShadow,
                     bProbePass,
                     nullptr,
+                    modelVisibility,
                     models);
             }
         }
+        for (const auto& batch : octreeBatches) {
+            octreeCulling(*octree, skyboxModel, *scene, batch);
+        }
     }
 }
 
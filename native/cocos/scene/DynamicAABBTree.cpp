@@ -0,0 +1,512 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "scene/DynamicAABBTree.h"
+#include <algorithm>
+#include <cmath>
+#include "base/std/container/array.h"
+#include "core/geometry/Frustum.h"
+#include "core/geometry/Ray.h"
+
+namespace cc {
+namespace scene {
+
+namespace {
+
+constexpr int32_t FRUSTUM_OUTSIDE = -1;
+constexpr int32_t FRUSTUM_INTERSECT = 0;
+constexpr int32_t FRUSTUM_INSIDE = 1;
+
+inline BBox combine(const BBox &a, const BBox &b) {
+    return {Vec3{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+            Vec3{std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}};
+}
+
+inline BBox enlarge(const BBox &box, float margin) {
+    const Vec3 expand{margin, margin, margin};
+    return {box.min - expand, box.max + expand};
+}
+
+inline float surfaceArea(const BBox &box) {
+    const Vec3 size = box.max - box.min;
+    return 2.0F * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+// same plane test as geometry::aabbPlane, but also reports boxes completely inside the frustum
+int32_t classifyFrustum(const BBox &box, const geometry::Frustum &frustum) {
+    const Vec3 center = box.getCenter();
+    const Vec3 halfExtents = (box.max - box.min) * 0.5F;
+    int32_t result = FRUSTUM_INSIDE;
+    for (const auto *plane : frustum.planes) {
+        const float r = halfExtents.x * std::abs(plane->n.x) + halfExtents.y * std::abs(plane->n.y) + halfExtents.z * std::abs(plane->n.z);
+        const float dot = Vec3::dot(plane->n, center);
+        if (dot + r < plane->d) {
+            return FRUSTUM_OUTSIDE;
+        }
+        if (dot - r < plane->d) {
+            result = FRUSTUM_INTERSECT;
+        }
+    }
+    return result;
+}
+
+inline bool rayHitBox(const Vec3 &origin, const Vec3 &invDir, float maxDistance, const BBox &box) {
+    const float tx1 = (box.min.x - origin.x) * invDir.x;
+    const float tx2 = (box.max.x - origin.x) * invDir.x;
+    const float ty1 = (box.min.y - origin.y) * invDir.y;
+    const float ty2 = (box.max.y - origin.y) * invDir.y;
+    const float tz1 = (box.min.z - origin.z) * invDir.z;
+    const float tz2 = (box.max.z - origin.z) * invDir.z;
+    const float tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+    const float tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+    return tmax >= 0.0F && tmin <= tmax && tmin <= maxDistance;
+}
+
+} // namespace
+
+int32_t DynamicAABBTree::allocateNode() {
+    int32_t nodeId = _freeList;
+    if (nodeId == NULL_NODE) {
+        nodeId = static_cast<int32_t>(_nodes.size());
+        _nodes.emplace_back();
+    } else {
+        _freeList = _nodes[nodeId].parent;
+    }
+
+    auto &node = _nodes[nodeId];
+    node.model = nullptr;
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    return nodeId;
+}
+
+void DynamicAABBTree::freeNode(int32_t nodeId) {
+    auto &node = _nodes[nodeId];
+    node.model = nullptr;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = -1;
+    node.parent = _freeList;
+    _freeList = nodeId;
+}
+
+int32_t DynamicAABBTree::createProxy(const BBox &box, Model *model) {
+    const int32_t proxyId = allocateNode();
+    _nodes[proxyId].box = enlarge(box, DYNAMIC_TREE_FAT_MARGIN);
+    _nodes[proxyId].model = model;
+    insertLeaf(proxyId);
+    ++_proxyCount;
+    return proxyId;
+}
+
+void DynamicAABBTree::destroyProxy(int32_t proxyId) {
+    CC_ASSERT(proxyId >= 0 && proxyId < static_cast<int32_t>(_nodes.size()) && _nodes[proxyId].isLeaf());
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    --_proxyCount;
+}
+
+bool DynamicAABBTree::moveProxy(int32_t proxyId, const BBox &box) {
+    CC_ASSERT(proxyId >= 0 && proxyId < static_cast<int32_t>(_nodes.size()) && _nodes[proxyId].isLeaf());
+    const BBox &fatBox = _nodes[proxyId].box;
+    if (fatBox.contain(box)) {
+        // keep the leaf unless it has become much larger than the model
+        if (enlarge(box, 4.0F * DYNAMIC_TREE_FAT_MARGIN).contain(fatBox)) {
+            return false;
+        }
+    }
+
+    removeLeaf(proxyId);
+    _nodes[proxyId].box = enlarge(box, DYNAMIC_TREE_FAT_MARGIN);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void DynamicAABBTree::clear() {
+    _nodes.clear();
+    _root = NULL_NODE;
+    _freeList = NULL_NODE;
+    _proxyCount = 0;
+}
+
+void DynamicAABBTree::insertLeaf(int32_t leaf) {
+    if (_root == NULL_NODE) {
+        _root = leaf;
+        _nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // find the best sibling with the surface area heuristic
+    const BBox leafBox = _nodes[leaf].box;
+    int32_t index = _root;
+    while (!_nodes[index].isLeaf()) {
+        const auto &node = _nodes[index];
+        const int32_t child1 = node.child1;
+        const int32_t child2 = node.child2;
+
+        const float area = surfaceArea(node.box);
+        const float combinedArea = surfaceArea(combine(node.box, leafBox));
+
+        // cost of creating a new parent for this node and the new leaf
+        const float cost = 2.0F * combinedArea;
+        // minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0F * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const auto &childNode = _nodes[child];
+            const float newArea = surfaceArea(combine(leafBox, childNode.box));
+            return childNode.isLeaf() ? newArea + inheritanceCost : newArea - surfaceArea(childNode.box) + inheritanceCost;
+        };
+        const float cost1 = descendCost(child1);
+        const float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    const int32_t sibling = index;
+    const int32_t oldParent = _nodes[sibling].parent;
+    const int32_t newParent = allocateNode(); // may reallocate _nodes
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].box = combine(leafBox, _nodes[sibling].box);
+    _nodes[newParent].height = _nodes[sibling].height + 1;
+    _nodes[newParent].child1 = sibling;
+    _nodes[newParent].child2 = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (_nodes[oldParent].child1 == sibling) {
+            _nodes[oldParent].child1 = newParent;
+        } else {
+            _nodes[oldParent].child2 = newParent;
+        }
+    } else {
+        _root = newParent;
+    }
+
+    // refit the ancestors
+    index = _nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        auto &node = _nodes[index];
+        const auto &node1 = _nodes[node.child1];
+        const auto &node2 = _nodes[node.child2];
+        node.height = 1 + std::max(node1.height, node2.height);
+        node.box = combine(node1.box, node2.box);
+        index = node.parent;
+    }
+}
+
+void DynamicAABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == _root) {
+        _root = NULL_NODE;
+        return;
+    }
+
+    const int32_t parent = _nodes[leaf].parent;
+    const int32_t grandParent = _nodes[parent].parent;
+    const int32_t sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        _root = sibling;
+        _nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    if (_nodes[grandParent].child1 == parent) {
+        _nodes[grandParent].child1 = sibling;
+    } else {
+        _nodes[grandParent].child2 = sibling;
+    }
+    _nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    int32_t index = grandParent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        auto &node = _nodes[index];
+        const auto &node1 = _nodes[node.child1];
+        const auto &node2 = _nodes[node.child2];
+        node.box = combine(node1.box, node2.box);
+        node.height = 1 + std::max(node1.height, node2.height);
+        index = node.parent;
+    }
+}
+
+// rotate the taller child up if the node is imbalanced, return the root of the rotated subtree
+int32_t DynamicAABBTree::balance(int32_t iA) {
+    auto &a = _nodes[iA];
+    if (a.isLeaf() || a.height < 2) {
+        return iA;
+    }
+
+    const int32_t iB = a.child1;
+    const int32_t iC = a.child2;
+    auto &b = _nodes[iB];
+    auto &c = _nodes[iC];
+    const int32_t diff = c.height - b.height;
+
+    if (diff > 1) {
+        // rotate C up
+        const int32_t iF = c.child1;
+        const int32_t iG = c.child2;
+        auto &f = _nodes[iF];
+        auto &g = _nodes[iG];
+
+        c.child1 = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+        if (c.parent != NULL_NODE) {
+            if (_nodes[c.parent].child1 == iA) {
+                _nodes[c.parent].child1 = iC;
+            } else {
+                _nodes[c.parent].child2 = iC;
+            }
+        } else {
+            _root = iC;
+        }
+
+        if (f.height > g.height) {
+            c.child2 = iF;
+            a.child2 = iG;
+            g.parent = iA;
+            a.box = combine(b.box, g.box);
+            c.box = combine(a.box, f.box);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        } else {
+            c.child2 = iG;
+            a.child2 = iF;
+            f.parent = iA;
+            a.box = combine(b.box, f.box);
+            c.box = combine(a.box, g.box);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return iC;
+    }
+
+    if (diff < -1) {
+        // rotate B up
+        const int32_t iD = b.child1;
+        const int32_t iE = b.child2;
+        auto &d = _nodes[iD];
+        auto &e = _nodes[iE];
+
+        b.child1 = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+        if (b.parent != NULL_NODE) {
+            if (_nodes[b.parent].child1 == iA) {
+                _nodes[b.parent].child1 = iB;
+            } else {
+                _nodes[b.parent].child2 = iB;
+            }
+        } else {
+            _root = iB;
+        }
+
+        if (d.height > e.height) {
+            b.child2 = iD;
+            a.child1 = iE;
+            e.parent = iA;
+            a.box = combine(c.box, e.box);
+            b.box = combine(a.box, d.box);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        } else {
+            b.child2 = iE;
+            a.child1 = iD;
+            d.parent = iA;
+            a.box = combine(c.box, d.box);
+            b.box = combine(a.box, e.box);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void DynamicAABBTree::gatherModels(ccstd::vector<Model *> &results) const {
+    if (_root == NULL_NODE) {
+        return;
+    }
+
+    ccstd::vector<int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(_root);
+    while (!stack.empty()) {
+        const auto &node = _nodes[stack.back()];
+        stack.pop_back();
+        if (node.isLeaf()) {
+            results.push_back(node.model);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicAABBTree::queryFrustums(const geometry::Frustum *const *frustums, uint32_t count, ccstd::vector<Model *> *results) const {
+    CC_ASSERT(count <= DYNAMIC_TREE_MAX_BATCH);
+    if (_root == NULL_NODE || count == 0) {
+        return;
+    }
+
+    struct Entry {
+        int32_t nodeId;
+        uint32_t testMask;   // frustums intersecting the parent box
+        uint32_t insideMask; // frustums containing the parent box, no more tests needed
+    };
+
+    ccstd::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({_root, count == DYNAMIC_TREE_MAX_BATCH ? ~0U : (1U << count) - 1U, 0U});
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+
+        const auto &node = _nodes[entry.nodeId];
+        uint32_t testMask = 0U;
+        uint32_t insideMask = entry.insideMask;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!(entry.testMask & (1U << i))) {
+                continue;
+            }
+            const int32_t result = classifyFrustum(node.box, *frustums[i]);
+            if (result == FRUSTUM_INSIDE) {
+                insideMask |= 1U << i;
+            } else if (result == FRUSTUM_INTERSECT) {
+                testMask |= 1U << i;
+            }
+        }
+
+        const uint32_t visibleMask = testMask | insideMask;
+        if (!visibleMask) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (visibleMask & (1U << i)) {
+                    results[i].push_back(node.model);
+                }
+            }
+        } else {
+            stack.push_back({node.child2, testMask, insideMask});
+            stack.push_back({node.child1, testMask, insideMask});
+        }
+    }
+}
+
+void DynamicAABBTree::queryRays(const geometry::Ray *const *rays, uint32_t count, float maxDistance, ccstd::vector<Model *> *results) const {
+    CC_ASSERT(count <= DYNAMIC_TREE_MAX_BATCH);
+    if (_root == NULL_NODE || count == 0) {
+        return;
+    }
+
+    ccstd::array<Vec3, DYNAMIC_TREE_MAX_BATCH> invDirs;
+    for (uint32_t i = 0; i < count; ++i) {
+        const Vec3 &dir = rays[i]->d;
+        invDirs[i].set(1.0F / dir.x, 1.0F / dir.y, 1.0F / dir.z);
+    }
+
+    struct Entry {
+        int32_t nodeId;
+        uint32_t rayMask; // rays hitting the parent box
+    };
+
+    ccstd::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({_root, count == DYNAMIC_TREE_MAX_BATCH ? ~0U : (1U << count) - 1U});
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+
+        const auto &node = _nodes[entry.nodeId];
+        uint32_t rayMask = 0U;
+        for (uint32_t i = 0; i < count; ++i) {
+            if ((entry.rayMask & (1U << i)) && rayHitBox(rays[i]->o, invDirs[i], maxDistance, node.box)) {
+                rayMask |= 1U << i;
+            }
+        }
+
+        if (!rayMask) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (rayMask & (1U << i)) {
+                    results[i].push_back(node.model);
+                }
+            }
+        } else {
+            stack.push_back({node.child2, rayMask});
+            stack.push_back({node.child1, rayMask});
+        }
+    }
+}
+
+bool DynamicAABBTree::validateNode(int32_t nodeId, int32_t parent, uint32_t &leafCount) const { // NOLINT(misc-no-recursion)
+    const auto &node = _nodes[nodeId];
+    if (node.parent != parent) {
+        return false;
+    }
+
+    if (node.isLeaf()) {
+        ++leafCount;
+        return node.height == 0 && node.child2 == NULL_NODE;
+    }
+
+    const auto &node1 = _nodes[node.child1];
+    const auto &node2 = _nodes[node.child2];
+    if (node.height != 1 + std::max(node1.height, node2.height) ||
+        !node.box.contain(node1.box) || !node.box.contain(node2.box)) {
+        return false;
+    }
+
+    return validateNode(node.child1, nodeId, leafCount) && validateNode(node.child2, nodeId, leafCount);
+}
+
+bool DynamicAABBTree::validate() const {
+    if (_root == NULL_NODE) {
+        return _proxyCount == 0;
+    }
+
+    uint32_t leafCount = 0;
+    return validateNode(_root, NULL_NODE, leafCount) && leafCount == _proxyCount;
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "scene/Octree.h"
+
+namespace cc {
+
+namespace geometry {
+class Frustum;
+class Ray;
+} // namespace geometry
+
+namespace scene {
+
+class Model;
+
+constexpr float DYNAMIC_TREE_FAT_MARGIN = 0.1F;   // leaf boxes are enlarged by this value to absorb small movements
+constexpr uint32_t DYNAMIC_TREE_MAX_BATCH = 32U; // maximum number of frustums or rays tested in one traversal
+
+/**
+ * @en Dynamic bounding volume hierarchy of model bounds, leaves store enlarged boxes
+ * so that small movements do not touch the tree, and the tree is kept balanced with rotations.
+ * Unlike the fixed depth octree, it has no world bounds and grows with the scene.
+ * @zh 模型包围盒的动态层次包围体树，叶节点存储扩大后的包围盒，微小的移动不需要修改树，
+ * 并通过旋转保持树的平衡。与固定深度的八叉树不同，它没有世界边界，可以随场景增长。
+ */
+class CC_DLL DynamicAABBTree final {
+public:
+    static constexpr int32_t NULL_NODE = -1;
+
+    DynamicAABBTree() = default;
+    ~DynamicAABBTree() = default;
+
+    /**
+     * @en Insert a model with its tight world box, return the proxy id.
+     * @zh 使用模型的紧致世界包围盒插入模型，返回代理 id。
+     */
+    int32_t createProxy(const BBox &box, Model *model);
+
+    void destroyProxy(int32_t proxyId);
+
+    /**
+     * @en Update the box of a proxy, return true if the leaf was reinserted.
+     * @zh 更新代理的包围盒，叶节点被重新插入时返回 true。
+     */
+    bool moveProxy(int32_t proxyId, const BBox &box);
+
+    void clear();
+
+    inline Model *getModel(int32_t proxyId) const { return _nodes[proxyId].model; }
+    inline const BBox &getFatBox(int32_t proxyId) const { return _nodes[proxyId].box; }
+    inline uint32_t getProxyCount() const { return _proxyCount; }
+    inline int32_t getHeight() const { return _root == NULL_NODE ? 0 : _nodes[_root].height; }
+
+    void gatherModels(ccstd::vector<Model *> &results) const;
+
+    /**
+     * @en Gather the models whose enlarged boxes intersect each frustum, the whole batch shares
+     * a single traversal of the tree. results must point to count vectors.
+     * @zh 收集扩大后的包围盒与各视锥体相交的模型，整批视锥体共用一次树的遍历。results 需指向 count 个数组。
+     */
+    void queryFrustums(const geometry::Frustum *const *frustums, uint32_t count, ccstd::vector<Model *> *results) const;
+
+    /**
+     * @en Gather the models whose enlarged boxes are hit by each ray within maxDistance, the whole batch shares
+     * a single traversal of the tree. results must point to count vectors.
+     * @zh 收集在 maxDistance 范围内扩大后的包围盒与各射线相交的模型，整批射线共用一次树的遍历。results 需指向 count 个数组。
+     */
+    void queryRays(const geometry::Ray *const *rays, uint32_t count, float maxDistance, ccstd::vector<Model *> *results) const;
+
+    // check the structure of the tree, for debugging and tests
+    bool validate() const;
+
+private:
+    struct TreeNode {
+        BBox box;
+        Model *model{nullptr};
+        int32_t parent{NULL_NODE}; // next free node when in the free list
+        int32_t child1{NULL_NODE};
+        int32_t child2{NULL_NODE};
+        int32_t height{-1}; // leaf is 0, free node is -1
+
+        inline bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t nodeId);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t nodeId);
+    bool validateNode(int32_t nodeId, int32_t parent, uint32_t &leafCount) const;
+
+    ccstd::vector<TreeNode> _nodes;
+    int32_t _root{NULL_NODE};
+    int32_t _freeList{NULL_NODE};
+    uint32_t _proxyCount{0};
+};
+
+} // namespace scene
+} // namespace cc
@@ -177,15 +177,69 @@ void Model::updateUBOs(uint32_t stamp) {
 
     updateSHUBOs();
 
-    const auto *pipeline = Root::getInstance()->getPipeline();
-    const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
-    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
-
     if (!_localDataUpdated) {
         return;
     }
     _localDataUpdated = false;
     getTransform()->updateWorldTransform();
+    if (writeLocalUBOData()) {
+        uploadLocalUBOData();
+    }
+}
+
+void Model::prepareParallelUpdate(uint32_t /*stamp*/) {
+    // Node::updateWorldTransform walks up shared parents and is not thread safe,
+    // flush the nodes read by updateLocalData before it runs on workers
+    Node *node = _transform;
+    if (node->isTransformDirty()) {
+        node->updateWorldTransform();
+    }
+
+    for (const int32_t probeId : {_reflectionProbeId, _reflectionProbeBlendId}) {
+        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(probeId);
+        if (probe && probe->getNode()) {
+            probe->getNode()->updateWorldTransform();
+        }
+    }
+}
+
+void Model::updateLocalData(uint32_t /*stamp*/) {
+    const Node *node = _transform;
+    if (node->getChangedFlags() || node->isTransformDirty()) {
+        _localDataUpdated = true;
+        if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
+            _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
+            _worldBoundsDirty = true;
+        }
+    }
+
+    updateLocalUBOData();
+}
+
+void Model::uploadLocalData(uint32_t stamp) {
+    for (SubModel *subModel : _subModels) {
+        subModel->update();
+    }
+    _updateStamp = stamp;
+
+    updateSHUBOs();
+
+    if (_localBufferDirty) {
+        _localBufferDirty = false;
+        uploadLocalUBOData();
+    }
+}
+
+void Model::updateLocalUBOData() {
+    if (!_localDataUpdated) {
+        return;
+    }
+    _localDataUpdated = false;
+    _localBufferDirty = writeLocalUBOData();
+}
+
+// write the world matrices to the instanced attributes and the local buffer staging memory, return true if the local buffer should be uploaded
+bool Model::writeLocalUBOData() {
     const auto &worldMatrix = getTransform()->getWorldMatrix();
     bool hasNonInstancingPass = false;
     for (const auto &subModel : _subModels) {
@@ -198,53 +252,65 @@ void Model::updateUBOs(uint32_t stamp) {
         }
     }
 
-    if ((hasNonInstancingPass || forceUpdateUBO) && _localBuffer) {
-        Mat4 mat4;
-        Mat4::inverseTranspose(worldMatrix, &mat4);
-
-        _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
-        _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
-        _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
-
-        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
-        auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
-        if (probe) {
-            if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
-                const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
-                _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
-                _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            } else {
-                const uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
-                const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
-                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            }
-            if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
-                _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                if (blendProbe) {
-                    const uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
-                    const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
-                    const Vec3 boudingBox = blendProbe->getBoudingSize();
-                    const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                    const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                    _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
-                } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                    // blend with skybox
-                    const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                }
+    if (!_localBuffer) {
+        return false;
+    }
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
+    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
+    if (!hasNonInstancingPass && !forceUpdateUBO) {
+        return false;
+    }
+
+    Mat4 mat4;
+    Mat4::inverseTranspose(worldMatrix, &mat4);
+
+    _localBuffer->write(worldMatrix, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_OFFSET);
+    _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
+    _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
+    _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+
+    auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
+    auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
+    if (probe) {
+        if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
+            const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
+            _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
+            _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
+        } else {
+            const uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
+            const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
+            _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+            _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
+        }
+        if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
+            _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+            if (blendProbe) {
+                const uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
+                const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
+                const Vec3 boudingBox = blendProbe->getBoudingSize();
+                const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
+                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
+                const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
+            } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+                // blend with skybox
+                const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
+                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
             }
         }
+    }
 
-        _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+    return true;
+}
+
+void Model::uploadLocalUBOData() {
+    _localBuffer->update();
+    const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
+    if (enableOcclusionQuery) {
+        updateWorldBoundUBOs();
     }
 }
 
@@ -412,35 +478,50 @@ void Model::clearSHUBOs() {
     updateSHBuffer();
 }
 
-void Model::updateSHUBOs() {
+bool Model::isSHUBOsDirty() const {
     if (!isLightProbeAvailable()) {
-        return;
+        return false;
     }
 
-    const auto center = _worldBounds->getCenter();
 #if !CC_EDITOR
-    if (center.approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
-        return;
+    if (_worldBounds->getCenter().approxEquals(_lastWorldBoundCenter, math::EPSILON)) {
+        return false;
     }
 #endif
 
-    ccstd::vector<Vec3> coefficients;
-    Vec4 weights(0.0F, 0.0F, 0.0F, 0.0F);
+    return true;
+}
+
+void Model::updateSHUBOs() {
+    if (!isSHUBOsDirty()) {
+        return;
+    }
+
+    const auto center = _worldBounds->getCenter();
     const auto *pipeline = Root::getInstance()->getPipeline();
     const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
 
+    ccstd::array<Vec3, SH_BASIS_COUNT> coefficients;
     _lastWorldBoundCenter.set(center);
-    _tetrahedronIndex = lightProbes->getData()->getInterpolationWeights(center, _tetrahedronIndex, weights);
-    const bool result = lightProbes->getData()->getInterpolationSHCoefficients(_tetrahedronIndex, weights, coefficients);
-    if (!result) {
+    if (!lightProbes->getData()->evaluateSHCoefficients(&center, &_tetrahedronIndex, coefficients.data(), 1)) {
         return;
     }
 
+    applySHCoefficients(coefficients.data(), lightProbes->getReduceRinging());
+}
+
+void Model::updateSHUBOs(int32_t tetrahedronIndex, Vec3 *coefficients, float reduceRinging) {
+    _lastWorldBoundCenter.set(_worldBounds->getCenter());
+    _tetrahedronIndex = tetrahedronIndex;
+    applySHCoefficients(coefficients, reduceRinging);
+}
+
+void Model::applySHCoefficients(Vec3 *coefficients, float reduceRinging) {
     if (_localSHData.empty()) {
         return;
     }
 
-    gi::SH::reduceRinging(coefficients, lightProbes->getReduceRinging());
+    gi::SH::reduceRinging(coefficients, reduceRinging);
     gi::SH::updateUBOData(_localSHData, pipeline::UBOSH::SH_LINEAR_CONST_R_OFFSET, coefficients);
     updateSHBuffer();
 }
@@ -125,6 +125,14 @@ public:
     virtual void updateLocalSHDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
     virtual void updateWorldBoundDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
 
+    // updateTransform and updateUBOs split for the parallel update of RenderScene:
+    // prepareParallelUpdate runs serially and resolves transforms that may be shared with other models,
+    // updateLocalData only writes data owned by this model and may run on job system workers,
+    // uploadLocalData runs serially in model order and commits the results to gfx.
+    virtual void prepareParallelUpdate(uint32_t stamp);
+    virtual void updateLocalData(uint32_t stamp);
+    virtual void uploadLocalData(uint32_t stamp);
+
     void createBoundingShape(const ccstd::optional<Vec3> &minPos, const ccstd::optional<Vec3> &maxPos);
     void initialize();
     void initLightingmap(Texture2D *texture, const Vec4 &uvParam);
@@ -142,6 +150,9 @@ public:
     void updateLightingmap(Texture2D *texture, const Vec4 &uvParam);
     void clearSHUBOs();
     void updateSHUBOs();
+    bool isSHUBOsDirty() const;
+    // commit SH coefficients evaluated for the current world bounds in a batch of models
+    void updateSHUBOs(int32_t tetrahedronIndex, Vec3 *coefficients, float reduceRinging);
     void updateOctree();
     void updateWorldBoundUBOs();
     void updateLocalShadowBias();
@@ -177,6 +188,7 @@ public:
         _worldBoundsDirty = true;
     }
     inline void setOctreeNode(OctreeNode *node) { _octreeNode = node; }
+    inline void setSpatialProxyId(int32_t proxyId) { _spatialProxyId = proxyId; }
     inline void setScene(RenderScene *scene) {
         _scene = scene;
         if (scene) _localDataUpdated = true;
@@ -227,6 +239,7 @@ public:
     inline Type getType() const { return _type; };
     inline void setType(Type type) { _type = type; }
     inline OctreeNode *getOctreeNode() const { return _octreeNode; }
+    inline int32_t getSpatialProxyId() const { return _spatialProxyId; }
     inline RenderScene *getScene() const { return _scene; }
     inline void setDynamicBatching(bool val) { _isDynamicBatching = val; }
     inline bool isDynamicBatching() const { return _isDynamicBatching; }
@@ -256,7 +269,11 @@ protected:
 
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
+    void applySHCoefficients(Vec3 *coefficients, float reduceRinging);
     void updateSHBuffer();
+    void updateLocalUBOData();
+    bool writeLocalUBOData();
+    void uploadLocalUBOData();
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -272,6 +289,7 @@ protected:
     float _reflectionProbeBlendWeight{0.F};
 
     OctreeNode *_octreeNode{nullptr};
+    int32_t _spatialProxyId{-1}; // proxy in the dynamic bvh of the octree
     RenderScene *_scene{nullptr};
     gfx::Device *_device{nullptr};
 
@@ -291,6 +309,7 @@ protected:
     bool _inited{false};
     bool _localDataUpdated{false};
     bool _worldBoundsDirty{true};
+    bool _localBufferDirty{false};
     bool _useLightProbe = false;
     bool _bakeToReflectionProbe{true};
     bool _receiveDirLight{true};
@@ -0,0 +1,189 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+// Detect SIMD support before including math headers, Mat4.h undefines __SSE__.
+#if defined(__SSE__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define USE_SSE
+    #include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define USE_NEON
+    #include <arm_neon.h>
+#endif
+
+#include "scene/ModelBoundsArray.h"
+#include <algorithm>
+#include <cmath>
+#include "base/job-system/ForEachChunk.h"
+#include "base/std/container/array.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+
+namespace cc {
+namespace scene {
+
+void ModelBoundsArray::clear() {
+    _models.clear();
+    _centerX.clear();
+    _centerY.clear();
+    _centerZ.clear();
+    _extentX.clear();
+    _extentY.clear();
+    _extentZ.clear();
+    _unbounded.clear();
+}
+
+void ModelBoundsArray::reserve(uint32_t capacity) {
+    _models.reserve(capacity);
+    _centerX.reserve(capacity);
+    _centerY.reserve(capacity);
+    _centerZ.reserve(capacity);
+    _extentX.reserve(capacity);
+    _extentY.reserve(capacity);
+    _extentZ.reserve(capacity);
+    _unbounded.reserve(capacity);
+}
+
+void ModelBoundsArray::add(const Model *model, const geometry::AABB *worldBounds) {
+    _models.emplace_back(model);
+    if (worldBounds) {
+        const auto &center = worldBounds->getCenter();
+        const auto &halfExtents = worldBounds->getHalfExtents();
+        _centerX.emplace_back(center.x);
+        _centerY.emplace_back(center.y);
+        _centerZ.emplace_back(center.z);
+        _extentX.emplace_back(halfExtents.x);
+        _extentY.emplace_back(halfExtents.y);
+        _extentZ.emplace_back(halfExtents.z);
+        _unbounded.emplace_back(0);
+    } else {
+        _centerX.emplace_back(0.F);
+        _centerY.emplace_back(0.F);
+        _centerZ.emplace_back(0.F);
+        _extentX.emplace_back(0.F);
+        _extentY.emplace_back(0.F);
+        _extentZ.emplace_back(0.F);
+        _unbounded.emplace_back(1);
+    }
+}
+
+void ModelBoundsArray::cullFrustumScalar(const geometry::Frustum &frustum, uint32_t begin, uint32_t end, uint8_t *visibility) const {
+    // Same as geometry::AABB::aabbFrustum, kept in sync with the SIMD paths below.
+    for (uint32_t i = begin; i < end; ++i) {
+        bool outside = false;
+        for (const auto *plane : frustum.planes) {
+            const float dot = plane->n.x * _centerX[i] + plane->n.y * _centerY[i] + plane->n.z * _centerZ[i];
+            const float r = _extentX[i] * std::abs(plane->n.x) + _extentY[i] * std::abs(plane->n.y) + _extentZ[i] * std::abs(plane->n.z);
+            if (dot + r < plane->d) {
+                outside = true;
+                break;
+            }
+        }
+        visibility[i] = (!outside || _unbounded[i]) ? 1 : 0;
+    }
+}
+
+void ModelBoundsArray::cullFrustum(const geometry::Frustum &frustum, uint32_t begin, uint32_t end, uint8_t *visibility) const {
+    CC_ASSERT(begin <= end && end <= size());
+    uint32_t i = begin;
+#if defined(USE_SSE)
+    struct PlaneLanes {
+        __m128 nx, ny, nz, ax, ay, az, d;
+    };
+    ccstd::array<PlaneLanes, 6> planes;
+    for (size_t p = 0; p < planes.size(); ++p) {
+        const auto *plane = frustum.planes[p];
+        planes[p] = {
+            _mm_set1_ps(plane->n.x), _mm_set1_ps(plane->n.y), _mm_set1_ps(plane->n.z),
+            _mm_set1_ps(std::abs(plane->n.x)), _mm_set1_ps(std::abs(plane->n.y)), _mm_set1_ps(std::abs(plane->n.z)),
+            _mm_set1_ps(plane->d)};
+    }
+    for (; i + 4 <= end; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&_centerX[i]);
+        const __m128 cy = _mm_loadu_ps(&_centerY[i]);
+        const __m128 cz = _mm_loadu_ps(&_centerZ[i]);
+        const __m128 ex = _mm_loadu_ps(&_extentX[i]);
+        const __m128 ey = _mm_loadu_ps(&_extentY[i]);
+        const __m128 ez = _mm_loadu_ps(&_extentZ[i]);
+        __m128 outside = _mm_setzero_ps();
+        for (const auto &plane : planes) {
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane.nx, cx), _mm_mul_ps(plane.ny, cy)), _mm_mul_ps(plane.nz, cz));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, plane.ax), _mm_mul_ps(ey, plane.ay)), _mm_mul_ps(ez, plane.az));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), plane.d));
+        }
+        const int mask = _mm_movemask_ps(outside);
+        for (uint32_t k = 0; k < 4; ++k) {
+            visibility[i + k] = (!(mask & (1 << k)) || _unbounded[i + k]) ? 1 : 0;
+        }
+    }
+#elif defined(USE_NEON)
+    struct PlaneLanes {
+        float32x4_t nx, ny, nz, ax, ay, az, d;
+    };
+    ccstd::array<PlaneLanes, 6> planes;
+    for (size_t p = 0; p < planes.size(); ++p) {
+        const auto *plane = frustum.planes[p];
+        planes[p] = {
+            vdupq_n_f32(plane->n.x), vdupq_n_f32(plane->n.y), vdupq_n_f32(plane->n.z),
+            vdupq_n_f32(std::abs(plane->n.x)), vdupq_n_f32(std::abs(plane->n.y)), vdupq_n_f32(std::abs(plane->n.z)),
+            vdupq_n_f32(plane->d)};
+    }
+    for (; i + 4 <= end; i += 4) {
+        const float32x4_t cx = vld1q_f32(&_centerX[i]);
+        const float32x4_t cy = vld1q_f32(&_centerY[i]);
+        const float32x4_t cz = vld1q_f32(&_centerZ[i]);
+        const float32x4_t ex = vld1q_f32(&_extentX[i]);
+        const float32x4_t ey = vld1q_f32(&_extentY[i]);
+        const float32x4_t ez = vld1q_f32(&_extentZ[i]);
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (const auto &plane : planes) {
+            const float32x4_t dot = vaddq_f32(vaddq_f32(vmulq_f32(plane.nx, cx), vmulq_f32(plane.ny, cy)), vmulq_f32(plane.nz, cz));
+            const float32x4_t r = vaddq_f32(vaddq_f32(vmulq_f32(ex, plane.ax), vmulq_f32(ey, plane.ay)), vmulq_f32(ez, plane.az));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), plane.d));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        for (uint32_t k = 0; k < 4; ++k) {
+            visibility[i + k] = (!lanes[k] || _unbounded[i + k]) ? 1 : 0;
+        }
+    }
+#endif
+    cullFrustumScalar(frustum, i, end, visibility);
+}
+
+void ModelBoundsArray::cullFrustum(const geometry::Frustum &frustum, ccstd::vector<uint8_t> &visibility) const {
+    const uint32_t count = size();
+    visibility.resize(count);
+
+    // keep whole SIMD groups in one job
+    uint8_t *output = visibility.data();
+    forEachChunk(
+        count, BOUNDS_CULLING_PARALLEL_THRESHOLD, [this, &frustum, output](uint32_t begin, uint32_t end) {
+            cullFrustum(frustum, begin, end, output);
+        },
+        1U, 4U);
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,97 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace geometry {
+class AABB;
+class Frustum;
+} // namespace geometry
+
+namespace scene {
+
+class Model;
+
+constexpr uint32_t BOUNDS_CULLING_PARALLEL_THRESHOLD = 8192; // split frustum culling into jobs if greater than this value
+
+/**
+ * @en World bounds of the models in a render scene, packed as structure of arrays.
+ * Frustum culling tests four boxes per iteration with SSE or NEON when available,
+ * and big arrays are split across the job system workers.
+ * @zh 以结构数组形式紧凑存储的渲染场景中模型的世界包围盒。
+ * 视锥剔除在支持 SSE 或 NEON 时每次迭代测试四个包围盒，较大的数组会分发到 job system 中并行处理。
+ */
+class CC_DLL ModelBoundsArray final {
+public:
+    ModelBoundsArray() = default;
+    ~ModelBoundsArray() = default;
+
+    void clear();
+    void reserve(uint32_t capacity);
+
+    /**
+     * @en Append a model, models without world bounds are never culled.
+     * @zh 添加一个模型，没有世界包围盒的模型永远不会被剔除。
+     */
+    void add(const Model *model, const geometry::AABB *worldBounds);
+
+    inline uint32_t size() const { return static_cast<uint32_t>(_models.size()); }
+    inline bool empty() const { return _models.empty(); }
+    inline const ccstd::vector<const Model *> &getModels() const { return _models; }
+
+    /**
+     * @en Test the boxes in [begin, end) against the frustum, writes 1 to visibility[i] if box i intersects the frustum, 0 otherwise.
+     * @zh 测试 [begin, end) 范围内的包围盒与视锥是否相交，相交时 visibility[i] 为 1，否则为 0。
+     */
+    void cullFrustum(const geometry::Frustum &frustum, uint32_t begin, uint32_t end, uint8_t *visibility) const;
+
+    /**
+     * @en Test all boxes against the frustum, split across the job system if the array is big enough.
+     * @zh 测试所有包围盒与视锥是否相交，数组足够大时分发到 job system 中并行处理。
+     */
+    void cullFrustum(const geometry::Frustum &frustum, ccstd::vector<uint8_t> &visibility) const;
+
+private:
+    void cullFrustumScalar(const geometry::Frustum &frustum, uint32_t begin, uint32_t end, uint8_t *visibility) const;
+
+    ccstd::vector<const Model *> _models;
+    ccstd::vector<float> _centerX;
+    ccstd::vector<float> _centerY;
+    ccstd::vector<float> _centerZ;
+    ccstd::vector<float> _extentX;
+    ccstd::vector<float> _extentY;
+    ccstd::vector<float> _extentZ;
+    ccstd::vector<uint8_t> _unbounded;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(ModelBoundsArray);
+};
+
+} // namespace scene
+} // namespace cc
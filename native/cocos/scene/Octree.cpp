@@ -23,14 +23,68 @@
 ****************************************************************************/
 
 #include "Octree.h"
+#include <algorithm>
 #include <future>
 #include <utility>
+#include "core/geometry/Intersect.h"
+#include "core/geometry/Ray.h"
 #include "scene/Camera.h"
+#include "scene/DynamicAABBTree.h"
 #include "scene/Model.h"
 
 namespace cc {
 namespace scene {
 
+namespace {
+
+bool isModelVisible(uint32_t visibility, const Model *model, const geometry::Frustum &frustum, bool isShadow) {
+    if (!model->isEnabled()) {
+        return false;
+    }
+
+    const Node *node = model->getNode();
+    if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
+        (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+        const geometry::AABB *modelWorldBounds = model->getWorldBounds();
+        if (!modelWorldBounds) {
+            return false;
+        }
+
+        if (isShadow && !model->isCastShadow()) {
+            return false;
+        }
+
+        return modelWorldBounds->aabbFrustum(frustum);
+    }
+
+    return false;
+}
+
+void hitModel(const geometry::Ray &ray, uint32_t mask, float distance, const Model *model, ccstd::vector<ModelRayHit> &results) {
+    if (!model->isEnabled()) {
+        return;
+    }
+
+    const Node *node = model->getNode();
+    const geometry::AABB *modelWorldBounds = model->getWorldBounds();
+    if (!node || !(node->getLayer() & mask) || !modelWorldBounds) {
+        return;
+    }
+
+    const float d = geometry::rayAABB(ray, *modelWorldBounds);
+    if (d > 0.F && d < distance) {
+        results.push_back({model, d});
+    }
+}
+
+void sortRayHits(ccstd::vector<ModelRayHit> &results, size_t first) {
+    std::sort(results.begin() + static_cast<std::ptrdiff_t>(first), results.end(), [](const ModelRayHit &lhs, const ModelRayHit &rhs) {
+        return lhs.distance < rhs.distance;
+    });
+}
+
+} // namespace
+
 void OctreeInfo::setEnabled(bool val) {
     if (_enabled == val) {
         return;
@@ -62,6 +116,13 @@ void OctreeInfo::setDepth(uint32_t val) {
     }
 }
 
+void OctreeInfo::setType(OctreeType val) {
+    _type = val;
+    if (_resource) {
+        _resource->setType(val);
+    }
+}
+
 void OctreeInfo::activate(Octree *resource) {
     _resource = resource;
     _resource->initialize(*this);
@@ -224,27 +285,8 @@ void OctreeNode::gatherModels(ccstd::vector<Model *> &results) const { // NOLINT
 void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
     const auto visibility = camera->getVisibility();
     for (auto *model : _models) {
-        if (!model->isEnabled()) {
-            continue;
-        }
-
-        const Node *node = model->getNode();
-        if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
-            (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-            const geometry::AABB *modelWorldBounds = model->getWorldBounds();
-            if (!modelWorldBounds) {
-                continue;
-            }
-
-            if (isShadow) {
-                if (model->isCastShadow() && modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            } else {
-                if (modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            }
+        if (isModelVisible(visibility, model, frustum, isShadow)) {
+            results.push_back(model);
         }
     }
 }
@@ -294,15 +336,36 @@ void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometr
     }
 }
 
+void OctreeNode::queryRay(const geometry::Ray &ray, uint32_t mask, float distance, ccstd::vector<ModelRayHit> &results) const { // NOLINT(misc-no-recursion)
+    if (!_aabb.contain(ray.o)) {
+        const float d = geometry::rayAABB2(ray, _aabb.min, _aabb.max);
+        if (d <= 0.F || d >= distance) {
+            return;
+        }
+    }
+
+    for (auto *model : _models) {
+        hitModel(ray, mask, distance, model, results);
+    }
+
+    for (auto *child : _children) {
+        if (child) {
+            child->queryRay(ray, mask, distance, results);
+        }
+    }
+}
+
 /**
  * Octree class
  */
 Octree::Octree() {
     _root = ccnew OctreeNode(this, nullptr);
+    _dynamicTree = ccnew DynamicAABBTree();
 }
 
 Octree::~Octree() {
     delete _root;
+    delete _dynamicTree;
 }
 
 void Octree::initialize(const OctreeInfo &info) {
@@ -311,6 +374,7 @@ void Octree::initialize(const OctreeInfo &info) {
     _maxPos = info.getMaxPos();
     _maxDepth = std::max(info.getDepth(), 1U);
     setEnabled(info.isEnabled());
+    setType(info.getType());
     _root->setBox(BBox{_minPos - expand, _maxPos});
     _root->setDepth(0);
     _root->setIndex(0);
@@ -323,6 +387,23 @@ void Octree::setEnabled(bool val) {
     _enabled = val;
 }
 
+void Octree::setType(OctreeType val) {
+    if (_type == val) {
+        return;
+    }
+
+    ccstd::vector<Model *> models;
+    gatherModels(models);
+    for (auto *model : models) {
+        remove(model);
+    }
+
+    _type = val;
+    for (auto *model : models) {
+        insert(model);
+    }
+}
+
 void Octree::setMinPos(const Vec3 &val) {
     _minPos = val;
 }
@@ -366,6 +447,18 @@ void Octree::insert(Model *model) {
         return;
     }
 
+    if (_type == OctreeType::DYNAMIC_BVH) {
+        const BBox modelBox(*model->getWorldBounds());
+        const int32_t proxyId = model->getSpatialProxyId();
+        if (proxyId == DynamicAABBTree::NULL_NODE) {
+            model->setSpatialProxyId(_dynamicTree->createProxy(modelBox, model));
+            _totalCount++;
+        } else {
+            _dynamicTree->moveProxy(proxyId, modelBox);
+        }
+        return;
+    }
+
     if (isOutside(model)) {
         CC_LOG_WARNING("Octree insert: model is outside of the scene bounding box, please modify DEFAULT_WORLD_MIN_POS and DEFAULT_WORLD_MAX_POS.");
         return;
@@ -381,6 +474,13 @@ void Octree::insert(Model *model) {
 void Octree::remove(Model *model) {
     CC_ASSERT(model);
 
+    const int32_t proxyId = model->getSpatialProxyId();
+    if (proxyId != DynamicAABBTree::NULL_NODE) {
+        _dynamicTree->destroyProxy(proxyId);
+        model->setSpatialProxyId(DynamicAABBTree::NULL_NODE);
+        _totalCount--;
+    }
+
     OctreeNode *node = model->getOctreeNode();
     if (node) {
         node->remove(model);
@@ -394,6 +494,13 @@ void Octree::update(Model *model) {
 }
 
 void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
+    if (_type == OctreeType::DYNAMIC_BVH) {
+        const geometry::Frustum *frustums[] = {&frustum};
+        ccstd::vector<const Model *> *outputs[] = {&results};
+        queryVisibilityBatched(camera, frustums, 1, isShadow, outputs);
+        return;
+    }
+
     if (_totalCount > USE_MULTI_THRESHOLD) {
         _root->queryVisibilityParallelly(camera, frustum, isShadow, results);
     } else {
@@ -401,6 +508,86 @@ void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frus
     }
 }
 
+void Octree::queryVisibilityBatched(const Camera *camera, const geometry::Frustum *const *frustums, uint32_t count, bool isShadow, ccstd::vector<const Model *> *const *results) const {
+    if (_type != OctreeType::DYNAMIC_BVH) {
+        for (uint32_t i = 0; i < count; ++i) {
+            queryVisibility(camera, *frustums[i], isShadow, *results[i]);
+        }
+        return;
+    }
+
+    const auto visibility = camera->getVisibility();
+    ccstd::vector<ccstd::vector<Model *>> candidates(std::min(count, DYNAMIC_TREE_MAX_BATCH));
+    for (uint32_t offset = 0; offset < count; offset += DYNAMIC_TREE_MAX_BATCH) {
+        const uint32_t batchSize = std::min(count - offset, DYNAMIC_TREE_MAX_BATCH);
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            candidates[i].clear();
+        }
+
+        _dynamicTree->queryFrustums(frustums + offset, batchSize, candidates.data());
+
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            const auto &frustum = *frustums[offset + i];
+            auto &output = *results[offset + i];
+            for (const auto *model : candidates[i]) {
+                if (isModelVisible(visibility, model, frustum, isShadow)) {
+                    output.push_back(model);
+                }
+            }
+        }
+    }
+}
+
+void Octree::queryRay(const geometry::Ray &ray, uint32_t mask, float distance, ccstd::vector<ModelRayHit> &results) const {
+    if (_type == OctreeType::DYNAMIC_BVH) {
+        const geometry::Ray *rays[] = {&ray};
+        ccstd::vector<ModelRayHit> *outputs[] = {&results};
+        queryRaysBatched(rays, 1, mask, distance, outputs);
+        return;
+    }
+
+    const auto first = results.size();
+    _root->queryRay(ray, mask, distance, results);
+    sortRayHits(results, first);
+}
+
+void Octree::queryRaysBatched(const geometry::Ray *const *rays, uint32_t count, uint32_t mask, float distance, ccstd::vector<ModelRayHit> *const *results) const {
+    if (_type != OctreeType::DYNAMIC_BVH) {
+        for (uint32_t i = 0; i < count; ++i) {
+            queryRay(*rays[i], mask, distance, *results[i]);
+        }
+        return;
+    }
+
+    ccstd::vector<ccstd::vector<Model *>> candidates(std::min(count, DYNAMIC_TREE_MAX_BATCH));
+    for (uint32_t offset = 0; offset < count; offset += DYNAMIC_TREE_MAX_BATCH) {
+        const uint32_t batchSize = std::min(count - offset, DYNAMIC_TREE_MAX_BATCH);
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            candidates[i].clear();
+        }
+
+        _dynamicTree->queryRays(rays + offset, batchSize, distance, candidates.data());
+
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            const auto &ray = *rays[offset + i];
+            auto &output = *results[offset + i];
+            const auto first = output.size();
+            for (const auto *model : candidates[i]) {
+                hitModel(ray, mask, distance, model, output);
+            }
+            sortRayHits(output, first);
+        }
+    }
+}
+
+void Octree::gatherModels(ccstd::vector<Model *> &results) const {
+    if (_type == OctreeType::DYNAMIC_BVH) {
+        _dynamicTree->gatherModels(results);
+    } else {
+        _root->gatherModels(results);
+    }
+}
+
 bool Octree::isInside(Model *model) const {
     const BBox &rootBox = _root->getBox();
     BBox modelBox = BBox(*model->getWorldBounds());
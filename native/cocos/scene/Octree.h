@@ -31,9 +31,15 @@
 #include "math/Vec3.h"
 
 namespace cc {
+
+namespace geometry {
+class Ray;
+} // namespace geometry
+
 namespace scene {
 
 class Camera;
+class DynamicAABBTree;
 class Model;
 class Octree;
 
@@ -44,6 +50,18 @@ const Vec3 DEFAULT_WORLD_MAX_POS = {1024.0F, 1024.0F, 1024.0F};
 const float OCTREE_BOX_EXPAND_SIZE = 10.0F;
 constexpr int USE_MULTI_THRESHOLD = 1024; // use parallel culling if greater than this value
 
+enum class OctreeType : uint32_t {
+    // octree with fixed world bounds and depth
+    FIXED_DEPTH = 0,
+    // dynamic bounding volume hierarchy without world bounds
+    DYNAMIC_BVH = 1,
+};
+
+struct ModelRayHit {
+    const Model *model{nullptr};
+    float distance{0.F};
+};
+
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
     OctreeInfo() = default;
@@ -76,6 +94,9 @@ public:
     void setDepth(uint32_t val);
     inline uint32_t getDepth() const { return _depth; }
 
+    void setType(OctreeType val);
+    inline OctreeType getType() const { return _type; }
+
     void activate(Octree *resource);
 
     // JS deserialization require the properties to be public
@@ -84,6 +105,7 @@ public:
     Vec3 _minPos{DEFAULT_WORLD_MIN_POS};
     Vec3 _maxPos{DEFAULT_WORLD_MAX_POS};
     uint32_t _depth{DEFAULT_OCTREE_DEPTH};
+    OctreeType _type{OctreeType::FIXED_DEPTH};
 
 private:
     Octree *_resource{nullptr};
@@ -154,6 +176,7 @@ private:
     void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
     void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
     void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
+    void queryRay(const geometry::Ray &ray, uint32_t mask, float distance, ccstd::vector<ModelRayHit> &results) const;
 
     Octree *_owner{nullptr};
     OctreeNode *_parent{nullptr};
@@ -197,6 +220,10 @@ public:
     void setMaxPos(const Vec3 &val);
     inline const Vec3 &getMaxPos() const { return _maxPos; }
 
+    // switch between the fixed depth octree and the dynamic bvh, all models are moved to the new structure
+    void setType(OctreeType val);
+    inline OctreeType getType() const { return _type; }
+
     // reinsert all models in the tree when you change the aabb or max depth in editor
     void resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth);
 
@@ -220,15 +247,37 @@ public:
     // view frustum culling
     void queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
 
+    /**
+     * @en View frustum culling of several frustums, e.g. shadow cascades, results holds count output vectors.
+     * With the dynamic bvh the whole batch is culled in one traversal.
+     * @zh 多个视锥体的剔除，例如阴影级联，results 包含 count 个输出数组。使用动态 bvh 时整批视锥体只遍历一次。
+     */
+    void queryVisibilityBatched(const Camera *camera, const geometry::Frustum *const *frustums, uint32_t count, bool isShadow, ccstd::vector<const Model *> *const *results) const;
+
+    /**
+     * @en Gather the enabled models in the layer mask whose world bounds are hit by the ray within distance, sorted by distance.
+     * @zh 收集层级掩码内在 distance 范围内世界包围盒与射线相交的已启用模型，按距离排序。
+     */
+    void queryRay(const geometry::Ray &ray, uint32_t mask, float distance, ccstd::vector<ModelRayHit> &results) const;
+
+    /**
+     * @en Ray queries of several rays, results holds count output vectors. With the dynamic bvh the whole batch is tested in one traversal.
+     * @zh 多条射线的查询，results 包含 count 个输出数组。使用动态 bvh 时整批射线只遍历一次。
+     */
+    void queryRaysBatched(const geometry::Ray *const *rays, uint32_t count, uint32_t mask, float distance, ccstd::vector<ModelRayHit> *const *results) const;
+
 private:
     bool isInside(Model *model) const;
     bool isOutside(Model *model) const;
+    void gatherModels(ccstd::vector<Model *> &results) const;
 
     OctreeNode *_root{nullptr};
+    DynamicAABBTree *_dynamicTree{nullptr};
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t _totalCount{0};
 
     bool _enabled{false};
+    OctreeType _type{OctreeType::FIXED_DEPTH};
     Vec3 _minPos;
     Vec3 _maxPos;
 };
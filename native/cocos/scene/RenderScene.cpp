@@ -25,12 +25,19 @@
 #include "scene/RenderScene.h"
 #include "scene/Camera.h"
 
+#include <algorithm>
 #include <utility>
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/ForEachChunk.h"
 #include "core/Root.h"
+#include "core/geometry/Intersect.h"
+#include "core/geometry/Ray.h"
 #include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformHierarchy.h"
+#include "gi/light-probe/LightProbe.h"
+#include "gi/light-probe/SH.h"
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -48,6 +55,11 @@
 namespace cc {
 namespace scene {
 
+namespace {
+constexpr uint32_t PARALLEL_MODEL_UPDATE_THRESHOLD = 256; // update models on the job system if more than this value
+constexpr uint32_t MIN_MODELS_PER_UPDATE_JOB = 64;
+} // namespace
+
 /**
  * @zh 管理LODGroup的使用状态，包含使用层级及其上的model可见相机列表；便于判断当前model是否被LODGroup裁剪
  * @en Manage the usage status of LODGroup, including the usage level and the list of visible cameras on its models; easy to determine whether the current mod is cropped by LODGroup。
@@ -160,9 +172,17 @@ void RenderScene::setMainLight(DirectionalLight *dl) {
     if (_mainLight) _mainLight->activate();
 }
 
+void RenderScene::setTransformHierarchy(TransformHierarchy *hierarchy) {
+    _transformHierarchy = hierarchy;
+}
+
 void RenderScene::update(uint32_t stamp) {
     CC_PROFILE(RenderSceneUpdate);
 
+    if (_transformHierarchy) {
+        _transformHierarchy->update();
+    }
+
     if (_mainLight) {
         _mainLight->update();
     }
@@ -178,11 +198,23 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &light : _rangedDirLights) {
         light->update();
     }
-    for (const auto &model : _models) {
-        if (model->isEnabled()) {
-            model->updateTransform(stamp);
-            model->updateUBOs(stamp);
-            model->updateOctree();
+    _modelBounds.clear();
+    _modelBounds.reserve(static_cast<uint32_t>(_models.size()));
+    if (_parallelUpdateEnabled && _models.size() >= PARALLEL_MODEL_UPDATE_THRESHOLD && JobSystem::getInstance()->threadCount() > 1) {
+        updateModelsParallelly(stamp);
+    } else {
+        for (const auto &model : _models) {
+            if (model->isEnabled()) {
+                model->updateTransform(stamp);
+            }
+        }
+        updateModelSHUBOs();
+        for (const auto &model : _models) {
+            if (model->isEnabled()) {
+                model->updateUBOs(stamp);
+                model->updateOctree();
+            }
+            _modelBounds.add(model, model->getWorldBounds());
         }
     }
 
@@ -193,6 +225,84 @@ void RenderScene::update(uint32_t stamp) {
     _lodStateCache->updateLodState();
 }
 
+void RenderScene::updateModelsParallelly(uint32_t stamp) {
+    const auto modelCount = static_cast<uint32_t>(_models.size());
+
+    // resolve node and joint transforms which may be shared between models
+    for (const auto &model : _models) {
+        if (model->isEnabled() && !model->isModelImplementedInJS()) {
+            model->prepareParallelUpdate(stamp);
+        }
+    }
+
+    // every model only writes its own data here
+    forEachChunk(
+        modelCount, 0U, [this, stamp](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                Model *model = _models[i];
+                if (model->isEnabled() && !model->isModelImplementedInJS()) {
+                    model->updateLocalData(stamp);
+                }
+            }
+        },
+        MIN_MODELS_PER_UPDATE_JOB);
+
+    updateModelSHUBOs();
+
+    // commit gfx uploads and the octree in model order
+    for (const auto &model : _models) {
+        if (model->isEnabled()) {
+            if (model->isModelImplementedInJS()) {
+                model->updateTransform(stamp);
+                model->updateUBOs(stamp);
+            } else {
+                model->uploadLocalData(stamp);
+            }
+            model->updateOctree();
+        }
+        _modelBounds.add(model, model->getWorldBounds());
+    }
+}
+
+void RenderScene::updateModelSHUBOs() {
+#if !CC_EDITOR
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    if (!pipeline || !pipeline->getPipelineSceneData()) {
+        return;
+    }
+
+    const auto *lightProbes = pipeline->getPipelineSceneData()->getLightProbes();
+    if (!lightProbes || lightProbes->empty() || !lightProbes->getData()->hasCoefficients()) {
+        return;
+    }
+
+    // models left out here, such as the ones implemented in JS, evaluate their own in updateUBOs
+    _shModels.clear();
+    _shPositions.clear();
+    _shTetrahedronIndices.clear();
+    for (const auto &model : _models) {
+        if (model->isEnabled() && !model->isModelImplementedInJS() && model->isSHUBOsDirty()) {
+            _shModels.push_back(model);
+            _shPositions.push_back(model->getWorldBounds()->getCenter());
+            _shTetrahedronIndices.push_back(model->getTetrahedronIndex());
+        }
+    }
+    if (_shModels.empty()) {
+        return;
+    }
+
+    const auto basisCount = gi::SH::getBasisCount();
+    const auto count = static_cast<uint32_t>(_shModels.size());
+    _shCoefficients.resize(count * basisCount);
+    lightProbes->getData()->evaluateSHCoefficients(_shPositions.data(), _shTetrahedronIndices.data(), _shCoefficients.data(), count);
+
+    const auto reduceRinging = lightProbes->getReduceRinging();
+    for (uint32_t i = 0; i < count; ++i) {
+        _shModels[i]->updateSHUBOs(_shTetrahedronIndices[i], &_shCoefficients[i * basisCount], reduceRinging);
+    }
+#endif
+}
+
 void RenderScene::destroy() {
     removeCameras();
     removeSphereLights();
@@ -343,6 +453,7 @@ void RenderScene::removeRangedDirLights() {
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
     _models.emplace_back(model);
+    _modelBounds.clear();
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
@@ -357,6 +468,7 @@ void RenderScene::removeModel(Model *model) {
         _lodStateCache->removeModel(model);
         model->detachFromScene();
         _models.erase(iter);
+        _modelBounds.clear();
     } else {
         CC_LOG_WARNING("Try to remove invalid model.");
     }
@@ -372,6 +484,7 @@ void RenderScene::removeModels() {
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
+    _modelBounds.clear();
 }
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
@@ -396,6 +509,43 @@ void RenderScene::updateOctree(Model *model) {
     }
 }
 
+void RenderScene::raycastModels(const geometry::Ray *const *rays, uint32_t count, uint32_t mask, float distance, ccstd::vector<IRaycastResult> *const *results) const {
+    if (_octree && _octree->isEnabled()) {
+        ccstd::vector<ccstd::vector<ModelRayHit>> hits(count);
+        ccstd::vector<ccstd::vector<ModelRayHit> *> outputs(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            outputs[i] = &hits[i];
+        }
+        _octree->queryRaysBatched(rays, count, mask, distance, outputs.data());
+        for (uint32_t i = 0; i < count; ++i) {
+            for (const auto &hit : hits[i]) {
+                results[i]->push_back({hit.model->getNode(), hit.distance});
+            }
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        auto &output = *results[i];
+        const auto first = output.size();
+        for (const auto &model : _models) {
+            Node *node = model->getNode();
+            const geometry::AABB *modelWorldBounds = model->getWorldBounds();
+            if (!model->isEnabled() || !node || !(node->getLayer() & mask) || !modelWorldBounds) {
+                continue;
+            }
+
+            const float d = geometry::rayAABB(*rays[i], *modelWorldBounds);
+            if (d > 0.F && d < distance) {
+                output.push_back({node, d});
+            }
+        }
+        std::sort(output.begin() + static_cast<std::ptrdiff_t>(first), output.end(), [](const IRaycastResult &lhs, const IRaycastResult &rhs) {
+            return lhs.distance < rhs.distance;
+        });
+    }
+}
+
 void RenderScene::onGlobalPipelineStateChanged() {
     for (const auto &model : _models) {
         model->onGlobalPipelineStateChanged();
@@ -29,14 +29,20 @@
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "scene/ModelBoundsArray.h"
 #include <cocos/scene/raytracing/RayTracing.h>
 
 namespace cc {
 
 class Node;
+class TransformHierarchy;
 class SkinningModel;
 class BakedSkinningModel;
 
+namespace geometry {
+class Ray;
+} // namespace geometry
+
 namespace scene {
 
 class Model;
@@ -122,16 +128,55 @@ public:
     inline const ccstd::vector<IntrusivePtr<PointLight>> &getPointLights() const { return _pointLights; }
     inline const ccstd::vector<IntrusivePtr<RangedDirectionalLight>> &getRangedDirLights() const { return _rangedDirLights; }
     inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
+    /**
+     * @en World bounds of [[getModels]] in the same order, gathered by [[update]]. Empty if models changed since then.
+     * @zh 与 [[getModels]] 顺序一致的模型世界包围盒，在 [[update]] 中收集，若之后模型列表有变化则为空。
+     */
+    inline const ModelBoundsArray &getModelBounds() const { return _modelBounds; }
     inline Octree *getOctree() const { return _octree; }
     void updateOctree(Model *model);
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
+    /**
+     * @en Raycast the world bounds of the enabled models in the layer mask within distance, the hits of each ray are sorted by distance.
+     * results holds count output vectors. The rays are batched through the octree when it is enabled.
+     * @zh 对层级掩码内已启用模型的世界包围盒进行 distance 范围内的射线检测，每条射线的结果按距离排序。
+     * results 包含 count 个输出数组。启用八叉树时射线会通过八叉树批量查询。
+     */
+    void raycastModels(const geometry::Ray *const *rays, uint32_t count, uint32_t mask, float distance, ccstd::vector<IRaycastResult> *const *results) const;
+
+    /**
+     * @en Set the transform hierarchy flushed at the beginning of [[update]], nullptr to update transforms on demand.
+     * @zh 设置在 [[update]] 开始时统一更新的变换层级，传入 nullptr 则按需更新节点变换。
+     */
+    void setTransformHierarchy(TransformHierarchy *hierarchy);
+    inline TransformHierarchy *getTransformHierarchy() const { return _transformHierarchy.get(); }
+
+    /**
+     * @en Update models on the job system workers in [[update]]. Transforms and local data of the models are computed
+     * in parallel chunks, while gfx uploads and the octree are committed serially in model order, so the results match the serial update.
+     * @zh 在 [[update]] 中使用 job system 的工作线程更新模型。模型的变换与局部数据分块并行计算，
+     * gfx 上传与八叉树按模型顺序串行提交，因此结果与串行更新一致。
+     */
+    inline void setParallelUpdateEnabled(bool enabled) { _parallelUpdateEnabled = enabled; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
 private:
+    void updateModelsParallelly(uint32_t stamp);
+    void updateModelSHUBOs();
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
     IntrusivePtr<LodStateCache> _lodStateCache;
+    IntrusivePtr<TransformHierarchy> _transformHierarchy;
     ccstd::vector<IntrusivePtr<Model>> _models;
+    ModelBoundsArray _modelBounds;
+    // scratch of the batched light probe evaluation, kept to avoid per-frame allocations
+    ccstd::vector<Model *> _shModels;
+    ccstd::vector<Vec3> _shPositions;
+    ccstd::vector<int32_t> _shTetrahedronIndices;
+    ccstd::vector<Vec3> _shCoefficients;
     ccstd::vector<IntrusivePtr<Camera>> _cameras;
     ccstd::vector<IntrusivePtr<DirectionalLight>> _directionalLights;
     ccstd::vector<IntrusivePtr<LODGroup>> _lodGroups;
@@ -141,6 +186,7 @@ private:
     ccstd::vector<IntrusivePtr<RangedDirectionalLight>> _rangedDirLights;
     ccstd::vector<DrawBatch2D *> _batches;
     Octree *_octree{nullptr};
+    bool _parallelUpdateEnabled{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
@@ -168,6 +168,7 @@ void SubModel::destroy() {
     _subMesh = nullptr;
     _passes.reset();
     _shaders.clear();
+    setBatchedInstances(nullptr, 0);
 }
 
 void SubModel::onPipelineStateChanged() {
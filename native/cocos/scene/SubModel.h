@@ -94,6 +94,18 @@ public:
     int32_t getReflectionProbeType() const { return _reflectionProbeType; }
     void setReflectionProbeType(int32_t val) { _reflectionProbeType = val; }
 
+    /**
+     * @en Sets extra instances drawn together with this sub model, packed with the layout of the instanced attribute block.
+     * The data is owned by the caller and must stay valid until it is reset.
+     * @zh 设置与该子模型一同绘制的额外实例数据，按实例化属性块的布局紧密排列，数据由调用者持有。
+     */
+    void setBatchedInstances(const uint8_t *data, uint32_t count) {
+        _batchedInstanceData = data;
+        _batchedInstanceCount = data ? count : 0;
+    }
+    const uint8_t *getBatchedInstanceData() const { return _batchedInstanceData; }
+    uint32_t getBatchedInstanceCount() const { return _batchedInstanceCount; }
+
 protected:
     void flushPassInfo();
 
@@ -121,6 +133,10 @@ protected:
 
     int32_t _reflectionProbeType{0};
 
+    // weak reference
+    const uint8_t *_batchedInstanceData{nullptr};
+    uint32_t _batchedInstanceCount{0};
+
 private:
     static int32_t generateId() {
         static int32_t generator = 0;
@@ -121,3 +121,14 @@ void localStorageGetLength(int &outLength) {
     CC_ASSERT(gInitialized);
     outLength = JniHelper::callStaticIntMethod(JCLS_LOCALSTORAGE, "getLength");
 }
+
+/** the Java storage owns its database, write-behind mode is not available here. */
+void localStorageSetWriteBehindEnabled(bool /*enabled*/) {
+}
+
+bool localStorageIsWriteBehindEnabled() {
+    return false;
+}
+
+void localStorageFlush() {
+}
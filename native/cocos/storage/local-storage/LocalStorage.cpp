@@ -30,8 +30,12 @@
  */
 
 #include "storage/local-storage/LocalStorage.h"
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
+#include <thread>
 
 #if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
     #include <sqlite3/sqlite3.h>
@@ -41,6 +45,10 @@
 
 #include "base/Macros.h"
 #include "base/Log.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/optional.h"
+#include "engine/EngineEvents.h"
 
 static int _initialized = 0;
 static sqlite3 *_db;
@@ -51,6 +59,34 @@ static sqlite3_stmt *_stmt_clear;
 static sqlite3_stmt *_stmt_key;
 static sqlite3_stmt *_stmt_count;
 
+// writes made within this interval are committed in the same transaction
+static constexpr auto WRITE_BEHIND_INTERVAL = std::chrono::milliseconds(500);
+
+struct WriteBehindQueue {
+    std::mutex mutex;
+    std::condition_variable workCv;
+    std::condition_variable flushedCv;
+    // latest value per key, nullopt removes the key
+    ccstd::unordered_map<ccstd::string, ccstd::optional<ccstd::string>> pending;
+    bool clearPending{false};
+    uint64_t writeSeq{0};
+    uint64_t flushedSeq{0};
+    uint64_t flushRequestSeq{0};
+    // bumped on every failed commit, lets flush callers give up instead of waiting forever
+    uint64_t failedCommits{0};
+    bool stop{false};
+    std::thread thread;
+};
+
+static bool _writeBehindEnabled = false;
+// only exists while write-behind mode runs on an initialized database
+static WriteBehindQueue *_queue = nullptr;
+// mirror of the table, only touched by the calling thread
+static ccstd::unordered_map<ccstd::string, ccstd::string> _cache;
+// the writer thread holds it while committing
+static std::mutex _dbMutex;
+static cc::events::EnterBackground::Listener _enterBackgroundListener;
+
 static void localStorageCreateTable() {
     const char *sql_createtable = "CREATE TABLE IF NOT EXISTS data(key TEXT PRIMARY KEY,value TEXT);";
     sqlite3_stmt *stmt;
@@ -62,6 +98,129 @@ static void localStorageCreateTable() {
         printf("Error in CREATE TABLE\n");
 }
 
+static bool localStorageCommit(bool clear, const ccstd::unordered_map<ccstd::string, ccstd::optional<ccstd::string>> &batch) {
+    bool ok = sqlite3_exec(_db, "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    if (ok && clear) {
+        ok = sqlite3_step(_stmt_clear) == SQLITE_DONE;
+        sqlite3_reset(_stmt_clear);
+    }
+    for (auto iter = batch.begin(); ok && iter != batch.end(); ++iter) {
+        const auto &item = *iter;
+        if (item.second) {
+            sqlite3_bind_text(_stmt_update, 1, item.first.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(_stmt_update, 2, item.second->c_str(), -1, SQLITE_STATIC);
+            ok = sqlite3_step(_stmt_update) == SQLITE_DONE;
+            sqlite3_reset(_stmt_update);
+        } else {
+            sqlite3_bind_text(_stmt_remove, 1, item.first.c_str(), -1, SQLITE_STATIC);
+            ok = sqlite3_step(_stmt_remove) == SQLITE_DONE;
+            sqlite3_reset(_stmt_remove);
+        }
+    }
+    ok = ok && sqlite3_exec(_db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+    if (!ok) {
+        CC_LOG_ERROR("Error in committing %d localStorage writes: %s", static_cast<int>(batch.size()), sqlite3_errmsg(_db));
+        if (!sqlite3_get_autocommit(_db)) {
+            sqlite3_exec(_db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+    }
+    return ok;
+}
+
+static void localStorageWriterLoop() {
+    std::unique_lock<std::mutex> lock(_queue->mutex);
+    while (true) {
+        _queue->workCv.wait(lock, [] { return _queue->stop || _queue->writeSeq != _queue->flushedSeq; });
+        if (_queue->writeSeq == _queue->flushedSeq) {
+            break; // stopped with nothing left to write
+        }
+        // keep coalescing writes unless somebody waits for them
+        _queue->workCv.wait_for(lock, WRITE_BEHIND_INTERVAL, [] {
+            return _queue->stop || _queue->flushRequestSeq > _queue->flushedSeq;
+        });
+
+        auto batch = std::move(_queue->pending);
+        _queue->pending.clear();
+        const bool clear = _queue->clearPending;
+        _queue->clearPending = false;
+        const uint64_t seq = _queue->writeSeq;
+        lock.unlock();
+        bool committed = false;
+        {
+            std::lock_guard<std::mutex> dbLock(_dbMutex);
+            committed = localStorageCommit(clear, batch);
+        }
+        lock.lock();
+        if (committed) {
+            _queue->flushedSeq = seq;
+            _queue->flushedCv.notify_all();
+            continue;
+        }
+
+        ++_queue->failedCommits;
+        _queue->flushedCv.notify_all();
+        if (_queue->stop) {
+            CC_LOG_ERROR("Dropping %d localStorage writes", static_cast<int>(batch.size() + _queue->pending.size()));
+            break;
+        }
+        // put the batch back under the writes made meanwhile, unless a clear superseded it
+        if (!_queue->clearPending) {
+            for (auto &item : batch) {
+                _queue->pending.emplace(item.first, std::move(item.second));
+            }
+            _queue->clearPending = clear;
+        }
+        // the database is likely locked or full, retry later
+        _queue->workCv.wait_for(lock, WRITE_BEHIND_INTERVAL, [] { return _queue->stop; });
+    }
+}
+
+static void localStorageEnqueue(const ccstd::string &key, ccstd::optional<ccstd::string> value) {
+    std::lock_guard<std::mutex> lock(_queue->mutex);
+    _queue->pending[key] = std::move(value);
+    ++_queue->writeSeq;
+    _queue->workCv.notify_one();
+}
+
+static void localStorageStartWriteBehind() {
+    // WAL keeps the database consistent if the process dies in the middle of a commit,
+    // so the commits only need to be synced at checkpoints.
+    int ok = sqlite3_exec(_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+    ok |= sqlite3_exec(_db, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr);
+    if (ok != SQLITE_OK)
+        CC_LOG_WARNING("Error in switching localStorage to WAL journaling");
+
+    sqlite3_stmt *stmt = nullptr;
+    ok = sqlite3_prepare_v2(_db, "SELECT key,value FROM data;", -1, &stmt, nullptr);
+    while (ok == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        const auto *key = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+        const auto *value = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+        if (key) {
+            _cache.emplace(key, value ? value : "");
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    _queue = ccnew WriteBehindQueue();
+    _queue->thread = std::thread(localStorageWriterLoop);
+    _enterBackgroundListener.bind(&localStorageFlush);
+}
+
+static void localStorageStopWriteBehind() {
+    _enterBackgroundListener.reset();
+    {
+        std::lock_guard<std::mutex> lock(_queue->mutex);
+        _queue->stop = true;
+        _queue->workCv.notify_one();
+    }
+    // the writer commits what is left before it exits
+    _queue->thread.join();
+    delete _queue;
+    _queue = nullptr;
+    _cache.clear();
+}
+
 void localStorageInit(const ccstd::string &fullpath /* = "" */) {
     if (!_initialized) {
         int ret = 0;
@@ -102,11 +261,19 @@ void localStorageInit(const ccstd::string &fullpath /* = "" */) {
             // report error
         }
         _initialized = 1;
+
+        if (_writeBehindEnabled) {
+            localStorageStartWriteBehind();
+        }
     }
 }
 
 void localStorageFree() {
     if (_initialized) {
+        if (_queue) {
+            localStorageStopWriteBehind();
+        }
+
         sqlite3_finalize(_stmt_select);
         sqlite3_finalize(_stmt_remove);
         sqlite3_finalize(_stmt_update);
@@ -127,6 +294,12 @@ void localStorageFree() {
 /** sets an item in the LS */
 void localStorageSetItem(const ccstd::string &key, const ccstd::string &value) {
     CC_ASSERT(_initialized);
+    if (_queue) {
+        _cache[key] = value;
+        localStorageEnqueue(key, value);
+        return;
+    }
+
     int ok = sqlite3_bind_text(_stmt_update, 1, key.c_str(), -1, SQLITE_TRANSIENT);
     ok |= sqlite3_bind_text(_stmt_update, 2, value.c_str(), -1, SQLITE_TRANSIENT);
 
@@ -141,6 +314,15 @@ void localStorageSetItem(const ccstd::string &key, const ccstd::string &value) {
 /** gets an item from the LS */
 bool localStorageGetItem(const ccstd::string &key, ccstd::string *outItem) {
     CC_ASSERT(_initialized);
+    if (_queue) {
+        auto iter = _cache.find(key);
+        if (iter == _cache.end()) {
+            return false;
+        }
+        outItem->assign(iter->second);
+        return true;
+    }
+
     int ok = sqlite3_reset(_stmt_select);
 
     ok |= sqlite3_bind_text(_stmt_select, 1, key.c_str(), -1, SQLITE_TRANSIENT);
@@ -161,6 +343,12 @@ bool localStorageGetItem(const ccstd::string &key, ccstd::string *outItem) {
 /** removes an item from the LS */
 void localStorageRemoveItem(const ccstd::string &key) {
     CC_ASSERT(_initialized);
+    if (_queue) {
+        _cache.erase(key);
+        localStorageEnqueue(key, ccstd::nullopt);
+        return;
+    }
+
     int ok = sqlite3_bind_text(_stmt_remove, 1, key.c_str(), -1, SQLITE_TRANSIENT);
 
     ok |= sqlite3_step(_stmt_remove);
@@ -174,6 +362,16 @@ void localStorageRemoveItem(const ccstd::string &key) {
 /** removes all items from the LS */
 void localStorageClear() {
     CC_ASSERT(_initialized);
+    if (_queue) {
+        _cache.clear();
+        std::lock_guard<std::mutex> lock(_queue->mutex);
+        _queue->pending.clear();
+        _queue->clearPending = true;
+        ++_queue->writeSeq;
+        _queue->workCv.notify_one();
+        return;
+    }
+
     int ok = sqlite3_step(_stmt_clear);
 
     ok |= sqlite3_reset(_stmt_clear);
@@ -189,6 +387,12 @@ void localStorageGetKey(const int nIndex, ccstd::string *outKey) {
         printf("Error in input localStorage index Less than zero\n");
         return;
     }
+    // the key order is the row order, which only the database knows
+    std::unique_lock<std::mutex> dbLock(_dbMutex, std::defer_lock);
+    if (_queue) {
+        localStorageFlush();
+        dbLock.lock();
+    }
     int ok = sqlite3_reset(_stmt_key);
 
     ok |= sqlite3_step(_stmt_key);
@@ -217,6 +421,11 @@ void localStorageGetKey(const int nIndex, ccstd::string *outKey) {
 /** gets all items count in the JS. */
 void localStorageGetLength(int &outLength) {
     CC_ASSERT(_initialized);
+    if (_queue) {
+        outLength = static_cast<int>(_cache.size());
+        return;
+    }
+
     int ok = sqlite3_reset(_stmt_count);
 
     ok |= sqlite3_step(_stmt_count);
@@ -228,3 +437,40 @@ void localStorageGetLength(int &outLength) {
         outLength = sqlite3_column_int(_stmt_count, 0);
     }
 }
+
+void localStorageSetWriteBehindEnabled(bool enabled) {
+    if (_writeBehindEnabled == enabled) {
+        return;
+    }
+    _writeBehindEnabled = enabled;
+    if (!_initialized) {
+        return;
+    }
+    if (enabled) {
+        localStorageStartWriteBehind();
+    } else {
+        localStorageStopWriteBehind();
+    }
+}
+
+bool localStorageIsWriteBehindEnabled() {
+    return _writeBehindEnabled;
+}
+
+/** blocks until the writer thread has committed every write made so far */
+void localStorageFlush() {
+    if (!_queue) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_queue->mutex);
+    const uint64_t target = _queue->writeSeq;
+    if (_queue->flushedSeq >= target) {
+        return;
+    }
+    const uint64_t failedCommits = _queue->failedCommits;
+    _queue->flushRequestSeq = target;
+    _queue->workCv.notify_one();
+    _queue->flushedCv.wait(lock, [target, failedCommits] {
+        return _queue->flushedSeq >= target || _queue->failedCommits != failedCommits;
+    });
+}
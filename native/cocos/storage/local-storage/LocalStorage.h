@@ -61,6 +61,23 @@ void CC_DLL localStorageGetKey(const int nIndex, ccstd::string *outKey);
 /** Gets all items count in the JS. */
 void CC_DLL localStorageGetLength(int &outLength);
 
+/**
+ * Serves reads from an in-memory copy and commits writes on a background thread,
+ * batched in one transaction and journaled with WAL. Can be switched before or after initialization.
+ * Writes are also flushed when the application enters background and when the storage is freed.
+ * Keys written between two commits are not ordered by write time in localStorageGetKey.
+ */
+void CC_DLL localStorageSetWriteBehindEnabled(bool enabled);
+
+/** Whether write-behind mode is enabled. */
+bool CC_DLL localStorageIsWriteBehindEnabled();
+
+/**
+ * Blocks until every pending write is committed or a commit fails, does nothing when write-behind mode is disabled.
+ * Failed writes stay queued and are retried by the background thread.
+ */
+void CC_DLL localStorageFlush();
+
 // end group
 /// @}
 
@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include <random>
+#include <thread>
+#include "core/animation/SkeletalAnimationUtils.h"
+#include "gtest/gtest.h"
+#include "math/Quaternion.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t JOINT_COUNT = 67;
+constexpr float PALETTE_TOLERANCE = 1e-4F;
+
+Mat4 createRandomTransform(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position(-5.F, 5.F);
+    std::uniform_real_distribution<float> angle(-180.F, 180.F);
+    std::uniform_real_distribution<float> scale(0.2F, 3.F);
+    Quaternion rotation;
+    Quaternion::fromEuler(angle(rng), angle(rng), angle(rng), &rotation);
+    Mat4 transform;
+    Mat4::fromRTS(rotation, Vec3(position(rng), position(rng), position(rng)), Vec3(scale(rng), scale(rng), scale(rng)), &transform);
+    return transform;
+}
+
+// the scalar path used before the palette, same as the old SkinningModel::uploadJointData
+void computeReferencePalette(const Mat4 &world, const Mat4 &bindpose, float *dst) {
+    Mat4 mat;
+    Mat4::multiply(world, bindpose, &mat);
+    memcpy(dst, mat.m, sizeof(float) * 12);
+    dst[3] = mat.m[12];
+    dst[7] = mat.m[13];
+    dst[11] = mat.m[14];
+}
+
+void expectPaletteNear(const float *actual, const float *expected, uint32_t joint) {
+    for (uint32_t i = 0; i < JOINT_PALETTE_STRIDE; ++i) {
+        EXPECT_NEAR(actual[i], expected[i], PALETTE_TOLERANCE * std::max(1.F, std::abs(expected[i]))) << "joint " << joint << " float " << i;
+    }
+}
+
+IntrusivePtr<JointPalette> createPalette(std::mt19937 &rng) {
+    IntrusivePtr<JointPalette> palette = ccnew JointPalette();
+    palette->transforms.resize(JOINT_COUNT);
+    palette->bindposes.resize(JOINT_COUNT);
+    palette->data.resize(JOINT_COUNT * JOINT_PALETTE_STRIDE);
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        palette->bindposes[i] = createRandomTransform(rng);
+        // every 11th joint node is missing
+        if (i % 11) {
+            palette->transforms[i] = ccnew IJointTransform();
+            palette->transforms[i]->world = createRandomTransform(rng);
+        }
+    }
+    return palette;
+}
+
+} // namespace
+
+TEST(JointPaletteTest, matchesScalarPalette) {
+    std::mt19937 rng(JOINT_COUNT);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const Mat4 world = createRandomTransform(rng);
+        const Mat4 bindpose = createRandomTransform(rng);
+        float expected[JOINT_PALETTE_STRIDE];
+        float actual[JOINT_PALETTE_STRIDE];
+        computeReferencePalette(world, bindpose, expected);
+        computeJointPalette(world, bindpose, actual);
+        expectPaletteNear(actual, expected, i);
+    }
+
+    // identity bindpose keeps the world matrix, only the layout changes
+    const Mat4 world = createRandomTransform(rng);
+    float actual[JOINT_PALETTE_STRIDE];
+    computeJointPalette(world, Mat4::IDENTITY, actual);
+    for (uint32_t column = 0; column < 3; ++column) {
+        for (uint32_t row = 0; row < 3; ++row) {
+            EXPECT_FLOAT_EQ(actual[column * 4 + row], world.m[column * 4 + row]);
+        }
+        EXPECT_FLOAT_EQ(actual[column * 4 + 3], world.m[12 + column]);
+    }
+}
+
+TEST(JointPaletteTest, updatesOncePerStamp) {
+    std::mt19937 rng(JOINT_COUNT + 1);
+    auto palette = createPalette(rng);
+    constexpr float MISSING_JOINT = -1.F;
+    std::fill(palette->data.begin(), palette->data.end(), MISSING_JOINT);
+
+    // models sharing the palette update it from the parallel scene update
+    ccstd::vector<const float *> results(4);
+    ccstd::vector<std::thread> workers;
+    for (auto &result : results) {
+        workers.emplace_back([&palette, &result]() {
+            result = updateJointPalette(palette, 1);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    for (const auto *result : results) {
+        EXPECT_EQ(result, palette->data.data());
+    }
+
+    const auto verify = [&]() {
+        for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+            const float *actual = palette->data.data() + i * JOINT_PALETTE_STRIDE;
+            if (palette->transforms[i]) {
+                float expected[JOINT_PALETTE_STRIDE];
+                computeReferencePalette(palette->transforms[i]->world, palette->bindposes[i], expected);
+                expectPaletteNear(actual, expected, i);
+            } else {
+                for (uint32_t j = 0; j < JOINT_PALETTE_STRIDE; ++j) {
+                    EXPECT_EQ(actual[j], MISSING_JOINT) << "joint " << i;
+                }
+            }
+        }
+    };
+    verify();
+
+    // the same stamp reuses the palette computed by the first model
+    const auto previous = palette->data;
+    palette->transforms[1]->world = createRandomTransform(rng);
+    updateJointPalette(palette, 1);
+    EXPECT_EQ(palette->data, previous);
+
+    updateJointPalette(palette, 2);
+    EXPECT_NE(palette->data, previous);
+    verify();
+}
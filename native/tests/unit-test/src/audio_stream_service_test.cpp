@@ -0,0 +1,239 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#if CC_USE_AUDIO && (CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS || CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX)
+    #include <chrono>
+    #include <condition_variable>
+    #include <memory>
+    #include <mutex>
+    #include <thread>
+    #include "audio/oalsoft/AudioStreamService.h"
+    #include "base/std/container/unordered_set.h"
+    #include "base/std/container/vector.h"
+
+using cc::AudioStream;
+using cc::AudioStreamService;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr auto TIMEOUT = std::chrono::seconds(5);
+// longer than any refill the service may schedule in a test
+constexpr float LONG_DELAY = 60.F;
+
+// Records its refills instead of decoding, a refill can be held until it is released.
+class FakeStream : public AudioStream {
+public:
+    explicit FakeStream(float delay) : _delay(delay) {}
+
+    float rotateBuffers(ccstd::vector<char> &buffer) override {
+        std::unique_lock<std::mutex> lk(_mutex);
+        _refills.push_back(Clock::now());
+        _buffers.insert(&buffer);
+        _threads.insert(std::this_thread::get_id());
+        _busy = true;
+        _condition.notify_all();
+        _condition.wait(lk, [this]() { return !_hold; });
+        _busy = false;
+        return _delay;
+    }
+
+    void setDelay(float delay) {
+        std::lock_guard<std::mutex> lk(_mutex);
+        _delay = delay;
+    }
+
+    void hold() {
+        std::lock_guard<std::mutex> lk(_mutex);
+        _hold = true;
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lk(_mutex);
+        _hold = false;
+        _condition.notify_all();
+    }
+
+    bool waitForRefills(size_t count) {
+        std::unique_lock<std::mutex> lk(_mutex);
+        return _condition.wait_for(lk, TIMEOUT, [&]() { return _refills.size() >= count; });
+    }
+
+    bool waitUntilBusy() {
+        std::unique_lock<std::mutex> lk(_mutex);
+        return _condition.wait_for(lk, TIMEOUT, [this]() { return _busy; });
+    }
+
+    size_t getRefillCount() {
+        std::lock_guard<std::mutex> lk(_mutex);
+        return _refills.size();
+    }
+
+    Clock::time_point getRefillTime(size_t index) {
+        std::lock_guard<std::mutex> lk(_mutex);
+        return _refills[index];
+    }
+
+    ccstd::unordered_set<const ccstd::vector<char> *> getBuffers() {
+        std::lock_guard<std::mutex> lk(_mutex);
+        return _buffers;
+    }
+
+    ccstd::unordered_set<std::thread::id> getThreads() {
+        std::lock_guard<std::mutex> lk(_mutex);
+        return _threads;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    float _delay{0.F};
+    bool _hold{false};
+    bool _busy{false};
+    ccstd::vector<Clock::time_point> _refills;
+    ccstd::unordered_set<const ccstd::vector<char> *> _buffers;
+    ccstd::unordered_set<std::thread::id> _threads;
+};
+
+} // namespace
+
+TEST(AudioStreamServiceTest, refillsAtDeadline) {
+    constexpr float DELAY = 0.05F;
+    AudioStreamService service;
+    FakeStream stream(DELAY);
+
+    const auto added = Clock::now();
+    service.addStream(1, &stream);
+    ASSERT_TRUE(stream.waitForRefills(3));
+    service.removeStream(1);
+
+    // the first refill is not delayed, the next ones wait until the playing buffer is processed
+    EXPECT_LT(stream.getRefillTime(0) - added, std::chrono::seconds(1));
+    const auto delay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(DELAY));
+    EXPECT_GE(stream.getRefillTime(1) - stream.getRefillTime(0), delay);
+    EXPECT_GE(stream.getRefillTime(2) - stream.getRefillTime(1), delay);
+}
+
+TEST(AudioStreamServiceTest, finishedStreamIsNotRefilled) {
+    AudioStreamService service;
+    FakeStream stream(-1.F);
+
+    service.addStream(1, &stream);
+    ASSERT_TRUE(stream.waitForRefills(1));
+    service.wakeStream(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(stream.getRefillCount(), 1U);
+    service.removeStream(1);
+}
+
+TEST(AudioStreamServiceTest, wakeStream) {
+    AudioStreamService service;
+    FakeStream stream(LONG_DELAY);
+
+    service.addStream(1, &stream);
+    ASSERT_TRUE(stream.waitForRefills(1));
+
+    // an idle stream is refilled right away instead of at its deadline
+    service.wakeStream(1);
+    ASSERT_TRUE(stream.waitForRefills(2));
+
+    // a wake up during a refill schedules another one as soon as it has finished
+    stream.hold();
+    service.wakeStream(1);
+    ASSERT_TRUE(stream.waitUntilBusy());
+    service.wakeStream(1);
+    stream.release();
+    ASSERT_TRUE(stream.waitForRefills(4));
+
+    // unknown streams are ignored
+    service.wakeStream(2);
+    service.removeStream(1);
+    EXPECT_EQ(stream.getRefillCount(), 4U);
+}
+
+TEST(AudioStreamServiceTest, removeStreamWaitsForRefill) {
+    AudioStreamService service;
+    FakeStream stream(0.F);
+
+    stream.hold();
+    service.addStream(1, &stream);
+    ASSERT_TRUE(stream.waitUntilBusy());
+
+    std::mutex mutex;
+    bool removed = false;
+    std::thread remover([&]() {
+        service.removeStream(1);
+        std::lock_guard<std::mutex> lk(mutex);
+        removed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        EXPECT_FALSE(removed);
+    }
+    stream.release();
+    remover.join();
+    EXPECT_TRUE(removed);
+
+    // the stream is never refilled once it has been removed
+    const auto refills = stream.getRefillCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(stream.getRefillCount(), refills);
+}
+
+TEST(AudioStreamServiceTest, workersShareStreams) {
+    constexpr uint32_t WORKER_COUNT = 2;
+    constexpr uint32_t STREAM_COUNT = 8;
+    constexpr size_t REFILL_COUNT = 4;
+    AudioStreamService service(WORKER_COUNT);
+
+    ccstd::vector<std::unique_ptr<FakeStream>> streams;
+    for (uint32_t i = 0; i < STREAM_COUNT; ++i) {
+        streams.emplace_back(std::make_unique<FakeStream>(0.F));
+        service.addStream(i, streams.back().get());
+    }
+    for (auto &stream : streams) {
+        EXPECT_TRUE(stream->waitForRefills(REFILL_COUNT));
+    }
+    for (uint32_t i = 0; i < STREAM_COUNT; ++i) {
+        service.removeStream(i);
+    }
+
+    // every stream is refilled by the fixed pool of workers, each one reusing its decode buffer
+    ccstd::unordered_set<std::thread::id> threads;
+    ccstd::unordered_set<const ccstd::vector<char> *> buffers;
+    for (auto &stream : streams) {
+        const auto streamThreads = stream->getThreads();
+        const auto streamBuffers = stream->getBuffers();
+        threads.insert(streamThreads.begin(), streamThreads.end());
+        buffers.insert(streamBuffers.begin(), streamBuffers.end());
+    }
+    EXPECT_LE(threads.size(), WORKER_COUNT);
+    EXPECT_LE(buffers.size(), WORKER_COUNT);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0U);
+}
+
+#endif
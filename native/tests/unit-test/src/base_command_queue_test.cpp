@@ -0,0 +1,257 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include "gtest/gtest.h"
+
+#include "base/std/container/vector.h"
+#include "base/threading/CommandQueue.h"
+#include "base/threading/MessageQueue.h"
+
+using namespace cc;
+
+namespace {
+
+enum CommandType : uint32_t {
+    BIND_PIPELINE_STATE,
+    BIND_DESCRIPTOR_SET,
+    BIND_INPUT_ASSEMBLER,
+    DRAW,
+    UPDATE_BUFFER,
+    TERMINATE,
+    COMMAND_TYPE_COUNT,
+};
+
+struct CapturedCommand {
+    uint32_t type{0};
+    ccstd::vector<uint32_t> data;
+};
+
+struct ReplayCommand {
+    uint32_t count;
+    // followed by count words of payload
+};
+
+// a synthetic capture shaped like the per-frame traffic of the gfx agent:
+// mostly state binding and draws with small arguments, plus some buffer uploads
+ccstd::vector<CapturedCommand> captureFrame(uint32_t commandCount) {
+    std::mt19937 rng(42);
+    ccstd::vector<CapturedCommand> frame;
+    frame.reserve(commandCount);
+    for (uint32_t i = 0; i < commandCount; ++i) {
+        CapturedCommand command;
+        uint32_t roll = rng() % 100;
+        if (roll < 10) {
+            command.type = BIND_PIPELINE_STATE;
+            command.data.resize(2);
+        } else if (roll < 40) {
+            command.type = BIND_DESCRIPTOR_SET;
+            command.data.resize(4 + rng() % 4);
+        } else if (roll < 55) {
+            command.type = BIND_INPUT_ASSEMBLER;
+            command.data.resize(2);
+        } else if (roll < 95) {
+            command.type = DRAW;
+            command.data.resize(7);
+        } else {
+            command.type = UPDATE_BUFFER;
+            command.data.resize(16 + rng() % 240);
+        }
+        for (auto &word : command.data) {
+            word = rng();
+        }
+        frame.push_back(std::move(command));
+    }
+    return frame;
+}
+
+struct Sink {
+    uint64_t checksum{0};
+    uint32_t counts[COMMAND_TYPE_COUNT]{};
+
+    void consume(uint32_t type, uint32_t const *data, uint32_t count) {
+        ++counts[type];
+        for (uint32_t i = 0; i < count; ++i) {
+            checksum = checksum * 31 + data[i];
+        }
+    }
+};
+
+void dispatch(Sink &sink, uint32_t type, void const *payload) {
+    auto const *command = static_cast<ReplayCommand const *>(payload);
+    auto const *data = reinterpret_cast<uint32_t const *>(command + 1);
+    switch (type) {
+        case BIND_PIPELINE_STATE:
+        case BIND_DESCRIPTOR_SET:
+        case BIND_INPUT_ASSEMBLER:
+        case DRAW:
+        case UPDATE_BUFFER:
+            sink.consume(type, data, command->count);
+            break;
+        default:
+            break;
+    }
+}
+
+void enqueue(CommandQueue &queue, CapturedCommand const &captured) {
+    auto const count = static_cast<uint32_t>(captured.data.size());
+    auto *command = queue.allocate<ReplayCommand>(captured.type, count * sizeof(uint32_t));
+    command->count = count;
+    memcpy(command + 1, captured.data.data(), count * sizeof(uint32_t));
+}
+
+void replayThroughMessageQueue(ccstd::vector<CapturedCommand> const &frame, int numFrames, Sink &sink) {
+    auto *messageQueue = ccnew MessageQueue;
+    messageQueue->setImmediateMode(false);
+    messageQueue->runConsumerThread();
+    for (int i = 0; i < numFrames; ++i) {
+        for (auto const &captured : frame) {
+            auto const count = static_cast<uint32_t>(captured.data.size());
+            uint32_t const *data = messageQueue->allocateAndCopy<uint32_t>(count, captured.data.data());
+            ENQUEUE_MESSAGE_4(
+                messageQueue, ReplayCommand,
+                sink, &sink,
+                type, captured.type,
+                data, data,
+                count, count,
+                {
+                    sink->consume(type, data, count);
+                });
+        }
+        MessageQueue::freeChunksInFreeQueue(messageQueue);
+        messageQueue->finishWriting();
+    }
+    messageQueue->kickAndWait();
+    messageQueue->terminateConsumerThread();
+    delete messageQueue;
+}
+
+void replayThroughCommandQueue(ccstd::vector<CapturedCommand> const &frame, int numFrames, Sink &sink) {
+    CommandQueue commandQueue;
+    bool terminated = false;
+    std::thread consumer([&]() {
+        while (!terminated) {
+            commandQueue.execute([&](uint32_t type, void const *payload) {
+                if (type == TERMINATE) {
+                    terminated = true;
+                } else {
+                    dispatch(sink, type, payload);
+                }
+            });
+        }
+    });
+    for (int i = 0; i < numFrames; ++i) {
+        for (auto const &captured : frame) {
+            enqueue(commandQueue, captured);
+        }
+        commandQueue.kick();
+    }
+    commandQueue.allocate<ReplayCommand>(TERMINATE)->count = 0;
+    commandQueue.kick();
+    consumer.join();
+}
+
+} // namespace
+
+TEST(CommandQueueTest, wrapAround) {
+    // small enough for the producer to wrap and wait on the consumer many times
+    CommandQueue queue(4096);
+    auto const frame = captureFrame(5000);
+
+    Sink expected;
+    for (auto const &command : frame) {
+        expected.consume(command.type, command.data.data(), static_cast<uint32_t>(command.data.size()));
+    }
+
+    Sink sink;
+    bool terminated = false;
+    std::thread consumer([&]() {
+        while (!terminated) {
+            queue.execute([&](uint32_t type, void const *payload) {
+                if (type == TERMINATE) {
+                    terminated = true;
+                } else {
+                    dispatch(sink, type, payload);
+                }
+            });
+        }
+    });
+
+    for (uint32_t i = 0; i < frame.size(); ++i) {
+        enqueue(queue, frame[i]);
+        if (i % 64 == 0) queue.kick();
+    }
+    queue.allocate<ReplayCommand>(TERMINATE)->count = 0;
+    queue.kick();
+    consumer.join();
+
+    EXPECT_EQ(sink.checksum, expected.checksum);
+    for (uint32_t type = 0; type < TERMINATE; ++type) {
+        EXPECT_EQ(sink.counts[type], expected.counts[type]);
+    }
+}
+
+// replaying the same frames through both queues must reach the same sink state
+TEST(CommandQueueTest, matchesMessageQueue) {
+    auto const frame = captureFrame(2000);
+
+    Sink messageSink;
+    replayThroughMessageQueue(frame, 4, messageSink);
+    Sink commandSink;
+    replayThroughCommandQueue(frame, 4, commandSink);
+
+    EXPECT_EQ(commandSink.checksum, messageSink.checksum);
+    for (uint32_t type = 0; type < TERMINATE; ++type) {
+        EXPECT_EQ(commandSink.counts[type], messageSink.counts[type]);
+    }
+}
+
+TEST(CommandQueueTest, benchmark) {
+    constexpr uint32_t COMMANDS_PER_FRAME = 2000;
+    constexpr int NUM_FRAMES = 300;
+    auto const frame = captureFrame(COMMANDS_PER_FRAME);
+    using Clock = std::chrono::steady_clock;
+
+    Sink messageSink;
+    auto const messageStart = Clock::now();
+    replayThroughMessageQueue(frame, NUM_FRAMES, messageSink);
+    auto const messageTime = Clock::now() - messageStart;
+
+    Sink commandSink;
+    auto const commandStart = Clock::now();
+    replayThroughCommandQueue(frame, NUM_FRAMES, commandSink);
+    auto const commandTime = Clock::now() - commandStart;
+
+    EXPECT_EQ(commandSink.checksum, messageSink.checksum);
+
+    using Micro = std::chrono::duration<double, std::micro>;
+    printf("command stream replay per frame (%u commands): MessageQueue %.2fus, CommandQueue %.2fus\n",
+           COMMANDS_PER_FRAME,
+           Micro(messageTime).count() / NUM_FRAMES,
+           Micro(commandTime).count() / NUM_FRAMES);
+}
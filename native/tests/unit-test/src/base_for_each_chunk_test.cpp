@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "base/job-system/ForEachChunk.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Chunk {
+    uint32_t begin{0};
+    uint32_t end{0};
+    std::thread::id thread;
+};
+
+ccstd::vector<Chunk> collectChunks(uint32_t count, uint32_t threshold, uint32_t minChunkSize, uint32_t alignment, ccstd::vector<std::atomic<uint32_t>> &visits) {
+    std::mutex mutex;
+    ccstd::vector<Chunk> chunks;
+    cc::forEachChunk(
+        count, threshold, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+            std::lock_guard<std::mutex> lk(mutex);
+            chunks.push_back({begin, end, std::this_thread::get_id()});
+        },
+        minChunkSize, alignment);
+    return chunks;
+}
+
+} // namespace
+
+TEST(ForEachChunkTest, coversRangeOnce) {
+    constexpr uint32_t COUNT = 1001;
+    const auto caller = std::this_thread::get_id();
+    for (const uint32_t alignment : {1U, 4U}) {
+        ccstd::vector<std::atomic<uint32_t>> visits(COUNT);
+        const auto chunks = collectChunks(COUNT, 0U, 1U, alignment, visits);
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            EXPECT_EQ(visits[i].load(), 1U) << "item " << i;
+        }
+
+        EXPECT_LE(chunks.size(), std::max(cc::JobSystem::getInstance()->threadCount(), 1U));
+        bool callerRanFirstChunk = false;
+        for (const auto &chunk : chunks) {
+            EXPECT_LT(chunk.begin, chunk.end);
+            EXPECT_EQ(chunk.begin % alignment, 0U);
+            if (chunk.end != COUNT) {
+                EXPECT_EQ((chunk.end - chunk.begin) % alignment, 0U);
+            }
+            callerRanFirstChunk |= chunk.begin == 0 && chunk.thread == caller;
+        }
+        EXPECT_TRUE(callerRanFirstChunk);
+    }
+}
+
+TEST(ForEachChunkTest, smallRangesStayOnCaller) {
+    constexpr uint32_t COUNT = 100;
+    ccstd::vector<std::atomic<uint32_t>> visits(COUNT);
+
+    // below the threshold
+    auto chunks = collectChunks(COUNT, COUNT + 1, 1U, 1U, visits);
+    ASSERT_EQ(chunks.size(), 1U);
+    EXPECT_EQ(chunks[0].begin, 0U);
+    EXPECT_EQ(chunks[0].end, COUNT);
+    EXPECT_EQ(chunks[0].thread, std::this_thread::get_id());
+
+    // a single chunk holds at least minChunkSize items
+    chunks = collectChunks(COUNT, 0U, COUNT, 1U, visits);
+    ASSERT_EQ(chunks.size(), 1U);
+    EXPECT_EQ(chunks[0].end, COUNT);
+    EXPECT_EQ(chunks[0].thread, std::this_thread::get_id());
+
+    for (uint32_t i = 0; i < COUNT; ++i) {
+        EXPECT_EQ(visits[i].load(), 2U) << "item " << i;
+    }
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "cocos/renderer/pipeline/custom/FrameGraphDispatcherCache.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+TEST(frameGraphDispatcherCacheTest, reuse) {
+    TEST_CASE_1;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcherCache cache;
+    // first frames may differ by the states of external resources written back by the dispatcher
+    cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    const auto* warm = &cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    const auto* cached = &cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    EXPECT_EQ(warm, cached);
+    EXPECT_GE(cache.getHitCount(), 1);
+
+    // cached result matches a cold compilation
+    FrameGraphDispatcher cold(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    cold.run();
+    const auto& cachedRag = cached->resourceAccessGraph;
+    const auto& coldRag = cold.resourceAccessGraph;
+    EXPECT_EQ(cachedRag.barrier.size(), coldRag.barrier.size());
+    for (size_t i = 0; i != coldRag.barrier.size(); ++i) {
+        EXPECT_EQ(cachedRag.barrier[i].frontBarriers.size(), coldRag.barrier[i].frontBarriers.size());
+        EXPECT_EQ(cachedRag.barrier[i].rearBarriers.size(), coldRag.barrier[i].rearBarriers.size());
+    }
+    EXPECT_EQ(cachedRag.culledPasses.size(), coldRag.culledPasses.size());
+
+    // descriptor change invalidates the entry
+    const auto misses = cache.getMissCount();
+    rescGraph.descs[rescGraph.valueIndex.at(string("3"))].width = 480;
+    cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    EXPECT_EQ(cache.getMissCount(), misses + 1);
+}
+
+TEST(frameGraphDispatcherCacheTest, disabled) {
+    TEST_CASE_1;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcherCache cache;
+    cache.setEnabled(false);
+    for (int i = 0; i != 3; ++i) {
+        cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    }
+    EXPECT_EQ(cache.getHitCount(), 0);
+    EXPECT_EQ(cache.getMissCount(), 3);
+}
+
+TEST(frameGraphDispatcherCacheTest, steadyState) {
+    TEST_CASE_3;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    constexpr uint32_t NUM_FRAMES = 20;
+    FrameGraphDispatcherCache cache;
+    const FrameGraphDispatcher* last = nullptr;
+    for (uint32_t i = 0; i != NUM_FRAMES; ++i) {
+        last = &cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    }
+    // only the frames before external states settle compile
+    EXPECT_LE(cache.getMissCount(), 2);
+    EXPECT_EQ(cache.getHitCount() + cache.getMissCount(), NUM_FRAMES);
+
+    // once settled, every frame reuses the same dispatcher
+    const auto misses = cache.getMissCount();
+    for (uint32_t i = 0; i != NUM_FRAMES; ++i) {
+        EXPECT_EQ(&cache.compile(rescGraph, renderGraph, layoutGraphData, resource), last);
+    }
+    EXPECT_EQ(cache.getMissCount(), misses);
+    EXPECT_EQ(cache.getHitCount(), 2 * NUM_FRAMES - misses);
+}
+
+TEST(frameGraphDispatcherCacheTest, signature) {
+    TEST_CASE_1;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    ccstd::vector<uint32_t> signature;
+    ccstd::vector<uint32_t> same;
+    buildRenderGraphSignature(renderGraph, rescGraph, layoutGraphData, signature);
+    buildRenderGraphSignature(renderGraph, rescGraph, layoutGraphData, same);
+    EXPECT_FALSE(signature.empty());
+    EXPECT_EQ(signature, same);
+
+    // structural changes show up in the signature, not only in the hash
+    ccstd::vector<uint32_t> changed;
+    rescGraph.descs[rescGraph.valueIndex.at(string("3"))].height = 270;
+    buildRenderGraphSignature(renderGraph, rescGraph, layoutGraphData, changed);
+    EXPECT_NE(signature, changed);
+}
@@ -0,0 +1,164 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "cocos/renderer/pipeline/custom/FrameGraphDispatcherCache.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#define TEST_CASE_CHAIN                                        \
+    TEST_CASE_DEFINE                                           \
+                                                               \
+    ViewInfo rasterData = {                                    \
+        {PassType::RASTER, {{{}, {"0"}}}},                     \
+        {PassType::RASTER, {{{"0"}, {"1"}}}},                  \
+        {PassType::RASTER, {{{"1"}, {"2"}}}},                  \
+        {PassType::RASTER, {{{"2"}, {"22"}}}},                 \
+    };                                                         \
+                                                               \
+    LayoutInfo layoutInfo = {                                  \
+        {                                                      \
+            {"0", 0, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+        },                                                     \
+        {                                                      \
+            {"0", 0, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"1", 1, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+        },                                                     \
+        {                                                      \
+            {"1", 1, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"2", 2, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+        },                                                     \
+        {                                                      \
+            {"2", 2, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"22", 22, cc::gfx::ShaderStageFlagBit::FRAGMENT}, \
+        }};
+
+namespace {
+
+// 960 x 640 RGBA8, single mip, single sample
+constexpr uint64_t TEXTURE_SIZE = 960ULL * 640ULL * 4ULL;
+
+} // namespace
+
+TEST(memoryAliasingTest, chain) {
+    // 0 -> 1 -> 2 -> backbuffer, lifetimes of 0 and 2 do not overlap
+    TEST_CASE_CHAIN;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    fgDispatcher.run();
+
+    const auto& stats = fgDispatcher.memoryAliasingStats;
+    EXPECT_EQ(stats.numTransientResources, 3);
+    EXPECT_EQ(stats.numMemorySlots, 2);
+    EXPECT_EQ(stats.transientMemory, 3 * TEXTURE_SIZE);
+    EXPECT_EQ(stats.aliasedTransientMemory, 2 * TEXTURE_SIZE);
+    EXPECT_EQ(stats.liveTransientMemory, 2 * TEXTURE_SIZE);
+
+    const auto slot0 = fgDispatcher.getMemorySlot(rescGraph.valueIndex.at(string("0")));
+    const auto slot1 = fgDispatcher.getMemorySlot(rescGraph.valueIndex.at(string("1")));
+    const auto slot2 = fgDispatcher.getMemorySlot(rescGraph.valueIndex.at(string("2")));
+    EXPECT_EQ(slot0, slot2);
+    EXPECT_NE(slot0, slot1);
+
+    // backbuffer is never aliased
+    EXPECT_EQ(fgDispatcher.getMemorySlot(rescGraph.valueIndex.at(string("22"))), 0xFFFFFFFF);
+
+    const auto& rag = fgDispatcher.resourceAccessGraph;
+    const auto& record0 = rag.resourceLifeRecord.at(string("0"));
+    const auto& record2 = rag.resourceLifeRecord.at(string("2"));
+    ExpectEq(record0.end < record2.start, true);
+
+    // 2 takes over the slot of 0, it waits for the last access of 0
+    EXPECT_EQ(stats.numAliasingBarriers, 1);
+    const auto res0 = rescGraph.valueIndex.at(string("0"));
+    const auto res2 = rescGraph.valueIndex.at(string("2"));
+    uint32_t numBarriers = 0;
+    for (const auto passID : cc::makeRange(vertices(renderGraph))) {
+        for (const auto& barrier : fgDispatcher.getBarrier(passID).frontBarriers) {
+            ExpectEq(barrier.resourceID != res0, true);
+            if (barrier.resourceID != res2) {
+                continue;
+            }
+            ++numBarriers;
+            EXPECT_EQ(barrier.endVert, passID);
+            const auto& lastAccess0 = fgDispatcher.getAccessNode(barrier.beginVert).resourceStatus.at(string("0"));
+            EXPECT_EQ(barrier.beginStatus.accessFlag, lastAccess0.accessFlag);
+            const auto& firstAccess2 = fgDispatcher.getAccessNode(passID).resourceStatus.at(string("2"));
+            EXPECT_EQ(barrier.endStatus.accessFlag, firstAccess2.accessFlag);
+            EXPECT_NE(barrier.barrier, nullptr);
+        }
+    }
+    EXPECT_EQ(numBarriers, 1);
+}
+
+TEST(memoryAliasingTest, dispatcherCache) {
+    TEST_CASE_CHAIN;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcherCache cache;
+    EXPECT_EQ(cache.compile(rescGraph, renderGraph, layoutGraphData, resource).memoryAliasingStats.numMemorySlots, 0);
+
+    // the compiled plan is kept on cache hits
+    cache.setMemoryAliasing(true);
+    EXPECT_EQ(cache.compile(rescGraph, renderGraph, layoutGraphData, resource).memoryAliasingStats.numMemorySlots, 2);
+    const auto& cached = cache.compile(rescGraph, renderGraph, layoutGraphData, resource);
+    EXPECT_EQ(cache.getHitCount(), 1);
+    EXPECT_EQ(cached.memoryAliasingStats.numMemorySlots, 2);
+    EXPECT_EQ(cached.memoryAliasingStats.numAliasingBarriers, 1);
+    EXPECT_EQ(cached.getMemorySlot(rescGraph.valueIndex.at(string("0"))), cached.getMemorySlot(rescGraph.valueIndex.at(string("2"))));
+}
+
+TEST(memoryAliasingTest, disabled) {
+    TEST_CASE_CHAIN;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.run();
+
+    EXPECT_EQ(fgDispatcher.memoryAliasingStats.numMemorySlots, 0);
+    EXPECT_EQ(fgDispatcher.memoryAliasingStats.aliasedTransientMemory, 0);
+    EXPECT_EQ(fgDispatcher.getMemorySlot(rescGraph.valueIndex.at(string("0"))), 0xFFFFFFFF);
+}
@@ -0,0 +1,159 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#define TEST_CASE_INTERLEAVED                                  \
+    TEST_CASE_DEFINE                                           \
+                                                               \
+    ViewInfo rasterData = {                                    \
+        {PassType::RASTER, {{{}, {"0"}}}},                     \
+        {PassType::RASTER, {{{}, {"1"}}}},                     \
+        {PassType::RASTER, {{{"0"}, {"2"}}}},                  \
+        {PassType::RASTER, {{{"1", "2"}, {"22"}}}},            \
+    };                                                         \
+                                                               \
+    LayoutInfo layoutInfo = {                                  \
+        {                                                      \
+            {"0", 0, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+        },                                                     \
+        {                                                      \
+            {"1", 1, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+        },                                                     \
+        {                                                      \
+            {"0", 0, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"2", 2, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+        },                                                     \
+        {                                                      \
+            {"1", 1, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"2", 2, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"22", 22, cc::gfx::ShaderStageFlagBit::FRAGMENT}, \
+        }};
+
+namespace {
+
+ccstd::vector<uint32_t> getPositions(const cc::render::FrameGraphDispatcher& fgDispatcher, const cc::render::RenderGraph& renderGraph) {
+    ccstd::vector<uint32_t> positions(cc::render::num_vertices(renderGraph), std::numeric_limits<uint32_t>::max());
+    for (uint32_t i = 0; i != fgDispatcher.passOrder.size(); ++i) {
+        positions[fgDispatcher.passOrder[i]] = i;
+    }
+    return positions;
+}
+
+} // namespace
+
+TEST(passReorderTest, disabled) {
+    TEST_CASE_INTERLEAVED;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enablePassReorder(false);
+    fgDispatcher.run();
+
+    const auto& stats = fgDispatcher.passReorderStats;
+    EXPECT_TRUE(fgDispatcher.passOrder.empty());
+    EXPECT_EQ(stats.numMovedPasses, 0);
+    EXPECT_EQ(stats.barriersBefore, 0);
+    EXPECT_EQ(stats.barriersAfter, 0);
+}
+
+TEST(passReorderTest, interleaved) {
+    // A(0), B(1), C(0 -> 2), D(1, 2 -> backbuffer):
+    // B sits between the producer and the consumer of 0
+    TEST_CASE_INTERLEAVED;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enablePassReorder(true);
+    fgDispatcher.run();
+
+    // C is pulled right behind A, so 0 stays in the tile and B no longer splits the hand over
+    const auto& stats = fgDispatcher.passReorderStats;
+    ASSERT_FALSE(stats.rejected);
+    EXPECT_EQ(stats.numMovedPasses, 2);
+    EXPECT_EQ(stats.renderPassBreaksBefore, 2);
+    EXPECT_EQ(stats.renderPassBreaksAfter, 1);
+    EXPECT_LT(stats.barriersAfter, stats.barriersBefore);
+
+    // every pass is scheduled once and producers still run before consumers
+    ASSERT_EQ(fgDispatcher.passOrder.size(), 4);
+    const auto positions = getPositions(fgDispatcher, renderGraph);
+    const auto passA = renderGraph.sortedVertices[0];
+    const auto passB = renderGraph.sortedVertices[1];
+    const auto passC = renderGraph.sortedVertices[2];
+    const auto passD = renderGraph.sortedVertices[3];
+    EXPECT_EQ(positions[passA], 0);
+    EXPECT_EQ(positions[passC], 1);
+    EXPECT_EQ(positions[passB], 2);
+    EXPECT_EQ(positions[passD], 3);
+
+    // the access graph follows the accepted schedule
+    const auto& order = fgDispatcher.resourceAccessGraph.topologicalOrder;
+    ASSERT_EQ(order.size(), 6);
+    EXPECT_EQ(order[1], fgDispatcher.resourceAccessGraph.passIndex.at(passA));
+    EXPECT_EQ(order[2], fgDispatcher.resourceAccessGraph.passIndex.at(passC));
+    EXPECT_EQ(order[3], fgDispatcher.resourceAccessGraph.passIndex.at(passB));
+    EXPECT_EQ(order[4], fgDispatcher.resourceAccessGraph.passIndex.at(passD));
+}
+
+TEST(passReorderTest, deterministic) {
+    TEST_CASE_INTERLEAVED;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher lhs(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    lhs.enablePassReorder(true);
+    lhs.run();
+
+    FrameGraphDispatcher rhs(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    rhs.enablePassReorder(true);
+    rhs.run();
+
+    EXPECT_TRUE(lhs.passOrder == rhs.passOrder);
+    EXPECT_TRUE(lhs.resourceAccessGraph.topologicalOrder == rhs.resourceAccessGraph.topologicalOrder);
+    EXPECT_EQ(lhs.passReorderStats.barriersAfter, rhs.passReorderStats.barriersAfter);
+    EXPECT_EQ(lhs.passReorderStats.renderPassBreaksAfter, rhs.passReorderStats.renderPassBreaksAfter);
+    EXPECT_EQ(lhs.passReorderStats.numMovedPasses, rhs.passReorderStats.numMovedPasses);
+}
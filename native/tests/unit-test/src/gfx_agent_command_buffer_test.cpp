@@ -0,0 +1,160 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <cstring>
+#include "gtest/gtest.h"
+
+#include "base/Ptr.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-agent/BufferAgent.h"
+#include "renderer/gfx-agent/CommandBufferAgent.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
+
+using namespace cc::gfx;
+
+namespace {
+// logs what the render thread replays, in order
+class RecordingCommandBuffer final : public CommandBuffer {
+public:
+    void begin(RenderPass * /*renderPass*/, uint32_t /*subpass*/, Framebuffer * /*frameBuffer*/) override { log("begin"); }
+    void end() override { log("end"); }
+    void beginRenderPass(RenderPass * /*renderPass*/, Framebuffer * /*fbo*/, const Rect & /*renderArea*/, const Color * /*colors*/, float /*depth*/, uint32_t /*stencil*/, CommandBuffer *const * /*secondaryCBs*/, uint32_t /*secondaryCBCount*/) override {}
+    void endRenderPass() override {}
+    void insertMarker(const MarkerInfo &marker) override { log("insertMarker " + marker.name); }
+    void beginMarker(const MarkerInfo &marker) override { log("beginMarker " + marker.name); }
+    void endMarker() override { log("endMarker"); }
+    void bindPipelineState(PipelineState * /*pso*/) override {}
+    void bindDescriptorSet(uint32_t set, DescriptorSet * /*descriptorSet*/, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) override {
+        ccstd::string entry = "bindDescriptorSet " + std::to_string(set);
+        for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
+            entry += " " + std::to_string(dynamicOffsets[i]);
+        }
+        log(entry);
+    }
+    void bindInputAssembler(InputAssembler * /*ia*/) override {}
+    void setViewport(const Viewport &vp) override { log("setViewport " + std::to_string(vp.width)); }
+    void setScissor(const Rect &rect) override { log("setScissor " + std::to_string(rect.width)); }
+    void setLineWidth(float width) override { log("setLineWidth " + std::to_string(static_cast<int>(width))); }
+    void setDepthBias(float /*constant*/, float /*clamp*/, float /*slope*/) override {}
+    void setBlendConstants(const Color & /*constants*/) override {}
+    void setDepthBound(float /*minBounds*/, float /*maxBounds*/) override {}
+    void setStencilWriteMask(StencilFace /*face*/, uint32_t /*mask*/) override {}
+    void setStencilCompareMask(StencilFace /*face*/, uint32_t /*ref*/, uint32_t /*mask*/) override {}
+    void nextSubpass() override {}
+    void draw(const DrawInfo &info) override { log("draw " + std::to_string(info.vertexCount)); }
+    void updateBuffer(Buffer * /*buff*/, const void *data, uint32_t size) override {
+        log("updateBuffer " + std::to_string(size) + " " + std::to_string(static_cast<const uint8_t *>(data)[size - 1]));
+    }
+    void copyBuffersToTexture(const uint8_t *const * /*buffers*/, Texture * /*texture*/, const BufferTextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void blitTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureBlit * /*regions*/, uint32_t /*count*/, Filter /*filter*/) override {}
+    void copyTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void resolveTexture(Texture * /*srcTexture*/, Texture * /*dstTexture*/, const TextureCopy * /*regions*/, uint32_t /*count*/) override {}
+    void execute(CommandBuffer *const * /*cmdBuffs*/, uint32_t /*count*/) override {}
+    void dispatch(const DispatchInfo & /*info*/) override {}
+    void beginQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void endQuery(QueryPool * /*queryPool*/, uint32_t /*id*/) override {}
+    void resetQueryPool(QueryPool * /*queryPool*/) override {}
+    void pipelineBarrier(const GeneralBarrier * /*barrier*/, const BufferBarrier *const * /*bufferBarriers*/, const Buffer *const * /*buffers*/, uint32_t /*bufferBarrierCount*/, const TextureBarrier *const * /*textureBarriers*/, const Texture *const * /*textures*/, uint32_t /*textureBarrierCount*/) override {}
+
+    ccstd::vector<ccstd::string> calls;
+
+protected:
+    void doInit(const CommandBufferInfo & /*info*/) override {}
+    void doDestroy() override {}
+
+    void log(ccstd::string entry) { calls.push_back(std::move(entry)); }
+};
+
+// a frame mixing frequent state and draw commands with less frequent ones
+ccstd::vector<ccstd::string> recordFrame(CommandBuffer *cmdBuff, Buffer *buffer, DescriptorSet *descriptorSet, uint32_t frame) {
+    ccstd::vector<ccstd::string> expected;
+    cmdBuff->begin();
+    expected.emplace_back("begin");
+    cmdBuff->beginMarker({"frame" + std::to_string(frame), {}});
+    expected.push_back("beginMarker frame" + std::to_string(frame));
+    cmdBuff->setViewport({0, 0, 640 + frame, 480});
+    expected.push_back("setViewport " + std::to_string(640 + frame));
+    cmdBuff->setScissor({0, 0, 320 + frame, 240});
+    expected.push_back("setScissor " + std::to_string(320 + frame));
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t const offsets[] = {i * 256, frame};
+        cmdBuff->bindDescriptorSet(i % 4, descriptorSet, i % 3, offsets);
+        ccstd::string entry = "bindDescriptorSet " + std::to_string(i % 4);
+        for (uint32_t j = 0; j < i % 3; ++j) {
+            entry += " " + std::to_string(offsets[j]);
+        }
+        expected.push_back(entry);
+
+        if (i % 16 == 0) {
+            uint8_t data[64];
+            memset(data, static_cast<int>(i + frame), sizeof(data));
+            cmdBuff->updateBuffer(buffer, data, sizeof(data));
+            expected.push_back("updateBuffer 64 " + std::to_string(static_cast<uint8_t>(i + frame)));
+            cmdBuff->setLineWidth(static_cast<float>(i));
+            expected.push_back("setLineWidth " + std::to_string(i));
+        }
+
+        cmdBuff->draw({3 * (i + 1)});
+        expected.push_back("draw " + std::to_string(3 * (i + 1)));
+    }
+    cmdBuff->insertMarker({"done", {}});
+    expected.emplace_back("insertMarker done");
+    cmdBuff->endMarker();
+    expected.emplace_back("endMarker");
+    cmdBuff->end();
+    expected.emplace_back("end");
+    return expected;
+}
+} // namespace
+
+TEST(GfxAgentCommandBufferTest, replayedInOrderPerFlush) {
+    auto *device = DeviceAgent::getInstance();
+    if (!device) {
+        GTEST_SKIP() << "agent layer disabled";
+    }
+
+    auto *actor = new RecordingCommandBuffer();
+    cc::IntrusivePtr<CommandBufferAgent> cmdBuff = new CommandBufferAgent(actor);
+    cmdBuff->initialize({device->getQueue()});
+    cc::IntrusivePtr<Buffer> buffer = device->createBuffer({BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::DEVICE, 64});
+    cc::IntrusivePtr<DescriptorSetLayout> layout = device->createDescriptorSetLayout({});
+    cc::IntrusivePtr<DescriptorSet> descriptorSet = device->createDescriptorSet({layout});
+    device->getMessageQueue()->kickAndWait();
+
+    for (uint32_t frame = 0; frame < 3; ++frame) {
+        auto expected = recordFrame(cmdBuff, buffer, descriptorSet, frame);
+        // nothing is replayed before the command buffer is flushed
+        device->getMessageQueue()->kickAndWait();
+        EXPECT_TRUE(actor->calls.empty());
+
+        CommandBuffer *cmdBuffs[] = {cmdBuff.get()};
+        device->flushCommands(cmdBuffs, 1);
+        device->getMessageQueue()->kickAndWait();
+        EXPECT_EQ(actor->calls, expected);
+        actor->calls.clear();
+        device->present();
+    }
+}
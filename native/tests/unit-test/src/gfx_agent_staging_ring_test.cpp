@@ -0,0 +1,234 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "gtest/gtest.h"
+
+#include "base/Ptr.h"
+#include "renderer/gfx-agent/BufferAgent.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
+
+using namespace cc::gfx;
+
+namespace {
+// keeps what the render thread hands over to the actor
+class RecordingBuffer final : public Buffer {
+public:
+    void update(const void *buffer, uint32_t size) override {
+        lastData = static_cast<const uint8_t *>(buffer);
+        received.assign(lastData, lastData + size);
+    }
+
+    const uint8_t *lastData{nullptr};
+    ccstd::vector<uint8_t> received;
+
+protected:
+    void doInit(const BufferInfo & /*info*/) override {}
+    void doInit(const BufferViewInfo & /*info*/) override {}
+    void doResize(uint32_t /*size*/, uint32_t /*count*/) override {}
+    void doDestroy() override {}
+};
+
+constexpr uint32_t SMALL_BUFFER_COUNT = 32;
+constexpr uint32_t SMALL_BUFFER_SIZE = 16U << 10;
+constexpr uint32_t LARGE_BUFFER_COUNT = 8;
+constexpr uint32_t LARGE_BUFFER_SIZE = 256U << 10;
+constexpr int NUM_FRAMES = 200;
+
+void fill(uint8_t *data, uint32_t size, int frame) {
+    memset(data, frame & 0xff, size);
+}
+
+void presentAll(DeviceAgent *device) {
+    // every slot of the ring has been recycled afterwards
+    for (uint32_t i = 0; i < DeviceAgent::MAX_FRAME_INDEX; ++i) {
+        device->present();
+    }
+}
+} // namespace
+
+TEST(GfxAgentStagingRingTest, updateReachesActor) {
+    // the test device is the empty backend, wrapped by the agent when device threads are detached
+    auto *device = DeviceAgent::getInstance();
+    if (!device) {
+        GTEST_SKIP() << "agent layer disabled";
+    }
+
+    constexpr uint32_t SIZE = 4096;
+    auto *actor = new RecordingBuffer();
+    cc::IntrusivePtr<BufferAgent> agent = new BufferAgent(actor);
+    agent->initialize({BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::DEVICE, SIZE});
+
+    for (uint32_t frame = 0; frame < 3; ++frame) {
+        ccstd::vector<uint8_t> data(SIZE);
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            data[i] = static_cast<uint8_t>(i * 7 + frame);
+        }
+        agent->update(data.data(), SIZE);
+        // the producer memory can be reused right away, the update was staged in the ring
+        std::fill(data.begin(), data.end(), 0);
+        device->getMessageQueue()->kickAndWait();
+
+        ASSERT_EQ(actor->received.size(), SIZE);
+        EXPECT_NE(actor->lastData, data.data());
+        for (uint32_t i = 0; i < SIZE; ++i) {
+            ASSERT_EQ(actor->received[i], static_cast<uint8_t>(i * 7 + frame)) << "byte " << i;
+        }
+        device->present();
+    }
+}
+
+TEST(GfxAgentStagingRingTest, recycledAcrossPresent) {
+    auto *device = DeviceAgent::getInstance();
+    if (!device) {
+        GTEST_SKIP() << "agent layer disabled";
+    }
+
+    presentAll(device);
+    ccstd::vector<uint8_t *> firsts;
+    for (uint32_t i = 0; i < DeviceAgent::MAX_FRAME_INDEX; ++i) {
+        firsts.push_back(device->allocateStaging(256));
+        ASSERT_NE(firsts.back(), nullptr);
+        device->present();
+    }
+    // every slot hands out the same memory once its frame is done
+    for (uint32_t round = 0; round < 3; ++round) {
+        for (uint32_t i = 0; i < DeviceAgent::MAX_FRAME_INDEX; ++i) {
+            EXPECT_EQ(device->allocateStaging(256), firsts[i]);
+            device->present();
+        }
+    }
+
+    // a frame outgrowing its block is merged into a single block for the next round
+    constexpr uint32_t UPDATE_SIZE = 400U << 10;
+    constexpr uint32_t UPDATE_COUNT = 4;
+    presentAll(device);
+    const auto frameIndex = device->getCurrentIndex();
+    for (uint32_t i = 0; i < UPDATE_COUNT; ++i) {
+        ASSERT_NE(device->allocateStaging(UPDATE_SIZE), nullptr);
+    }
+    presentAll(device);
+    ASSERT_EQ(device->getCurrentIndex(), frameIndex);
+    uint8_t *base = device->allocateStaging(UPDATE_SIZE);
+    for (uint32_t i = 1; i < UPDATE_COUNT; ++i) {
+        EXPECT_EQ(device->allocateStaging(UPDATE_SIZE), base + i * UPDATE_SIZE);
+    }
+    presentAll(device);
+}
+
+TEST(GfxAgentStagingRingTest, mapConsumedInPlace) {
+    auto *device = DeviceAgent::getInstance();
+    if (!device) {
+        GTEST_SKIP() << "agent layer disabled";
+    }
+
+    constexpr uint32_t SIZE = 4096;
+    auto *actor = new RecordingBuffer();
+    cc::IntrusivePtr<BufferAgent> agent = new BufferAgent(actor);
+    agent->initialize({BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::DEVICE, SIZE});
+
+    // unmap, update and command buffer updates all hand the mapped memory over without a copy
+    for (uint32_t submit = 0; submit < 3; ++submit) {
+        uint8_t *data = agent->map(SIZE);
+        ASSERT_NE(data, nullptr);
+        fill(data, SIZE, static_cast<int>(submit + 1));
+        switch (submit) {
+            case 0: agent->unmap(); break;
+            case 1: agent->update(data, SIZE); break;
+            default:
+                device->getCommandBuffer()->begin();
+                device->getCommandBuffer()->updateBuffer(agent, data, SIZE);
+                device->getCommandBuffer()->end();
+                break;
+        }
+        EXPECT_FALSE(agent->isMapped(data));
+        device->getMessageQueue()->kickAndWait();
+
+        if (submit < 2) {
+            EXPECT_EQ(actor->lastData, data);
+            ASSERT_EQ(actor->received.size(), SIZE);
+            EXPECT_EQ(actor->received.front(), submit + 1);
+            EXPECT_EQ(actor->received.back(), submit + 1);
+        }
+        device->present();
+    }
+    presentAll(device);
+}
+
+TEST(GfxAgentStagingRingTest, benchmark) {
+    auto *device = DeviceAgent::getInstance();
+    if (!device) {
+        GTEST_SKIP() << "agent layer disabled";
+    }
+
+    ccstd::vector<cc::IntrusivePtr<Buffer>> buffers;
+    for (uint32_t i = 0; i < SMALL_BUFFER_COUNT + LARGE_BUFFER_COUNT; ++i) {
+        uint32_t size = i < SMALL_BUFFER_COUNT ? SMALL_BUFFER_SIZE : LARGE_BUFFER_SIZE;
+        buffers.push_back(device->createBuffer({BufferUsageBit::VERTEX | BufferUsageBit::TRANSFER_DST, MemoryUsageBit::DEVICE, size, 4}));
+    }
+    ccstd::vector<uint8_t> scratch(LARGE_BUFFER_SIZE);
+
+    using Clock = std::chrono::steady_clock;
+
+    // only the producer side is timed, present waits for the render thread
+    Clock::duration copyTime{};
+    Clock::duration mapTime{};
+
+    // producer fills its own memory, update copies it into the ring
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        const auto start = Clock::now();
+        for (auto &buffer : buffers) {
+            fill(scratch.data(), buffer->getSize(), frame);
+            buffer->update(scratch.data(), buffer->getSize());
+        }
+        copyTime += Clock::now() - start;
+        device->present();
+    }
+
+    // producer fills the ring directly
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        const auto start = Clock::now();
+        for (auto &buffer : buffers) {
+            auto *agent = static_cast<BufferAgent *>(buffer.get());
+            uint8_t *data = agent->map(buffer->getSize());
+            ASSERT_NE(data, nullptr);
+            fill(data, buffer->getSize(), frame);
+            agent->unmap();
+        }
+        mapTime += Clock::now() - start;
+        device->present();
+    }
+
+    buffers.clear();
+    presentAll(device);
+
+    using Micro = std::chrono::duration<double, std::micro>;
+    printf("buffer updates per frame: update %.2fus, map/unmap %.2fus\n",
+           Micro(copyTime).count() / NUM_FRAMES,
+           Micro(mapTime).count() / NUM_FRAMES);
+}
@@ -0,0 +1,237 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "gtest/gtest.h"
+
+#include "gi/light-probe/LightProbe.h"
+
+using namespace cc;
+using namespace cc::gi;
+
+namespace {
+IntrusivePtr<LightProbesData> createProbes(uint32_t count, float size) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-size, size);
+    ccstd::vector<Vec3> points;
+    for (uint32_t i = 0; i < count; i++) {
+        points.emplace_back(dist(rng), dist(rng) * 0.25F, dist(rng));
+    }
+
+    IntrusivePtr<LightProbesData> data = new LightProbesData();
+    data->updateProbes(points);
+    data->updateTetrahedrons();
+    for (auto &probe : data->getProbes()) {
+        probe.coefficients.resize(SH::getBasisCount());
+        for (uint32_t i = 0; i < SH::getBasisCount(); i++) {
+            probe.coefficients[i].set(probe.position.x, probe.position.y + static_cast<float>(i), probe.position.z);
+        }
+    }
+    return data;
+}
+
+ccstd::vector<ccstd::array<int32_t, 4>> sortedTetrahedrons(LightProbesData *data) {
+    ccstd::vector<ccstd::array<int32_t, 4>> result;
+    for (const auto &tetrahedron : data->getTetrahedrons()) {
+        if (tetrahedron.isInnerTetrahedron()) {
+            ccstd::array<int32_t, 4> vertices{tetrahedron.vertex0, tetrahedron.vertex1, tetrahedron.vertex2, tetrahedron.vertex3};
+            std::sort(vertices.begin(), vertices.end());
+            result.push_back(vertices);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+double getVolume(LightProbesData *data) {
+    const auto &probes = data->getProbes();
+    double volume = 0.0;
+    for (const auto &tetrahedron : data->getTetrahedrons()) {
+        if (tetrahedron.isInnerTetrahedron()) {
+            const auto &p0 = probes[tetrahedron.vertex0].position;
+            const auto e1 = probes[tetrahedron.vertex1].position - p0;
+            const auto e2 = probes[tetrahedron.vertex2].position - p0;
+            const auto e3 = probes[tetrahedron.vertex3].position - p0;
+            Vec3 normal;
+            Vec3::cross(e2, e3, &normal);
+            volume += std::abs(e1.dot(normal)) / 6.0;
+        }
+    }
+    return volume;
+}
+
+// Brute force over the inner tetrahedrons, independent of the grid and the walk.
+bool isInsideHull(LightProbesData *data, const Vec3 &position) {
+    const auto &probes = data->getProbes();
+    const auto signedVolume = [](const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) {
+        Vec3 normal;
+        Vec3::cross(p2 - p0, p3 - p0, &normal);
+        return (p1 - p0).dot(normal);
+    };
+    for (const auto &tetrahedron : data->getTetrahedrons()) {
+        if (!tetrahedron.isInnerTetrahedron()) {
+            continue;
+        }
+        const auto &p0 = probes[tetrahedron.vertex0].position;
+        const auto &p1 = probes[tetrahedron.vertex1].position;
+        const auto &p2 = probes[tetrahedron.vertex2].position;
+        const auto &p3 = probes[tetrahedron.vertex3].position;
+        const auto volume = signedVolume(p0, p1, p2, p3);
+        const float volumes[4] = {signedVolume(position, p1, p2, p3), signedVolume(p0, position, p2, p3),
+                                  signedVolume(p0, p1, position, p3), signedVolume(p0, p1, p2, position)};
+        if (std::all_of(std::begin(volumes), std::end(volumes), [&](float v) { return v / volume >= -1e-4F; })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isInside(const Vec4 &weights) {
+    return weights.x >= -1e-3F && weights.y >= -1e-3F && weights.z >= -1e-3F && weights.w >= -1e-3F;
+}
+} // namespace
+
+TEST(LightProbeTest, seededLookup) {
+    auto data = createProbes(2000, 100.0F);
+    ASSERT_FALSE(data->empty());
+    const auto &tetrahedrons = data->getTetrahedrons();
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> inner(-60.0F, 60.0F);
+    std::uniform_real_distribution<float> outer(-200.0F, 200.0F);
+    Vec4 weights;
+    for (auto i = 0; i < 1000; i++) {
+        // no cached index, the lookup starts from the grid
+        const Vec3 position{inner(rng), inner(rng) * 0.25F, inner(rng)};
+        const auto tetIndex = data->getInterpolationWeights(position, -1, weights);
+        ASSERT_GE(tetIndex, 0);
+        ASSERT_LT(tetIndex, tetrahedrons.size());
+        EXPECT_TRUE(tetrahedrons[tetIndex].isInnerTetrahedron());
+        EXPECT_TRUE(isInside(weights));
+
+        // positions outside of the grid are clamped onto it
+        const Vec3 far{outer(rng), outer(rng), outer(rng)};
+        const auto outerIndex = data->getInterpolationWeights(far, tetIndex, weights);
+        ASSERT_GE(outerIndex, 0);
+        ASSERT_LT(outerIndex, tetrahedrons.size());
+    }
+}
+
+TEST(LightProbeTest, batchedEvaluation) {
+    auto data = createProbes(500, 50.0F);
+    const auto basisCount = SH::getBasisCount();
+
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> dist(-40.0F, 40.0F);
+    ccstd::vector<Vec3> positions;
+    for (auto i = 0; i < 256; i++) {
+        positions.emplace_back(dist(rng), dist(rng) * 0.25F, dist(rng));
+    }
+    ccstd::vector<int32_t> tetIndices(positions.size(), -1);
+    ccstd::vector<Vec3> coefficients(positions.size() * basisCount);
+    ASSERT_TRUE(data->evaluateSHCoefficients(positions.data(), tetIndices.data(), coefficients.data(), static_cast<uint32_t>(positions.size())));
+
+    // probe coefficients are linear in the position, so interpolating them inside the
+    // hull must reproduce the position whichever tetrahedron the lookup ended in
+    auto insideCount = 0;
+    for (auto i = 0; i < positions.size(); i++) {
+        if (!isInsideHull(data.get(), positions[i])) {
+            continue;
+        }
+        insideCount++;
+        for (auto k = 0; k < basisCount; k++) {
+            const Vec3 expected{positions[i].x, positions[i].y + static_cast<float>(k), positions[i].z};
+            EXPECT_TRUE(coefficients[i * basisCount + k].approxEquals(expected, 1e-2F));
+        }
+    }
+    EXPECT_GT(insideCount, positions.size() / 2);
+
+    // a second batch starts from the cached tetrahedrons and must agree with the first
+    auto cachedIndices = tetIndices;
+    ccstd::vector<Vec3> cachedCoefficients(coefficients.size());
+    ASSERT_TRUE(data->evaluateSHCoefficients(positions.data(), cachedIndices.data(), cachedCoefficients.data(), static_cast<uint32_t>(positions.size())));
+    EXPECT_EQ(cachedIndices, tetIndices);
+    for (auto i = 0; i < coefficients.size(); i++) {
+        EXPECT_TRUE(cachedCoefficients[i].approxEquals(coefficients[i], 1e-3F));
+    }
+}
+
+TEST(LightProbeTest, incrementalTetrahedrons) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> dist(-100.0F, 100.0F);
+    ccstd::vector<Vec3> points;
+    for (auto i = 0; i < 1000; i++) {
+        points.emplace_back(dist(rng), dist(rng) * 0.25F, dist(rng));
+    }
+
+    IntrusivePtr<LightProbesData> data = new LightProbesData();
+    data->updateProbes(points);
+    data->updateTetrahedrons(true);
+    ASSERT_FALSE(data->empty());
+    EXPECT_EQ(data->getTetrahedronUpdateStats().meshRebuilds, 1U);
+
+    for (auto round = 0; round < 4; round++) {
+        // move, remove and add a few probes, some of them outside of the current hull
+        for (auto i = 0; i < 10; i++) {
+            auto &point = points[rng() % points.size()];
+            point.x += dist(rng) * 0.05F;
+            point.z += dist(rng) * 0.05F;
+        }
+        for (auto i = 0; i < 5; i++) {
+            points.erase(points.begin() + static_cast<std::ptrdiff_t>(rng() % points.size()));
+        }
+        for (auto i = 0; i < 10; i++) {
+            points.emplace_back(dist(rng) * 1.2F, dist(rng) * 0.3F, dist(rng) * 1.2F);
+        }
+        data->updateProbes(points);
+        data->updateTetrahedrons(true);
+        // the kept mesh was updated in place
+        EXPECT_EQ(data->getTetrahedronUpdateStats().incrementalUpdates, static_cast<uint32_t>(round + 1));
+        EXPECT_EQ(data->getTetrahedronUpdateStats().meshRebuilds, 1U);
+        EXPECT_EQ(data->getTetrahedronUpdateStats().fallbacks, 0U);
+
+        // the kept mesh must match a mesh built from scratch
+        IntrusivePtr<LightProbesData> fresh = new LightProbesData();
+        fresh->updateProbes(points);
+        fresh->updateTetrahedrons(true);
+        EXPECT_EQ(sortedTetrahedrons(data.get()), sortedTetrahedrons(fresh.get()));
+
+        // and cover the same convex hull as tetgen
+        IntrusivePtr<LightProbesData> full = new LightProbesData();
+        full->updateProbes(points);
+        full->updateTetrahedrons();
+        EXPECT_EQ(full->getTetrahedronUpdateStats().fullBuilds, 1U);
+        const auto volume = getVolume(full.get());
+        EXPECT_NEAR(getVolume(data.get()), volume, volume * 1e-4);
+
+        for (const auto &tetrahedron : data->getTetrahedrons()) {
+            for (const auto neighbour : tetrahedron.neighbours) {
+                EXPECT_GE(neighbour, 0);
+            }
+        }
+    }
+}
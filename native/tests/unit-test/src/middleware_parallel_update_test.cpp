@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#if CC_USE_MIDDLEWARE
+    #include <atomic>
+    #include <memory>
+    #include <thread>
+    #include "editor-support/MiddlewareManager.h"
+
+using cc::middleware::IMiddleware;
+using cc::middleware::MiddlewareManager;
+
+namespace {
+
+constexpr uint32_t MIDDLEWARE_COUNT = 70;
+constexpr float DELTA_TIME = 1.F / 60.F;
+
+std::atomic<uint32_t> updateSequence{0};
+
+class FakeMiddleware : public IMiddleware {
+public:
+    explicit FakeMiddleware(bool parallelSafe) : _parallelSafe(parallelSafe) {}
+
+    void update(float dt) override {
+        ++updateCount;
+        lastDt = dt;
+        sequence = updateSequence++;
+        threadId = std::this_thread::get_id();
+    }
+    void render(float /*dt*/) override {}
+    bool isParallelUpdateSafe() const override { return _parallelSafe; }
+
+    uint32_t updateCount{0};
+    uint32_t sequence{0};
+    float lastDt{0.F};
+    std::thread::id threadId;
+
+private:
+    bool _parallelSafe{false};
+};
+
+void updateFrame(MiddlewareManager &manager, ccstd::vector<std::unique_ptr<FakeMiddleware>> &middlewares, bool parallel) {
+    manager.setParallelUpdate(parallel);
+    updateSequence = 0;
+    for (auto &middleware : middlewares) {
+        middleware->updateCount = 0;
+    }
+    manager.update(DELTA_TIME);
+}
+
+} // namespace
+
+TEST(MiddlewareManagerTest, updateInParallel) {
+    MiddlewareManager manager;
+    ccstd::vector<std::unique_ptr<FakeMiddleware>> middlewares;
+    for (uint32_t i = 0; i < MIDDLEWARE_COUNT; ++i) {
+        // every third middleware may call back into scripts
+        middlewares.emplace_back(std::make_unique<FakeMiddleware>(i % 3 != 0));
+        manager.addTimer(middlewares.back().get());
+    }
+
+    // the serial update gives the order of the update list
+    updateFrame(manager, middlewares, false);
+    ccstd::vector<FakeMiddleware *> updateOrder(MIDDLEWARE_COUNT);
+    for (const auto &middleware : middlewares) {
+        EXPECT_EQ(middleware->updateCount, 1U);
+        EXPECT_EQ(middleware->lastDt, DELTA_TIME);
+        EXPECT_EQ(middleware->threadId, std::this_thread::get_id());
+        ASSERT_LT(middleware->sequence, MIDDLEWARE_COUNT);
+        updateOrder[middleware->sequence] = middleware.get();
+    }
+
+    for (uint32_t frame = 0; frame < 2; ++frame) {
+        updateFrame(manager, middlewares, true);
+        uint32_t lastParallelSequence = 0;
+        uint32_t previousSerialSequence = 0;
+        bool firstSerial = true;
+        for (const auto *middleware : updateOrder) {
+            ASSERT_NE(middleware, nullptr);
+            EXPECT_EQ(middleware->updateCount, 1U);
+            EXPECT_EQ(middleware->lastDt, DELTA_TIME);
+            if (middleware->isParallelUpdateSafe()) {
+                lastParallelSequence = std::max(lastParallelSequence, middleware->sequence);
+                continue;
+            }
+            // unsafe middleware runs on the calling thread in list order, after every safe one
+            EXPECT_EQ(middleware->threadId, std::this_thread::get_id());
+            if (!firstSerial) {
+                EXPECT_GT(middleware->sequence, previousSerialSequence);
+            }
+            firstSerial = false;
+            previousSerialSequence = middleware->sequence;
+        }
+        for (const auto *middleware : updateOrder) {
+            if (!middleware->isParallelUpdateSafe()) {
+                EXPECT_GT(middleware->sequence, lastParallelSequence);
+            }
+        }
+    }
+
+    // removed middleware is no longer updated
+    manager.removeTimer(middlewares[1].get());
+    updateFrame(manager, middlewares, true);
+    EXPECT_EQ(middlewares[1]->updateCount, 0U);
+    EXPECT_EQ(middlewares[2]->updateCount, 1U);
+}
+#endif
@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <random>
+#include "3d/models/BakedSkinningModel.h"
+#include "core/geometry/AABB.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "math/Quaternion.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t CROWD_COUNT = 37;
+constexpr float BOUNDS_TOLERANCE = 1e-3F;
+
+const Vec3 MODEL_MIN{-0.5F, 0.F, -0.3F};
+const Vec3 MODEL_MAX{0.5F, 1.8F, 0.4F};
+
+Mat4 createRandomTransform(std::mt19937 &rng, float range) {
+    std::uniform_real_distribution<float> position(-range, range);
+    std::uniform_real_distribution<float> angle(-180.F, 180.F);
+    std::uniform_real_distribution<float> scale(0.5F, 2.F);
+    Quaternion rotation;
+    Quaternion::fromEuler(angle(rng), angle(rng), angle(rng), &rotation);
+    Mat4 transform;
+    Mat4::fromRTS(rotation, Vec3(position(rng), position(rng), position(rng)), Vec3(scale(rng), scale(rng), scale(rng)), &transform);
+    return transform;
+}
+
+// bounds of the model bounds corners transformed by every matrix
+void getExpectedBounds(const ccstd::vector<Mat4> &transforms, Vec3 *min, Vec3 *max) {
+    min->set(FLT_MAX, FLT_MAX, FLT_MAX);
+    max->set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const auto &transform : transforms) {
+        for (uint32_t corner = 0; corner < 8; ++corner) {
+            Vec3 point{corner & 1 ? MODEL_MAX.x : MODEL_MIN.x, corner & 2 ? MODEL_MAX.y : MODEL_MIN.y, corner & 4 ? MODEL_MAX.z : MODEL_MIN.z};
+            point.transformMat4(transform);
+            Vec3::min(*min, point, min);
+            Vec3::max(*max, point, max);
+        }
+    }
+}
+
+void expectBounds(const geometry::AABB *bounds, const ccstd::vector<Mat4> &transforms) {
+    ASSERT_NE(bounds, nullptr);
+    Vec3 expectedMin;
+    Vec3 expectedMax;
+    getExpectedBounds(transforms, &expectedMin, &expectedMax);
+    Vec3 min;
+    Vec3 max;
+    bounds->getBoundary(&min, &max);
+    EXPECT_NEAR(min.x, expectedMin.x, BOUNDS_TOLERANCE);
+    EXPECT_NEAR(min.y, expectedMin.y, BOUNDS_TOLERANCE);
+    EXPECT_NEAR(min.z, expectedMin.z, BOUNDS_TOLERANCE);
+    EXPECT_NEAR(max.x, expectedMax.x, BOUNDS_TOLERANCE);
+    EXPECT_NEAR(max.y, expectedMax.y, BOUNDS_TOLERANCE);
+    EXPECT_NEAR(max.z, expectedMax.z, BOUNDS_TOLERANCE);
+}
+
+} // namespace
+
+TEST(BakedSkinningCrowdTest, worldBoundsContainInstances) {
+    std::mt19937 rng(CROWD_COUNT);
+    IntrusivePtr<Node> node = ccnew Node();
+    node->setPosition(3.F, 0.F, -2.F);
+    node->setRotationFromEuler(0.F, 30.F, 0.F);
+
+    IntrusivePtr<BakedSkinningModel> model = ccnew BakedSkinningModel();
+    model->initialize();
+    model->setNode(node);
+    model->setTransform(node);
+    model->createBoundingShape(MODEL_MIN, MODEL_MAX);
+
+    // the model itself and every crowd instance, with the instance world matrix not relative to the node
+    ccstd::vector<Mat4> transforms{node->getWorldMatrix()};
+    model->setCrowdInstanceCount(CROWD_COUNT);
+    for (uint32_t i = 0; i < CROWD_COUNT; ++i) {
+        transforms.emplace_back(createRandomTransform(rng, 50.F));
+        model->setCrowdInstance(i, transforms.back(), static_cast<float>(i), 0.F);
+    }
+    model->updateTransform(1);
+    expectBounds(model->getWorldBounds(), transforms);
+    Node::resetChangedFlags();
+
+    // the crowd gathers next to the model while the node stays still, the bounds must shrink
+    Float32Array data(CROWD_COUNT * BakedSkinningModel::CROWD_INSTANCE_FLOATS);
+    for (uint32_t i = 0; i < CROWD_COUNT; ++i) {
+        Mat4 &transform = transforms[i + 1];
+        transform = createRandomTransform(rng, 5.F);
+        const uint32_t base = i * BakedSkinningModel::CROWD_INSTANCE_FLOATS;
+        for (uint32_t column = 0; column < 3; ++column) {
+            for (uint32_t row = 0; row < 3; ++row) {
+                data[base + column * 4 + row] = transform.m[column * 4 + row];
+            }
+            data[base + column * 4 + 3] = transform.m[12 + column];
+        }
+    }
+    model->updateCrowdInstances(data);
+    model->updateTransform(2);
+    expectBounds(model->getWorldBounds(), transforms);
+
+    // moving the node keeps the crowd in place
+    node->setPosition(-4.F, 1.F, 0.F);
+    transforms[0] = node->getWorldMatrix();
+    model->updateTransform(3);
+    expectBounds(model->getWorldBounds(), transforms);
+    Node::resetChangedFlags();
+
+    // without crowd the bounds are back to the model
+    model->setCrowdInstanceCount(0);
+    transforms.resize(1);
+    model->updateTransform(4);
+    expectBounds(model->getWorldBounds(), transforms);
+
+    model->destroy();
+}
@@ -0,0 +1,419 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "utils.h"
+
+// the curl downloader is only built on these platforms, the server below needs POSIX sockets
+#if (CC_PLATFORM == CC_PLATFORM_LINUX)
+
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #include <algorithm>
+    #include <chrono>
+    #include <cstdio>
+    #include <cstdlib>
+    #include <fstream>
+    #include <iterator>
+    #include <mutex>
+    #include <thread>
+    #include "application/ApplicationManager.h"
+    #include "base/Scheduler.h"
+    #include "base/std/container/string.h"
+    #include "base/std/container/unordered_map.h"
+    #include "base/std/container/vector.h"
+    #include "network/Downloader.h"
+
+using namespace cc;
+using namespace cc::network;
+
+namespace {
+
+// Minimal HTTP/1.1 server with keep-alive and single byte ranges, records every request it serves.
+class LocalHttpServer {
+public:
+    struct Request {
+        ccstd::string method;
+        ccstd::string path;
+        ccstd::string range;
+    };
+
+    explicit LocalHttpServer(ccstd::unordered_map<ccstd::string, ccstd::string> files)
+    : _files(std::move(files)) {
+        _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(_listenFd, reinterpret_cast<sockaddr *>(&addr), &len);
+        _port = ntohs(addr.sin_port);
+        listen(_listenFd, 64);
+        _acceptThread = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~LocalHttpServer() {
+        shutdown(_listenFd, SHUT_RDWR);
+        close(_listenFd);
+        _acceptThread.join();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const int fd : _clientFds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto &thread : _clientThreads) {
+            thread.join();
+        }
+    }
+
+    ccstd::string url(const ccstd::string &path) const {
+        return "http://127.0.0.1:" + std::to_string(_port) + path;
+    }
+
+    ccstd::vector<Request> requests() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _requests;
+    }
+
+    uint32_t connections() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return static_cast<uint32_t>(_clientFds.size());
+    }
+
+private:
+    void acceptLoop() {
+        while (true) {
+            const int fd = accept(_listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _clientFds.push_back(fd);
+            _clientThreads.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        ccstd::string buffer;
+        char chunk[4096];
+        while (true) {
+            const auto headerEnd = buffer.find("\r\n\r\n");
+            if (headerEnd == ccstd::string::npos) {
+                const auto received = recv(fd, chunk, sizeof(chunk), 0);
+                if (received <= 0) {
+                    break;
+                }
+                buffer.append(chunk, received);
+                continue;
+            }
+            const auto head = buffer.substr(0, headerEnd);
+            buffer.erase(0, headerEnd + 4);
+            if (!respond(fd, head)) {
+                break;
+            }
+        }
+        close(fd);
+    }
+
+    bool respond(int fd, const ccstd::string &head) {
+        Request request;
+        const auto methodEnd = head.find(' ');
+        const auto pathEnd = head.find(' ', methodEnd + 1);
+        request.method = head.substr(0, methodEnd);
+        request.path = head.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+        ccstd::string lower = head;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+        const auto rangePos = lower.find("\r\nrange: ");
+        if (rangePos != ccstd::string::npos) {
+            const auto valueBegin = rangePos + 9;
+            request.range = head.substr(valueBegin, head.find("\r\n", valueBegin) - valueBegin);
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _requests.push_back(request);
+        }
+
+        ccstd::string response;
+        ccstd::string body;
+        const auto iter = _files.find(request.path);
+        if (iter == _files.end()) {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        } else if (request.range.empty()) {
+            body = iter->second;
+            response = "HTTP/1.1 200 OK\r\nAccept-Ranges: bytes\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+        } else {
+            const auto &content = iter->second;
+            const auto dash = request.range.find('-');
+            const uint64_t first = std::strtoull(request.range.c_str() + 6, nullptr, 10);
+            uint64_t last = dash + 1 < request.range.size() ? std::strtoull(request.range.c_str() + dash + 1, nullptr, 10) : content.size() - 1;
+            if (first >= content.size()) {
+                response = "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" + std::to_string(content.size()) + "\r\nContent-Length: 0\r\n\r\n";
+            } else {
+                last = std::min<uint64_t>(last, content.size() - 1);
+                body = content.substr(first, last - first + 1);
+                response = "HTTP/1.1 206 Partial Content\r\nAccept-Ranges: bytes\r\nContent-Range: bytes " +
+                           std::to_string(first) + "-" + std::to_string(last) + "/" + std::to_string(content.size()) +
+                           "\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+            }
+        }
+        if (request.method != "HEAD") {
+            response += body;
+        }
+        for (size_t sent = 0; sent < response.size();) {
+            const auto count = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (count <= 0) {
+                return false;
+            }
+            sent += count;
+        }
+        return true;
+    }
+
+    ccstd::unordered_map<ccstd::string, ccstd::string> _files;
+    int _listenFd{-1};
+    uint16_t _port{0};
+    std::thread _acceptThread;
+    mutable std::mutex _mutex;
+    ccstd::vector<Request> _requests;
+    ccstd::vector<int> _clientFds;
+    ccstd::vector<std::thread> _clientThreads;
+};
+
+// the downloader reports through the engine scheduler, the test thread ticks it
+class TestEngine : public BaseEngine {
+public:
+    int32_t init() override { return 0; }
+    int32_t run() override { return 0; }
+    void pause() override {}
+    void resume() override {}
+    int restart() override { return 0; }
+    void close() override {}
+    uint getTotalFrames() const override { return 0; }
+    void setPreferredFramesPerSecond(int fps) override {}
+    SchedulerPtr getScheduler() const override { return _scheduler; }
+    bool isInited() const override { return true; }
+
+private:
+    SchedulerPtr _scheduler{std::make_shared<Scheduler>()};
+};
+
+class TestApplication : public BaseApplication {
+public:
+    int32_t init() override { return 0; }
+    int32_t run(int argc, const char **argv) override { return 0; }
+    void pause() override {}
+    void resume() override {}
+    void restart() override {}
+    void close() override {}
+    BaseEngine::Ptr getEngine() const override { return _engine; }
+    const std::vector<std::string> &getArguments() const override { return _arguments; }
+
+protected:
+    void setArgumentsInternal(int argc, const char *argv[]) override {}
+
+private:
+    BaseEngine::Ptr _engine{std::make_shared<TestEngine>()};
+    std::vector<std::string> _arguments;
+};
+
+ccstd::string makeContent(uint32_t size, uint32_t seed) {
+    ccstd::string content(size, '\0');
+    for (uint32_t i = 0; i != size; ++i) {
+        content[i] = static_cast<char>((i * 131 + i / 251 + seed) & 0xFF);
+    }
+    return content;
+}
+
+ccstd::string readFile(const ccstd::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+bool fileExists(const ccstd::string &path) {
+    return access(path.c_str(), F_OK) == 0;
+}
+
+class DownloaderCurlTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        CC_APPLICATION_MANAGER()->createApplication<TestApplication>(0, nullptr);
+        char dirTemplate[] = "/tmp/cc_downloader_XXXXXX";
+        ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+        _dir = dirTemplate;
+    }
+
+    void TearDown() override {
+        std::system(("rm -rf " + _dir).c_str());
+        CC_APPLICATION_MANAGER()->releaseAllApplications();
+    }
+
+    // ticks the scheduler until every task reported success or error
+    void run(uint32_t taskCount) {
+        const auto scheduler = CC_CURRENT_ENGINE()->getScheduler();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (_succeeded + _failed.size() < taskCount && std::chrono::steady_clock::now() < deadline) {
+            scheduler->update(0.016F);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    void observe(Downloader &downloader) {
+        downloader.onFileTaskSuccess = [this](const DownloadTask &task) { ++_succeeded; };
+        downloader.onTaskError = [this](const DownloadTask &task, int errorCode, int errorCodeInternal, const ccstd::string &errorStr) {
+            _failed.push_back(task.requestURL);
+        };
+    }
+
+    ccstd::string _dir;
+    uint32_t _succeeded{0};
+    ccstd::vector<ccstd::string> _failed;
+};
+
+} // namespace
+
+TEST_F(DownloaderCurlTest, rangedSplit) {
+    constexpr uint32_t CHUNK_SIZE = 256 * 1024;
+    constexpr uint32_t BIG_SIZE = 1500000;
+    const auto big = makeContent(BIG_SIZE, 1);
+    const auto small = makeContent(1000, 2);
+    LocalHttpServer server({{"/big.bin", big}, {"/small.bin", small}, {"/empty.bin", ""}});
+
+    DownloaderHints hints;
+    hints.rangeChunkSize = CHUNK_SIZE;
+    Downloader downloader(hints);
+    observe(downloader);
+    downloader.createDownloadTask(server.url("/big.bin"), _dir + "/big.bin");
+    downloader.createDownloadTask(server.url("/small.bin"), _dir + "/small.bin");
+    downloader.createDownloadTask(server.url("/empty.bin"), _dir + "/empty.bin");
+    downloader.createDownloadTask(server.url("/missing.bin"), _dir + "/missing.bin");
+    run(4);
+
+    EXPECT_EQ(_succeeded, 3);
+    ASSERT_EQ(_failed.size(), 1);
+    EXPECT_EQ(_failed[0], server.url("/missing.bin"));
+    EXPECT_TRUE(readFile(_dir + "/big.bin") == big);
+    EXPECT_TRUE(readFile(_dir + "/small.bin") == small);
+    EXPECT_TRUE(fileExists(_dir + "/empty.bin"));
+    EXPECT_TRUE(readFile(_dir + "/empty.bin").empty());
+    EXPECT_FALSE(fileExists(_dir + "/big.bin.tmp"));
+    EXPECT_FALSE(fileExists(_dir + "/missing.bin"));
+
+    // the first chunk tells the size, the rest is split in ranges no larger than a chunk
+    ccstd::vector<std::pair<uint32_t, uint32_t>> ranges;
+    uint32_t smallRequests = 0;
+    for (const auto &request : server.requests()) {
+        if (request.path == "/small.bin") {
+            ++smallRequests;
+            EXPECT_EQ(request.range, "bytes=0-" + std::to_string(CHUNK_SIZE - 1));
+        }
+        if (request.path != "/big.bin") {
+            continue;
+        }
+        EXPECT_EQ(request.method, "GET");
+        uint32_t first = 0;
+        uint32_t last = 0;
+        ASSERT_EQ(std::sscanf(request.range.c_str(), "bytes=%u-%u", &first, &last), 2);
+        ranges.emplace_back(first, last);
+    }
+    EXPECT_EQ(smallRequests, 1);
+    ASSERT_EQ(ranges.size(), 1 + (BIG_SIZE - CHUNK_SIZE + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    EXPECT_EQ(ranges[0], std::make_pair(0U, CHUNK_SIZE - 1));
+    std::sort(ranges.begin(), ranges.end());
+    uint32_t next = 0;
+    for (const auto &[first, last] : ranges) {
+        EXPECT_EQ(first, next);
+        EXPECT_LE(last - first + 1, CHUNK_SIZE);
+        next = last + 1;
+    }
+    EXPECT_EQ(next, BIG_SIZE);
+}
+
+TEST_F(DownloaderCurlTest, resume) {
+    constexpr uint32_t PARTIAL_SIZE = 100000;
+    const auto content = makeContent(500000, 3);
+    LocalHttpServer server({{"/file.bin", content}});
+    {
+        std::ofstream partial(_dir + "/file.bin.tmp", std::ios::binary);
+        partial.write(content.data(), PARTIAL_SIZE);
+    }
+
+    Downloader downloader;
+    observe(downloader);
+    downloader.createDownloadTask(server.url("/file.bin"), _dir + "/file.bin");
+    run(1);
+
+    EXPECT_EQ(_succeeded, 1);
+    EXPECT_TRUE(_failed.empty());
+    EXPECT_TRUE(readFile(_dir + "/file.bin") == content);
+    EXPECT_FALSE(fileExists(_dir + "/file.bin.tmp"));
+
+    // the header request tells whether the server can resume, only the missing bytes are requested
+    const auto requests = server.requests();
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].method, "HEAD");
+    EXPECT_EQ(requests[1].method, "GET");
+    EXPECT_EQ(requests[1].range, "bytes=" + std::to_string(PARTIAL_SIZE) + "-");
+}
+
+TEST_F(DownloaderCurlTest, connectionReuse) {
+    constexpr uint32_t FILE_COUNT = 40;
+    ccstd::unordered_map<ccstd::string, ccstd::string> files;
+    for (uint32_t i = 0; i != FILE_COUNT; ++i) {
+        files.emplace("/f" + std::to_string(i) + ".bin", makeContent(2000 + i, i));
+    }
+    LocalHttpServer server(files);
+
+    DownloaderHints hints;
+    hints.countOfMaxProcessingTasks = 16;
+    hints.countOfMaxConnectionsPerHost = 2;
+    Downloader downloader(hints);
+    observe(downloader);
+    for (uint32_t i = 0; i != FILE_COUNT / 2; ++i) {
+        const auto name = "/f" + std::to_string(i) + ".bin";
+        downloader.createDownloadTask(server.url(name), _dir + name);
+    }
+    run(FILE_COUNT / 2);
+    EXPECT_LE(server.connections(), 2);
+
+    // the connections outlive the batch and serve the next one
+    for (uint32_t i = FILE_COUNT / 2; i != FILE_COUNT; ++i) {
+        const auto name = "/f" + std::to_string(i) + ".bin";
+        downloader.createDownloadTask(server.url(name), _dir + name);
+    }
+    run(FILE_COUNT);
+
+    EXPECT_EQ(_succeeded, FILE_COUNT);
+    EXPECT_TRUE(_failed.empty());
+    EXPECT_EQ(server.requests().size(), FILE_COUNT);
+    EXPECT_LE(server.connections(), 2);
+    for (const auto &[name, content] : files) {
+        EXPECT_TRUE(readFile(_dir + name) == content);
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <cstring>
+#include "gtest/gtest.h"
+
+#include "base/std/container/vector.h"
+#include "physics/spec/IWorld.h"
+#if CC_USE_PHYSICS_PHYSX
+    #include "physics/physx/PhysXWorld.h"
+#endif
+
+using cc::physics::BatchQueryDesc;
+
+namespace {
+constexpr uint32_t QUERY_COUNT = 64;
+constexpr float UNTOUCHED = -1.0F;
+
+struct BatchBuffers {
+    ccstd::vector<float> queries;
+    ccstd::vector<float> results;
+
+    BatchBuffers(uint32_t queryFloats, uint32_t resultFloats) : queries(queryFloats, 0.0F), results(resultFloats, UNTOUCHED) {}
+
+    BatchQueryDesc desc(uint32_t queryCount) {
+        BatchQueryDesc desc;
+        desc.queries = queries.data();
+        desc.queryLength = static_cast<uint32_t>(queries.size());
+        desc.queryCount = queryCount;
+        desc.results = results.data();
+        desc.resultLength = static_cast<uint32_t>(results.size());
+        desc.mask = 0xFFFFFFFF;
+        return desc;
+    }
+
+    void setRays(uint32_t stride) {
+        for (uint32_t i = 0; i + stride <= queries.size(); i += stride) {
+            queries[i + 1] = 10.0F; // origin y
+            queries[i + 4] = -1.0F; // direction -y
+            queries[i + 5] = 0.0F;
+            queries[i + 6] = 5.0F; // distance
+            if (stride == BatchQueryDesc::SWEEP_STRIDE) {
+                queries[i + 7] = 1.0F; // orientation w
+            }
+        }
+    }
+
+    bool isUntouched() const {
+        for (const auto value : results) {
+            if (value != UNTOUCHED) return false;
+        }
+        return true;
+    }
+};
+} // namespace
+
+TEST(physicsBatchQueryTest, validation) {
+    BatchBuffers rays(QUERY_COUNT * BatchQueryDesc::RAY_STRIDE, QUERY_COUNT * BatchQueryDesc::RESULT_STRIDE);
+    EXPECT_TRUE(rays.desc(QUERY_COUNT).isValid(BatchQueryDesc::RAY_STRIDE));
+    EXPECT_TRUE(rays.desc(1).isValid(BatchQueryDesc::RAY_STRIDE));
+    EXPECT_FALSE(rays.desc(0).isValid(BatchQueryDesc::RAY_STRIDE));
+    // the query buffer only holds QUERY_COUNT rays
+    EXPECT_FALSE(rays.desc(QUERY_COUNT + 1).isValid(BatchQueryDesc::RAY_STRIDE));
+    // and fewer sweeps, which are wider
+    EXPECT_FALSE(rays.desc(QUERY_COUNT).isValid(BatchQueryDesc::SWEEP_STRIDE));
+
+    BatchBuffers sweeps(QUERY_COUNT * BatchQueryDesc::SWEEP_STRIDE, QUERY_COUNT * BatchQueryDesc::RESULT_STRIDE);
+    EXPECT_TRUE(sweeps.desc(QUERY_COUNT).isValid(BatchQueryDesc::SWEEP_STRIDE));
+
+    // the result buffer is too small
+    BatchBuffers results(QUERY_COUNT * BatchQueryDesc::RAY_STRIDE, QUERY_COUNT * BatchQueryDesc::RESULT_STRIDE - 1);
+    EXPECT_FALSE(results.desc(QUERY_COUNT).isValid(BatchQueryDesc::RAY_STRIDE));
+
+    // a huge count must not wrap around the length check
+    EXPECT_FALSE(rays.desc(0x80000000U).isValid(BatchQueryDesc::RAY_STRIDE));
+
+    auto desc = rays.desc(QUERY_COUNT);
+    desc.queries = nullptr;
+    EXPECT_FALSE(desc.isValid(BatchQueryDesc::RAY_STRIDE));
+}
+
+#if CC_USE_PHYSICS_PHYSX
+TEST(physicsBatchQueryTest, physxBatch) {
+    cc::physics::PhysXWorld world;
+
+    BatchBuffers rays(QUERY_COUNT * BatchQueryDesc::RAY_STRIDE, QUERY_COUNT * BatchQueryDesc::RESULT_STRIDE);
+    rays.setRays(BatchQueryDesc::RAY_STRIDE);
+    auto overflow = rays.desc(QUERY_COUNT + 1);
+    EXPECT_EQ(world.raycastClosestBatch(overflow), 0U);
+    EXPECT_TRUE(rays.isUntouched());
+
+    // the scene is empty, every valid query reports a miss with shape id 0
+    auto valid = rays.desc(QUERY_COUNT);
+    EXPECT_EQ(world.raycastClosestBatch(valid), 0U);
+    for (uint32_t i = 0; i < QUERY_COUNT; ++i) {
+        uint32_t shape = 1;
+        memcpy(&shape, &rays.results[i * BatchQueryDesc::RESULT_STRIDE], sizeof(shape));
+        EXPECT_EQ(shape, 0U);
+    }
+
+    // a ray sized buffer is too small for as many sweeps
+    BatchBuffers sweeps(QUERY_COUNT * BatchQueryDesc::RAY_STRIDE, QUERY_COUNT * BatchQueryDesc::RESULT_STRIDE);
+    sweeps.setRays(BatchQueryDesc::RAY_STRIDE);
+    auto tooShort = sweeps.desc(QUERY_COUNT);
+    EXPECT_EQ(world.sweepSphereClosestBatch(tooShort, 0.5F), 0U);
+    EXPECT_TRUE(sweeps.isUntouched());
+
+    BatchBuffers validSweeps(QUERY_COUNT * BatchQueryDesc::SWEEP_STRIDE, QUERY_COUNT * BatchQueryDesc::RESULT_STRIDE);
+    validSweeps.setRays(BatchQueryDesc::SWEEP_STRIDE);
+    auto sweepDesc = validSweeps.desc(QUERY_COUNT);
+    EXPECT_EQ(world.sweepBoxClosestBatch(sweepDesc, 0.5F, 0.5F, 0.5F), 0U);
+    EXPECT_FALSE(validSweeps.isUntouched());
+}
+#endif
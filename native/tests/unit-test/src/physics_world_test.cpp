@@ -0,0 +1,145 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#if CC_USE_PHYSICS_PHYSX
+    #include "core/scene-graph/Node.h"
+    #include "physics/physx/PhysXInc.h"
+    #include "physics/physx/PhysXRigidBody.h"
+    #include "physics/physx/PhysXSharedBody.h"
+    #include "physics/physx/PhysXWorld.h"
+
+using cc::IntrusivePtr;
+using cc::Node;
+using cc::physics::ERigidBodyType;
+using cc::physics::PhysXRigidBody;
+using cc::physics::PhysXWorld;
+
+TEST(physicsWorldTest, syncSceneToPhysics) {
+    PhysXWorld world;
+    world.setGravity(0.0F, 0.0F, 0.0F);
+
+    IntrusivePtr<Node> moved(new Node());
+    IntrusivePtr<Node> resting(new Node());
+    PhysXRigidBody movedBody;
+    PhysXRigidBody restingBody;
+    movedBody.initialize(moved, ERigidBodyType::DYNAMIC, 1);
+    restingBody.initialize(resting, ERigidBodyType::DYNAMIC, 1);
+    movedBody.onEnable();
+    restingBody.onEnable();
+
+    auto *movedActor = movedBody.getSharedBody().getImpl().rigidActor;
+    auto *restingActor = restingBody.getSharedBody().getImpl().rigidActor;
+    // a body whose node did not change keeps the pose set in physics
+    restingActor->setGlobalPose(physx::PxTransform(physx::PxVec3(5.0F, 0.0F, 0.0F)));
+
+    Node::resetChangedFlags();
+    moved->setPosition(1.0F, 2.0F, 3.0F);
+    world.syncSceneToPhysics();
+
+    const auto movedPose = movedActor->getGlobalPose();
+    EXPECT_FLOAT_EQ(movedPose.p.x, 1.0F);
+    EXPECT_FLOAT_EQ(movedPose.p.y, 2.0F);
+    EXPECT_FLOAT_EQ(movedPose.p.z, 3.0F);
+    EXPECT_FLOAT_EQ(restingActor->getGlobalPose().p.x, 5.0F);
+
+    movedBody.onDisable();
+    restingBody.onDisable();
+    movedBody.onDestroy();
+    restingBody.onDestroy();
+}
+
+TEST(physicsWorldTest, syncPhysicsToScene) {
+    PhysXWorld world;
+    world.setGravity(0.0F, 0.0F, 0.0F);
+
+    IntrusivePtr<Node> moving(new Node());
+    IntrusivePtr<Node> sleeping(new Node());
+    IntrusivePtr<Node> kinematic(new Node());
+    PhysXRigidBody movingBody;
+    PhysXRigidBody sleepingBody;
+    PhysXRigidBody kinematicBody;
+    movingBody.initialize(moving, ERigidBodyType::DYNAMIC, 1);
+    sleepingBody.initialize(sleeping, ERigidBodyType::DYNAMIC, 1);
+    kinematicBody.initialize(kinematic, ERigidBodyType::KINEMATIC, 1);
+    movingBody.onEnable();
+    sleepingBody.onEnable();
+    kinematicBody.onEnable();
+
+    auto *movingActor = movingBody.getSharedBody().getImpl().rigidActor;
+    auto *sleepingActor = sleepingBody.getSharedBody().getImpl().rigidDynamic;
+    auto *kinematicActor = kinematicBody.getSharedBody().getImpl().rigidDynamic;
+    movingBody.setLinearVelocity(6.0F, 0.0F, 0.0F);
+    // sleeping bodies are not active, their pose must not reach the node
+    sleepingActor->setGlobalPose(physx::PxTransform(physx::PxVec3(5.0F, 0.0F, 0.0F)), false);
+    sleepingBody.sleep();
+    // kinematic bodies are active when they move to their target, but their nodes drive them
+    kinematicActor->setKinematicTarget(physx::PxTransform(physx::PxVec3(0.0F, 4.0F, 0.0F)));
+
+    Node::resetChangedFlags();
+    world.step(1.0F / 60.0F);
+
+    const auto movingPose = movingActor->getGlobalPose();
+    EXPECT_GT(movingPose.p.x, 0.0F);
+    EXPECT_FLOAT_EQ(moving->getWorldPosition().x, movingPose.p.x);
+    EXPECT_FLOAT_EQ(moving->getWorldPosition().y, 0.0F);
+    EXPECT_TRUE(moving->getChangedFlags() & static_cast<uint32_t>(cc::TransformBit::POSITION));
+
+    EXPECT_TRUE(sleepingBody.isSleeping());
+    EXPECT_FLOAT_EQ(sleepingActor->getGlobalPose().p.x, 5.0F);
+    EXPECT_EQ(sleeping->getWorldPosition(), cc::Vec3::ZERO);
+    EXPECT_EQ(sleeping->getChangedFlags(), 0U);
+
+    EXPECT_FLOAT_EQ(kinematicActor->getGlobalPose().p.y, 4.0F);
+    EXPECT_EQ(kinematic->getWorldPosition(), cc::Vec3::ZERO);
+    EXPECT_EQ(kinematic->getChangedFlags(), 0U);
+
+    movingBody.onDisable();
+    sleepingBody.onDisable();
+    kinematicBody.onDisable();
+    movingBody.onDestroy();
+    sleepingBody.onDestroy();
+    kinematicBody.onDestroy();
+}
+
+TEST(physicsWorldTest, workerThreadCount) {
+    PhysXWorld world;
+    auto *dispatcher = world.getScene().getCpuDispatcher();
+    EXPECT_EQ(world.getWorkerThreadCount(), 0U);
+    EXPECT_EQ(dispatcher->getWorkerCount(), 0U);
+
+    // the dispatcher is only recreated once the running step has fetched its results
+    world.setWorkerThreadCount(2);
+    EXPECT_EQ(world.getWorkerThreadCount(), 2U);
+    EXPECT_EQ(dispatcher->getWorkerCount(), 0U);
+
+    world.step(1.0F / 60.0F);
+    EXPECT_EQ(dispatcher->getWorkerCount(), 2U);
+
+    world.setWorkerThreadCount(0);
+    world.step(1.0F / 60.0F);
+    EXPECT_EQ(dispatcher->getWorkerCount(), 0U);
+}
+#endif
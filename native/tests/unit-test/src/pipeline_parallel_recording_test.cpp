@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/NativeExecutorRenderGraph.h"
+#include "cocos/renderer/pipeline/custom/RenderGraphGraphs.h"
+#include "gtest/gtest.h"
+
+using namespace cc::render;
+
+namespace {
+
+RenderGraph::vertex_descriptor addChild(RenderGraph& rg, RenderGraph::vertex_descriptor parentID, const char* name, bool isScene) {
+    if (isScene) {
+        return addVertex(
+            SceneTag{},
+            std::forward_as_tuple(name),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            std::forward_as_tuple(),
+            rg, parentID);
+    }
+    return addVertex(
+        QueueTag{},
+        std::forward_as_tuple(name),
+        std::forward_as_tuple(),
+        std::forward_as_tuple(),
+        std::forward_as_tuple(),
+        std::forward_as_tuple(),
+        rg, parentID);
+}
+
+ccstd::pmr::vector<uint32_t> partition(const ccstd::vector<uint32_t>& passCosts, uint32_t maxPartitions) {
+    auto* resource = boost::container::pmr::get_default_resource();
+    ccstd::pmr::vector<RenderGraph::vertex_descriptor> passes(resource);
+    ccstd::pmr::vector<uint32_t> costs(passCosts.begin(), passCosts.end(), resource);
+    for (uint32_t i = 0; i != passCosts.size(); ++i) {
+        passes.emplace_back(i);
+    }
+    ccstd::pmr::vector<uint32_t> partitionEnds(resource);
+    partitionPassesByCost(passes, costs, maxPartitions, partitionEnds);
+    return partitionEnds;
+}
+
+} // namespace
+
+TEST(parallelRecordingTest, recordable) {
+    auto* resource = boost::container::pmr::get_default_resource();
+    RenderGraph rg(resource);
+    const auto passID = add_vertex(rg, RasterPassTag{}, "pass");
+    const auto queueID = addChild(rg, passID, "queue", false);
+    const auto sceneID = addChild(rg, queueID, "scene", true);
+    EXPECT_TRUE(isParallelRecordable(rg));
+
+    // geometry scenes are recorded with immediate uploads
+    get(SceneTag{}, sceneID, rg).flags = SceneFlags::GEOMETRY;
+    EXPECT_FALSE(isParallelRecordable(rg));
+    get(SceneTag{}, sceneID, rg).flags = SceneFlags::NONE;
+
+    // statistics are drawn from the main thread
+    get(RasterPassTag{}, passID, rg).showStatistics = true;
+    EXPECT_FALSE(isParallelRecordable(rg));
+}
+
+TEST(parallelRecordingTest, costs) {
+    auto* resource = boost::container::pmr::get_default_resource();
+    RenderGraph rg(resource);
+    const auto pass0 = add_vertex(rg, RasterPassTag{}, "pass0");
+    const auto scene0 = addChild(rg, addChild(rg, pass0, "queue0", false), "scene0", true);
+    const auto pass1 = add_vertex(rg, RasterPassTag{}, "pass1");
+    const auto scene1 = addChild(rg, addChild(rg, pass1, "queue1", false), "scene1", true);
+    const auto pass2 = add_vertex(rg, RasterPassTag{}, "pass2");
+    addChild(rg, addChild(rg, pass2, "queue2", false), "scene2", true);
+
+    SceneCulling sceneCulling(resource);
+    sceneCulling.renderQueues.emplace_back();
+    sceneCulling.renderQueues.back().opaqueQueue.instances.resize(300);
+    sceneCulling.renderQueues.back().transparentQueue.instances.resize(20);
+    sceneCulling.renderQueueQueryIndex.emplace(scene0, NativeRenderQueueQuery{{}, {}, NativeRenderQueueID{0}});
+    sceneCulling.renderQueues.emplace_back();
+    sceneCulling.renderQueues.back().opaqueQueue.instances.resize(5);
+    sceneCulling.renderQueueQueryIndex.emplace(scene1, NativeRenderQueueQuery{{}, {}, NativeRenderQueueID{1}});
+
+    ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, resource);
+    validPasses[pass2] = false;
+    validPasses[pass2 + 1] = false;
+    validPasses[pass2 + 2] = false;
+
+    ccstd::pmr::vector<uint32_t> costs(resource);
+    estimateRecordingCosts(rg, validPasses, sceneCulling, costs);
+    ASSERT_EQ(costs.size(), num_vertices(rg));
+
+    // pass, queue and scene vertices count once each, plus the draws of the scene
+    EXPECT_EQ(costs[pass0], 3 + 320);
+    EXPECT_EQ(costs[pass1], 3 + 5);
+    EXPECT_EQ(costs[pass2], 0);
+    // children do not carry costs of their own
+    EXPECT_EQ(costs[scene0], 0);
+    EXPECT_EQ(costs[scene1], 0);
+}
+
+TEST(parallelRecordingTest, partitions) {
+    // too cheap to split
+    EXPECT_EQ(partition({10, 20, 30}, 8), (ccstd::pmr::vector<uint32_t>{3}));
+    EXPECT_EQ(partition({1000}, 8), (ccstd::pmr::vector<uint32_t>{1}));
+    EXPECT_EQ(partition({1000, 1000}, 1), (ccstd::pmr::vector<uint32_t>{2}));
+
+    // bounded by the number of passes, the cost and the workers
+    EXPECT_EQ(partition({300, 300, 300, 300}, 8), (ccstd::pmr::vector<uint32_t>{1, 2, 3, 4}));
+    EXPECT_EQ(partition({300, 300, 300, 300}, 2), (ccstd::pmr::vector<uint32_t>{2, 4}));
+    EXPECT_EQ(partition({200, 200, 200, 200}, 8), (ccstd::pmr::vector<uint32_t>{2, 3, 4}));
+
+    // contiguous partitions of similar cost
+    EXPECT_EQ(partition({600, 100, 100, 100, 100, 600}, 2), (ccstd::pmr::vector<uint32_t>{3, 6}));
+    EXPECT_EQ(partition({1, 1, 1, 1, 2000}, 2), (ccstd::pmr::vector<uint32_t>{4, 5}));
+}
@@ -0,0 +1,203 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "platform/FileUtils.h"
+#include "platform/FullPathCache.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+class TestFileUtils : public FileUtils {
+public:
+    bool isFileExistInternal(const ccstd::string &filename) const override {
+        struct stat st;
+        return stat(filename.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+    }
+    ccstd::string getWritablePath() const override { return ""; }
+};
+
+// resolves directories as files like the platforms whose file checks accept directories
+class DirectoryFileUtils : public TestFileUtils {
+public:
+    bool isFileExistInternal(const ccstd::string &filename) const override {
+        struct stat st;
+        return stat(filename.c_str(), &st) == 0;
+    }
+};
+
+void touchFile(const ccstd::string &path) {
+    FILE *fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    fclose(fp);
+}
+} // namespace
+
+TEST(FullPathCacheTest, findAndClear) {
+    FullPathCache cache;
+    ccstd::string fullPath;
+    EXPECT_FALSE(cache.find("a.png", &fullPath));
+
+    cache.emplace("a.png", "/res/a.png");
+    cache.emplace("b/c.png", "/res/b/c.png");
+    // the first resolved path is kept
+    cache.emplace("a.png", "/other/a.png");
+
+    EXPECT_TRUE(cache.find("a.png", &fullPath));
+    EXPECT_EQ(fullPath, "/res/a.png");
+    EXPECT_TRUE(cache.find("b/c.png", &fullPath));
+    EXPECT_EQ(fullPath, "/res/b/c.png");
+    EXPECT_EQ(cache.size(), 2U);
+
+    const auto entries = cache.snapshot();
+    EXPECT_EQ(entries.size(), 2U);
+    EXPECT_EQ(entries.at("b/c.png"), "/res/b/c.png");
+
+    cache.clear();
+    EXPECT_FALSE(cache.find("a.png", &fullPath));
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(FullPathCacheTest, concurrentAccess) {
+    FullPathCache cache;
+    constexpr uint32_t threadCount = 4;
+    constexpr uint32_t fileCount = 1000;
+
+    ccstd::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&cache, t]() {
+            ccstd::string fullPath;
+            for (uint32_t i = 0; i < fileCount; ++i) {
+                const auto name = std::to_string(i) + ".png";
+                if (!cache.find(name, &fullPath)) {
+                    cache.emplace(name, "/res/" + name);
+                }
+                // every thread also owns some file names
+                cache.emplace(std::to_string(t) + "/" + name, "/res/" + name);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(cache.size(), static_cast<size_t>(fileCount * (threadCount + 1)));
+    ccstd::string fullPath;
+    for (uint32_t i = 0; i < fileCount; ++i) {
+        const auto name = std::to_string(i) + ".png";
+        EXPECT_TRUE(cache.find(name, &fullPath));
+        EXPECT_EQ(fullPath, "/res/" + name);
+    }
+}
+
+TEST(FullPathCacheTest, manifestWithParentSegments) {
+    char dirTemplate[] = "/tmp/cc_full_path_XXXXXX";
+    ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+    const ccstd::string root = dirTemplate;
+    ASSERT_EQ(mkdir((root + "/a").c_str(), 0755), 0);
+    ASSERT_EQ(mkdir((root + "/a/sub").c_str(), 0755), 0);
+    ASSERT_EQ(mkdir((root + "/b").c_str(), 0755), 0);
+    touchFile(root + "/a/x.png");
+    touchFile(root + "/a/sub/y.png");
+
+    TestFileUtils fileUtils;
+    fileUtils.setSearchPaths({root + "/b/../a/"});
+
+    // resolved on the file system
+    const auto x = fileUtils.fullPathForFilename("x.png");
+    const auto y = fileUtils.fullPathForFilename("sub/y.png");
+    EXPECT_EQ(x, root + "/a/x.png");
+    EXPECT_EQ(y, root + "/a/sub/y.png");
+
+    // resolved from the manifest, listed entries no longer contain the '..' segment
+    fileUtils.setSearchPathManifestEnabled(true);
+    fileUtils.purgeCachedEntries();
+    EXPECT_EQ(fileUtils.fullPathForFilename("x.png"), x);
+    EXPECT_EQ(fileUtils.fullPathForFilename("sub/y.png"), y);
+    EXPECT_EQ(fileUtils.fullPathForFilename("z.png"), "");
+
+    remove((root + "/a/sub/y.png").c_str());
+    remove((root + "/a/x.png").c_str());
+    rmdir((root + "/a/sub").c_str());
+    rmdir((root + "/a").c_str());
+    rmdir((root + "/b").c_str());
+    rmdir(root.c_str());
+}
+
+TEST(FullPathCacheTest, manifestWithDirectories) {
+    char dirTemplate[] = "/tmp/cc_full_path_XXXXXX";
+    ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+    const ccstd::string root = dirTemplate;
+    ASSERT_EQ(mkdir((root + "/a").c_str(), 0755), 0);
+    ASSERT_EQ(mkdir((root + "/a/sub").c_str(), 0755), 0);
+    ASSERT_EQ(mkdir((root + "/b").c_str(), 0755), 0);
+    touchFile(root + "/a/sub/y.png");
+
+    TestFileUtils fileUtils;
+    fileUtils.setSearchPaths({root + "/b/", root + "/a/"});
+    DirectoryFileUtils directoryFileUtils;
+    directoryFileUtils.setSearchPaths({root + "/b/", root + "/a/"});
+
+    for (const bool enabled : {false, true}) {
+        fileUtils.setSearchPathManifestEnabled(enabled);
+        fileUtils.purgeCachedEntries();
+        directoryFileUtils.setSearchPathManifestEnabled(enabled);
+        directoryFileUtils.purgeCachedEntries();
+
+        // directories resolve the same as without the manifest, isDirectoryExist caches them below
+        EXPECT_EQ(fileUtils.fullPathForFilename("sub"), "") << "manifest " << enabled;
+        EXPECT_EQ(directoryFileUtils.fullPathForFilename("sub"), root + "/a/sub") << "manifest " << enabled;
+        EXPECT_EQ(directoryFileUtils.fullPathForFilename("sub/y.png"), root + "/a/sub/y.png") << "manifest " << enabled;
+        EXPECT_EQ(directoryFileUtils.fullPathForFilename("missing"), "") << "manifest " << enabled;
+
+        // directories are found in the second search path, with or without the trailing '/'
+        EXPECT_TRUE(fileUtils.isDirectoryExist("sub")) << "manifest " << enabled;
+        EXPECT_TRUE(fileUtils.isDirectoryExist("sub/")) << "manifest " << enabled;
+        EXPECT_FALSE(fileUtils.isDirectoryExist("missing")) << "manifest " << enabled;
+        EXPECT_FALSE(fileUtils.isDirectoryExist("sub/y.png")) << "manifest " << enabled;
+        EXPECT_TRUE(directoryFileUtils.isDirectoryExist("sub")) << "manifest " << enabled;
+    }
+
+    // directories created afterwards are found once the manifest is rebuilt
+    ASSERT_EQ(mkdir((root + "/a/later").c_str(), 0755), 0);
+    EXPECT_FALSE(fileUtils.isDirectoryExist("later"));
+    fileUtils.rebuildSearchPathManifest();
+    EXPECT_TRUE(fileUtils.isDirectoryExist("later"));
+
+    remove((root + "/a/sub/y.png").c_str());
+    rmdir((root + "/a/later").c_str());
+    rmdir((root + "/a/sub").c_str());
+    rmdir((root + "/a").c_str());
+    rmdir((root + "/b").c_str());
+    rmdir(root.c_str());
+}
@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "base/Data.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "platform/Image.h"
+#include "platform/ImageDecodeQueue.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t PKM_HEADER_SIZE = 16;
+constexpr int FAILED = -1;
+
+void writeBEUint16(ccstd::vector<unsigned char> &bytes, uint32_t offset, uint32_t value) {
+    bytes[offset] = static_cast<unsigned char>(value >> 8);
+    bytes[offset + 1] = static_cast<unsigned char>(value & 0xFF);
+}
+
+// an etc1 pkm file, it is decoded without any codec library or gpu
+Data createEtc1(uint32_t width, uint32_t height) {
+    const uint32_t encodedWidth = (width + 3) & ~3U;
+    const uint32_t encodedHeight = (height + 3) & ~3U;
+    ccstd::vector<unsigned char> bytes(PKM_HEADER_SIZE + (encodedWidth / 4) * (encodedHeight / 4) * 8, 0);
+    memcpy(bytes.data(), "PKM 10", 6);
+    writeBEUint16(bytes, 6, 0); // ETC1_RGB_NO_MIPMAPS
+    writeBEUint16(bytes, 8, encodedWidth);
+    writeBEUint16(bytes, 10, encodedHeight);
+    writeBEUint16(bytes, 12, width);
+    writeBEUint16(bytes, 14, height);
+
+    Data data;
+    data.copy(bytes.data(), static_cast<uint32_t>(bytes.size()));
+    return data;
+}
+
+Data createCorrupted() {
+    Data data = createEtc1(4, 4);
+    data.getBytes()[0] = 'X';
+    return data;
+}
+
+} // namespace
+
+TEST(ImageDecodeQueueTest, completionOrder) {
+    constexpr uint32_t IMAGE_COUNT = 8;
+    IntrusivePtr<ImageDecodeQueue> queue = ccnew ImageDecodeQueue(1);
+
+    ccstd::vector<Data> buffers;
+    for (uint32_t i = 0; i < IMAGE_COUNT; ++i) {
+        buffers.emplace_back(createEtc1(4 * (i + 1), 4));
+    }
+    buffers[2] = createCorrupted();
+    buffers[5].clear();
+
+    ccstd::vector<uint32_t> order;
+    ccstd::vector<int> widths(IMAGE_COUNT, 0);
+    queue->decode(std::move(buffers), [&](uint32_t index, Image *image) {
+        order.push_back(index);
+        widths[index] = image ? static_cast<int>(image->getWidth()) : FAILED;
+    });
+    EXPECT_TRUE(buffers.empty());
+    queue->flush();
+
+    // a single worker finishes the images in the order they were queued
+    ccstd::vector<uint32_t> expectedOrder;
+    for (uint32_t i = 0; i < IMAGE_COUNT; ++i) {
+        expectedOrder.push_back(i);
+    }
+    EXPECT_EQ(order, expectedOrder);
+
+    for (uint32_t i = 0; i < IMAGE_COUNT; ++i) {
+        if (i == 2 || i == 5) {
+            EXPECT_EQ(widths[i], FAILED) << "image " << i;
+        } else {
+            EXPECT_EQ(widths[i], static_cast<int>(4 * (i + 1))) << "image " << i;
+        }
+    }
+    EXPECT_EQ(queue->getPendingCount(), 0U);
+    EXPECT_EQ(queue->getDecodedBytes(), 0U);
+}
+
+TEST(ImageDecodeQueueTest, memoryBudget) {
+    constexpr uint32_t THREAD_COUNT = 4;
+    constexpr uint32_t IMAGE_COUNT = 64;
+    constexpr uint32_t IMAGE_SIZE = 64;
+    constexpr uint32_t IMAGE_BYTES = (IMAGE_SIZE / 4) * (IMAGE_SIZE / 4) * 8;
+    // a single decoded image exhausts the budget
+    IntrusivePtr<ImageDecodeQueue> queue = ccnew ImageDecodeQueue(THREAD_COUNT, 1);
+    EXPECT_EQ(queue->getThreadCount(), THREAD_COUNT);
+
+    ccstd::array<ccstd::vector<uint32_t>, 2> delivered;
+    for (uint32_t batch = 0; batch < 2; ++batch) {
+        ccstd::vector<Data> buffers;
+        for (uint32_t i = 0; i < IMAGE_COUNT; ++i) {
+            buffers.emplace_back(i % 7 == 3 ? createCorrupted() : createEtc1(IMAGE_SIZE, IMAGE_SIZE));
+        }
+        auto &results = delivered[batch];
+        results.resize(IMAGE_COUNT, 0);
+        queue->decode(std::move(buffers), [&](uint32_t index, Image *image) {
+            EXPECT_EQ(image == nullptr, index % 7 == 3) << "image " << index;
+            if (image) {
+                EXPECT_EQ(image->getDataLen(), IMAGE_BYTES);
+            }
+            ++results[index];
+        });
+    }
+
+    // workers stop taking images once the budget is exceeded, each one holds at most the image it was decoding
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LE(queue->getDecodedBytes(), THREAD_COUNT * IMAGE_BYTES);
+    EXPECT_GT(queue->getPendingCount(), THREAD_COUNT);
+
+    while (queue->getPendingCount() > 0) {
+        queue->deliver(1);
+        EXPECT_LE(queue->getDecodedBytes(), THREAD_COUNT * IMAGE_BYTES);
+        std::this_thread::yield();
+    }
+
+    // every image of both batches is delivered exactly once
+    for (const auto &results : delivered) {
+        for (uint32_t i = 0; i < IMAGE_COUNT; ++i) {
+            EXPECT_EQ(results[i], 1U) << "image " << i;
+        }
+    }
+}
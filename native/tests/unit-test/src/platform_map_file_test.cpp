@@ -0,0 +1,214 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include "base/Data.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t PKM_HEADER_SIZE = 16;
+const ccstd::string PACKAGE_ROOT = "/cc_map_file_package/";
+
+class TestFileUtils : public FileUtils {
+public:
+    bool isFileExistInternal(const ccstd::string &filename) const override {
+        struct stat st;
+        return stat(filename.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+    }
+    ccstd::string getWritablePath() const override { return ""; }
+};
+
+// serves files that only exist inside a package, so they can not be mapped
+class PackageFileUtils : public TestFileUtils {
+public:
+    using FileUtils::getContents;
+
+    Status getContents(const ccstd::string &filename, ResizableBuffer *buffer) override {
+        if (filename.compare(0, PACKAGE_ROOT.size(), PACKAGE_ROOT) != 0) {
+            return FileUtils::getContents(filename, buffer);
+        }
+        ++packageReads;
+        buffer->resize(contents.size());
+        memcpy(buffer->buffer(), contents.data(), contents.size());
+        return Status::OK;
+    }
+
+    ccstd::string contents;
+    uint32_t packageReads{0};
+};
+
+// records when the views handed out are released
+class TrackingFileUtils : public TestFileUtils {
+public:
+    IntrusivePtr<MappedFile> mapFile(const ccstd::string &filename, Status *status) override {
+        IntrusivePtr<MappedFile> file = FileUtils::mapFile(filename, status);
+        if (!file) {
+            return file;
+        }
+        ++mapped;
+        return ccnew MappedFile(
+            file->getBytes(), file->getSize(),
+            [this, file](const uint8_t * /*bytes*/, uint32_t /*size*/) {
+                ++released;
+            },
+            file->isMapped());
+    }
+
+    uint32_t mapped{0};
+    uint32_t released{0};
+};
+
+void writeFile(const ccstd::string &path, const ccstd::vector<unsigned char> &bytes) {
+    FILE *fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    if (!bytes.empty()) {
+        ASSERT_EQ(fwrite(bytes.data(), 1, bytes.size(), fp), bytes.size());
+    }
+    fclose(fp);
+}
+
+void writeBEUint16(ccstd::vector<unsigned char> &bytes, uint32_t offset, uint32_t value) {
+    bytes[offset] = static_cast<unsigned char>(value >> 8);
+    bytes[offset + 1] = static_cast<unsigned char>(value & 0xFF);
+}
+
+// an etc1 pkm file, it is decoded without any codec library or gpu
+ccstd::vector<unsigned char> createEtc1(uint32_t width, uint32_t height) {
+    ccstd::vector<unsigned char> bytes(PKM_HEADER_SIZE + (width / 4) * (height / 4) * 8, 0);
+    memcpy(bytes.data(), "PKM 10", 6);
+    writeBEUint16(bytes, 6, 0); // ETC1_RGB_NO_MIPMAPS
+    writeBEUint16(bytes, 8, width);
+    writeBEUint16(bytes, 10, height);
+    writeBEUint16(bytes, 12, width);
+    writeBEUint16(bytes, 14, height);
+    return bytes;
+}
+
+} // namespace
+
+TEST(MapFileTest, mapsFromFileSystem) {
+    char dirTemplate[] = "/tmp/cc_map_file_XXXXXX";
+    ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+    const ccstd::string root = dirTemplate;
+    const ccstd::vector<unsigned char> bytes = {'c', 'o', 'c', 'o', 's', '\0', 'm', 'a', 'p'};
+    writeFile(root + "/a.bin", bytes);
+    writeFile(root + "/empty.bin", {});
+
+    TestFileUtils fileUtils;
+    fileUtils.setSearchPaths({root + "/"});
+
+    FileUtils::Status status = FileUtils::Status::OK;
+    IntrusivePtr<MappedFile> file = fileUtils.mapFile("a.bin", &status);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(status, FileUtils::Status::OK);
+#if (CC_PLATFORM != CC_PLATFORM_WINDOWS)
+    EXPECT_TRUE(file->isMapped());
+#endif
+    ASSERT_EQ(file->getSize(), bytes.size());
+    EXPECT_EQ(memcmp(file->getBytes(), bytes.data(), bytes.size()), 0);
+
+    // the mapping stays valid after the file is removed
+    remove((root + "/a.bin").c_str());
+    EXPECT_EQ(memcmp(file->getBytes(), bytes.data(), bytes.size()), 0);
+    file = nullptr;
+
+    // empty files are represented by an empty view
+    file = fileUtils.mapFile("empty.bin", &status);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(status, FileUtils::Status::OK);
+    EXPECT_EQ(file->getSize(), 0U);
+    file = nullptr;
+
+    // missing files
+    EXPECT_EQ(fileUtils.mapFile("missing.bin", &status), nullptr);
+    EXPECT_EQ(status, FileUtils::Status::NOT_EXISTS);
+    EXPECT_EQ(fileUtils.mapFile("", &status), nullptr);
+    EXPECT_EQ(status, FileUtils::Status::NOT_EXISTS);
+    EXPECT_EQ(fileUtils.mapFile(root + "/missing.bin", &status), nullptr);
+    EXPECT_NE(status, FileUtils::Status::OK);
+
+    remove((root + "/empty.bin").c_str());
+    rmdir(root.c_str());
+}
+
+TEST(MapFileTest, fallsBackToGetContents) {
+    PackageFileUtils fileUtils;
+    fileUtils.contents = "packaged contents";
+
+    FileUtils::Status status = FileUtils::Status::NOT_EXISTS;
+    IntrusivePtr<MappedFile> file = fileUtils.mapFile(PACKAGE_ROOT + "a.bin", &status);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(status, FileUtils::Status::OK);
+    EXPECT_FALSE(file->isMapped());
+    EXPECT_EQ(fileUtils.packageReads, 1U);
+    ASSERT_EQ(file->getSize(), fileUtils.contents.size());
+    EXPECT_EQ(memcmp(file->getBytes(), fileUtils.contents.data(), fileUtils.contents.size()), 0);
+
+    // empty packaged files
+    fileUtils.contents.clear();
+    file = fileUtils.mapFile(PACKAGE_ROOT + "empty.bin", &status);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(status, FileUtils::Status::OK);
+    EXPECT_FALSE(file->isMapped());
+    EXPECT_EQ(file->getSize(), 0U);
+}
+
+TEST(MapFileTest, releasedAfterImageDecode) {
+    char dirTemplate[] = "/tmp/cc_map_file_XXXXXX";
+    ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+    const ccstd::string root = dirTemplate;
+    const ccstd::string path = root + "/a.pkm";
+    writeFile(path, createEtc1(8, 4));
+    writeFile(root + "/empty.pkm", {});
+
+    TrackingFileUtils fileUtils;
+    {
+        IntrusivePtr<Image> image = ccnew Image();
+        EXPECT_TRUE(image->initWithImageFile(path));
+        EXPECT_EQ(image->getWidth(), 8);
+        EXPECT_EQ(image->getHeight(), 4);
+        // the decoded image does not keep the encoded file
+        EXPECT_EQ(fileUtils.mapped, 1U);
+        EXPECT_EQ(fileUtils.released, 1U);
+    }
+
+    // failed decodes release the view too
+    IntrusivePtr<Image> image = ccnew Image();
+    EXPECT_FALSE(image->initWithImageFile(root + "/empty.pkm"));
+    EXPECT_EQ(fileUtils.mapped, 2U);
+    EXPECT_EQ(fileUtils.released, 2U);
+
+    remove(path.c_str());
+    remove((root + "/empty.pkm").c_str());
+    rmdir(root.c_str());
+}
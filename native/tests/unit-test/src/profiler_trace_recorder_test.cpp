@@ -0,0 +1,144 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+
+#include <atomic>
+#include <thread>
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "profiler/TraceRecorder.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+uint32_t countOccurrences(const ccstd::string &text, const ccstd::string &pattern) {
+    uint32_t count = 0;
+    for (size_t pos = text.find(pattern); pos != ccstd::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+} // namespace
+
+TEST(TraceRecorderTest, multiThreadCapture) {
+    constexpr uint32_t threadCount = 4;
+    constexpr uint32_t blockCount = 100;
+
+    // events outside of a capture are ignored
+    TraceRecorder::begin("Ignored");
+    TraceRecorder::end();
+
+    TraceRecorder::start();
+    EXPECT_TRUE(TraceRecorder::isRecording());
+    TraceRecorder::setThreadName("TestMain");
+
+    ccstd::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([]() {
+            TraceRecorder::setThreadName("TestWorker");
+            for (uint32_t i = 0; i < blockCount; ++i) {
+                AutoTraceScope outer("Outer");
+                AutoTraceScope inner("Inner");
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    TraceRecorder::stop();
+    EXPECT_FALSE(TraceRecorder::isRecording());
+
+    const auto trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(trace.find("Ignored"), ccstd::string::npos);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"Outer\""), threadCount * blockCount);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"Inner\""), threadCount * blockCount);
+    EXPECT_EQ(countOccurrences(trace, "\"ph\":\"E\""), threadCount * blockCount * 2);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"TestWorker\""), threadCount);
+    EXPECT_EQ(TraceRecorder::getDroppedEventCount(), 0U);
+}
+
+TEST(TraceRecorderTest, dropsEventsBeyondCapacity) {
+    TraceRecorder::start(8);
+    std::thread([]() {
+        for (uint32_t i = 0; i < 8; ++i) {
+            AutoTraceScope scope("Block");
+        }
+    }).join();
+    TraceRecorder::stop();
+
+    const auto trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"Block\""), 4U);
+    EXPECT_EQ(TraceRecorder::getDroppedEventCount(), 8U);
+}
+
+TEST(TraceRecorderTest, reclaimsExitedThreads) {
+    TraceRecorder::start();
+    std::thread([]() {
+        TraceRecorder::setThreadName("ExitedWorker");
+        AutoTraceScope scope("ExitedBlock");
+    }).join();
+    TraceRecorder::stop();
+
+    // kept for the capture it recorded into
+    auto trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"ExitedWorker\""), 1U);
+    EXPECT_EQ(countOccurrences(trace, "\"name\":\"ExitedBlock\""), 1U);
+
+    // freed by the next capture
+    TraceRecorder::start();
+    TraceRecorder::stop();
+    trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countOccurrences(trace, "ExitedWorker"), 0U);
+    EXPECT_EQ(countOccurrences(trace, "ExitedBlock"), 0U);
+}
+
+TEST(TraceRecorderTest, exportWhileRestarting) {
+    constexpr uint32_t captureCount = 50;
+    std::atomic<bool> done{false};
+
+    TraceRecorder::start(64);
+    ccstd::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 2; ++t) {
+        threads.emplace_back([&done]() {
+            while (!done.load(std::memory_order_relaxed)) {
+                AutoTraceScope scope("Busy");
+            }
+        });
+    }
+    for (uint32_t i = 0; i < captureCount; ++i) {
+        // buffers are reset and reallocated by their threads while the previous capture is exported
+        const auto trace = TraceRecorder::exportChromeTrace();
+        EXPECT_EQ(trace.compare(trace.size() - 2, 2, "]}"), 0);
+        // a begin and an end event per block, at most 128 events per thread
+        EXPECT_LE(countOccurrences(trace, "\"name\":\"Busy\""), 2U * 64U);
+        TraceRecorder::start(i % 2 ? 64 : 128);
+    }
+    done.store(true, std::memory_order_relaxed);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    TraceRecorder::stop();
+}
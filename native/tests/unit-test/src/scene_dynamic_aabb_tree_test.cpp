@@ -0,0 +1,219 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <algorithm>
+#include <random>
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "core/geometry/Intersect.h"
+#include "core/geometry/Ray.h"
+#include "gtest/gtest.h"
+#include "scene/DynamicAABBTree.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+// the tree never dereferences the models, use the indices as fake pointers
+scene::Model *toModel(uint32_t index) {
+    return reinterpret_cast<scene::Model *>(static_cast<uintptr_t>(index + 1));
+}
+
+uint32_t toIndex(const scene::Model *model) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(model) - 1);
+}
+
+struct Proxy {
+    geometry::AABB box;
+    int32_t id{scene::DynamicAABBTree::NULL_NODE};
+};
+
+void randomBox(std::mt19937 &rng, geometry::AABB &box) {
+    std::uniform_real_distribution<float> position(-5000.F, 5000.F);
+    std::uniform_real_distribution<float> extent(0.1F, 20.F);
+    box.setCenter(position(rng), position(rng), position(rng));
+    box.setHalfExtents(extent(rng), extent(rng), extent(rng));
+}
+
+void createFrustum(const Vec3 &position, geometry::Frustum &frustum) {
+    Mat4 transform;
+    Mat4::fromRT(Quaternion::identity(), position, &transform);
+    frustum.createOrtho(1500.F, 1000.F, 1.F, 3000.F, transform);
+}
+
+void buildTree(scene::DynamicAABBTree &tree, ccstd::vector<Proxy> &proxies) {
+    std::mt19937 rng(7);
+    proxies.resize(4000);
+    for (uint32_t i = 0; i < proxies.size(); ++i) {
+        randomBox(rng, proxies[i].box);
+        proxies[i].id = tree.createProxy(scene::BBox(proxies[i].box), toModel(i));
+    }
+
+    // small moves stay in the enlarged leaves, teleports reinsert them
+    std::uniform_real_distribution<float> jitter(-0.05F, 0.05F);
+    for (uint32_t i = 0; i < proxies.size(); i += 2) {
+        auto &proxy = proxies[i];
+        if (i % 4) {
+            proxy.box.setCenter(proxy.box.getCenter() + Vec3(jitter(rng), jitter(rng), jitter(rng)));
+            EXPECT_FALSE(tree.moveProxy(proxy.id, scene::BBox(proxy.box)));
+        } else {
+            randomBox(rng, proxy.box);
+            tree.moveProxy(proxy.id, scene::BBox(proxy.box));
+        }
+    }
+
+    for (uint32_t i = 0; i < proxies.size(); i += 3) {
+        tree.destroyProxy(proxies[i].id);
+        proxies[i].id = scene::DynamicAABBTree::NULL_NODE;
+    }
+}
+
+} // namespace
+
+TEST(DynamicAABBTreeTest, structure) {
+    scene::DynamicAABBTree tree;
+    ccstd::vector<Proxy> proxies;
+    buildTree(tree, proxies);
+
+    const auto alive = static_cast<uint32_t>(std::count_if(proxies.begin(), proxies.end(), [](const Proxy &proxy) {
+        return proxy.id != scene::DynamicAABBTree::NULL_NODE;
+    }));
+    EXPECT_EQ(tree.getProxyCount(), alive);
+    EXPECT_TRUE(tree.validate());
+    // a balanced tree of n leaves should stay close to log2(n) in height
+    EXPECT_LT(tree.getHeight(), 32);
+
+    ccstd::vector<scene::Model *> models;
+    tree.gatherModels(models);
+    EXPECT_EQ(models.size(), alive);
+
+    tree.clear();
+    EXPECT_EQ(tree.getProxyCount(), 0U);
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAABBTreeTest, queryFrustums) {
+    scene::DynamicAABBTree tree;
+    ccstd::vector<Proxy> proxies;
+    buildTree(tree, proxies);
+
+    ccstd::array<geometry::Frustum, 3> frustums;
+    createFrustum(Vec3(0.F, 0.F, 1500.F), frustums[0]);
+    createFrustum(Vec3(2000.F, 0.F, 1500.F), frustums[1]);
+    createFrustum(Vec3(-2000.F, 1000.F, 0.F), frustums[2]);
+    const geometry::Frustum *frustumPtrs[] = {&frustums[0], &frustums[1], &frustums[2]};
+
+    ccstd::array<ccstd::vector<scene::Model *>, 3> batched;
+    tree.queryFrustums(frustumPtrs, 3, batched.data());
+
+    for (uint32_t f = 0; f < 3; ++f) {
+        ccstd::vector<scene::Model *> single;
+        tree.queryFrustums(&frustumPtrs[f], 1, &single);
+        EXPECT_EQ(single, batched[f]);
+
+        // the candidates refined by the exact box test must match the brute force culling
+        ccstd::vector<uint32_t> visible;
+        for (const auto *model : single) {
+            const auto index = toIndex(model);
+            ASSERT_NE(proxies[index].id, scene::DynamicAABBTree::NULL_NODE);
+            if (proxies[index].box.aabbFrustum(frustums[f])) {
+                visible.push_back(index);
+            }
+        }
+        std::sort(visible.begin(), visible.end());
+        EXPECT_EQ(std::adjacent_find(visible.begin(), visible.end()), visible.end());
+
+        ccstd::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < proxies.size(); ++i) {
+            if (proxies[i].id != scene::DynamicAABBTree::NULL_NODE && proxies[i].box.aabbFrustum(frustums[f])) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(visible, expected) << "frustum " << f;
+    }
+}
+
+TEST(DynamicAABBTreeTest, queryRays) {
+    scene::DynamicAABBTree tree;
+    ccstd::vector<Proxy> proxies;
+    buildTree(tree, proxies);
+
+    constexpr uint32_t RAY_COUNT = 16;
+    constexpr float MAX_DISTANCE = 4000.F;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-1000.F, 1000.F);
+    std::uniform_int_distribution<uint32_t> target(0, static_cast<uint32_t>(proxies.size()) - 1);
+    ccstd::vector<geometry::Ray> rays;
+    ccstd::vector<const geometry::Ray *> rayPtrs;
+    for (uint32_t r = 0; r < RAY_COUNT; ++r) {
+        // aim at boxes of the tree, the boxes are too sparse to be hit by random rays
+        const Vec3 origin{position(rng), position(rng), position(rng)};
+        Vec3 dir = proxies[target(rng)].box.getCenter() - origin;
+        dir.normalize();
+        rays.emplace_back(origin.x, origin.y, origin.z, dir.x, dir.y, dir.z);
+    }
+    for (const auto &ray : rays) {
+        rayPtrs.push_back(&ray);
+    }
+
+    ccstd::vector<ccstd::vector<scene::Model *>> batched(RAY_COUNT);
+    tree.queryRays(rayPtrs.data(), RAY_COUNT, MAX_DISTANCE, batched.data());
+
+    uint32_t hitCount = 0;
+    for (uint32_t r = 0; r < RAY_COUNT; ++r) {
+        ccstd::vector<scene::Model *> single;
+        tree.queryRays(&rayPtrs[r], 1, MAX_DISTANCE, &single);
+        EXPECT_EQ(single, batched[r]);
+
+        // the candidates refined by the exact box test must match the brute force raycast
+        ccstd::vector<uint32_t> hits;
+        for (const auto *model : single) {
+            const auto index = toIndex(model);
+            ASSERT_NE(proxies[index].id, scene::DynamicAABBTree::NULL_NODE);
+            const float distance = geometry::rayAABB(rays[r], proxies[index].box);
+            if (distance > 0.F && distance < MAX_DISTANCE) {
+                hits.push_back(index);
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+        EXPECT_EQ(std::adjacent_find(hits.begin(), hits.end()), hits.end());
+
+        ccstd::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < proxies.size(); ++i) {
+            if (proxies[i].id == scene::DynamicAABBTree::NULL_NODE) {
+                continue;
+            }
+            const float distance = geometry::rayAABB(rays[r], proxies[i].box);
+            if (distance > 0.F && distance < MAX_DISTANCE) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(hits, expected) << "ray " << r;
+        hitCount += static_cast<uint32_t>(expected.size());
+    }
+    EXPECT_GT(hitCount, 0U);
+}
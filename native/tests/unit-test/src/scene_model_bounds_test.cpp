@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <random>
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "gtest/gtest.h"
+#include "scene/ModelBoundsArray.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+void createRandomBounds(uint32_t count, ccstd::vector<geometry::AABB> &boxes) {
+    std::mt19937 rng(count);
+    std::uniform_real_distribution<float> position(-500.F, 500.F);
+    std::uniform_real_distribution<float> extent(0.1F, 10.F);
+    boxes.resize(count);
+    for (auto &box : boxes) {
+        box.setCenter(position(rng), position(rng), position(rng));
+        box.setHalfExtents(extent(rng), extent(rng), extent(rng));
+    }
+}
+
+void createFrustum(geometry::Frustum &frustum) {
+    Mat4 transform;
+    Mat4::fromRT(Quaternion::identity(), Vec3(0.F, 0.F, 100.F), &transform);
+    frustum.createOrtho(300.F, 200.F, 1.F, 400.F, transform);
+}
+
+} // namespace
+
+TEST(ModelBoundsArrayTest, matchesAABBFrustum) {
+    geometry::Frustum frustum;
+    createFrustum(frustum);
+
+    ccstd::vector<geometry::AABB> boxes;
+    createRandomBounds(1027, boxes);
+
+    scene::ModelBoundsArray bounds;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        // every 7th model has no world bounds and must never be culled
+        bounds.add(nullptr, i % 7 ? &boxes[i] : nullptr);
+    }
+
+    ccstd::vector<uint8_t> visibility;
+    bounds.cullFrustum(frustum, visibility);
+    ASSERT_EQ(visibility.size(), boxes.size());
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        const bool expected = !(i % 7) || boxes[i].aabbFrustum(frustum);
+        EXPECT_EQ(visibility[i] != 0, expected) << "box " << i;
+    }
+}
+
+TEST(ModelBoundsArrayTest, matchesPerModelCulling) {
+    geometry::Frustum ortho;
+    createFrustum(ortho);
+    geometry::Frustum perspective;
+    Mat4 transform;
+    Quaternion rotation;
+    Quaternion::fromEuler(20.F, 35.F, 0.F, &rotation);
+    Mat4::fromRT(rotation, Vec3(10.F, -20.F, 300.F), &transform);
+    geometry::Frustum::createPerspective(&perspective, 1.F, 1.5F, 1.F, 800.F, transform);
+
+    // sizes around the SIMD width and above the parallel threshold
+    for (const uint32_t count : {1U, 3U, 4U, 5U, 1027U, scene::BOUNDS_CULLING_PARALLEL_THRESHOLD * 3 + 1}) {
+        ccstd::vector<geometry::AABB> boxes;
+        createRandomBounds(count, boxes);
+        scene::ModelBoundsArray bounds;
+        for (auto &box : boxes) {
+            bounds.add(nullptr, &box);
+        }
+
+        for (const auto *frustum : {&ortho, &perspective}) {
+            // per model path, same as isFrustumCulled in NativeSceneCulling.cpp
+            ccstd::vector<uint8_t> expected(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                geometry::AABB transWorldBounds{};
+                transWorldBounds.set(boxes[i].getCenter(), boxes[i].getHalfExtents());
+                expected[i] = transWorldBounds.aabbFrustum(*frustum) ? 1 : 0;
+            }
+
+            ccstd::vector<uint8_t> visibility;
+            bounds.cullFrustum(*frustum, visibility);
+            EXPECT_EQ(visibility, expected) << count << " models";
+
+            // unaligned sub range, untouched outside of it
+            const uint32_t begin = count / 3;
+            const uint32_t end = count - count / 5;
+            ccstd::vector<uint8_t> range(count, 2);
+            bounds.cullFrustum(*frustum, begin, end, range.data());
+            for (uint32_t i = 0; i < count; ++i) {
+                EXPECT_EQ(range[i], i >= begin && i < end ? expected[i] : 2) << "box " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <random>
+#include <thread>
+#include "core/geometry/AABB.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "scene/Model.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t MODEL_COUNT = 301;
+constexpr uint32_t THREAD_COUNT = 4;
+constexpr uint32_t FRAME_COUNT = 3;
+
+struct ModelSet {
+    IntrusivePtr<Node> root;
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    ccstd::vector<IntrusivePtr<scene::Model>> models;
+};
+
+// short chains of nodes under a shared root, so sibling models share dirty parents
+void createModels(ModelSet &set) {
+    std::mt19937 rng(MODEL_COUNT);
+    std::uniform_real_distribution<float> position(-10.F, 10.F);
+    std::uniform_real_distribution<float> angle(-180.F, 180.F);
+    std::uniform_real_distribution<float> scale(0.5F, 2.F);
+
+    set.root = ccnew Node();
+    for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+        Node *parent = i % 5 ? set.nodes.back().get() : set.root.get();
+        IntrusivePtr<Node> node = ccnew Node();
+        node->setParent(parent);
+        node->setPosition(position(rng), position(rng), position(rng));
+        node->setRotationFromEuler(angle(rng), angle(rng), angle(rng));
+        node->setScale(scale(rng), scale(rng), scale(rng));
+        set.nodes.emplace_back(node);
+
+        IntrusivePtr<scene::Model> model = ccnew scene::Model();
+        model->initialize();
+        model->setNode(node);
+        model->setTransform(node);
+        model->createBoundingShape(Vec3(-1.F, -2.F, -0.5F), Vec3(1.F, 0.5F, 3.F));
+        set.models.emplace_back(model);
+    }
+}
+
+void moveNodes(ModelSet &set, uint32_t frame) {
+    set.root->setPosition(static_cast<float>(frame), 0.F, -static_cast<float>(frame));
+    for (uint32_t i = frame; i < MODEL_COUNT; i += 7) {
+        set.nodes[i]->setRotationFromEuler(0.F, 15.F * static_cast<float>(frame + i), 0.F);
+    }
+}
+
+// same as the serial branch of RenderScene::update
+void updateSerially(ModelSet &set, uint32_t stamp) {
+    for (const auto &model : set.models) {
+        model->updateTransform(stamp);
+    }
+    for (const auto &model : set.models) {
+        model->updateUBOs(stamp);
+    }
+}
+
+// same phases as RenderScene::updateModelsParallelly, with real worker threads
+void updateParallelly(ModelSet &set, uint32_t stamp) {
+    for (const auto &model : set.models) {
+        model->prepareParallelUpdate(stamp);
+    }
+
+    const uint32_t chunkSize = (MODEL_COUNT + THREAD_COUNT - 1) / THREAD_COUNT;
+    ccstd::vector<std::thread> workers;
+    for (uint32_t job = 0; job < THREAD_COUNT; ++job) {
+        workers.emplace_back([&set, stamp, chunkSize, job]() {
+            const uint32_t end = std::min((job + 1) * chunkSize, MODEL_COUNT);
+            for (uint32_t i = job * chunkSize; i < end; ++i) {
+                set.models[i]->updateLocalData(stamp);
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    for (const auto &model : set.models) {
+        model->uploadLocalData(stamp);
+    }
+}
+
+void expectSameBounds(const ModelSet &serial, const ModelSet &parallel, uint32_t frame) {
+    for (uint32_t i = 0; i < MODEL_COUNT; ++i) {
+        const auto &expectedMatrix = serial.nodes[i]->getWorldMatrix();
+        const auto &actualMatrix = parallel.nodes[i]->getWorldMatrix();
+        for (uint32_t j = 0; j < 16; ++j) {
+            EXPECT_EQ(actualMatrix.m[j], expectedMatrix.m[j]) << "node " << i << " frame " << frame;
+        }
+        const auto *expected = serial.models[i]->getWorldBounds();
+        const auto *actual = parallel.models[i]->getWorldBounds();
+        ASSERT_NE(actual, nullptr);
+        EXPECT_EQ(actual->getCenter(), expected->getCenter()) << "model " << i << " frame " << frame;
+        EXPECT_EQ(actual->getHalfExtents(), expected->getHalfExtents()) << "model " << i << " frame " << frame;
+        EXPECT_EQ(parallel.models[i]->getUpdateStamp(), serial.models[i]->getUpdateStamp());
+    }
+}
+
+} // namespace
+
+TEST(ModelParallelUpdateTest, matchesSerialUpdate) {
+    ModelSet serial;
+    ModelSet parallel;
+    createModels(serial);
+    createModels(parallel);
+
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        if (frame) {
+            moveNodes(serial, frame);
+            moveNodes(parallel, frame);
+        }
+        updateSerially(serial, frame + 1);
+        updateParallelly(parallel, frame + 1);
+        expectSameBounds(serial, parallel, frame);
+        Node::resetChangedFlags();
+    }
+
+    // a frame without changes keeps the bounds of the previous one
+    updateSerially(serial, FRAME_COUNT + 1);
+    updateParallelly(parallel, FRAME_COUNT + 1);
+    expectSameBounds(serial, parallel, FRAME_COUNT);
+
+    for (auto *set : {&serial, &parallel}) {
+        for (const auto &model : set->models) {
+            model->destroy();
+        }
+    }
+}
@@ -0,0 +1,339 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+
+#if CC_USE_SPINE_3_8
+    #include <chrono>
+    #include <cstring>
+    #include <thread>
+    #include "editor-support/spine-creator-support/SkeletonCache.h"
+    #include "editor-support/spine-creator-support/SkeletonDataMgr.h"
+    #include "editor-support/spine-creator-support/spine-cocos2dx.h"
+
+using cc::IntrusivePtr;
+using cc::SkeletonCache;
+using cc::middleware::Color4B;
+using cc::middleware::Texture2D;
+using cc::middleware::V3F_T2F_C4B_C4B;
+
+namespace {
+
+const char *const SKELETON_UUID = "skeleton-cache-test";
+const char *const ANIMATION_NAME = "move";
+constexpr std::size_t VERTEX_FLOATS = sizeof(V3F_T2F_C4B_C4B) / sizeof(float);
+constexpr float UV_TOLERANCE = 1.0F / 65535.0F;
+
+const char ATLAS[] = R"(
+page0.png
+size: 64,64
+format: RGBA8888
+filter: Linear,Linear
+repeat: none
+box
+  rotate: false
+  xy: 0, 0
+  size: 32, 32
+  orig: 32, 32
+  offset: 0, 0
+  index: -1
+
+page1.png
+size: 64,64
+format: RGBA8888
+filter: Linear,Linear
+repeat: none
+tip
+  rotate: false
+  xy: 8, 16
+  size: 16, 8
+  orig: 16, 8
+  offset: 0, 0
+  index: -1
+)";
+
+// three slots over two textures and two blend modes, a color timeline splits the color runs
+const char SKELETON_JSON[] = R"({
+"skeleton": {"spine": "3.8.99", "width": 100, "height": 100},
+"bones": [
+    {"name": "root"},
+    {"name": "arm", "parent": "root", "length": 50, "x": 10, "y": 20}
+],
+"slots": [
+    {"name": "body", "bone": "root", "attachment": "box"},
+    {"name": "hand", "bone": "arm", "attachment": "box", "color": "ff8040ff", "blend": "additive"},
+    {"name": "tip", "bone": "arm", "attachment": "tip"}
+],
+"skins": [{
+    "name": "default",
+    "attachments": {
+        "body": {"box": {"width": 40, "height": 30}},
+        "hand": {"box": {"x": 25, "rotation": 30, "width": 20, "height": 10}},
+        "tip": {"tip": {"x": 50, "width": 16, "height": 8}}
+    }
+}],
+"animations": {
+    "move": {
+        "bones": {
+            "arm": {
+                "rotate": [{"angle": 0}, {"time": 0.5, "angle": 90}],
+                "translate": [{"x": 0, "y": 0}, {"time": 0.5, "x": 15, "y": -5}]
+            },
+            "root": {
+                "scale": [{"x": 1, "y": 1}, {"time": 0.5, "x": 1.5, "y": 0.8}]
+            }
+        },
+        "slots": {
+            "tip": {"color": [{"color": "ffffffff"}, {"time": 0.5, "color": "20ff0080"}]}
+        }
+    }
+}
+})";
+
+Texture2D *atlasTextures[2] = {nullptr, nullptr};
+
+Texture2D *loadAtlasTexture(const char *path) {
+    return strcmp(path, "page0.png") == 0 ? atlasTextures[0] : atlasTextures[1];
+}
+
+bool sameColor(const Color4B &lhs, const Color4B &rhs) {
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+const V3F_T2F_C4B_C4B *getVertices(const SkeletonCache::FrameData *frame, std::size_t *count) {
+    *count = frame->vb.getCurPos() / sizeof(V3F_T2F_C4B_C4B);
+    return reinterpret_cast<const V3F_T2F_C4B_C4B *>(frame->vb.getBuffer());
+}
+
+// half a quantization step of the position range of the whole animation
+float getPositionTolerance(const SkeletonCache::AnimationData &animation) {
+    float range = 0.0F;
+    float minX = FLT_MAX;
+    float minY = FLT_MAX;
+    float maxX = -FLT_MAX;
+    float maxY = -FLT_MAX;
+    for (std::size_t frameIdx = 0; frameIdx < animation.getFrameCount(); ++frameIdx) {
+        std::size_t count = 0;
+        const auto *verts = getVertices(animation.getFrameData(frameIdx), &count);
+        for (std::size_t i = 0; i < count; ++i) {
+            minX = std::min(minX, verts[i].vertex.x);
+            minY = std::min(minY, verts[i].vertex.y);
+            maxX = std::max(maxX, verts[i].vertex.x);
+            maxY = std::max(maxY, verts[i].vertex.y);
+        }
+    }
+    range = std::max(maxX - minX, maxY - minY);
+    return range / 65535.0F + 1e-4F;
+}
+
+void expectSameFrames(const SkeletonCache::AnimationData &full, const SkeletonCache::CompactFrames &compact) {
+    ASSERT_EQ(compact.getFrameCount(), full.getFrameCount());
+    const float positionTolerance = getPositionTolerance(full);
+    std::size_t vertexBytes = 0;
+    for (std::size_t frameIdx = 0; frameIdx < full.getFrameCount(); ++frameIdx) {
+        const auto *frame = full.getFrameData(frameIdx);
+        const auto &compactFrame = compact.getFrame(frameIdx);
+        std::size_t vertexCount = 0;
+        const auto *verts = getVertices(frame, &vertexCount);
+        vertexBytes += frame->vb.getCurPos();
+
+        const auto *compactVertices = compact.getVertices(compactFrame);
+        const auto *colors = compact.getColors(compactFrame);
+        ASSERT_EQ(compactFrame.colorCount, frame->getColorCount());
+        uint32_t colorIndex = 0;
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            EXPECT_NEAR(compact.decodeX(compactVertices[i].x), verts[i].vertex.x, positionTolerance) << "frame " << frameIdx << " vertex " << i;
+            EXPECT_NEAR(compact.decodeY(compactVertices[i].y), verts[i].vertex.y, positionTolerance) << "frame " << frameIdx << " vertex " << i;
+            EXPECT_NEAR(SkeletonCache::CompactFrames::decodeUV(compactVertices[i].u), verts[i].texCoord.u, UV_TOLERANCE);
+            EXPECT_NEAR(SkeletonCache::CompactFrames::decodeUV(compactVertices[i].v), verts[i].texCoord.v, UV_TOLERANCE);
+            while (i >= colors[colorIndex].vertexEnd && colorIndex + 1 < compactFrame.colorCount) {
+                ++colorIndex;
+            }
+            EXPECT_TRUE(sameColor(colors[colorIndex].finalColor, verts[i].color)) << "frame " << frameIdx << " vertex " << i;
+            EXPECT_TRUE(sameColor(colors[colorIndex].darkColor, verts[i].color2)) << "frame " << frameIdx << " vertex " << i;
+        }
+
+        const auto indexCount = frame->ib.getCurPos() / sizeof(uint16_t);
+        EXPECT_EQ(memcmp(compact.getIndices(compactFrame), frame->ib.getBuffer(), indexCount * sizeof(uint16_t)), 0) << "frame " << frameIdx;
+
+        const auto &segments = frame->getSegments();
+        ASSERT_EQ(compactFrame.segmentCount, segments.size());
+        const auto *compactSegments = compact.getSegments(compactFrame);
+        std::size_t segmentVertexCount = 0;
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            EXPECT_EQ(compact.getTexture(compactSegments[i].textureIndex), segments[i]->getTexture());
+            EXPECT_EQ(compactSegments[i].blendMode, segments[i]->blendMode);
+            EXPECT_EQ(compactSegments[i].indexCount, segments[i]->indexCount);
+            EXPECT_EQ(compactSegments[i].vertexCount * VERTEX_FLOATS, segments[i]->vertexFloatCount);
+            segmentVertexCount += compactSegments[i].vertexCount;
+        }
+        EXPECT_EQ(segmentVertexCount, vertexCount);
+
+        const auto &bones = frame->getBones();
+        ASSERT_EQ(compactFrame.boneCount, bones.size());
+        const auto *compactBones = compact.getBones(compactFrame);
+        for (std::size_t i = 0; i < bones.size(); ++i) {
+            const auto &matm = bones[i]->globalTransformMatrix.m;
+            EXPECT_EQ(compactBones[i].a, matm[0]);
+            EXPECT_EQ(compactBones[i].c, matm[1]);
+            EXPECT_EQ(compactBones[i].b, matm[4]);
+            EXPECT_EQ(compactBones[i].d, matm[5]);
+            EXPECT_EQ(compactBones[i].worldX, matm[12]);
+            EXPECT_EQ(compactBones[i].worldY, matm[13]);
+        }
+    }
+    EXPECT_LT(compact.getMemorySize(), vertexBytes);
+}
+
+void expectSameFrames(const SkeletonCache::AnimationData &expected, const SkeletonCache::AnimationData &actual) {
+    ASSERT_EQ(actual.getFrameCount(), expected.getFrameCount());
+    for (std::size_t frameIdx = 0; frameIdx < expected.getFrameCount(); ++frameIdx) {
+        const auto *expectedFrame = expected.getFrameData(frameIdx);
+        const auto *actualFrame = actual.getFrameData(frameIdx);
+        ASSERT_NE(actualFrame, nullptr);
+        ASSERT_EQ(actualFrame->vb.getCurPos(), expectedFrame->vb.getCurPos());
+        ASSERT_EQ(actualFrame->ib.getCurPos(), expectedFrame->ib.getCurPos());
+        EXPECT_EQ(memcmp(actualFrame->vb.getBuffer(), expectedFrame->vb.getBuffer(), expectedFrame->vb.getCurPos()), 0) << "frame " << frameIdx;
+        EXPECT_EQ(memcmp(actualFrame->ib.getBuffer(), expectedFrame->ib.getBuffer(), expectedFrame->ib.getCurPos()), 0) << "frame " << frameIdx;
+        ASSERT_EQ(actualFrame->getSegmentCount(), expectedFrame->getSegmentCount());
+        for (std::size_t i = 0; i < expectedFrame->getSegmentCount(); ++i) {
+            EXPECT_EQ(actualFrame->getSegments()[i]->getTexture(), expectedFrame->getSegments()[i]->getTexture());
+            EXPECT_EQ(actualFrame->getSegments()[i]->indexCount, expectedFrame->getSegments()[i]->indexCount);
+        }
+    }
+}
+
+class SkeletonCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        cc::setSpineObjectDisposeCallback([](void * /*mem*/) {});
+        for (int i = 0; i < 2; ++i) {
+            atlasTextures[i] = new Texture2D();
+            atlasTextures[i]->addRef();
+            atlasTextures[i]->setPixelsWide(64);
+            atlasTextures[i]->setPixelsHigh(64);
+            atlasTextures[i]->setRealTextureIndex(i);
+        }
+
+        cc::spAtlasPage_setCustomTextureLoader(loadAtlasTexture);
+        auto *atlas = new spine::Atlas(ATLAS, static_cast<int>(strlen(ATLAS)), "", &_textureLoader);
+        cc::spAtlasPage_setCustomTextureLoader(nullptr);
+        auto *attachmentLoader = new cc::Cocos2dAtlasAttachmentLoader(atlas);
+        spine::SkeletonJson json(attachmentLoader);
+        auto *skeletonData = json.readSkeletonData(SKELETON_JSON);
+        ASSERT_NE(skeletonData, nullptr) << json.getError().buffer();
+        cc::SkeletonDataMgr::getInstance()->setSkeletonData(SKELETON_UUID, skeletonData, atlas, attachmentLoader, {0, 1});
+    }
+
+    void TearDown() override {
+        SkeletonCache::UseCompactFrames = false;
+        cc::SkeletonDataMgr::getInstance()->releaseByUUID(SKELETON_UUID);
+        // the caches and the atlas released every texture they referenced
+        for (auto *&texture : atlasTextures) {
+            EXPECT_EQ(texture->getRefCount(), 1U);
+            texture->release();
+            texture = nullptr;
+        }
+    }
+
+    static IntrusivePtr<SkeletonCache> createCache() {
+        IntrusivePtr<SkeletonCache> cache = new SkeletonCache();
+        cache->initWithUUID(SKELETON_UUID);
+        return cache;
+    }
+
+    static SkeletonCache::AnimationData *bake(SkeletonCache *cache) {
+        auto *animationData = cache->buildAnimationData(ANIMATION_NAME);
+        cache->updateToFrame(ANIMATION_NAME);
+        return animationData;
+    }
+
+    // updateToFrame takes over the frames once the worker is done
+    static void waitForPrebake(SkeletonCache *cache, const SkeletonCache::AnimationData *animationData) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!animationData->isComplete() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            cache->updateToFrame(ANIMATION_NAME);
+        }
+    }
+
+private:
+    cc::Cocos2dTextureLoader _textureLoader;
+};
+
+} // namespace
+
+TEST_F(SkeletonCacheTest, compactFramesMatchFullFrames) {
+    auto full = createCache();
+    const auto *fullData = bake(full);
+    ASSERT_NE(fullData, nullptr);
+    ASSERT_TRUE(fullData->isComplete());
+    ASSERT_GT(fullData->getFrameCount(), 1U);
+    EXPECT_EQ(fullData->getCompactFrames(), nullptr);
+
+    SkeletonCache::UseCompactFrames = true;
+    auto compact = createCache();
+    const auto *compactData = bake(compact);
+    ASSERT_NE(compactData->getCompactFrames(), nullptr);
+    EXPECT_EQ(compactData->getFrameData(0), nullptr);
+    EXPECT_EQ(compactData->getFrameCount(), fullData->getFrameCount());
+    expectSameFrames(*fullData, *compactData->getCompactFrames());
+}
+
+TEST_F(SkeletonCacheTest, prebakeAnimation) {
+    auto reference = createCache();
+    const auto *referenceData = bake(reference);
+
+    for (const bool useCompactFrames : {false, true}) {
+        SkeletonCache::UseCompactFrames = useCompactFrames;
+        auto cache = createCache();
+        cache->prebakeAnimation(ANIMATION_NAME);
+        const auto *animationData = cache->getAnimationData(ANIMATION_NAME);
+        ASSERT_NE(animationData, nullptr);
+        waitForPrebake(cache, animationData);
+        ASSERT_TRUE(animationData->isComplete());
+        if (useCompactFrames) {
+            ASSERT_NE(animationData->getCompactFrames(), nullptr);
+            expectSameFrames(*referenceData, *animationData->getCompactFrames());
+        } else {
+            expectSameFrames(*referenceData, *animationData);
+        }
+    }
+    SkeletonCache::UseCompactFrames = false;
+
+    // a reset while baking discards the prebaked frames, the animation is baked again on this thread
+    auto resetCache = createCache();
+    resetCache->prebakeAnimation(ANIMATION_NAME);
+    resetCache->resetAnimationData(ANIMATION_NAME);
+    const auto *resetData = resetCache->getAnimationData(ANIMATION_NAME);
+    waitForPrebake(resetCache, resetData);
+    ASSERT_TRUE(resetData->isComplete());
+    expectSameFrames(*referenceData, *resetData);
+
+    // destroying the cache waits for the worker
+    auto destroyedCache = createCache();
+    destroyedCache->prebakeAnimation(ANIMATION_NAME);
+    destroyedCache = nullptr;
+}
+#endif
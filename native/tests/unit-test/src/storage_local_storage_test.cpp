@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include <sqlite3/sqlite3.h>
+#else
+    #include <sqlite3.h>
+#endif
+
+#include "storage/local-storage/LocalStorage.h"
+
+namespace {
+
+int countRows(sqlite3 *db) {
+    sqlite3_stmt *stmt = nullptr;
+    int count = -1;
+    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM data;", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+} // namespace
+
+TEST(LocalStorageTest, writeBehind) {
+    localStorageInit();
+    localStorageSetWriteBehindEnabled(true);
+
+    for (int i = 0; i < 1000; ++i) {
+        localStorageSetItem("key" + std::to_string(i % 10), std::to_string(i));
+    }
+    localStorageRemoveItem("key3");
+
+    ccstd::string value;
+    EXPECT_TRUE(localStorageGetItem("key7", &value));
+    EXPECT_EQ(value, "997");
+    EXPECT_FALSE(localStorageGetItem("key3", &value));
+    int length = 0;
+    localStorageGetLength(length);
+    EXPECT_EQ(length, 9);
+
+    // disabling commits the pending writes, the reads below go to the database
+    localStorageSetWriteBehindEnabled(false);
+    EXPECT_TRUE(localStorageGetItem("key9", &value));
+    EXPECT_EQ(value, "999");
+    EXPECT_FALSE(localStorageGetItem("key3", &value));
+    localStorageGetLength(length);
+    EXPECT_EQ(length, 9);
+
+    localStorageFree();
+}
+
+TEST(LocalStorageTest, writeBehindClear) {
+    localStorageInit();
+    localStorageSetItem("a", "1");
+    localStorageSetWriteBehindEnabled(true);
+
+    ccstd::string value;
+    EXPECT_TRUE(localStorageGetItem("a", &value));
+    localStorageClear();
+    localStorageSetItem("b", "2");
+    localStorageFlush();
+
+    ccstd::string key;
+    localStorageGetKey(0, &key);
+    EXPECT_EQ(key, "b");
+
+    localStorageSetWriteBehindEnabled(false);
+    EXPECT_FALSE(localStorageGetItem("a", &value));
+    int length = 0;
+    localStorageGetLength(length);
+    EXPECT_EQ(length, 1);
+
+    localStorageFree();
+}
+
+TEST(LocalStorageTest, writeBehindRetry) {
+    char dirTemplate[] = "/tmp/cc_local_storage_XXXXXX";
+    ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+    const ccstd::string path = ccstd::string(dirTemplate) + "/jsb.sqlite";
+    localStorageInit(path);
+    localStorageSetWriteBehindEnabled(true);
+
+    // another connection holding the write lock makes the commit fail with SQLITE_BUSY
+    sqlite3 *other = nullptr;
+    ASSERT_EQ(sqlite3_open(path.c_str(), &other), SQLITE_OK);
+    ASSERT_EQ(sqlite3_exec(other, "BEGIN IMMEDIATE;", nullptr, nullptr, nullptr), SQLITE_OK);
+
+    localStorageSetItem("a", "1");
+    localStorageFlush(); // returns once the commit failed
+    EXPECT_EQ(countRows(other), 0);
+    ccstd::string value;
+    EXPECT_TRUE(localStorageGetItem("a", &value));
+
+    // the failed batch is kept and committed together with the later writes
+    ASSERT_EQ(sqlite3_exec(other, "COMMIT;", nullptr, nullptr, nullptr), SQLITE_OK);
+    localStorageSetItem("b", "2");
+    localStorageFlush();
+    EXPECT_EQ(countRows(other), 2);
+
+    sqlite3_close(other);
+    localStorageSetWriteBehindEnabled(false);
+    EXPECT_TRUE(localStorageGetItem("a", &value));
+    EXPECT_EQ(value, "1");
+    localStorageFree();
+
+    for (const char *suffix : {"", "-wal", "-shm"}) {
+        std::remove((path + suffix).c_str());
+    }
+    rmdir(dirTemplate);
+}
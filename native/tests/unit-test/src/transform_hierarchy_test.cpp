@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2023 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformHierarchy.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+Mat4 expectedWorldMatrix(const Node *node) {
+    Mat4 local;
+    Mat4::fromRTS(node->getRotation(), node->getPosition(), node->getScale(), &local);
+    if (!node->getParent()) {
+        return local;
+    }
+    return expectedWorldMatrix(node->getParent()) * local;
+}
+
+} // namespace
+
+TEST(TransformHierarchyTest, matchesOnDemandUpdate) {
+    IntrusivePtr<Node> root(new Node());
+    root->setActiveInHierarchy(true);
+    root->setPosition(1, 2, 3);
+
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    for (int i = 0; i < 4; ++i) {
+        IntrusivePtr<Node> child(new Node());
+        child->setParent(root);
+        child->setActiveInHierarchy(true);
+        child->setRotationFromEuler(10.F * i, 0, 0);
+        child->setScale(1.F + i, 1, 1);
+        nodes.emplace_back(child);
+        for (int j = 0; j < 3; ++j) {
+            IntrusivePtr<Node> grandChild(new Node());
+            grandChild->setParent(child);
+            grandChild->setActiveInHierarchy(true);
+            grandChild->setPosition(static_cast<float>(j), 0, -1);
+            nodes.emplace_back(grandChild);
+        }
+    }
+
+    IntrusivePtr<TransformHierarchy> hierarchy(new TransformHierarchy(root));
+    hierarchy->update();
+    EXPECT_EQ(hierarchy->getNodeCount(), 17);
+    EXPECT_EQ(hierarchy->getLevelCount(), 3);
+    for (const auto &node : nodes) {
+        EXPECT_FALSE(node->isTransformDirty());
+        EXPECT_TRUE(node->getWorldMatrix().approxEquals(expectedWorldMatrix(node)));
+    }
+
+    // parent updated on demand between two passes, children should still see the new world matrix
+    nodes[0]->setPosition(5, 0, 0);
+    nodes[0]->getWorldMatrix();
+    nodes[1]->setRotationFromEuler(0, 45, 0);
+    hierarchy->update();
+    for (const auto &node : nodes) {
+        EXPECT_FALSE(node->isTransformDirty());
+        EXPECT_TRUE(node->getWorldMatrix().approxEquals(expectedWorldMatrix(node)));
+    }
+
+    // hierarchy changes are picked up on the next pass
+    nodes[4]->setParent(nodes[1]);
+    hierarchy->update();
+    EXPECT_EQ(hierarchy->getLevelCount(), 5);
+    for (const auto &node : nodes) {
+        EXPECT_FALSE(node->isTransformDirty());
+        EXPECT_TRUE(node->getWorldMatrix().approxEquals(expectedWorldMatrix(node)));
+    }
+}